@@ -252,6 +252,8 @@ print_bearer_info (MMBearer *bearer)
         gchar *duration = NULL;
         gchar *bytes_rx = NULL;
         gchar *bytes_tx = NULL;
+        gchar *uplink_speed = NULL;
+        gchar *downlink_speed = NULL;
         gchar *attempts = NULL;
         gchar *failed_attempts = NULL;
         gchar *total_duration = NULL;
@@ -270,6 +272,12 @@ print_bearer_info (MMBearer *bearer)
             val = mm_bearer_stats_get_tx_bytes (stats);
             if (val)
                 bytes_tx = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_uplink_speed (stats);
+            if (val)
+                uplink_speed = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
+            val = mm_bearer_stats_get_downlink_speed (stats);
+            if (val)
+                downlink_speed = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
             val = mm_bearer_stats_get_attempts (stats);
             if (val)
                 attempts = g_strdup_printf ("%" G_GUINT64_FORMAT, val);
@@ -290,6 +298,8 @@ print_bearer_info (MMBearer *bearer)
         mmcli_output_string_take (MMC_F_BEARER_STATS_DURATION,        duration);
         mmcli_output_string_take (MMC_F_BEARER_STATS_BYTES_RX,        bytes_rx);
         mmcli_output_string_take (MMC_F_BEARER_STATS_BYTES_TX,        bytes_tx);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_UPLINK_SPEED,    uplink_speed);
+        mmcli_output_string_take (MMC_F_BEARER_STATS_DOWNLINK_SPEED,  downlink_speed);
         mmcli_output_string_take (MMC_F_BEARER_STATS_ATTEMPTS,        attempts);
         mmcli_output_string_take (MMC_F_BEARER_STATS_FAILED_ATTEMPTS, failed_attempts);
         mmcli_output_string_take (MMC_F_BEARER_STATS_TOTAL_DURATION,  total_duration);
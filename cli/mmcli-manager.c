@@ -44,6 +44,7 @@
 typedef struct {
     MMManager *manager;
     GCancellable *cancellable;
+    gchar **monitor_json_filter;
 #if defined WITH_UDEV
     GUdevClient *udev;
 #endif
@@ -54,6 +55,8 @@ static Context *ctx;
 static gboolean get_daemon_version_flag;
 static gboolean list_modems_flag;
 static gboolean monitor_modems_flag;
+static gboolean monitor_json_flag;
+static gchar *monitor_json_filter_str;
 static gboolean scan_modems_flag;
 static gchar *set_logging_str;
 static gchar *inhibit_device_str;
@@ -80,6 +83,14 @@ static GOptionEntry entries[] = {
       "List available modems and monitor additions and removals",
       NULL
     },
+    { "monitor-json", 0, 0, G_OPTION_ARG_NONE, &monitor_json_flag,
+      "Monitor all modems, reporting each property change and signal as a JSON line",
+      NULL
+    },
+    { "monitor-json-filter", 0, 0, G_OPTION_ARG_STRING, &monitor_json_filter_str,
+      "Only report the given properties and signals when monitoring in JSON",
+      "[Name1,Name2...]"
+    },
     { "scan-modems", 'S', 0, G_OPTION_ARG_NONE, &scan_modems_flag,
       "Request to re-scan looking for modems",
       NULL
@@ -129,6 +140,7 @@ mmcli_manager_options_enabled (void)
     n_actions = (get_daemon_version_flag +
                  list_modems_flag +
                  monitor_modems_flag +
+                 monitor_json_flag +
                  scan_modems_flag +
                  !!set_logging_str +
                  !!inhibit_device_str +
@@ -143,6 +155,11 @@ mmcli_manager_options_enabled (void)
         exit (EXIT_FAILURE);
     }
 
+    if (monitor_json_filter_str && !monitor_json_flag) {
+        g_printerr ("error: the JSON monitoring filter requires --monitor-json\n");
+        exit (EXIT_FAILURE);
+    }
+
     if (get_daemon_version_flag)
         mmcli_force_sync_operation ();
     else if (monitor_modems_flag) {
@@ -151,7 +168,9 @@ mmcli_manager_options_enabled (void)
             exit (EXIT_FAILURE);
         }
         mmcli_force_async_operation ();
-    } else if (inhibit_device_str)
+    } else if (monitor_json_flag)
+        mmcli_force_async_operation ();
+    else if (inhibit_device_str)
         mmcli_force_async_operation ();
 
 #if defined WITH_UDEV
@@ -178,6 +197,7 @@ context_free (void)
         g_object_unref (ctx->manager);
     if (ctx->cancellable)
         g_object_unref (ctx->cancellable);
+    g_strfreev (ctx->monitor_json_filter);
     g_free (ctx);
 }
 
@@ -378,6 +398,139 @@ list_current_modems (MMManager *manager)
     mmcli_output_list_dump (MMC_F_MODEM_LIST_DBUS_PATH);
 }
 
+static gboolean
+monitor_json_filter_match (const gchar *name)
+{
+    return (!ctx->monitor_json_filter || g_strv_contains ((const gchar * const *) ctx->monitor_json_filter, name));
+}
+
+static void
+monitor_json_dump_object (GDBusObject *object)
+{
+    const gchar *path;
+    GList       *interfaces;
+    GList       *l;
+
+    path = g_dbus_object_get_object_path (object);
+    interfaces = g_dbus_object_get_interfaces (object);
+    for (l = interfaces; l; l = g_list_next (l)) {
+        GDBusProxy  *proxy;
+        gchar      **names;
+        guint        i;
+
+        if (!G_IS_DBUS_PROXY (l->data))
+            continue;
+
+        proxy = G_DBUS_PROXY (l->data);
+        names = g_dbus_proxy_get_cached_property_names (proxy);
+        for (i = 0; names && names[i]; i++) {
+            GVariant *value;
+
+            if (!monitor_json_filter_match (names[i]))
+                continue;
+
+            value = g_dbus_proxy_get_cached_property (proxy, names[i]);
+            if (value) {
+                mmcli_output_json_event ("property", path, g_dbus_proxy_get_interface_name (proxy), names[i], value);
+                g_variant_unref (value);
+            }
+        }
+        g_strfreev (names);
+    }
+    g_list_free_full (interfaces, g_object_unref);
+}
+
+static void
+monitor_json_object_added (GDBusObjectManager *manager,
+                           GDBusObject        *object)
+{
+    mmcli_output_json_event ("added", g_dbus_object_get_object_path (object), NULL, NULL, NULL);
+    monitor_json_dump_object (object);
+}
+
+static void
+monitor_json_object_removed (GDBusObjectManager *manager,
+                             GDBusObject        *object)
+{
+    mmcli_output_json_event ("removed", g_dbus_object_get_object_path (object), NULL, NULL, NULL);
+}
+
+static void
+monitor_json_properties_changed (GDBusObjectManagerClient  *manager,
+                                 GDBusObjectProxy          *object_proxy,
+                                 GDBusProxy                *interface_proxy,
+                                 GVariant                  *changed_properties,
+                                 const gchar *const        *invalidated_properties)
+{
+    GVariantIter  iter;
+    const gchar  *name;
+    GVariant     *value;
+
+    g_variant_iter_init (&iter, changed_properties);
+    while (g_variant_iter_next (&iter, "{&sv}", &name, &value)) {
+        if (monitor_json_filter_match (name))
+            mmcli_output_json_event ("property",
+                                     g_dbus_object_get_object_path (G_DBUS_OBJECT (object_proxy)),
+                                     g_dbus_proxy_get_interface_name (interface_proxy),
+                                     name,
+                                     value);
+        g_variant_unref (value);
+    }
+}
+
+static void
+monitor_json_signal (GDBusObjectManagerClient *manager,
+                     GDBusObjectProxy         *object_proxy,
+                     GDBusProxy               *interface_proxy,
+                     const gchar              *sender_name,
+                     const gchar              *signal_name,
+                     GVariant                 *parameters)
+{
+    if (monitor_json_filter_match (signal_name))
+        mmcli_output_json_event ("signal",
+                                 g_dbus_object_get_object_path (G_DBUS_OBJECT (object_proxy)),
+                                 g_dbus_proxy_get_interface_name (interface_proxy),
+                                 signal_name,
+                                 parameters);
+}
+
+static void
+monitor_json_start (void)
+{
+    GList *modems;
+    GList *l;
+
+    if (monitor_json_filter_str) {
+        guint i;
+
+        ctx->monitor_json_filter = g_strsplit (monitor_json_filter_str, ",", -1);
+        for (i = 0; ctx->monitor_json_filter[i]; i++)
+            g_strstrip (ctx->monitor_json_filter[i]);
+    }
+
+    g_signal_connect (ctx->manager,
+                      "object-added",
+                      G_CALLBACK (monitor_json_object_added),
+                      NULL);
+    g_signal_connect (ctx->manager,
+                      "object-removed",
+                      G_CALLBACK (monitor_json_object_removed),
+                      NULL);
+    g_signal_connect (ctx->manager,
+                      "interface-proxy-properties-changed",
+                      G_CALLBACK (monitor_json_properties_changed),
+                      NULL);
+    g_signal_connect (ctx->manager,
+                      "interface-proxy-signal",
+                      G_CALLBACK (monitor_json_signal),
+                      NULL);
+
+    modems = g_dbus_object_manager_get_objects (G_DBUS_OBJECT_MANAGER (ctx->manager));
+    for (l = modems; l; l = g_list_next (l))
+        monitor_json_object_added (G_DBUS_OBJECT_MANAGER (ctx->manager), G_DBUS_OBJECT (l->data));
+    g_list_free_full (modems, g_object_unref);
+}
+
 static void
 cancelled (GCancellable *cancellable)
 {
@@ -503,6 +656,18 @@ get_manager_ready (GObject      *source,
         return;
     }
 
+    /* Request to monitor modems in JSON? */
+    if (monitor_json_flag) {
+        monitor_json_start ();
+
+        /* If we get cancelled, operation done */
+        g_cancellable_connect (ctx->cancellable,
+                               G_CALLBACK (cancelled),
+                               NULL,
+                               NULL);
+        return;
+    }
+
     /* Request to list modems? */
     if (list_modems_flag) {
         list_current_modems (ctx->manager);
@@ -544,7 +709,7 @@ mmcli_manager_run_synchronous (GDBusConnection *connection)
 {
     GError *error = NULL;
 
-    if (monitor_modems_flag) {
+    if (monitor_modems_flag || monitor_json_flag) {
         g_printerr ("error: monitoring modems cannot be done synchronously\n");
         exit (EXIT_FAILURE);
     }
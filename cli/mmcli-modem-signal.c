@@ -47,12 +47,17 @@ static Context *ctx;
 /* Options */
 static gboolean get_flag;
 static gchar *setup_str;
+static gchar *setup_indications_str;
 
 static GOptionEntry entries[] = {
     { "signal-setup", 0, 0, G_OPTION_ARG_STRING, &setup_str,
       "Setup extended signal information retrieval",
       "[Rate]"
     },
+    { "signal-setup-indications", 0, 0, G_OPTION_ARG_STRING, &setup_indications_str,
+      "Setup indication-driven extended signal information reporting",
+      "[Rate]"
+    },
     { "signal-get", 0, 0, G_OPTION_ARG_NONE, &get_flag,
       "Get all extended signal quality information",
       NULL
@@ -85,6 +90,7 @@ mmcli_modem_signal_options_enabled (void)
         return !!n_actions;
 
     n_actions = (!!setup_str +
+                 !!setup_indications_str +
                  get_flag);
 
     if (n_actions > 1) {
@@ -139,6 +145,7 @@ print_signal_info (void)
     MMSignal *signal;
     gdouble   value;
     gchar    *refresh_rate;
+    gchar    *indication_rate;
     gchar    *cdma1x_rssi = NULL;
     gchar    *cdma1x_ecio = NULL;
     gchar    *evdo_rssi = NULL;
@@ -158,6 +165,7 @@ print_signal_info (void)
     gchar    *nr5g_snr = NULL;
 
     refresh_rate = g_strdup_printf ("%u", mm_modem_signal_get_rate (ctx->modem_signal));
+    indication_rate = g_strdup_printf ("%u", mm_modem_signal_get_indication_rate (ctx->modem_signal));
 
     signal = mm_modem_signal_peek_cdma (ctx->modem_signal);
     if (signal) {
@@ -218,6 +226,7 @@ print_signal_info (void)
     }
 
     mmcli_output_string_take_typed (MMC_F_SIGNAL_REFRESH_RATE, refresh_rate, "seconds");
+    mmcli_output_string_take_typed (MMC_F_SIGNAL_INDICATION_RATE, indication_rate, "ms");
     mmcli_output_string_take_typed (MMC_F_SIGNAL_CDMA1X_RSSI,  cdma1x_rssi,  "dBm");
     mmcli_output_string_take_typed (MMC_F_SIGNAL_CDMA1X_ECIO,  cdma1x_ecio,  "dBm");
     mmcli_output_string_take_typed (MMC_F_SIGNAL_EVDO_RSSI,    evdo_rssi,    "dBm");
@@ -264,6 +273,32 @@ setup_ready (MMModemSignal *modem,
     mmcli_async_operation_done ();
 }
 
+static void
+setup_indications_process_reply (gboolean      result,
+                                 const GError *error)
+{
+    if (!result) {
+        g_printerr ("error: couldn't setup extended signal information indications: '%s'\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    g_print ("Successfully setup extended signal information indications\n");
+}
+
+static void
+setup_indications_ready (MMModemSignal *modem,
+                         GAsyncResult  *result)
+{
+    gboolean res;
+    GError *error = NULL;
+
+    res = mm_modem_signal_setup_indications_finish (modem, result, &error);
+    setup_indications_process_reply (res, error);
+
+    mmcli_async_operation_done ();
+}
+
 static void
 get_modem_ready (GObject      *source,
                  GAsyncResult *result)
@@ -298,6 +333,24 @@ get_modem_ready (GObject      *source,
         return;
     }
 
+    /* Request to setup indications? */
+    if (setup_indications_str) {
+        guint rate;
+
+        if (!mm_get_uint_from_str (setup_indications_str, &rate)) {
+            g_printerr ("error: invalid rate value '%s'", setup_indications_str);
+            exit (EXIT_FAILURE);
+        }
+
+        g_debug ("Asynchronously setting up extended signal quality information indications...");
+        mm_modem_signal_setup_indications (ctx->modem_signal,
+                                           rate,
+                                           ctx->cancellable,
+                                           (GAsyncReadyCallback)setup_indications_ready,
+                                           NULL);
+        return;
+    }
+
     g_warn_if_reached ();
 }
 
@@ -361,6 +414,25 @@ mmcli_modem_signal_run_synchronous (GDBusConnection *connection)
         return;
     }
 
+    /* Request to setup indications? */
+    if (setup_indications_str) {
+        guint rate;
+        gboolean result;
+
+        if (!mm_get_uint_from_str (setup_indications_str, &rate)) {
+            g_printerr ("error: invalid rate value '%s'", setup_indications_str);
+            exit (EXIT_FAILURE);
+        }
+
+        g_debug ("Synchronously setting up extended signal quality information indications...");
+        result = mm_modem_signal_setup_indications_sync (ctx->modem_signal,
+                                                         rate,
+                                                         NULL,
+                                                         &error);
+        setup_indications_process_reply (result, error);
+        return;
+    }
+
 
     g_warn_if_reached ();
 }
@@ -19,6 +19,7 @@
  */
 
 #include <stdio.h>
+#include <math.h>
 #include <string.h>
 
 #include <libmm-glib.h>
@@ -158,6 +159,7 @@ static FieldInfo field_infos[] = {
     [MMC_F_MESSAGING_SUPPORTED_STORAGES]      = { "modem.messaging.supported-storages",              "supported storages",       MMC_S_MODEM_MESSAGING,         },
     [MMC_F_MESSAGING_DEFAULT_STORAGES]        = { "modem.messaging.default-storages",                "default storages",         MMC_S_MODEM_MESSAGING,         },
     [MMC_F_SIGNAL_REFRESH_RATE]               = { "modem.signal.refresh.rate",                       "refresh rate",             MMC_S_MODEM_SIGNAL,            },
+    [MMC_F_SIGNAL_INDICATION_RATE]            = { "modem.signal.indication.rate",                    "indication rate",          MMC_S_MODEM_SIGNAL,            },
     [MMC_F_SIGNAL_CDMA1X_RSSI]                = { "modem.signal.cdma1x.rssi",                        "rssi",                     MMC_S_MODEM_SIGNAL_CDMA1X,     },
     [MMC_F_SIGNAL_CDMA1X_ECIO]                = { "modem.signal.cdma1x.ecio",                        "ecio",                     MMC_S_MODEM_SIGNAL_CDMA1X,     },
     [MMC_F_SIGNAL_EVDO_RSSI]                  = { "modem.signal.evdo.rssi",                          "rssi",                     MMC_S_MODEM_SIGNAL_EVDO,       },
@@ -234,6 +236,8 @@ static FieldInfo field_infos[] = {
     [MMC_F_BEARER_STATS_DURATION]             = { "bearer.stats.duration",                           "duration",                 MMC_S_BEARER_STATS,            },
     [MMC_F_BEARER_STATS_BYTES_RX]             = { "bearer.stats.bytes-rx",                           "bytes rx",                 MMC_S_BEARER_STATS,            },
     [MMC_F_BEARER_STATS_BYTES_TX]             = { "bearer.stats.bytes-tx",                           "bytes tx",                 MMC_S_BEARER_STATS,            },
+    [MMC_F_BEARER_STATS_UPLINK_SPEED]         = { "bearer.stats.uplink-speed",                       "uplink-speed",             MMC_S_BEARER_STATS,            },
+    [MMC_F_BEARER_STATS_DOWNLINK_SPEED]       = { "bearer.stats.downlink-speed",                     "downlink-speed",           MMC_S_BEARER_STATS,            },
     [MMC_F_BEARER_STATS_ATTEMPTS]             = { "bearer.stats.attempts",                           "attempts",                 MMC_S_BEARER_STATS,            },
     [MMC_F_BEARER_STATS_FAILED_ATTEMPTS]      = { "bearer.stats.failed-attempts",                    "attempts",                 MMC_S_BEARER_STATS,            },
     [MMC_F_BEARER_STATS_TOTAL_DURATION]       = { "bearer.stats.total-duration",                     "total-duration",           MMC_S_BEARER_STATS,            },
@@ -1329,6 +1333,208 @@ dump_output_list_json (MmcF field)
     g_print("]}\n");
 }
 
+/******************************************************************************/
+/* Streaming JSON output */
+
+static void
+json_append_string (GString     *output,
+                    const gchar *str)
+{
+    gchar *escaped;
+
+    escaped = json_strescape (str);
+    g_string_append_printf (output, "\"%s\"", escaped);
+    g_free (escaped);
+}
+
+static void json_append_variant (GString  *output,
+                                 GVariant *value);
+
+static void
+json_append_dictionary (GString  *output,
+                        GVariant *value)
+{
+    GVariantIter iter;
+    GVariant     *entry;
+    gboolean      first = TRUE;
+
+    g_string_append_c (output, '{');
+    g_variant_iter_init (&iter, value);
+    while ((entry = g_variant_iter_next_value (&iter)) != NULL) {
+        GVariant *key;
+        GVariant *item;
+
+        key = g_variant_get_child_value (entry, 0);
+        item = g_variant_get_child_value (entry, 1);
+
+        if (!first)
+            g_string_append_c (output, ',');
+        first = FALSE;
+
+        /* JSON keys must be strings, so non-string keys are printed */
+        if (g_variant_is_of_type (key, G_VARIANT_TYPE_STRING) ||
+            g_variant_is_of_type (key, G_VARIANT_TYPE_OBJECT_PATH) ||
+            g_variant_is_of_type (key, G_VARIANT_TYPE_SIGNATURE))
+            json_append_string (output, g_variant_get_string (key, NULL));
+        else {
+            gchar *printed;
+
+            printed = g_variant_print (key, FALSE);
+            json_append_string (output, printed);
+            g_free (printed);
+        }
+        g_string_append_c (output, ':');
+        json_append_variant (output, item);
+
+        g_variant_unref (key);
+        g_variant_unref (item);
+        g_variant_unref (entry);
+    }
+    g_string_append_c (output, '}');
+}
+
+static void
+json_append_container (GString  *output,
+                       GVariant *value)
+{
+    gsize n_children;
+    gsize i;
+
+    n_children = g_variant_n_children (value);
+    g_string_append_c (output, '[');
+    for (i = 0; i < n_children; i++) {
+        GVariant *child;
+
+        if (i > 0)
+            g_string_append_c (output, ',');
+        child = g_variant_get_child_value (value, i);
+        json_append_variant (output, child);
+        g_variant_unref (child);
+    }
+    g_string_append_c (output, ']');
+}
+
+static void
+json_append_variant (GString  *output,
+                     GVariant *value)
+{
+    switch (g_variant_classify (value)) {
+    case G_VARIANT_CLASS_BOOLEAN:
+        g_string_append (output, g_variant_get_boolean (value) ? "true" : "false");
+        break;
+    case G_VARIANT_CLASS_BYTE:
+        g_string_append_printf (output, "%u", (guint) g_variant_get_byte (value));
+        break;
+    case G_VARIANT_CLASS_INT16:
+        g_string_append_printf (output, "%d", (gint) g_variant_get_int16 (value));
+        break;
+    case G_VARIANT_CLASS_UINT16:
+        g_string_append_printf (output, "%u", (guint) g_variant_get_uint16 (value));
+        break;
+    case G_VARIANT_CLASS_INT32:
+        g_string_append_printf (output, "%d", g_variant_get_int32 (value));
+        break;
+    case G_VARIANT_CLASS_UINT32:
+        g_string_append_printf (output, "%u", g_variant_get_uint32 (value));
+        break;
+    case G_VARIANT_CLASS_HANDLE:
+        g_string_append_printf (output, "%d", g_variant_get_handle (value));
+        break;
+    case G_VARIANT_CLASS_INT64:
+        g_string_append_printf (output, "%" G_GINT64_FORMAT, g_variant_get_int64 (value));
+        break;
+    case G_VARIANT_CLASS_UINT64:
+        g_string_append_printf (output, "%" G_GUINT64_FORMAT, g_variant_get_uint64 (value));
+        break;
+    case G_VARIANT_CLASS_DOUBLE: {
+        gdouble number;
+
+        number = g_variant_get_double (value);
+        if (isfinite (number)) {
+            gchar buffer[G_ASCII_DTOSTR_BUF_SIZE];
+
+            g_string_append (output, g_ascii_dtostr (buffer, sizeof (buffer), number));
+        } else
+            g_string_append (output, "null");
+        break;
+    }
+    case G_VARIANT_CLASS_STRING:
+    case G_VARIANT_CLASS_OBJECT_PATH:
+    case G_VARIANT_CLASS_SIGNATURE:
+        json_append_string (output, g_variant_get_string (value, NULL));
+        break;
+    case G_VARIANT_CLASS_VARIANT: {
+        GVariant *inner;
+
+        inner = g_variant_get_variant (value);
+        json_append_variant (output, inner);
+        g_variant_unref (inner);
+        break;
+    }
+    case G_VARIANT_CLASS_MAYBE:
+        if (g_variant_n_children (value) > 0) {
+            GVariant *inner;
+
+            inner = g_variant_get_child_value (value, 0);
+            json_append_variant (output, inner);
+            g_variant_unref (inner);
+        } else
+            g_string_append (output, "null");
+        break;
+    case G_VARIANT_CLASS_ARRAY:
+        if (g_variant_type_is_dict_entry (g_variant_type_element (g_variant_get_type (value))))
+            json_append_dictionary (output, value);
+        else
+            json_append_container (output, value);
+        break;
+    case G_VARIANT_CLASS_TUPLE:
+    case G_VARIANT_CLASS_DICT_ENTRY:
+        json_append_container (output, value);
+        break;
+    default:
+        g_assert_not_reached ();
+    }
+}
+
+void
+mmcli_output_json_event (const gchar *event,
+                         const gchar *path,
+                         const gchar *interface_name,
+                         const gchar *name,
+                         GVariant    *value)
+{
+    GString *output;
+
+    g_assert (event);
+
+    output = g_string_sized_new (256);
+    g_string_append_printf (output, "{\"timestamp\":%" G_GINT64_FORMAT ",\"event\":", g_get_real_time () / 1000);
+    json_append_string (output, event);
+    if (path) {
+        g_string_append (output, ",\"path\":");
+        json_append_string (output, path);
+    }
+    if (interface_name) {
+        g_string_append (output, ",\"interface\":");
+        json_append_string (output, interface_name);
+    }
+    if (name) {
+        g_string_append (output, ",\"name\":");
+        json_append_string (output, name);
+    }
+    if (value) {
+        g_string_append (output, ",\"value\":");
+        json_append_variant (output, value);
+    }
+    g_string_append (output, "}\n");
+
+    /* Events are written as soon as they're received, never sorted or
+     * accumulated in the list of output items */
+    fputs (output->str, stdout);
+    fflush (stdout);
+    g_string_free (output, TRUE);
+}
+
 /******************************************************************************/
 /* Dump output */
 
@@ -168,6 +168,7 @@ typedef enum {
     MMC_F_MESSAGING_DEFAULT_STORAGES,
     /* Signal section */
     MMC_F_SIGNAL_REFRESH_RATE,
+    MMC_F_SIGNAL_INDICATION_RATE,
     MMC_F_SIGNAL_CDMA1X_RSSI,
     MMC_F_SIGNAL_CDMA1X_ECIO,
     MMC_F_SIGNAL_EVDO_RSSI,
@@ -251,6 +252,8 @@ typedef enum {
     MMC_F_BEARER_STATS_DURATION,
     MMC_F_BEARER_STATS_BYTES_RX,
     MMC_F_BEARER_STATS_BYTES_TX,
+    MMC_F_BEARER_STATS_UPLINK_SPEED,
+    MMC_F_BEARER_STATS_DOWNLINK_SPEED,
     MMC_F_BEARER_STATS_ATTEMPTS,
     MMC_F_BEARER_STATS_FAILED_ATTEMPTS,
     MMC_F_BEARER_STATS_TOTAL_DURATION,
@@ -355,6 +358,15 @@ void mmcli_output_firmware_list      (GList                     *firmware_list,
 void mmcli_output_pco_list           (GList                     *pco_list);
 void mmcli_output_preferred_networks (GList                     *preferred_nets_list);
 
+/******************************************************************************/
+/* Streaming JSON output */
+
+void mmcli_output_json_event (const gchar *event,
+                              const gchar *path,
+                              const gchar *interface_name,
+                              const gchar *name,
+                              GVariant    *value);
+
 /******************************************************************************/
 /* Dump output */
 
@@ -275,4 +275,19 @@
  */
 #define ID_MM_TTY_FLOW_CONTROL "ID_MM_TTY_FLOW_CONTROL"
 
+/**
+ * ID_MM_QMI_LOC_INJECTION_WINDOW:
+ *
+ * This is a port-specific tag applied to ports of QMI devices that allow
+ * several assistance data parts to be injected without waiting for the
+ * result of the previous ones.
+ *
+ * The value of the tag should be the maximum number of parts that may be
+ * pending to be acknowledged by the device, e.g. "4". If not given, each
+ * part is injected only after the previous one has been acknowledged.
+ *
+ * Since: 1.18
+ */
+#define ID_MM_QMI_LOC_INJECTION_WINDOW "ID_MM_QMI_LOC_INJECTION_WINDOW"
+
 #endif /* MM_TAGS_H */
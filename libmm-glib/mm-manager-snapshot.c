@@ -0,0 +1,778 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * libmm -- Access modem status & information from glib applications
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+
+#include "mm-errors-types.h"
+#include "mm-manager-snapshot.h"
+
+/**
+ * SECTION: mm-manager-snapshot
+ * @title: MMManagerSnapshot
+ * @short_description: Immutable snapshot of all objects exposed by the daemon
+ *
+ * The #MMManagerSnapshot is an immutable view of the properties of all the
+ * modem, SIM and bearer objects exposed by ModemManager at a given time.
+ *
+ * A snapshot is loaded with mm_manager_load_snapshot() and is afterwards kept
+ * up to date by the #MMManager, which creates a new snapshot each time a
+ * property changes. Snapshots share the data of all the objects that didn't
+ * change, so keeping references to old snapshots is cheap.
+ *
+ * All the accessors return data owned by the snapshot, no copies are done. The
+ * returned values are valid as long as the snapshot is alive.
+ */
+
+G_DEFINE_TYPE (MMManagerSnapshot, mm_manager_snapshot, G_TYPE_OBJECT)
+
+/*****************************************************************************/
+/* Snapshot objects
+ *
+ * Each object is stored in a single allocation holding the object path and
+ * all its properties, sorted by interface and property name. Interface and
+ * property names are interned strings. Objects are reference counted so that
+ * they can be shared among consecutive snapshots.
+ */
+
+typedef struct {
+    const gchar *interface_name;
+    const gchar *property_name;
+    GVariant    *value;
+} SnapshotProperty;
+
+typedef struct {
+    volatile gint     ref_count;
+    const gchar      *path;
+    guint             n_properties;
+    SnapshotProperty  properties[];
+} SnapshotObject;
+
+static SnapshotObject *
+snapshot_object_ref (SnapshotObject *obj)
+{
+    g_atomic_int_inc (&obj->ref_count);
+    return obj;
+}
+
+static void
+snapshot_object_unref (SnapshotObject *obj)
+{
+    guint i;
+
+    if (!g_atomic_int_dec_and_test (&obj->ref_count))
+        return;
+
+    for (i = 0; i < obj->n_properties; i++)
+        g_variant_unref (obj->properties[i].value);
+    g_free (obj);
+}
+
+static gint
+snapshot_property_cmp (gconstpointer a,
+                       gconstpointer b)
+{
+    const SnapshotProperty *prop_a = a;
+    const SnapshotProperty *prop_b = b;
+    gint                    ret;
+
+    ret = strcmp (prop_a->interface_name, prop_b->interface_name);
+    if (ret != 0)
+        return ret;
+    return strcmp (prop_a->property_name, prop_b->property_name);
+}
+
+static gint
+snapshot_property_bsearch_cmp (const void *a,
+                               const void *b)
+{
+    return snapshot_property_cmp (a, b);
+}
+
+/* Takes ownership of the values stored in the array */
+static SnapshotObject *
+snapshot_object_new (const gchar *path,
+                     GArray      *properties)
+{
+    SnapshotObject *obj;
+    gsize           properties_size;
+    gsize           path_size;
+
+    g_array_sort (properties, snapshot_property_cmp);
+
+    properties_size = properties->len * sizeof (SnapshotProperty);
+    path_size = strlen (path) + 1;
+
+    obj = g_malloc (sizeof (SnapshotObject) + properties_size + path_size);
+    obj->ref_count = 1;
+    obj->n_properties = properties->len;
+    if (properties_size)
+        memcpy (obj->properties, properties->data, properties_size);
+    obj->path = (const gchar *) (((guint8 *) obj->properties) + properties_size);
+    memcpy ((gchar *) obj->path, path, path_size);
+    return obj;
+}
+
+static GArray *
+properties_array_new (SnapshotObject *obj)
+{
+    GArray *properties;
+    guint   i;
+
+    properties = g_array_sized_new (FALSE, FALSE, sizeof (SnapshotProperty), obj ? obj->n_properties : 0);
+    if (!obj)
+        return properties;
+
+    for (i = 0; i < obj->n_properties; i++) {
+        SnapshotProperty prop;
+
+        prop = obj->properties[i];
+        g_variant_ref (prop.value);
+        g_array_append_val (properties, prop);
+    }
+    return properties;
+}
+
+static void
+properties_array_merge (GArray      *properties,
+                        const gchar *interface_name,
+                        GVariant    *dictionary)
+{
+    GVariantIter  iter;
+    const gchar  *key;
+    GVariant     *value;
+
+    interface_name = g_intern_string (interface_name);
+
+    g_variant_iter_init (&iter, dictionary);
+    while (g_variant_iter_next (&iter, "{&sv}", &key, &value)) {
+        const gchar *property_name;
+        guint        i;
+
+        property_name = g_intern_string (key);
+        for (i = 0; i < properties->len; i++) {
+            SnapshotProperty *prop;
+
+            prop = &g_array_index (properties, SnapshotProperty, i);
+            if (prop->interface_name == interface_name && prop->property_name == property_name) {
+                g_variant_unref (prop->value);
+                prop->value = value;
+                break;
+            }
+        }
+
+        if (i == properties->len) {
+            SnapshotProperty prop;
+
+            prop.interface_name = interface_name;
+            prop.property_name = property_name;
+            prop.value = value;
+            g_array_append_val (properties, prop);
+        }
+    }
+}
+
+static SnapshotObject *
+snapshot_object_new_merged (SnapshotObject *old,
+                            const gchar    *path,
+                            GVariant       *interfaces_and_properties)
+{
+    SnapshotObject *obj;
+    GArray         *properties;
+    GVariantIter    iter;
+    const gchar    *interface_name;
+    GVariant       *dictionary;
+
+    properties = properties_array_new (old);
+
+    g_variant_iter_init (&iter, interfaces_and_properties);
+    while (g_variant_iter_next (&iter, "{&s@a{sv}}", &interface_name, &dictionary)) {
+        properties_array_merge (properties, interface_name, dictionary);
+        g_variant_unref (dictionary);
+    }
+
+    obj = snapshot_object_new (path, properties);
+    g_array_unref (properties);
+    return obj;
+}
+
+static SnapshotObject *
+snapshot_object_new_filtered (SnapshotObject     *old,
+                              const gchar *const *interfaces)
+{
+    SnapshotObject *obj;
+    GArray         *properties;
+    guint           i;
+
+    properties = g_array_sized_new (FALSE, FALSE, sizeof (SnapshotProperty), old->n_properties);
+    for (i = 0; i < old->n_properties; i++) {
+        SnapshotProperty prop;
+
+        prop = old->properties[i];
+        if (g_strv_contains (interfaces, prop.interface_name))
+            continue;
+        g_variant_ref (prop.value);
+        g_array_append_val (properties, prop);
+    }
+
+    /* Don't keep objects without properties around */
+    if (!properties->len) {
+        g_array_unref (properties);
+        return NULL;
+    }
+
+    obj = snapshot_object_new (old->path, properties);
+    g_array_unref (properties);
+    return obj;
+}
+
+static const SnapshotProperty *
+snapshot_object_lookup (const SnapshotObject *obj,
+                        const gchar          *interface_name,
+                        const gchar          *property_name)
+{
+    SnapshotProperty key;
+
+    key.interface_name = interface_name;
+    key.property_name = property_name;
+    key.value = NULL;
+
+    return bsearch (&key,
+                    obj->properties,
+                    obj->n_properties,
+                    sizeof (SnapshotProperty),
+                    snapshot_property_bsearch_cmp);
+}
+
+static gint
+snapshot_object_ptr_cmp (gconstpointer a,
+                         gconstpointer b)
+{
+    const SnapshotObject *obj_a = *((const SnapshotObject **) a);
+    const SnapshotObject *obj_b = *((const SnapshotObject **) b);
+
+    return strcmp (obj_a->path, obj_b->path);
+}
+
+/*****************************************************************************/
+
+struct _MMManagerSnapshotPrivate {
+    guint      generation;
+    /* SnapshotObject items, sorted by path */
+    GPtrArray *objects;
+};
+
+static MMManagerSnapshot *
+snapshot_new (guint generation,
+              guint n_objects)
+{
+    MMManagerSnapshot *self;
+
+    self = MM_MANAGER_SNAPSHOT (g_object_new (MM_TYPE_MANAGER_SNAPSHOT, NULL));
+    self->priv->generation = generation;
+    self->priv->objects = g_ptr_array_new_full (n_objects, (GDestroyNotify) snapshot_object_unref);
+    return self;
+}
+
+/* Returns TRUE if found; position is either the found index or the index
+ * where the object would need to be inserted to keep the array sorted. */
+static gboolean
+snapshot_find_object (MMManagerSnapshot *self,
+                      const gchar       *path,
+                      guint             *position)
+{
+    guint low = 0;
+    guint high;
+
+    high = self->priv->objects->len;
+    while (low < high) {
+        SnapshotObject *obj;
+        guint           mid;
+        gint            cmp;
+
+        mid = low + (high - low) / 2;
+        obj = g_ptr_array_index (self->priv->objects, mid);
+        cmp = strcmp (path, obj->path);
+        if (cmp == 0) {
+            *position = mid;
+            return TRUE;
+        }
+        if (cmp < 0)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+
+    *position = low;
+    return FALSE;
+}
+
+static const SnapshotProperty *
+snapshot_lookup_property (MMManagerSnapshot *self,
+                          const gchar       *path,
+                          const gchar       *interface_name,
+                          const gchar       *property_name)
+{
+    guint position;
+
+    if (!snapshot_find_object (self, path, &position))
+        return NULL;
+
+    return snapshot_object_lookup (g_ptr_array_index (self->priv->objects, position),
+                                   interface_name,
+                                   property_name);
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_manager_snapshot_get_generation:
+ * @self: A #MMManagerSnapshot.
+ *
+ * Gets the generation number of the snapshot. Each time the #MMManager
+ * updates its snapshot the generation number is increased, so that users
+ * can easily detect whether anything changed since the last time they looked.
+ *
+ * Returns: the generation number.
+ *
+ * Since: 1.18
+ */
+guint
+mm_manager_snapshot_get_generation (MMManagerSnapshot *self)
+{
+    g_return_val_if_fail (MM_IS_MANAGER_SNAPSHOT (self), 0);
+
+    return self->priv->generation;
+}
+
+/**
+ * mm_manager_snapshot_get_n_objects:
+ * @self: A #MMManagerSnapshot.
+ *
+ * Gets the number of objects in the snapshot.
+ *
+ * Returns: the number of objects.
+ *
+ * Since: 1.18
+ */
+guint
+mm_manager_snapshot_get_n_objects (MMManagerSnapshot *self)
+{
+    g_return_val_if_fail (MM_IS_MANAGER_SNAPSHOT (self), 0);
+
+    return self->priv->objects->len;
+}
+
+/**
+ * mm_manager_snapshot_get_object_path:
+ * @self: A #MMManagerSnapshot.
+ * @i: Index of the object, lower than mm_manager_snapshot_get_n_objects().
+ *
+ * Gets the DBus path of the object at index @i. Objects are sorted by path.
+ *
+ * Returns: (transfer none): the object path. Do not free the returned value,
+ * it is owned by @self.
+ *
+ * Since: 1.18
+ */
+const gchar *
+mm_manager_snapshot_get_object_path (MMManagerSnapshot *self,
+                                     guint              i)
+{
+    SnapshotObject *obj;
+
+    g_return_val_if_fail (MM_IS_MANAGER_SNAPSHOT (self), NULL);
+    g_return_val_if_fail (i < self->priv->objects->len, NULL);
+
+    obj = g_ptr_array_index (self->priv->objects, i);
+    return obj->path;
+}
+
+/**
+ * mm_manager_snapshot_has_object:
+ * @self: A #MMManagerSnapshot.
+ * @path: The DBus path of the object.
+ *
+ * Checks whether the object at @path is included in the snapshot.
+ *
+ * Returns: %TRUE if the object exists, %FALSE otherwise.
+ *
+ * Since: 1.18
+ */
+gboolean
+mm_manager_snapshot_has_object (MMManagerSnapshot *self,
+                                const gchar       *path)
+{
+    guint position;
+
+    g_return_val_if_fail (MM_IS_MANAGER_SNAPSHOT (self), FALSE);
+    g_return_val_if_fail (path != NULL, FALSE);
+
+    return snapshot_find_object (self, path, &position);
+}
+
+/**
+ * mm_manager_snapshot_peek_property:
+ * @self: A #MMManagerSnapshot.
+ * @path: The DBus path of the object.
+ * @interface_name: The DBus interface name.
+ * @property_name: The DBus property name.
+ *
+ * Gets the value of the given property.
+ *
+ * Returns: (transfer none): a #GVariant, or %NULL if the property isn't
+ * available. Do not free the returned value, it is owned by @self.
+ *
+ * Since: 1.18
+ */
+GVariant *
+mm_manager_snapshot_peek_property (MMManagerSnapshot *self,
+                                   const gchar       *path,
+                                   const gchar       *interface_name,
+                                   const gchar       *property_name)
+{
+    const SnapshotProperty *prop;
+
+    g_return_val_if_fail (MM_IS_MANAGER_SNAPSHOT (self), NULL);
+    g_return_val_if_fail (path != NULL, NULL);
+    g_return_val_if_fail (interface_name != NULL, NULL);
+    g_return_val_if_fail (property_name != NULL, NULL);
+
+    prop = snapshot_lookup_property (self, path, interface_name, property_name);
+    return prop ? prop->value : NULL;
+}
+
+/**
+ * mm_manager_snapshot_peek_string:
+ * @self: A #MMManagerSnapshot.
+ * @path: The DBus path of the object.
+ * @interface_name: The DBus interface name.
+ * @property_name: The DBus property name.
+ *
+ * Gets the value of the given string, object path or signature property.
+ *
+ * Returns: (transfer none): the string value, or %NULL if the property isn't
+ * available or isn't a string. Do not free the returned value, it is owned by
+ * @self.
+ *
+ * Since: 1.18
+ */
+const gchar *
+mm_manager_snapshot_peek_string (MMManagerSnapshot *self,
+                                 const gchar       *path,
+                                 const gchar       *interface_name,
+                                 const gchar       *property_name)
+{
+    GVariant *value;
+
+    value = mm_manager_snapshot_peek_property (self, path, interface_name, property_name);
+    if (!value)
+        return NULL;
+
+    if (!g_variant_is_of_type (value, G_VARIANT_TYPE_STRING) &&
+        !g_variant_is_of_type (value, G_VARIANT_TYPE_OBJECT_PATH) &&
+        !g_variant_is_of_type (value, G_VARIANT_TYPE_SIGNATURE))
+        return NULL;
+
+    return g_variant_get_string (value, NULL);
+}
+
+/**
+ * mm_manager_snapshot_get_uint32:
+ * @self: A #MMManagerSnapshot.
+ * @path: The DBus path of the object.
+ * @interface_name: The DBus interface name.
+ * @property_name: The DBus property name.
+ * @out_value: (out): Return location for the value.
+ *
+ * Gets the value of the given unsigned 32-bit integer property.
+ *
+ * Returns: %TRUE if @out_value is set, %FALSE if the property isn't available
+ * or isn't of the expected type.
+ *
+ * Since: 1.18
+ */
+gboolean
+mm_manager_snapshot_get_uint32 (MMManagerSnapshot *self,
+                                const gchar       *path,
+                                const gchar       *interface_name,
+                                const gchar       *property_name,
+                                guint32           *out_value)
+{
+    GVariant *value;
+
+    g_return_val_if_fail (out_value != NULL, FALSE);
+
+    value = mm_manager_snapshot_peek_property (self, path, interface_name, property_name);
+    if (!value || !g_variant_is_of_type (value, G_VARIANT_TYPE_UINT32))
+        return FALSE;
+
+    *out_value = g_variant_get_uint32 (value);
+    return TRUE;
+}
+
+/**
+ * mm_manager_snapshot_get_int32:
+ * @self: A #MMManagerSnapshot.
+ * @path: The DBus path of the object.
+ * @interface_name: The DBus interface name.
+ * @property_name: The DBus property name.
+ * @out_value: (out): Return location for the value.
+ *
+ * Gets the value of the given signed 32-bit integer property.
+ *
+ * Returns: %TRUE if @out_value is set, %FALSE if the property isn't available
+ * or isn't of the expected type.
+ *
+ * Since: 1.18
+ */
+gboolean
+mm_manager_snapshot_get_int32 (MMManagerSnapshot *self,
+                               const gchar       *path,
+                               const gchar       *interface_name,
+                               const gchar       *property_name,
+                               gint32            *out_value)
+{
+    GVariant *value;
+
+    g_return_val_if_fail (out_value != NULL, FALSE);
+
+    value = mm_manager_snapshot_peek_property (self, path, interface_name, property_name);
+    if (!value || !g_variant_is_of_type (value, G_VARIANT_TYPE_INT32))
+        return FALSE;
+
+    *out_value = g_variant_get_int32 (value);
+    return TRUE;
+}
+
+/**
+ * mm_manager_snapshot_get_boolean:
+ * @self: A #MMManagerSnapshot.
+ * @path: The DBus path of the object.
+ * @interface_name: The DBus interface name.
+ * @property_name: The DBus property name.
+ * @out_value: (out): Return location for the value.
+ *
+ * Gets the value of the given boolean property.
+ *
+ * Returns: %TRUE if @out_value is set, %FALSE if the property isn't available
+ * or isn't of the expected type.
+ *
+ * Since: 1.18
+ */
+gboolean
+mm_manager_snapshot_get_boolean (MMManagerSnapshot *self,
+                                 const gchar       *path,
+                                 const gchar       *interface_name,
+                                 const gchar       *property_name,
+                                 gboolean          *out_value)
+{
+    GVariant *value;
+
+    g_return_val_if_fail (out_value != NULL, FALSE);
+
+    value = mm_manager_snapshot_peek_property (self, path, interface_name, property_name);
+    if (!value || !g_variant_is_of_type (value, G_VARIANT_TYPE_BOOLEAN))
+        return FALSE;
+
+    *out_value = g_variant_get_boolean (value);
+    return TRUE;
+}
+
+/**
+ * mm_manager_snapshot_peek_uint32_array:
+ * @self: A #MMManagerSnapshot.
+ * @path: The DBus path of the object.
+ * @interface_name: The DBus interface name.
+ * @property_name: The DBus property name.
+ * @n_values: (out): Return location for the number of values in the array.
+ *
+ * Gets the value of the given array of unsigned 32-bit integers property, e.g.
+ * the list of supported capabilities of a modem.
+ *
+ * Returns: (transfer none) (array length=n_values): the array of values, or
+ * %NULL if the property isn't available, isn't of the expected type or is
+ * empty. Do not free the returned value, it is owned by @self.
+ *
+ * Since: 1.18
+ */
+const guint32 *
+mm_manager_snapshot_peek_uint32_array (MMManagerSnapshot *self,
+                                       const gchar       *path,
+                                       const gchar       *interface_name,
+                                       const gchar       *property_name,
+                                       gsize             *n_values)
+{
+    GVariant *value;
+
+    g_return_val_if_fail (n_values != NULL, NULL);
+
+    *n_values = 0;
+    value = mm_manager_snapshot_peek_property (self, path, interface_name, property_name);
+    if (!value || !g_variant_is_of_type (value, G_VARIANT_TYPE ("au")))
+        return NULL;
+
+    return g_variant_get_fixed_array (value, n_values, sizeof (guint32));
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_manager_snapshot_new_from_managed_objects: (skip)
+ */
+MMManagerSnapshot *
+mm_manager_snapshot_new_from_managed_objects (GVariant  *managed_objects,
+                                              GError   **error)
+{
+    MMManagerSnapshot *self;
+    GVariantIter       iter;
+    const gchar       *path;
+    GVariant          *interfaces_and_properties;
+
+    if (!g_variant_is_of_type (managed_objects, G_VARIANT_TYPE ("a{oa{sa{sv}}}"))) {
+        g_set_error (error,
+                     MM_CORE_ERROR,
+                     MM_CORE_ERROR_INVALID_ARGS,
+                     "Cannot create manager snapshot: "
+                     "invalid variant type received");
+        return NULL;
+    }
+
+    self = snapshot_new (0, g_variant_n_children (managed_objects));
+
+    g_variant_iter_init (&iter, managed_objects);
+    while (g_variant_iter_next (&iter, "{&o@a{sa{sv}}}", &path, &interfaces_and_properties)) {
+        g_ptr_array_add (self->priv->objects,
+                         snapshot_object_new_merged (NULL, path, interfaces_and_properties));
+        g_variant_unref (interfaces_and_properties);
+    }
+    g_ptr_array_sort (self->priv->objects, snapshot_object_ptr_cmp);
+
+    return self;
+}
+
+/**
+ * mm_manager_snapshot_new_updated: (skip)
+ *
+ * Creates a new snapshot where the given object is updated with the new
+ * interfaces and properties in @interfaces_and_properties, given as a
+ * a{sa{sv}} #GVariant. If the object doesn't exist yet, it is created. All
+ * other objects are shared with @self.
+ */
+MMManagerSnapshot *
+mm_manager_snapshot_new_updated (MMManagerSnapshot *self,
+                                 const gchar       *path,
+                                 GVariant          *interfaces_and_properties)
+{
+    MMManagerSnapshot *updated;
+    SnapshotObject    *old = NULL;
+    guint              position;
+    guint              i;
+    gboolean           found;
+
+    g_return_val_if_fail (MM_IS_MANAGER_SNAPSHOT (self), NULL);
+    g_return_val_if_fail (path != NULL, NULL);
+    g_return_val_if_fail (g_variant_is_of_type (interfaces_and_properties, G_VARIANT_TYPE ("a{sa{sv}}")), NULL);
+
+    found = snapshot_find_object (self, path, &position);
+    if (found)
+        old = g_ptr_array_index (self->priv->objects, position);
+
+    updated = snapshot_new (self->priv->generation + 1, self->priv->objects->len + (found ? 0 : 1));
+    for (i = 0; i < self->priv->objects->len; i++) {
+        if (i == position)
+            g_ptr_array_add (updated->priv->objects, snapshot_object_new_merged (old, path, interfaces_and_properties));
+        if (i == position && found)
+            continue;
+        g_ptr_array_add (updated->priv->objects, snapshot_object_ref (g_ptr_array_index (self->priv->objects, i)));
+    }
+    if (position == self->priv->objects->len)
+        g_ptr_array_add (updated->priv->objects, snapshot_object_new_merged (NULL, path, interfaces_and_properties));
+
+    return updated;
+}
+
+/**
+ * mm_manager_snapshot_new_without: (skip)
+ *
+ * Creates a new snapshot where the properties of the given @interfaces are
+ * removed from the object at @path, or where the whole object is removed if
+ * @interfaces is %NULL.
+ */
+MMManagerSnapshot *
+mm_manager_snapshot_new_without (MMManagerSnapshot  *self,
+                                 const gchar        *path,
+                                 const gchar *const *interfaces)
+{
+    MMManagerSnapshot *updated;
+    SnapshotObject    *filtered = NULL;
+    guint              position;
+    guint              i;
+
+    g_return_val_if_fail (MM_IS_MANAGER_SNAPSHOT (self), NULL);
+    g_return_val_if_fail (path != NULL, NULL);
+
+    if (!snapshot_find_object (self, path, &position))
+        return g_object_ref (self);
+
+    if (interfaces)
+        filtered = snapshot_object_new_filtered (g_ptr_array_index (self->priv->objects, position), interfaces);
+
+    updated = snapshot_new (self->priv->generation + 1, self->priv->objects->len);
+    for (i = 0; i < self->priv->objects->len; i++) {
+        if (i != position)
+            g_ptr_array_add (updated->priv->objects, snapshot_object_ref (g_ptr_array_index (self->priv->objects, i)));
+        else if (filtered)
+            g_ptr_array_add (updated->priv->objects, filtered);
+    }
+
+    return updated;
+}
+
+/*****************************************************************************/
+
+static void
+mm_manager_snapshot_init (MMManagerSnapshot *self)
+{
+    self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self,
+                                              MM_TYPE_MANAGER_SNAPSHOT,
+                                              MMManagerSnapshotPrivate);
+}
+
+static void
+finalize (GObject *object)
+{
+    MMManagerSnapshot *self = MM_MANAGER_SNAPSHOT (object);
+
+    if (self->priv->objects)
+        g_ptr_array_unref (self->priv->objects);
+
+    G_OBJECT_CLASS (mm_manager_snapshot_parent_class)->finalize (object);
+}
+
+static void
+mm_manager_snapshot_class_init (MMManagerSnapshotClass *klass)
+{
+    GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+    g_type_class_add_private (object_class, sizeof (MMManagerSnapshotPrivate));
+
+    object_class->finalize = finalize;
+}
@@ -0,0 +1,126 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * libmm -- Access modem status & information from glib applications
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _MM_MANAGER_SNAPSHOT_H_
+#define _MM_MANAGER_SNAPSHOT_H_
+
+#if !defined (__LIBMM_GLIB_H_INSIDE__) && !defined (LIBMM_GLIB_COMPILATION)
+#error "Only <libmm-glib.h> can be included directly."
+#endif
+
+#include <ModemManager.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define MM_TYPE_MANAGER_SNAPSHOT            (mm_manager_snapshot_get_type ())
+#define MM_MANAGER_SNAPSHOT(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), MM_TYPE_MANAGER_SNAPSHOT, MMManagerSnapshot))
+#define MM_MANAGER_SNAPSHOT_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST ((klass),  MM_TYPE_MANAGER_SNAPSHOT, MMManagerSnapshotClass))
+#define MM_IS_MANAGER_SNAPSHOT(obj)         (G_TYPE_CHECK_INSTANCE_TYPE ((obj), MM_TYPE_MANAGER_SNAPSHOT))
+#define MM_IS_MANAGER_SNAPSHOT_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE ((klass),  MM_TYPE_MANAGER_SNAPSHOT))
+#define MM_MANAGER_SNAPSHOT_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS ((obj),  MM_TYPE_MANAGER_SNAPSHOT, MMManagerSnapshotClass))
+
+typedef struct _MMManagerSnapshot MMManagerSnapshot;
+typedef struct _MMManagerSnapshotClass MMManagerSnapshotClass;
+typedef struct _MMManagerSnapshotPrivate MMManagerSnapshotPrivate;
+
+/**
+ * MMManagerSnapshot:
+ *
+ * The #MMManagerSnapshot structure contains private data and should
+ * only be accessed using the provided API.
+ */
+struct _MMManagerSnapshot {
+    /*< private >*/
+    GObject parent;
+    MMManagerSnapshotPrivate *priv;
+};
+
+struct _MMManagerSnapshotClass {
+    /*< private >*/
+    GObjectClass parent;
+};
+
+GType mm_manager_snapshot_get_type (void);
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMManagerSnapshot, g_object_unref)
+
+guint        mm_manager_snapshot_get_generation  (MMManagerSnapshot *self);
+guint        mm_manager_snapshot_get_n_objects   (MMManagerSnapshot *self);
+const gchar *mm_manager_snapshot_get_object_path (MMManagerSnapshot *self,
+                                                  guint              i);
+
+gboolean     mm_manager_snapshot_has_object      (MMManagerSnapshot *self,
+                                                  const gchar       *path);
+
+GVariant    *mm_manager_snapshot_peek_property   (MMManagerSnapshot *self,
+                                                  const gchar       *path,
+                                                  const gchar       *interface_name,
+                                                  const gchar       *property_name);
+
+const gchar *mm_manager_snapshot_peek_string     (MMManagerSnapshot *self,
+                                                  const gchar       *path,
+                                                  const gchar       *interface_name,
+                                                  const gchar       *property_name);
+
+gboolean     mm_manager_snapshot_get_uint32      (MMManagerSnapshot *self,
+                                                  const gchar       *path,
+                                                  const gchar       *interface_name,
+                                                  const gchar       *property_name,
+                                                  guint32           *out_value);
+
+gboolean     mm_manager_snapshot_get_int32       (MMManagerSnapshot *self,
+                                                  const gchar       *path,
+                                                  const gchar       *interface_name,
+                                                  const gchar       *property_name,
+                                                  gint32            *out_value);
+
+gboolean     mm_manager_snapshot_get_boolean     (MMManagerSnapshot *self,
+                                                  const gchar       *path,
+                                                  const gchar       *interface_name,
+                                                  const gchar       *property_name,
+                                                  gboolean          *out_value);
+
+const guint32 *mm_manager_snapshot_peek_uint32_array (MMManagerSnapshot *self,
+                                                      const gchar       *path,
+                                                      const gchar       *interface_name,
+                                                      const gchar       *property_name,
+                                                      gsize             *n_values);
+
+/*****************************************************************************/
+/* ModemManager/libmm-glib/mmcli specific methods */
+
+#if defined (_LIBMM_INSIDE_MM) ||    \
+    defined (_LIBMM_INSIDE_MMCLI) || \
+    defined (LIBMM_GLIB_COMPILATION)
+
+MMManagerSnapshot *mm_manager_snapshot_new_from_managed_objects (GVariant           *managed_objects,
+                                                                 GError            **error);
+MMManagerSnapshot *mm_manager_snapshot_new_updated              (MMManagerSnapshot  *self,
+                                                                 const gchar        *path,
+                                                                 GVariant           *interfaces_and_properties);
+MMManagerSnapshot *mm_manager_snapshot_new_without              (MMManagerSnapshot  *self,
+                                                                 const gchar        *path,
+                                                                 const gchar *const *interfaces);
+
+#endif
+
+G_END_DECLS
+
+#endif /* _MM_MANAGER_SNAPSHOT_H_ */
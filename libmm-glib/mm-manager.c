@@ -27,6 +27,7 @@
 #include "mm-errors-types.h"
 #include "mm-gdbus-manager.h"
 #include "mm-manager.h"
+#include "mm-manager-snapshot.h"
 #include "mm-object.h"
 
 /**
@@ -39,6 +40,10 @@
  * This object is also a #GDBusObjectManagerClient, and therefore it allows to
  * use the standard ObjectManager interface to list and handle the managed
  * modem objects.
+ *
+ * Users monitoring the properties of lots of modems may instead load a
+ * #MMManagerSnapshot with mm_manager_load_snapshot(), which the #MMManager
+ * keeps updated from the property change notifications emitted by the daemon.
  */
 
 G_DEFINE_TYPE (MMManager, mm_manager, MM_GDBUS_TYPE_OBJECT_MANAGER_CLIENT)
@@ -46,6 +51,12 @@ G_DEFINE_TYPE (MMManager, mm_manager, MM_GDBUS_TYPE_OBJECT_MANAGER_CLIENT)
 struct _MMManagerPrivate {
   /* The proxy for the Manager interface */
   MmGdbusOrgFreedesktopModemManager1 *manager_iface_proxy;
+
+  /* Snapshot support */
+  MMManagerSnapshot *snapshot;
+  guint              snapshot_properties_changed_id;
+  guint              snapshot_interfaces_added_id;
+  guint              snapshot_interfaces_removed_id;
 };
 
 /*****************************************************************************/
@@ -957,6 +968,640 @@ mm_manager_uninhibit_device_sync (MMManager     *manager,
     return common_inhibit_device_sync (manager, uid, FALSE, cancellable, error);
 }
 
+/*****************************************************************************/
+/* Snapshot support */
+
+static void snapshot_load_sub_object (MMManager   *self,
+                                      const gchar *path,
+                                      GTask       *task);
+
+static void
+snapshot_replace (MMManager         *self,
+                  MMManagerSnapshot *snapshot)
+{
+    g_clear_object (&self->priv->snapshot);
+    self->priv->snapshot = snapshot;
+}
+
+/* SIM and bearer objects are not exposed through the ObjectManager interface,
+ * so they're tracked through the properties of the modem object. */
+static GPtrArray *
+snapshot_collect_sub_objects (MMManagerSnapshot *snapshot,
+                              const gchar       *modem_path)
+{
+    GPtrArray   *paths;
+    const gchar *sim_path;
+    GVariant    *bearers;
+
+    paths = g_ptr_array_new_with_free_func (g_free);
+    if (!snapshot)
+        return paths;
+
+    sim_path = mm_manager_snapshot_peek_string (snapshot, modem_path, MM_DBUS_INTERFACE_MODEM, MM_MODEM_PROPERTY_SIM);
+    if (sim_path && g_str_has_prefix (sim_path, MM_DBUS_SIM_PREFIX))
+        g_ptr_array_add (paths, g_strdup (sim_path));
+
+    bearers = mm_manager_snapshot_peek_property (snapshot, modem_path, MM_DBUS_INTERFACE_MODEM, MM_MODEM_PROPERTY_BEARERS);
+    if (bearers && g_variant_is_of_type (bearers, G_VARIANT_TYPE ("ao"))) {
+        GVariantIter  iter;
+        const gchar  *bearer_path;
+
+        g_variant_iter_init (&iter, bearers);
+        while (g_variant_iter_next (&iter, "&o", &bearer_path))
+            g_ptr_array_add (paths, g_strdup (bearer_path));
+    }
+
+    return paths;
+}
+
+static gboolean
+path_array_contains (GPtrArray   *paths,
+                     const gchar *path)
+{
+    guint i;
+
+    for (i = 0; i < paths->len; i++) {
+        if (g_str_equal (g_ptr_array_index (paths, i), path))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void
+snapshot_sync_sub_objects (MMManager *self,
+                           GPtrArray *old_paths,
+                           GPtrArray *new_paths,
+                           GTask     *task)
+{
+    guint i;
+
+    for (i = 0; i < old_paths->len; i++) {
+        const gchar *path;
+
+        path = g_ptr_array_index (old_paths, i);
+        if (!path_array_contains (new_paths, path) && self->priv->snapshot)
+            snapshot_replace (self, mm_manager_snapshot_new_without (self->priv->snapshot, path, NULL));
+    }
+
+    for (i = 0; i < new_paths->len; i++) {
+        const gchar *path;
+
+        path = g_ptr_array_index (new_paths, i);
+        if (self->priv->snapshot && !mm_manager_snapshot_has_object (self->priv->snapshot, path))
+            snapshot_load_sub_object (self, path, task);
+    }
+}
+
+static void
+snapshot_update_object (MMManager   *self,
+                        const gchar *path,
+                        GVariant    *interfaces_and_properties)
+{
+    GPtrArray *old_paths;
+    GPtrArray *new_paths;
+
+    old_paths = snapshot_collect_sub_objects (self->priv->snapshot, path);
+    snapshot_replace (self, mm_manager_snapshot_new_updated (self->priv->snapshot, path, interfaces_and_properties));
+    new_paths = snapshot_collect_sub_objects (self->priv->snapshot, path);
+
+    snapshot_sync_sub_objects (self, old_paths, new_paths, NULL);
+
+    g_ptr_array_unref (old_paths);
+    g_ptr_array_unref (new_paths);
+}
+
+static void
+snapshot_update_interface (MMManager   *self,
+                           const gchar *path,
+                           const gchar *interface_name,
+                           GVariant    *dictionary)
+{
+    GVariantBuilder  builder;
+    GVariant        *interfaces_and_properties;
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sa{sv}}"));
+    g_variant_builder_add (&builder, "{s@a{sv}}", interface_name, dictionary);
+    interfaces_and_properties = g_variant_ref_sink (g_variant_builder_end (&builder));
+    snapshot_update_object (self, path, interfaces_and_properties);
+    g_variant_unref (interfaces_and_properties);
+}
+
+static void
+snapshot_remove_interfaces (MMManager          *self,
+                            const gchar        *path,
+                            const gchar *const *interfaces)
+{
+    GPtrArray *old_paths;
+    GPtrArray *new_paths;
+
+    old_paths = snapshot_collect_sub_objects (self->priv->snapshot, path);
+    snapshot_replace (self, mm_manager_snapshot_new_without (self->priv->snapshot, path, interfaces));
+    new_paths = snapshot_collect_sub_objects (self->priv->snapshot, path);
+
+    snapshot_sync_sub_objects (self, old_paths, new_paths, NULL);
+
+    g_ptr_array_unref (old_paths);
+    g_ptr_array_unref (new_paths);
+}
+
+static void
+snapshot_properties_changed (GDBusConnection *connection,
+                             const gchar     *sender_name,
+                             const gchar     *object_path,
+                             const gchar     *interface_name,
+                             const gchar     *signal_name,
+                             GVariant        *parameters,
+                             MMManager       *self)
+{
+    const gchar *changed_interface = NULL;
+    GVariant    *changed_properties = NULL;
+
+    /* Only objects already in the snapshot are updated; e.g. SMS or call
+     * objects are never tracked */
+    if (!self->priv->snapshot || !mm_manager_snapshot_has_object (self->priv->snapshot, object_path))
+        return;
+
+    if (!g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(sa{sv}as)")))
+        return;
+
+    g_variant_get (parameters, "(&s@a{sv}@as)", &changed_interface, &changed_properties, NULL);
+    snapshot_update_interface (self, object_path, changed_interface, changed_properties);
+    g_variant_unref (changed_properties);
+}
+
+static void
+snapshot_interfaces_added (GDBusConnection *connection,
+                           const gchar     *sender_name,
+                           const gchar     *object_path,
+                           const gchar     *interface_name,
+                           const gchar     *signal_name,
+                           GVariant        *parameters,
+                           MMManager       *self)
+{
+    const gchar *path = NULL;
+    GVariant    *interfaces_and_properties = NULL;
+
+    if (!self->priv->snapshot || !g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(oa{sa{sv}})")))
+        return;
+
+    g_variant_get (parameters, "(&o@a{sa{sv}})", &path, &interfaces_and_properties);
+    snapshot_update_object (self, path, interfaces_and_properties);
+    g_variant_unref (interfaces_and_properties);
+}
+
+static void
+snapshot_interfaces_removed (GDBusConnection *connection,
+                             const gchar     *sender_name,
+                             const gchar     *object_path,
+                             const gchar     *interface_name,
+                             const gchar     *signal_name,
+                             GVariant        *parameters,
+                             MMManager       *self)
+{
+    const gchar  *path = NULL;
+    const gchar **interfaces = NULL;
+
+    if (!self->priv->snapshot || !g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(oas)")))
+        return;
+
+    g_variant_get (parameters, "(&o^a&s)", &path, &interfaces);
+    snapshot_remove_interfaces (self, path, interfaces);
+    g_free (interfaces);
+}
+
+static void
+snapshot_name_owner_updated (MMManager *self)
+{
+    gchar *name_owner;
+
+    /* A snapshot of a daemon that went away is of no use */
+    name_owner = g_dbus_object_manager_client_get_name_owner (G_DBUS_OBJECT_MANAGER_CLIENT (self));
+    if (!name_owner)
+        g_clear_object (&self->priv->snapshot);
+    g_free (name_owner);
+}
+
+static void
+snapshot_tracking_setup (MMManager *self)
+{
+    GDBusConnection *connection;
+
+    if (self->priv->snapshot_properties_changed_id)
+        return;
+
+    connection = g_dbus_object_manager_client_get_connection (G_DBUS_OBJECT_MANAGER_CLIENT (self));
+
+    self->priv->snapshot_properties_changed_id =
+        g_dbus_connection_signal_subscribe (connection,
+                                            MM_DBUS_SERVICE,
+                                            "org.freedesktop.DBus.Properties",
+                                            "PropertiesChanged",
+                                            NULL,
+                                            NULL,
+                                            G_DBUS_SIGNAL_FLAGS_NONE,
+                                            (GDBusSignalCallback) snapshot_properties_changed,
+                                            self,
+                                            NULL);
+    self->priv->snapshot_interfaces_added_id =
+        g_dbus_connection_signal_subscribe (connection,
+                                            MM_DBUS_SERVICE,
+                                            "org.freedesktop.DBus.ObjectManager",
+                                            "InterfacesAdded",
+                                            MM_DBUS_PATH,
+                                            NULL,
+                                            G_DBUS_SIGNAL_FLAGS_NONE,
+                                            (GDBusSignalCallback) snapshot_interfaces_added,
+                                            self,
+                                            NULL);
+    self->priv->snapshot_interfaces_removed_id =
+        g_dbus_connection_signal_subscribe (connection,
+                                            MM_DBUS_SERVICE,
+                                            "org.freedesktop.DBus.ObjectManager",
+                                            "InterfacesRemoved",
+                                            MM_DBUS_PATH,
+                                            NULL,
+                                            G_DBUS_SIGNAL_FLAGS_NONE,
+                                            (GDBusSignalCallback) snapshot_interfaces_removed,
+                                            self,
+                                            NULL);
+
+    g_signal_connect (self,
+                      "notify::name-owner",
+                      G_CALLBACK (snapshot_name_owner_updated),
+                      NULL);
+}
+
+static void
+snapshot_tracking_cleanup (MMManager *self)
+{
+    GDBusConnection *connection;
+
+    if (!self->priv->snapshot_properties_changed_id)
+        return;
+
+    connection = g_dbus_object_manager_client_get_connection (G_DBUS_OBJECT_MANAGER_CLIENT (self));
+    g_dbus_connection_signal_unsubscribe (connection, self->priv->snapshot_properties_changed_id);
+    g_dbus_connection_signal_unsubscribe (connection, self->priv->snapshot_interfaces_added_id);
+    g_dbus_connection_signal_unsubscribe (connection, self->priv->snapshot_interfaces_removed_id);
+    self->priv->snapshot_properties_changed_id = 0;
+    self->priv->snapshot_interfaces_added_id = 0;
+    self->priv->snapshot_interfaces_removed_id = 0;
+
+    g_signal_handlers_disconnect_by_func (self, snapshot_name_owner_updated, NULL);
+}
+
+typedef struct {
+    guint n_pending;
+} LoadSnapshotContext;
+
+static void
+load_snapshot_complete_if_done (GTask *task)
+{
+    MMManager           *self;
+    LoadSnapshotContext *ctx;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    if (ctx->n_pending > 0)
+        return;
+
+    if (!self->priv->snapshot)
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_ABORTED,
+                                 "Snapshot lost: daemon went away while loading");
+    else
+        g_task_return_pointer (task, g_object_ref (self->priv->snapshot), g_object_unref);
+    g_object_unref (task);
+}
+
+typedef struct {
+    MMManager *self;
+    gchar     *path;
+    gchar     *interface_name;
+    GTask     *task;
+} SubObjectContext;
+
+static void
+sub_object_context_free (SubObjectContext *ctx)
+{
+    g_object_unref (ctx->self);
+    g_free (ctx->path);
+    g_free (ctx->interface_name);
+    g_free (ctx);
+}
+
+static void
+sub_object_get_all_ready (GDBusConnection  *connection,
+                          GAsyncResult     *res,
+                          SubObjectContext *ctx)
+{
+    GVariant *reply;
+
+    /* Errors are ignored, the object may have gone away since it was listed */
+    reply = g_dbus_connection_call_finish (connection, res, NULL);
+    if (reply && ctx->self->priv->snapshot) {
+        GVariant *dictionary = NULL;
+
+        g_variant_get (reply, "(@a{sv})", &dictionary);
+        snapshot_update_interface (ctx->self, ctx->path, ctx->interface_name, dictionary);
+        g_variant_unref (dictionary);
+    }
+    if (reply)
+        g_variant_unref (reply);
+
+    if (ctx->task) {
+        LoadSnapshotContext *load_ctx;
+
+        load_ctx = g_task_get_task_data (ctx->task);
+        g_assert (load_ctx->n_pending > 0);
+        load_ctx->n_pending--;
+        load_snapshot_complete_if_done (ctx->task);
+    }
+
+    sub_object_context_free (ctx);
+}
+
+static void
+snapshot_load_sub_object (MMManager   *self,
+                          const gchar *path,
+                          GTask       *task)
+{
+    SubObjectContext *ctx;
+    const gchar      *interface_name;
+
+    if (g_str_has_prefix (path, MM_DBUS_SIM_PREFIX))
+        interface_name = MM_DBUS_INTERFACE_SIM;
+    else if (g_str_has_prefix (path, MM_DBUS_BEARER_PREFIX))
+        interface_name = MM_DBUS_INTERFACE_BEARER;
+    else
+        return;
+
+    ctx = g_new0 (SubObjectContext, 1);
+    ctx->self = g_object_ref (self);
+    ctx->path = g_strdup (path);
+    ctx->interface_name = g_strdup (interface_name);
+    ctx->task = task;
+
+    if (task) {
+        LoadSnapshotContext *load_ctx;
+
+        load_ctx = g_task_get_task_data (task);
+        load_ctx->n_pending++;
+    }
+
+    /* All sub-object requests are issued right away, without waiting for the
+     * previous ones to finish */
+    g_dbus_connection_call (g_dbus_object_manager_client_get_connection (G_DBUS_OBJECT_MANAGER_CLIENT (self)),
+                            MM_DBUS_SERVICE,
+                            path,
+                            "org.freedesktop.DBus.Properties",
+                            "GetAll",
+                            g_variant_new ("(s)", interface_name),
+                            G_VARIANT_TYPE ("(a{sv})"),
+                            G_DBUS_CALL_FLAGS_NONE,
+                            -1,
+                            task ? g_task_get_cancellable (task) : NULL,
+                            (GAsyncReadyCallback) sub_object_get_all_ready,
+                            ctx);
+}
+
+/**
+ * mm_manager_load_snapshot_finish:
+ * @manager: A #MMManager.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_manager_load_snapshot().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_manager_load_snapshot().
+ *
+ * Returns: (transfer full): a #MMManagerSnapshot, or %NULL if @error is set.
+ * The returned value should be freed with g_object_unref().
+ *
+ * Since: 1.18
+ */
+MMManagerSnapshot *
+mm_manager_load_snapshot_finish (MMManager     *manager,
+                                 GAsyncResult  *res,
+                                 GError       **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+get_managed_objects_ready (GDBusConnection *connection,
+                           GAsyncResult    *res,
+                           GTask           *task)
+{
+    MMManager         *self;
+    MMManagerSnapshot *snapshot;
+    GVariant          *reply;
+    GVariant          *managed_objects;
+    GError            *error = NULL;
+    GPtrArray         *no_paths;
+    guint              n_objects;
+    guint              i;
+
+    self = g_task_get_source_object (task);
+
+    reply = g_dbus_connection_call_finish (connection, res, &error);
+    if (!reply) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    managed_objects = g_variant_get_child_value (reply, 0);
+    snapshot = mm_manager_snapshot_new_from_managed_objects (managed_objects, &error);
+    g_variant_unref (managed_objects);
+    g_variant_unref (reply);
+    if (!snapshot) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    snapshot_replace (self, snapshot);
+
+    /* Load all SIM and bearer objects of all modems at once */
+    no_paths = g_ptr_array_new ();
+    n_objects = mm_manager_snapshot_get_n_objects (snapshot);
+    for (i = 0; i < n_objects; i++) {
+        GPtrArray *sub_paths;
+
+        sub_paths = snapshot_collect_sub_objects (snapshot, mm_manager_snapshot_get_object_path (snapshot, i));
+        snapshot_sync_sub_objects (self, no_paths, sub_paths, task);
+        g_ptr_array_unref (sub_paths);
+    }
+    g_ptr_array_unref (no_paths);
+
+    load_snapshot_complete_if_done (task);
+}
+
+/**
+ * mm_manager_load_snapshot:
+ * @manager: A #MMManager.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously loads a #MMManagerSnapshot with the properties of all the
+ * modem, SIM and bearer objects exposed by the daemon.
+ *
+ * All modem objects are loaded with a single GetManagedObjects request, and the
+ * SIM and bearer objects are then all requested at once. Once loaded, the
+ * @manager keeps the snapshot updated with every property change notified by
+ * the daemon, see mm_manager_peek_snapshot().
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_manager_load_snapshot_finish() to get the result of the operation.
+ *
+ * See mm_manager_load_snapshot_sync() for the synchronous, blocking version of
+ * this method.
+ *
+ * Since: 1.18
+ */
+void
+mm_manager_load_snapshot (MMManager           *manager,
+                          GCancellable        *cancellable,
+                          GAsyncReadyCallback  callback,
+                          gpointer             user_data)
+{
+    GTask *task;
+
+    g_return_if_fail (MM_IS_MANAGER (manager));
+
+    task = g_task_new (manager, cancellable, callback, user_data);
+    g_task_set_task_data (task, g_new0 (LoadSnapshotContext, 1), g_free);
+
+    snapshot_tracking_setup (manager);
+
+    g_dbus_connection_call (g_dbus_object_manager_client_get_connection (G_DBUS_OBJECT_MANAGER_CLIENT (manager)),
+                            MM_DBUS_SERVICE,
+                            MM_DBUS_PATH,
+                            "org.freedesktop.DBus.ObjectManager",
+                            "GetManagedObjects",
+                            NULL,
+                            G_VARIANT_TYPE ("(a{oa{sa{sv}}})"),
+                            G_DBUS_CALL_FLAGS_NONE,
+                            -1,
+                            cancellable,
+                            (GAsyncReadyCallback) get_managed_objects_ready,
+                            task);
+}
+
+typedef struct {
+    GMainContext *context;
+    GAsyncResult *res;
+} LoadSnapshotSyncContext;
+
+static void
+load_snapshot_sync_ready (MMManager               *manager,
+                          GAsyncResult            *res,
+                          LoadSnapshotSyncContext *ctx)
+{
+    ctx->res = g_object_ref (res);
+    g_main_context_wakeup (ctx->context);
+}
+
+/**
+ * mm_manager_load_snapshot_sync:
+ * @manager: A #MMManager.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously loads a #MMManagerSnapshot with the properties of all the
+ * modem, SIM and bearer objects exposed by the daemon.
+ *
+ * The calling thread is blocked until all replies are received.
+ *
+ * See mm_manager_load_snapshot() for the asynchronous version of this method.
+ *
+ * Returns: (transfer full): a #MMManagerSnapshot, or %NULL if @error is set.
+ * The returned value should be freed with g_object_unref().
+ *
+ * Since: 1.18
+ */
+MMManagerSnapshot *
+mm_manager_load_snapshot_sync (MMManager     *manager,
+                               GCancellable  *cancellable,
+                               GError       **error)
+{
+    LoadSnapshotSyncContext  ctx = { NULL, NULL };
+    MMManagerSnapshot       *snapshot;
+
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    /* Signal tracking must be bound to the caller main context, not to the
+     * private one used to wait for the replies */
+    snapshot_tracking_setup (manager);
+
+    ctx.context = g_main_context_new ();
+    g_main_context_push_thread_default (ctx.context);
+    mm_manager_load_snapshot (manager,
+                              cancellable,
+                              (GAsyncReadyCallback) load_snapshot_sync_ready,
+                              &ctx);
+    while (!ctx.res)
+        g_main_context_iteration (ctx.context, TRUE);
+    g_main_context_pop_thread_default (ctx.context);
+
+    snapshot = mm_manager_load_snapshot_finish (manager, ctx.res, error);
+    g_object_unref (ctx.res);
+    g_main_context_unref (ctx.context);
+    return snapshot;
+}
+
+/**
+ * mm_manager_peek_snapshot:
+ * @manager: A #MMManager.
+ *
+ * Gets the latest #MMManagerSnapshot, as previously loaded with
+ * mm_manager_load_snapshot() and updated afterwards with every property change
+ * notified by the daemon.
+ *
+ * The snapshot is dropped if the daemon goes away, and a new one must be
+ * loaded once it is back.
+ *
+ * Returns: (transfer none): a #MMManagerSnapshot, or %NULL if none loaded. Do
+ * not free the returned object, it is owned by @manager.
+ *
+ * Since: 1.18
+ */
+MMManagerSnapshot *
+mm_manager_peek_snapshot (MMManager *manager)
+{
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    return manager->priv->snapshot;
+}
+
+/**
+ * mm_manager_get_snapshot:
+ * @manager: A #MMManager.
+ *
+ * Gets the latest #MMManagerSnapshot, as previously loaded with
+ * mm_manager_load_snapshot() and updated afterwards with every property change
+ * notified by the daemon.
+ *
+ * The returned snapshot is immutable; later property changes are reported in
+ * new snapshots.
+ *
+ * Returns: (transfer full): a #MMManagerSnapshot, or %NULL if none loaded. The
+ * returned value should be freed with g_object_unref().
+ *
+ * Since: 1.18
+ */
+MMManagerSnapshot *
+mm_manager_get_snapshot (MMManager *manager)
+{
+    g_return_val_if_fail (MM_IS_MANAGER (manager), NULL);
+
+    return manager->priv->snapshot ? g_object_ref (manager->priv->snapshot) : NULL;
+}
+
 /*****************************************************************************/
 
 static void
@@ -994,6 +1639,9 @@ dispose (GObject *object)
 
     g_clear_object (&self->priv->manager_iface_proxy);
 
+    snapshot_tracking_cleanup (self);
+    g_clear_object (&self->priv->snapshot);
+
     G_OBJECT_CLASS (mm_manager_parent_class)->dispose (object);
 }
 
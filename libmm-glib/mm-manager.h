@@ -34,6 +34,7 @@
 
 #include "mm-gdbus-modem.h"
 #include "mm-kernel-event-properties.h"
+#include "mm-manager-snapshot.h"
 
 G_BEGIN_DECLS
 
@@ -151,6 +152,20 @@ gboolean mm_manager_uninhibit_device_sync   (MMManager           *manager,
                                              GCancellable        *cancellable,
                                              GError             **error);
 
+void               mm_manager_load_snapshot        (MMManager           *manager,
+                                                    GCancellable        *cancellable,
+                                                    GAsyncReadyCallback  callback,
+                                                    gpointer             user_data);
+MMManagerSnapshot *mm_manager_load_snapshot_finish (MMManager           *manager,
+                                                    GAsyncResult        *res,
+                                                    GError             **error);
+MMManagerSnapshot *mm_manager_load_snapshot_sync   (MMManager           *manager,
+                                                    GCancellable        *cancellable,
+                                                    GError             **error);
+
+MMManagerSnapshot *mm_manager_peek_snapshot (MMManager *manager);
+MMManagerSnapshot *mm_manager_get_snapshot  (MMManager *manager);
+
 G_END_DECLS
 
 #endif /* _MM_MANAGER_H_ */
@@ -214,6 +214,220 @@ mm_modem_signal_get_rate (MMModemSignal *self)
 
 /*****************************************************************************/
 
+/**
+ * mm_modem_signal_setup_indications_finish:
+ * @self: A #MMModemSignal.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_modem_signal_setup_indications().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_signal_setup_indications().
+ *
+ * Returns: %TRUE if the setup was successful, %FALSE if @error is set.
+ *
+ * Since: 1.18
+ */
+gboolean
+mm_modem_signal_setup_indications_finish (MMModemSignal *self,
+                                          GAsyncResult *res,
+                                          GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), FALSE);
+
+    return mm_gdbus_modem_signal_call_setup_indications_finish (MM_GDBUS_MODEM_SIGNAL (self), res, error);
+}
+
+/**
+ * mm_modem_signal_setup_indications:
+ * @self: A #MMModemSignal.
+ * @rate: Minimum interval between samples, in milliseconds, or 0 to disable.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously setups the indication-driven extended signal quality
+ * reporting.
+ *
+ * When the modem supports it, the values are updated as soon as the modem
+ * reports them; otherwise they are polled, never more often than once per
+ * second.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_modem_signal_setup_indications_finish() to get the result of the
+ * operation.
+ *
+ * See mm_modem_signal_setup_indications_sync() for the synchronous, blocking
+ * version of this method.
+ *
+ * Since: 1.18
+ */
+void
+mm_modem_signal_setup_indications (MMModemSignal *self,
+                                   guint rate,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_SIGNAL (self));
+
+    mm_gdbus_modem_signal_call_setup_indications (MM_GDBUS_MODEM_SIGNAL (self), rate, cancellable, callback, user_data);
+}
+
+/**
+ * mm_modem_signal_setup_indications_sync:
+ * @self: A #MMModemSignal.
+ * @rate: Minimum interval between samples, in milliseconds, or 0 to disable.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously setups the indication-driven extended signal quality
+ * reporting.
+ *
+ * The calling thread is blocked until a reply is received. See
+ * mm_modem_signal_setup_indications() for the asynchronous version of this
+ * method.
+ *
+ * Returns: %TRUE if the setup was successful, %FALSE if @error is set.
+ *
+ * Since: 1.18
+ */
+gboolean
+mm_modem_signal_setup_indications_sync (MMModemSignal *self,
+                                        guint rate,
+                                        GCancellable *cancellable,
+                                        GError **error)
+{
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), FALSE);
+
+    return mm_gdbus_modem_signal_call_setup_indications_sync (MM_GDBUS_MODEM_SIGNAL (self), rate, cancellable, error);
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_modem_signal_get_indication_rate:
+ * @self: A #MMModemSignal.
+ *
+ * Gets the currently configured minimum interval between indication-driven
+ * updates.
+ *
+ * Returns: the interval, in milliseconds, or 0 if disabled.
+ *
+ * Since: 1.18
+ */
+guint
+mm_modem_signal_get_indication_rate (MMModemSignal *self)
+{
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), 0);
+
+    return mm_gdbus_modem_signal_get_indication_rate (MM_GDBUS_MODEM_SIGNAL (self));
+}
+
+/*****************************************************************************/
+
+/**
+ * mm_modem_signal_get_history_finish:
+ * @self: A #MMModemSignal.
+ * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
+ *  mm_modem_signal_get_history().
+ * @error: Return location for error or %NULL.
+ *
+ * Finishes an operation started with mm_modem_signal_get_history().
+ *
+ * Returns: (transfer full): a #GVariant of type <literal>aa{sv}</literal>
+ * with the most recent samples, oldest first, or %NULL if @error is set. The
+ * returned value should be freed with g_variant_unref().
+ *
+ * Since: 1.18
+ */
+GVariant *
+mm_modem_signal_get_history_finish (MMModemSignal *self,
+                                    GAsyncResult *res,
+                                    GError **error)
+{
+    GVariant *samples = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), NULL);
+
+    if (!mm_gdbus_modem_signal_call_get_history_finish (MM_GDBUS_MODEM_SIGNAL (self), &samples, res, error))
+        return NULL;
+    return samples;
+}
+
+/**
+ * mm_modem_signal_get_history:
+ * @self: A #MMModemSignal.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @callback: A #GAsyncReadyCallback to call when the request is satisfied or
+ *  %NULL.
+ * @user_data: User data to pass to @callback.
+ *
+ * Asynchronously gets the most recent extended signal quality information
+ * samples.
+ *
+ * Each sample is a dictionary with a <literal>"timestamp"</literal> key, in
+ * milliseconds since the Epoch, and one dictionary per access technology
+ * reported in the sample, in the same format as the per-technology DBus
+ * properties.
+ *
+ * When the operation is finished, @callback will be invoked in the
+ * <link linkend="g-main-context-push-thread-default">thread-default main loop</link>
+ * of the thread you are calling this method from. You can then call
+ * mm_modem_signal_get_history_finish() to get the result of the operation.
+ *
+ * See mm_modem_signal_get_history_sync() for the synchronous, blocking
+ * version of this method.
+ *
+ * Since: 1.18
+ */
+void
+mm_modem_signal_get_history (MMModemSignal *self,
+                             GCancellable *cancellable,
+                             GAsyncReadyCallback callback,
+                             gpointer user_data)
+{
+    g_return_if_fail (MM_IS_MODEM_SIGNAL (self));
+
+    mm_gdbus_modem_signal_call_get_history (MM_GDBUS_MODEM_SIGNAL (self), cancellable, callback, user_data);
+}
+
+/**
+ * mm_modem_signal_get_history_sync:
+ * @self: A #MMModemSignal.
+ * @cancellable: (allow-none): A #GCancellable or %NULL.
+ * @error: Return location for error or %NULL.
+ *
+ * Synchronously gets the most recent extended signal quality information
+ * samples.
+ *
+ * The calling thread is blocked until a reply is received. See
+ * mm_modem_signal_get_history() for the asynchronous version of this method.
+ *
+ * Returns: (transfer full): a #GVariant of type <literal>aa{sv}</literal>
+ * with the most recent samples, oldest first, or %NULL if @error is set. The
+ * returned value should be freed with g_variant_unref().
+ *
+ * Since: 1.18
+ */
+GVariant *
+mm_modem_signal_get_history_sync (MMModemSignal *self,
+                                  GCancellable *cancellable,
+                                  GError **error)
+{
+    GVariant *samples = NULL;
+
+    g_return_val_if_fail (MM_IS_MODEM_SIGNAL (self), NULL);
+
+    if (!mm_gdbus_modem_signal_call_get_history_sync (MM_GDBUS_MODEM_SIGNAL (self), &samples, cancellable, error))
+        return NULL;
+    return samples;
+}
+
+/*****************************************************************************/
+
 static void values_updated (MMModemSignal *self, GParamSpec *pspec, UpdatedPropertyType type);
 
 static void
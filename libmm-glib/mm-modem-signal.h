@@ -82,6 +82,32 @@ gboolean mm_modem_signal_setup_sync   (MMModemSignal *self,
                                        GCancellable *cancellable,
                                        GError **error);
 
+guint        mm_modem_signal_get_indication_rate (MMModemSignal *self);
+
+void     mm_modem_signal_setup_indications        (MMModemSignal *self,
+                                                   guint rate,
+                                                   GCancellable *cancellable,
+                                                   GAsyncReadyCallback callback,
+                                                   gpointer user_data);
+gboolean mm_modem_signal_setup_indications_finish (MMModemSignal *self,
+                                                   GAsyncResult *res,
+                                                   GError **error);
+gboolean mm_modem_signal_setup_indications_sync   (MMModemSignal *self,
+                                                   guint rate,
+                                                   GCancellable *cancellable,
+                                                   GError **error);
+
+void      mm_modem_signal_get_history        (MMModemSignal *self,
+                                              GCancellable *cancellable,
+                                              GAsyncReadyCallback callback,
+                                              gpointer user_data);
+GVariant *mm_modem_signal_get_history_finish (MMModemSignal *self,
+                                              GAsyncResult *res,
+                                              GError **error);
+GVariant *mm_modem_signal_get_history_sync   (MMModemSignal *self,
+                                              GCancellable *cancellable,
+                                              GError **error);
+
 MMSignal *mm_modem_signal_get_cdma (MMModemSignal *self);
 MMSignal *mm_modem_signal_peek_cdma (MMModemSignal *self);
 
@@ -0,0 +1,213 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ */
+
+#include <glib.h>
+#include <libmm-glib.h>
+#include <string.h>
+
+#define MODEM0_PATH MM_DBUS_MODEM_PREFIX "/0"
+#define MODEM1_PATH MM_DBUS_MODEM_PREFIX "/1"
+#define SIM0_PATH   MM_DBUS_SIM_PREFIX "/0"
+
+static MMManagerSnapshot *
+common_build_snapshot (void)
+{
+    MMManagerSnapshot *snapshot;
+    GVariant          *managed_objects;
+    GError            *error = NULL;
+
+    managed_objects = g_variant_ref_sink (g_variant_new_parsed (
+        "@a{oa{sa{sv}}} {"
+        "  '" MODEM1_PATH "': {"
+        "    '" MM_DBUS_INTERFACE_MODEM "': {"
+        "      'Manufacturer': <'Acme'>,"
+        "      'SignalQuality': <(@u 30, true)>"
+        "    }"
+        "  },"
+        "  '" MODEM0_PATH "': {"
+        "    '" MM_DBUS_INTERFACE_MODEM "': {"
+        "      'Manufacturer': <'Foo'>,"
+        "      'Model': <'Bar'>,"
+        "      'Sim': <objectpath '" SIM0_PATH "'>,"
+        "      'SupportedCapabilities': <[@u 4, 8, 12]>,"
+        "      'PowerState': <@u 3>"
+        "    },"
+        "    '" MM_DBUS_INTERFACE_MODEM_MODEM3GPP "': {"
+        "      'Imei': <'012345678901234'>,"
+        "      'OperatorName': <'Op'>"
+        "    }"
+        "  }"
+        "}"));
+
+    snapshot = mm_manager_snapshot_new_from_managed_objects (managed_objects, &error);
+    g_assert_no_error (error);
+    g_assert (snapshot);
+    g_variant_unref (managed_objects);
+
+    return snapshot;
+}
+
+static void
+test_snapshot_lookup (void)
+{
+    MMManagerSnapshot *snapshot;
+    const guint32     *capabilities;
+    gsize              n_capabilities = 0;
+    guint32            power_state = 0;
+    gboolean           found;
+
+    snapshot = common_build_snapshot ();
+
+    g_assert_cmpuint (mm_manager_snapshot_get_generation (snapshot), ==, 0);
+    g_assert_cmpuint (mm_manager_snapshot_get_n_objects (snapshot), ==, 2);
+    g_assert_cmpstr (mm_manager_snapshot_get_object_path (snapshot, 0), ==, MODEM0_PATH);
+    g_assert_cmpstr (mm_manager_snapshot_get_object_path (snapshot, 1), ==, MODEM1_PATH);
+    g_assert (mm_manager_snapshot_has_object (snapshot, MODEM0_PATH));
+    g_assert (!mm_manager_snapshot_has_object (snapshot, SIM0_PATH));
+
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (snapshot, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "Manufacturer"), ==, "Foo");
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (snapshot, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "Sim"), ==, SIM0_PATH);
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (snapshot, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM_MODEM3GPP, "Imei"), ==, "012345678901234");
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (snapshot, MODEM1_PATH, MM_DBUS_INTERFACE_MODEM, "Manufacturer"), ==, "Acme");
+
+    /* Unknown property, interface and object */
+    g_assert (!mm_manager_snapshot_peek_property (snapshot, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "Revision"));
+    g_assert (!mm_manager_snapshot_peek_property (snapshot, MODEM1_PATH, MM_DBUS_INTERFACE_MODEM_MODEM3GPP, "Imei"));
+    g_assert (!mm_manager_snapshot_peek_property (snapshot, SIM0_PATH, MM_DBUS_INTERFACE_SIM, "SimIdentifier"));
+
+    /* Type mismatches */
+    g_assert (!mm_manager_snapshot_peek_string (snapshot, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "PowerState"));
+    g_assert (!mm_manager_snapshot_get_uint32 (snapshot, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "Model", &power_state));
+
+    found = mm_manager_snapshot_get_uint32 (snapshot, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "PowerState", &power_state);
+    g_assert (found);
+    g_assert_cmpuint (power_state, ==, 3);
+
+    capabilities = mm_manager_snapshot_peek_uint32_array (snapshot, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "SupportedCapabilities", &n_capabilities);
+    g_assert (capabilities);
+    g_assert_cmpuint (n_capabilities, ==, 3);
+    g_assert_cmpuint (capabilities[0], ==, 4);
+    g_assert_cmpuint (capabilities[1], ==, 8);
+    g_assert_cmpuint (capabilities[2], ==, 12);
+
+    g_object_unref (snapshot);
+}
+
+static void
+test_snapshot_update (void)
+{
+    MMManagerSnapshot *snapshot;
+    MMManagerSnapshot *updated;
+    MMManagerSnapshot *with_sim;
+    GVariant          *changes;
+    const gchar       *manufacturer;
+
+    snapshot = common_build_snapshot ();
+    manufacturer = mm_manager_snapshot_peek_string (snapshot, MODEM1_PATH, MM_DBUS_INTERFACE_MODEM, "Manufacturer");
+
+    changes = g_variant_ref_sink (g_variant_new_parsed (
+        "@a{sa{sv}} {"
+        "  '" MM_DBUS_INTERFACE_MODEM "': {"
+        "    'Model': <'Baz'>,"
+        "    'Revision': <'1.0'>"
+        "  }"
+        "}"));
+    updated = mm_manager_snapshot_new_updated (snapshot, MODEM0_PATH, changes);
+    g_variant_unref (changes);
+
+    /* Original snapshot is untouched */
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (snapshot, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "Model"), ==, "Bar");
+    g_assert (!mm_manager_snapshot_peek_property (snapshot, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "Revision"));
+
+    g_assert_cmpuint (mm_manager_snapshot_get_generation (updated), ==, 1);
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (updated, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "Model"), ==, "Baz");
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (updated, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "Revision"), ==, "1.0");
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (updated, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "Manufacturer"), ==, "Foo");
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (updated, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM_MODEM3GPP, "OperatorName"), ==, "Op");
+
+    /* Unchanged objects are shared, not copied */
+    g_assert (mm_manager_snapshot_peek_string (updated, MODEM1_PATH, MM_DBUS_INTERFACE_MODEM, "Manufacturer") == manufacturer);
+
+    /* New objects are inserted in order */
+    changes = g_variant_ref_sink (g_variant_new_parsed (
+        "@a{sa{sv}} {"
+        "  '" MM_DBUS_INTERFACE_SIM "': {"
+        "    'SimIdentifier': <'89012345678901234567'>"
+        "  }"
+        "}"));
+    with_sim = mm_manager_snapshot_new_updated (updated, SIM0_PATH, changes);
+    g_variant_unref (changes);
+
+    g_assert_cmpuint (mm_manager_snapshot_get_generation (with_sim), ==, 2);
+    g_assert_cmpuint (mm_manager_snapshot_get_n_objects (with_sim), ==, 3);
+    g_assert_cmpstr (mm_manager_snapshot_get_object_path (with_sim, 2), ==, SIM0_PATH);
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (with_sim, SIM0_PATH, MM_DBUS_INTERFACE_SIM, "SimIdentifier"), ==, "89012345678901234567");
+
+    g_object_unref (snapshot);
+    g_object_unref (updated);
+    g_object_unref (with_sim);
+}
+
+static void
+test_snapshot_remove (void)
+{
+    MMManagerSnapshot  *snapshot;
+    MMManagerSnapshot  *without_3gpp;
+    MMManagerSnapshot  *without_modem;
+    const gchar *const  interfaces[] = { MM_DBUS_INTERFACE_MODEM_MODEM3GPP, NULL };
+
+    snapshot = common_build_snapshot ();
+
+    without_3gpp = mm_manager_snapshot_new_without (snapshot, MODEM0_PATH, interfaces);
+    g_assert_cmpuint (mm_manager_snapshot_get_n_objects (without_3gpp), ==, 2);
+    g_assert (!mm_manager_snapshot_peek_property (without_3gpp, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM_MODEM3GPP, "Imei"));
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (without_3gpp, MODEM0_PATH, MM_DBUS_INTERFACE_MODEM, "Model"), ==, "Bar");
+
+    without_modem = mm_manager_snapshot_new_without (without_3gpp, MODEM0_PATH, NULL);
+    g_assert_cmpuint (mm_manager_snapshot_get_n_objects (without_modem), ==, 1);
+    g_assert (!mm_manager_snapshot_has_object (without_modem, MODEM0_PATH));
+    g_assert (mm_manager_snapshot_has_object (without_modem, MODEM1_PATH));
+
+    g_object_unref (snapshot);
+    g_object_unref (without_3gpp);
+    g_object_unref (without_modem);
+}
+
+static void
+test_snapshot_invalid (void)
+{
+    MMManagerSnapshot *snapshot;
+    GVariant          *invalid;
+    GError            *error = NULL;
+
+    invalid = g_variant_ref_sink (g_variant_new_parsed ("@a{sv} {'Foo': <'Bar'>}"));
+    snapshot = mm_manager_snapshot_new_from_managed_objects (invalid, &error);
+    g_assert_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS);
+    g_assert (!snapshot);
+    g_error_free (error);
+    g_variant_unref (invalid);
+}
+
+/**************************************************************/
+
+int main (int argc, char **argv)
+{
+    g_test_init (&argc, &argv, NULL);
+
+    g_test_add_func ("/MM/ManagerSnapshot/lookup",  test_snapshot_lookup);
+    g_test_add_func ("/MM/ManagerSnapshot/update",  test_snapshot_update);
+    g_test_add_func ("/MM/ManagerSnapshot/remove",  test_snapshot_remove);
+    g_test_add_func ("/MM/ManagerSnapshot/invalid", test_snapshot_invalid);
+
+    return g_test_run ();
+}
@@ -181,3 +181,82 @@ qcdm_log_item_evdo_pilot_sets_v2_get_pilot (QcdmResult *result,
 }
 
 /**********************************************************************/
+
+#define RPC_LOG_BAND_CLASS "band-class"
+#define RPC_LOG_STEP_SIZE  "step-size"
+#define RPC_LOG_RECORDS    "records"
+
+QcdmResult *
+qcdm_log_item_cdma_reverse_power_control_new (const char *buf, size_t len, int *out_error)
+{
+    QcdmResult *result = NULL;
+    DMLogItemCdmaReversePowerControl *rpc;
+    DMCmdLog *log_cmd = (DMCmdLog *) buf;
+    size_t records_len;
+
+    qcdm_return_val_if_fail (buf != NULL, NULL);
+
+    if (!check_log_item (buf, len, DM_LOG_ITEM_CDMA_REVERSE_POWER_CONTROL, sizeof (DMLogItemCdmaReversePowerControl), out_error))
+        return NULL;
+
+    rpc = (DMLogItemCdmaReversePowerControl *) log_cmd->data;
+
+    records_len = rpc->num_records * sizeof (DMLogItemRPCItem);
+    if (len < sizeof (DMCmdLog) + sizeof (DMLogItemCdmaReversePowerControl) + records_len) {
+        qcdm_err (0, "DM log item response not long enough for %u power control records", rpc->num_records);
+        if (out_error)
+            *out_error = -QCDM_ERROR_RESPONSE_BAD_LENGTH;
+        return NULL;
+    }
+
+    result = qcdm_result_new ();
+    qcdm_result_add_u8 (result, RPC_LOG_BAND_CLASS, rpc->band_class);
+    qcdm_result_add_u8 (result, RPC_LOG_STEP_SIZE, rpc->step_size);
+    if (records_len > 0)
+        qcdm_result_add_u8_array (result, RPC_LOG_RECORDS, (const uint8_t *) &rpc->records[0], records_len);
+
+    return result;
+}
+
+qcdmbool
+qcdm_log_item_cdma_reverse_power_control_get_num (QcdmResult *result,
+                                                  uint32_t *out_num)
+{
+    const uint8_t *array = NULL;
+    size_t array_len = 0;
+
+    qcdm_return_val_if_fail (result != NULL, FALSE);
+
+    if (qcdm_result_get_u8_array (result, RPC_LOG_RECORDS, &array, &array_len))
+        array_len = 0;
+
+    *out_num = array_len / sizeof (DMLogItemRPCItem);
+    return TRUE;
+}
+
+qcdmbool
+qcdm_log_item_cdma_reverse_power_control_get_record (QcdmResult *result,
+                                                     uint32_t num,
+                                                     uint8_t *out_rx_agc,
+                                                     uint8_t *out_tx_power,
+                                                     uint8_t *out_tx_gain_adjust)
+{
+    DMLogItemRPCItem *record;
+    const uint8_t *array = NULL;
+    size_t array_len = 0;
+
+    qcdm_return_val_if_fail (result != NULL, FALSE);
+
+    if (qcdm_result_get_u8_array (result, RPC_LOG_RECORDS, &array, &array_len))
+        return FALSE;
+
+    qcdm_return_val_if_fail (num < array_len / sizeof (DMLogItemRPCItem), FALSE);
+
+    record = (DMLogItemRPCItem *) &array[num * sizeof (DMLogItemRPCItem)];
+    *out_rx_agc = record->rx_agc_vals;
+    *out_tx_power = record->tx_power_vals;
+    *out_tx_gain_adjust = record->tx_gain_adjust;
+    return TRUE;
+}
+
+/**********************************************************************/
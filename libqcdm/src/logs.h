@@ -47,4 +47,19 @@ qcdmbool    qcdm_log_item_evdo_pilot_sets_v2_get_pilot (QcdmResult *result,
 
 /**********************************************************************/
 
+QcdmResult *qcdm_log_item_cdma_reverse_power_control_new        (const char *buf,
+                                                                 size_t len,
+                                                                 int *out_error);
+
+qcdmbool    qcdm_log_item_cdma_reverse_power_control_get_num    (QcdmResult *result,
+                                                                 uint32_t *out_num);
+
+qcdmbool    qcdm_log_item_cdma_reverse_power_control_get_record (QcdmResult *result,
+                                                                 uint32_t num,
+                                                                 uint8_t *out_rx_agc,
+                                                                 uint8_t *out_tx_power,
+                                                                 uint8_t *out_tx_gain_adjust);
+
+/**********************************************************************/
+
 #endif  /* LIBQCDM_LOGS_H */
@@ -24,7 +24,14 @@
 
 /*********************************************************/
 
-typedef struct Val Val;
+/* All values of a result live in a single arena owned by the result, and are
+ * looked up through a small open addressing hash index. Results decoded from
+ * DM responses hold a handful of fields, which fit in the inline storage so
+ * that building a result takes a single allocation. */
+
+#define RESULT_INLINE_VALS  16
+#define RESULT_INLINE_INDEX 32   /* power of two, twice the inline vals */
+#define RESULT_INLINE_ARENA 256
 
 typedef enum {
     VAL_TYPE_NONE = 0,
@@ -35,161 +42,232 @@ typedef enum {
     VAL_TYPE_U16_ARRAY = 5,
 } ValType;
 
-struct Val {
-    char *key;
+typedef struct {
+    uint32_t hash;
+    uint32_t key;        /* arena offset */
     uint8_t type;
     union {
-        char *s;
         uint8_t u8;
         uint32_t u32;
-        uint8_t *u8_array;
-        uint16_t *u16_array;
+        uint32_t offset; /* arena offset of strings and arrays */
     } u;
     uint32_t array_len;
-    Val *next;
-};
+} Val;
 
-static void
-val_free (Val *v)
-{
-    if (v->type == VAL_TYPE_STRING) {
-        free (v->u.s);
-    } else if (v->type == VAL_TYPE_U8_ARRAY) {
-        free (v->u.u8_array);
-    } else if (v->type == VAL_TYPE_U16_ARRAY) {
-        free (v->u.u16_array);
-    }
-    free (v->key);
-    memset (v, 0, sizeof (*v));
-    free (v);
-}
+struct QcdmResult {
+    uint32_t refcount;
 
-static Val *
-val_new_string (const char *key, const char *value)
-{
-    Val *v;
+    Val *vals;
+    uint32_t n_vals;
+    uint32_t vals_size;
 
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-    qcdm_return_val_if_fail (value != NULL, NULL);
+    /* Position of the value in 'vals' plus one, 0 if the slot is empty */
+    uint32_t *index;
+    uint32_t index_size;
 
-    v = calloc (sizeof (Val), 1);
-    if (v == NULL)
-        return NULL;
+    uint8_t *arena;
+    size_t arena_len;
+    size_t arena_size;
 
-    v->key = strdup (key);
-    v->type = VAL_TYPE_STRING;
-    v->u.s = strdup (value);
-    return v;
-}
+    Val vals_inline[RESULT_INLINE_VALS];
+    uint32_t index_inline[RESULT_INLINE_INDEX];
+    uint64_t arena_inline[RESULT_INLINE_ARENA / sizeof (uint64_t)];
+};
 
-static Val *
-val_new_u8 (const char *key, uint8_t u)
+static uint32_t
+key_hash (const char *key)
 {
-    Val *v;
+    uint32_t h = 2166136261u;
 
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
+    /* FNV-1a */
+    while (*key) {
+        h ^= (uint8_t) *key++;
+        h *= 16777619u;
+    }
+    return h;
+}
 
-    v = calloc (sizeof (Val), 1);
-    if (v == NULL)
-        return NULL;
+static int
+arena_append (QcdmResult *r,
+              const void *data,
+              size_t len,
+              size_t align,
+              uint32_t *out_offset)
+{
+    size_t offset;
+
+    offset = (r->arena_len + align - 1) & ~(align - 1);
+    if (offset + len > UINT32_MAX)
+        return -QCDM_ERROR_INVALID_ARGUMENTS;
+
+    if (offset + len > r->arena_size) {
+        size_t new_size;
+        uint8_t *new_arena;
+
+        new_size = r->arena_size * 2;
+        while (new_size < offset + len)
+            new_size *= 2;
+
+        if (r->arena == (uint8_t *) r->arena_inline) {
+            new_arena = malloc (new_size);
+            if (new_arena)
+                memcpy (new_arena, r->arena, r->arena_len);
+        } else
+            new_arena = realloc (r->arena, new_size);
+        if (!new_arena)
+            return -QCDM_ERROR_INVALID_ARGUMENTS;
+
+        r->arena = new_arena;
+        r->arena_size = new_size;
+    }
 
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U8;
-    v->u.u8 = u;
-    return v;
+    memcpy (r->arena + offset, data, len);
+    r->arena_len = offset + len;
+    *out_offset = (uint32_t) offset;
+    return 0;
 }
 
-static Val *
-val_new_u8_array (const char *key, const uint8_t *array, size_t array_len)
+static uint32_t *
+index_find_slot (uint32_t *index,
+                 uint32_t index_size,
+                 const QcdmResult *r,
+                 const char *key,
+                 uint32_t hash)
 {
-    Val *v;
+    uint32_t i;
 
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-    qcdm_return_val_if_fail (array != NULL, NULL);
-    qcdm_return_val_if_fail (array_len > 0, NULL);
+    /* Linear probing; the index is never more than half full, so there is
+     * always an empty slot to stop at */
+    for (i = hash & (index_size - 1); index[i]; i = (i + 1) & (index_size - 1)) {
+        const Val *v = &r->vals[index[i] - 1];
 
-    v = calloc (sizeof (Val), 1);
-    if (v == NULL)
-        return NULL;
+        if (v->hash == hash && strcmp ((const char *) r->arena + v->key, key) == 0)
+            break;
+    }
+    return &index[i];
+}
 
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U8_ARRAY;
-    v->u.u8_array = malloc (array_len);
-    if (v->u.u8_array == NULL) {
-        val_free (v);
-        return NULL;
+static int
+index_grow (QcdmResult *r)
+{
+    uint32_t *new_index;
+    uint32_t new_size;
+    uint32_t i;
+
+    /* Only reached with about a billion values, the arena can't hold that
+     * many keys anyway */
+    if (r->index_size > UINT32_MAX / 2)
+        return -QCDM_ERROR_INVALID_ARGUMENTS;
+    new_size = r->index_size * 2;
+
+    new_index = calloc (new_size, sizeof (uint32_t));
+    if (!new_index)
+        return -QCDM_ERROR_INVALID_ARGUMENTS;
+
+    /* Re-add only the values currently referenced, so that shadowed
+     * duplicates stay hidden */
+    for (i = 0; i < r->index_size; i++) {
+        const Val *v;
+
+        if (!r->index[i])
+            continue;
+        v = &r->vals[r->index[i] - 1];
+        *index_find_slot (new_index, new_size, r, (const char *) r->arena + v->key, v->hash) = r->index[i];
     }
-    memcpy (v->u.u8_array, array, array_len);
-    v->array_len = array_len;
 
-    return v;
+    if (r->index != r->index_inline)
+        free (r->index);
+    r->index = new_index;
+    r->index_size = new_size;
+    return 0;
+}
+
+static int
+vals_grow (QcdmResult *r)
+{
+    Val *new_vals;
+    uint32_t new_size;
+
+    if (r->vals_size > UINT32_MAX / 2 || (size_t) r->vals_size * 2 > SIZE_MAX / sizeof (Val))
+        return -QCDM_ERROR_INVALID_ARGUMENTS;
+    new_size = r->vals_size * 2;
+    if (r->vals == r->vals_inline) {
+        new_vals = malloc (sizeof (Val) * new_size);
+        if (new_vals)
+            memcpy (new_vals, r->vals, sizeof (Val) * r->n_vals);
+    } else
+        new_vals = realloc (r->vals, sizeof (Val) * new_size);
+    if (!new_vals)
+        return -QCDM_ERROR_INVALID_ARGUMENTS;
+
+    r->vals = new_vals;
+    r->vals_size = new_size;
+    return 0;
 }
 
+/* Adds a new value with the given key; a previous value with the same key
+ * is shadowed by the new one. The payload must be filled in by the caller. */
 static Val *
-val_new_u32 (const char *key, uint32_t u)
+val_add (QcdmResult *r, const char *key, ValType type)
 {
     Val *v;
+    uint32_t *slot;
+    uint32_t key_offset;
 
     qcdm_return_val_if_fail (key != NULL, NULL);
     qcdm_return_val_if_fail (key[0] != '\0', NULL);
 
-    v = calloc (sizeof (Val), 1);
-    if (v == NULL)
+    if ((r->n_vals + 1) * 2 > r->index_size && index_grow (r) < 0)
+        return NULL;
+    if (r->n_vals == r->vals_size && vals_grow (r) < 0)
+        return NULL;
+    if (arena_append (r, key, strlen (key) + 1, 1, &key_offset) < 0)
         return NULL;
 
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U32;
-    v->u.u32 = u;
+    v = &r->vals[r->n_vals];
+    memset (v, 0, sizeof (*v));
+    v->hash = key_hash (key);
+    v->key = key_offset;
+    v->type = type;
+
+    slot = index_find_slot (r->index, r->index_size, r, key, v->hash);
+    *slot = ++r->n_vals;
     return v;
 }
 
-static Val *
-val_new_u16_array (const char *key, const uint16_t *array, size_t array_len)
+static const Val *
+find_val (QcdmResult *r, const char *key, ValType expected_type)
 {
-    Val *v;
-    size_t sz;
-
-    qcdm_return_val_if_fail (key != NULL, NULL);
-    qcdm_return_val_if_fail (key[0] != '\0', NULL);
-    qcdm_return_val_if_fail (array != NULL, NULL);
-    qcdm_return_val_if_fail (array_len > 0, NULL);
+    uint32_t *slot;
+    const Val *v;
 
-    v = calloc (sizeof (Val), 1);
-    if (v == NULL)
+    slot = index_find_slot (r->index, r->index_size, r, key, key_hash (key));
+    if (!*slot)
         return NULL;
 
-    v->key = strdup (key);
-    v->type = VAL_TYPE_U16_ARRAY;
-    sz = sizeof (uint16_t) * array_len;
-    v->u.u16_array = malloc (sz);
-    if (v->u.u16_array == NULL) {
-        val_free (v);
-        return NULL;
-    }
-    memcpy (v->u.u16_array, array, sz);
-    v->array_len = array_len;
-
+    v = &r->vals[*slot - 1];
+    /* Check type */
+    qcdm_return_val_if_fail (v->type == expected_type, NULL);
     return v;
 }
 
 /*********************************************************/
 
-struct QcdmResult {
-    uint32_t refcount;
-    Val *first;
-};
-
 QcdmResult *
 qcdm_result_new (void)
 {
     QcdmResult *r;
 
     r = calloc (sizeof (QcdmResult), 1);
-    if (r)
+    if (r) {
         r->refcount = 1;
+        r->vals = r->vals_inline;
+        r->vals_size = RESULT_INLINE_VALS;
+        r->index = r->index_inline;
+        r->index_size = RESULT_INLINE_INDEX;
+        r->arena = (uint8_t *) r->arena_inline;
+        r->arena_size = sizeof (r->arena_inline);
+    }
     return r;
 }
 
@@ -206,14 +284,12 @@ qcdm_result_ref (QcdmResult *r)
 static void
 qcdm_result_free (QcdmResult *r)
 {
-    Val *v, *n;
-
-    v = r->first;
-    while (v) {
-        n = v->next;
-        val_free (v);
-        v = n;
-    }
+    if (r->vals != r->vals_inline)
+        free (r->vals);
+    if (r->index != r->index_inline)
+        free (r->index);
+    if (r->arena != (uint8_t *) r->arena_inline)
+        free (r->arena);
     memset (r, 0, sizeof (*r));
     free (r);
 }
@@ -229,40 +305,25 @@ qcdm_result_unref (QcdmResult *r)
         qcdm_result_free (r);
 }
 
-static Val *
-find_val (QcdmResult *r, const char *key, ValType expected_type)
-{
-    Val *v, *n;
-
-    v = r->first;
-    while (v) {
-        n = v->next;
-        if (strcmp (v->key, key) == 0) {
-            /* Check type */
-            qcdm_return_val_if_fail (v->type == expected_type, NULL);
-            return v;
-        }
-        v = n;
-    }
-    return NULL;
-}
-
 void
 qcdm_result_add_string (QcdmResult *r,
                        const char *key,
                        const char *str)
 {
     Val *v;
+    uint32_t offset;
 
     qcdm_return_if_fail (r != NULL);
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
     qcdm_return_if_fail (str != NULL);
 
-    v = val_new_string (key, str);
+    /* Store the payload first, so that a failure doesn't leave a value
+     * without contents behind */
+    qcdm_return_if_fail (arena_append (r, str, strlen (str) + 1, 1, &offset) == 0);
+    v = val_add (r, key, VAL_TYPE_STRING);
     qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    v->u.offset = offset;
 }
 
 int
@@ -270,7 +331,7 @@ qcdm_result_get_string (QcdmResult *r,
                        const char *key,
                        const char **out_val)
 {
-    Val *v;
+    const Val *v;
 
     qcdm_return_val_if_fail (r != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (r->refcount > 0, -QCDM_ERROR_INVALID_ARGUMENTS);
@@ -282,7 +343,7 @@ qcdm_result_get_string (QcdmResult *r,
     if (v == NULL)
         return -QCDM_ERROR_VALUE_NOT_FOUND;
 
-    *out_val = v->u.s;
+    *out_val = (const char *) r->arena + v->u.offset;
     return 0;
 }
 
@@ -297,10 +358,9 @@ qcdm_result_add_u8 (QcdmResult *r,
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
 
-    v = val_new_u8 (key, num);
+    v = val_add (r, key, VAL_TYPE_U8);
     qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    v->u.u8 = num;
 }
 
 int
@@ -308,7 +368,7 @@ qcdm_result_get_u8  (QcdmResult *r,
                     const char *key,
                     uint8_t *out_val)
 {
-    Val *v;
+    const Val *v;
 
     qcdm_return_val_if_fail (r != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (r->refcount > 0, -QCDM_ERROR_INVALID_ARGUMENTS);
@@ -330,16 +390,19 @@ qcdm_result_add_u8_array (QcdmResult *r,
                           size_t array_len)
 {
     Val *v;
+    uint32_t offset;
 
     qcdm_return_if_fail (r != NULL);
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
     qcdm_return_if_fail (array != NULL);
+    qcdm_return_if_fail (array_len > 0);
 
-    v = val_new_u8_array (key, array, array_len);
+    qcdm_return_if_fail (arena_append (r, array, array_len, 1, &offset) == 0);
+    v = val_add (r, key, VAL_TYPE_U8_ARRAY);
     qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    v->u.offset = offset;
+    v->array_len = array_len;
 }
 
 int
@@ -348,7 +411,7 @@ qcdm_result_get_u8_array (QcdmResult *r,
                           const uint8_t **out_val,
                           size_t *out_len)
 {
-    Val *v;
+    const Val *v;
 
     qcdm_return_val_if_fail (r != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (r->refcount > 0, -QCDM_ERROR_INVALID_ARGUMENTS);
@@ -360,7 +423,7 @@ qcdm_result_get_u8_array (QcdmResult *r,
     if (v == NULL)
         return -QCDM_ERROR_VALUE_NOT_FOUND;
 
-    *out_val = v->u.u8_array;
+    *out_val = r->arena + v->u.offset;
     *out_len = v->array_len;
     return 0;
 }
@@ -376,10 +439,9 @@ qcdm_result_add_u32 (QcdmResult *r,
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
 
-    v = val_new_u32 (key, num);
+    v = val_add (r, key, VAL_TYPE_U32);
     qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    v->u.u32 = num;
 }
 
 int
@@ -387,7 +449,7 @@ qcdm_result_get_u32 (QcdmResult *r,
                     const char *key,
                     uint32_t *out_val)
 {
-    Val *v;
+    const Val *v;
 
     qcdm_return_val_if_fail (r != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (r->refcount > 0, -QCDM_ERROR_INVALID_ARGUMENTS);
@@ -409,16 +471,19 @@ qcdm_result_add_u16_array (QcdmResult *r,
                            size_t array_len)
 {
     Val *v;
+    uint32_t offset;
 
     qcdm_return_if_fail (r != NULL);
     qcdm_return_if_fail (r->refcount > 0);
     qcdm_return_if_fail (key != NULL);
     qcdm_return_if_fail (array != NULL);
+    qcdm_return_if_fail (array_len > 0);
 
-    v = val_new_u16_array (key, array, array_len);
+    qcdm_return_if_fail (arena_append (r, array, sizeof (uint16_t) * array_len, sizeof (uint16_t), &offset) == 0);
+    v = val_add (r, key, VAL_TYPE_U16_ARRAY);
     qcdm_return_if_fail (v != NULL);
-    v->next = r->first;
-    r->first = v;
+    v->u.offset = offset;
+    v->array_len = array_len;
 }
 
 int
@@ -427,7 +492,7 @@ qcdm_result_get_u16_array (QcdmResult *r,
                            const uint16_t **out_val,
                            size_t *out_len)
 {
-    Val *v;
+    const Val *v;
 
     qcdm_return_val_if_fail (r != NULL, -QCDM_ERROR_INVALID_ARGUMENTS);
     qcdm_return_val_if_fail (r->refcount > 0, -QCDM_ERROR_INVALID_ARGUMENTS);
@@ -439,7 +504,7 @@ qcdm_result_get_u16_array (QcdmResult *r,
     if (v == NULL)
         return -QCDM_ERROR_VALUE_NOT_FOUND;
 
-    *out_val = v->u.u16_array;
+    *out_val = (const uint16_t *) (r->arena + v->u.offset);
     *out_len = v->array_len;
     return 0;
 }
@@ -0,0 +1,91 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * Copyright (C) 2010 Red Hat, Inc.
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of version 2 of the GNU General Public
+ * License as published by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <string.h>
+
+#include "test-qcdm-logs.h"
+#include "logs.h"
+#include "result.h"
+#include "errors.h"
+
+/* DM_LOG_ITEM_CDMA_REVERSE_POWER_CONTROL with two records */
+static const char rpc_log_item[] = {
+    0x10, 0x00, 0x25, 0x00, 0x25, 0x00, 0x2c, 0x10, 0x5a, 0x3b, 0x21, 0x6f,
+    0x0e, 0xd5, 0x00, 0x00, 0x00, 0x01, 0x03, 0x00, 0x00, 0x01, 0x02, 0x01,
+    0x10, 0x00, 0x01, 0x00, 0x00, 0xb0, 0x40, 0x12, 0x01, 0x11, 0x00, 0x01,
+    0x00, 0x00, 0xb2, 0x42, 0x14
+};
+
+void
+test_log_item_cdma_reverse_power_control (void *f, void *data)
+{
+    QcdmResult *result;
+    int err = QCDM_SUCCESS;
+    uint32_t num = 0;
+    uint8_t rx_agc = 0;
+    uint8_t tx_power = 0;
+    uint8_t tx_gain_adjust = 0;
+
+    result = qcdm_log_item_cdma_reverse_power_control_new (rpc_log_item, sizeof (rpc_log_item), &err);
+    g_assert_cmpint (err, ==, QCDM_SUCCESS);
+    g_assert (result);
+
+    g_assert (qcdm_log_item_cdma_reverse_power_control_get_num (result, &num));
+    g_assert_cmpuint (num, ==, 2);
+
+    g_assert (qcdm_log_item_cdma_reverse_power_control_get_record (result, 0, &rx_agc, &tx_power, &tx_gain_adjust));
+    g_assert_cmpuint (rx_agc, ==, 0xb0);
+    g_assert_cmpuint (tx_power, ==, 0x40);
+    g_assert_cmpuint (tx_gain_adjust, ==, 0x12);
+
+    g_assert (qcdm_log_item_cdma_reverse_power_control_get_record (result, 1, &rx_agc, &tx_power, &tx_gain_adjust));
+    g_assert_cmpuint (rx_agc, ==, 0xb2);
+    g_assert_cmpuint (tx_power, ==, 0x42);
+    g_assert_cmpuint (tx_gain_adjust, ==, 0x14);
+
+    g_assert (!qcdm_log_item_cdma_reverse_power_control_get_record (result, 2, &rx_agc, &tx_power, &tx_gain_adjust));
+
+    qcdm_result_unref (result);
+}
+
+void
+test_log_item_cdma_reverse_power_control_short (void *f, void *data)
+{
+    QcdmResult *result;
+    int err = QCDM_SUCCESS;
+
+    /* Two records announced, but the second one is truncated */
+    result = qcdm_log_item_cdma_reverse_power_control_new (rpc_log_item, sizeof (rpc_log_item) - 1, &err);
+    g_assert (!result);
+    g_assert_cmpint (err, ==, -QCDM_ERROR_RESPONSE_BAD_LENGTH);
+}
+
+void
+test_log_item_cdma_reverse_power_control_unexpected (void *f, void *data)
+{
+    QcdmResult *result;
+    int err = QCDM_SUCCESS;
+    char buf[sizeof (rpc_log_item)];
+
+    /* Same contents, different log code */
+    memcpy (buf, rpc_log_item, sizeof (rpc_log_item));
+    buf[6] = 0x8b;
+    result = qcdm_log_item_cdma_reverse_power_control_new (buf, sizeof (buf), &err);
+    g_assert (!result);
+    g_assert_cmpint (err, ==, -QCDM_ERROR_RESPONSE_UNEXPECTED);
+}
@@ -0,0 +1,26 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * Copyright (C) 2010 Red Hat, Inc.
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of version 2 of the GNU General Public
+ * License as published by the Free Software Foundation
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_QCDM_LOGS_H
+#define TEST_QCDM_LOGS_H
+
+void test_log_item_cdma_reverse_power_control (void *f, void *data);
+void test_log_item_cdma_reverse_power_control_short (void *f, void *data);
+void test_log_item_cdma_reverse_power_control_unexpected (void *f, void *data);
+
+#endif  /* TEST_QCDM_LOGS_H */
+
@@ -21,9 +21,75 @@
 #include "test-qcdm-result.h"
 #include "result.h"
 #include "result-private.h"
+#include "errors.h"
 
 #define TEST_TAG "test"
 
+/*****************************************************************************/
+/* Counting allocator
+ *
+ * The test program is linked with --wrap for the libc allocation functions
+ * (see Makefile.am), so that the allocations done by the statically linked
+ * libqcdm go through these wrappers and can be counted. Allocations done
+ * within GLib are not accounted. */
+
+void *__real_malloc  (size_t size);
+void *__real_calloc  (size_t nmemb, size_t size);
+void *__real_realloc (void *ptr, size_t size);
+void  __real_free    (void *ptr);
+
+void *__wrap_malloc  (size_t size);
+void *__wrap_calloc  (size_t nmemb, size_t size);
+void *__wrap_realloc (void *ptr, size_t size);
+void  __wrap_free    (void *ptr);
+
+/* Allocation requests, including reallocations */
+static guint n_allocs;
+/* Blocks allocated and not yet freed */
+static gint  n_live;
+
+void *
+__wrap_malloc (size_t size)
+{
+    n_allocs++;
+    n_live++;
+    return __real_malloc (size);
+}
+
+void *
+__wrap_calloc (size_t nmemb, size_t size)
+{
+    n_allocs++;
+    n_live++;
+    return __real_calloc (nmemb, size);
+}
+
+void *
+__wrap_realloc (void *ptr, size_t size)
+{
+    n_allocs++;
+    if (!ptr)
+        n_live++;
+    return __real_realloc (ptr, size);
+}
+
+void
+__wrap_free (void *ptr)
+{
+    if (ptr)
+        n_live--;
+    __real_free (ptr);
+}
+
+static void
+alloc_counters_reset (void)
+{
+    n_allocs = 0;
+    n_live = 0;
+}
+
+/*****************************************************************************/
+
 void
 test_result_string (void *f, void *data)
 {
@@ -90,3 +156,213 @@ test_result_uint8_array (void *f, void *data)
 
     qcdm_result_unref (result);
 }
+
+void
+test_result_uint16_array (void *f, void *data)
+{
+    uint16_t array[] = { 0, 1, 0xFFFF, 0x1234, 128 };
+    const uint16_t *tmp = NULL;
+    size_t tmp_len = 0;
+    QcdmResult *result;
+
+    result = qcdm_result_new ();
+    /* Misalign the arena on purpose */
+    qcdm_result_add_u8 (result, "pad", 1);
+    qcdm_result_add_u16_array (result, TEST_TAG, array, G_N_ELEMENTS (array));
+
+    qcdm_result_get_u16_array (result, TEST_TAG, &tmp, &tmp_len);
+    g_assert_cmpint (tmp_len, ==, G_N_ELEMENTS (array));
+    g_assert_cmpint (memcmp (tmp, array, sizeof (array)), ==, 0);
+
+    qcdm_result_unref (result);
+}
+
+void
+test_result_duplicate (void *f, void *data)
+{
+    guint32 tmp = 0;
+    guint8 tmp8 = 0;
+    QcdmResult *result;
+
+    result = qcdm_result_new ();
+    qcdm_result_add_u32 (result, TEST_TAG, 1);
+    qcdm_result_add_u32 (result, TEST_TAG, 2);
+
+    /* Last value added wins */
+    qcdm_result_get_u32 (result, TEST_TAG, &tmp);
+    g_assert_cmpuint (tmp, ==, 2);
+
+    /* Wrong type and unknown keys */
+    g_assert_cmpint (qcdm_result_get_u8 (result, TEST_TAG, &tmp8), ==, -QCDM_ERROR_VALUE_NOT_FOUND);
+    g_assert_cmpint (qcdm_result_get_u32 (result, "foobar", &tmp), ==, -QCDM_ERROR_VALUE_NOT_FOUND);
+
+    qcdm_result_unref (result);
+}
+
+#define MANY_FIELDS 500
+
+void
+test_result_many (void *f, void *data)
+{
+    QcdmResult *result;
+    guint i;
+
+    /* Well beyond the inline storage of a result */
+    result = qcdm_result_new ();
+    for (i = 0; i < MANY_FIELDS; i++) {
+        gchar key[16];
+        gchar str[32];
+
+        g_snprintf (key, sizeof (key), "key-%u", i);
+        if (i % 2) {
+            g_snprintf (str, sizeof (str), "value-%u", i);
+            qcdm_result_add_string (result, key, str);
+        } else
+            qcdm_result_add_u32 (result, key, i);
+    }
+
+    for (i = 0; i < MANY_FIELDS; i++) {
+        gchar key[16];
+
+        g_snprintf (key, sizeof (key), "key-%u", i);
+        if (i % 2) {
+            const char *tmp = NULL;
+            gchar str[32];
+
+            g_snprintf (str, sizeof (str), "value-%u", i);
+            g_assert_cmpint (qcdm_result_get_string (result, key, &tmp), ==, 0);
+            g_assert_cmpstr (tmp, ==, str);
+        } else {
+            guint32 tmp = 0;
+
+            g_assert_cmpint (qcdm_result_get_u32 (result, key, &tmp), ==, 0);
+            g_assert_cmpuint (tmp, ==, i);
+        }
+    }
+
+    qcdm_result_unref (result);
+}
+
+/* Beyond the 16k values the index could hold with 16-bit slots */
+#define HUGE_FIELDS 20000
+
+void
+test_result_huge (void *f, void *data)
+{
+    QcdmResult *result;
+    guint i;
+
+    result = qcdm_result_new ();
+    for (i = 0; i < HUGE_FIELDS; i++) {
+        gchar key[16];
+
+        g_snprintf (key, sizeof (key), "key-%u", i);
+        qcdm_result_add_u32 (result, key, i);
+    }
+
+    for (i = 0; i < HUGE_FIELDS; i++) {
+        gchar key[16];
+        guint32 tmp = 0;
+
+        g_snprintf (key, sizeof (key), "key-%u", i);
+        g_assert_cmpint (qcdm_result_get_u32 (result, key, &tmp), ==, 0);
+        g_assert_cmpuint (tmp, ==, i);
+    }
+
+    qcdm_result_unref (result);
+}
+
+/* Builds a result like the ones decoded from DM responses, and reads all its
+ * values back */
+static void
+common_build_typical_result (void)
+{
+    static const uint8_t  esn[] = { 0xDE, 0xAD, 0xBE, 0xEF };
+    static const uint16_t sids[] = { 4096, 4097, 4098 };
+    QcdmResult     *result;
+    const char     *str = NULL;
+    const uint8_t  *u8_array = NULL;
+    const uint16_t *u16_array = NULL;
+    size_t          len = 0;
+    uint32_t        u32 = 0;
+    uint8_t         u8 = 0;
+
+    result = qcdm_result_new ();
+    qcdm_result_add_string (result, "comp-date", "Mar 12 2010");
+    qcdm_result_add_string (result, "comp-time", "19:36:37");
+    qcdm_result_add_string (result, "sw-version", "Q6085BDRFZ");
+    qcdm_result_add_u8 (result, "band-class", 1);
+    qcdm_result_add_u8 (result, "rx-state", 3);
+    qcdm_result_add_u32 (result, "cdma-channel", 1175);
+    qcdm_result_add_u8_array (result, "esn", esn, sizeof (esn));
+    qcdm_result_add_u16_array (result, "sids", sids, G_N_ELEMENTS (sids));
+
+    g_assert_cmpint (qcdm_result_get_string (result, "sw-version", &str), ==, 0);
+    g_assert_cmpint (qcdm_result_get_u8 (result, "rx-state", &u8), ==, 0);
+    g_assert_cmpint (qcdm_result_get_u32 (result, "cdma-channel", &u32), ==, 0);
+    g_assert_cmpint (qcdm_result_get_u8_array (result, "esn", &u8_array, &len), ==, 0);
+    g_assert_cmpint (qcdm_result_get_u16_array (result, "sids", &u16_array, &len), ==, 0);
+
+    qcdm_result_unref (result);
+}
+
+void
+test_result_allocations (void *f, void *data)
+{
+    QcdmResult *result;
+    guint i;
+
+    /* Typical results are built with a single allocation */
+    alloc_counters_reset ();
+    common_build_typical_result ();
+    g_assert_cmpuint (n_allocs, ==, 1);
+    g_assert_cmpint (n_live, ==, 0);
+
+    /* Larger ones grow geometrically: a few allocations for each of the
+     * values, index and arena storage */
+    alloc_counters_reset ();
+    result = qcdm_result_new ();
+    for (i = 0; i < MANY_FIELDS; i++) {
+        gchar key[16];
+
+        g_snprintf (key, sizeof (key), "key-%u", i);
+        qcdm_result_add_u32 (result, key, i);
+    }
+    g_assert_cmpuint (n_allocs, <=, 20);
+    qcdm_result_unref (result);
+    g_assert_cmpint (n_live, ==, 0);
+}
+
+#define THROUGHPUT_ITERATIONS      10000
+#define THROUGHPUT_ITERATIONS_PERF 1000000
+/* Very conservative, so that it doesn't fail in slow or instrumented runs */
+#define THROUGHPUT_MIN_RESULTS_PER_SEC 50000.0
+
+void
+test_result_throughput (void *f, void *data)
+{
+    GTimer  *timer;
+    guint    n_iterations;
+    guint    i;
+    gdouble  elapsed;
+    gdouble  rate;
+
+    n_iterations = g_test_perf () ? THROUGHPUT_ITERATIONS_PERF : THROUGHPUT_ITERATIONS;
+
+    alloc_counters_reset ();
+    timer = g_timer_new ();
+    for (i = 0; i < n_iterations; i++)
+        common_build_typical_result ();
+    elapsed = g_timer_elapsed (timer, NULL);
+    g_timer_destroy (timer);
+
+    g_assert_cmpuint (n_allocs, ==, n_iterations);
+    g_assert_cmpint (n_live, ==, 0);
+
+    rate = elapsed > 0 ? n_iterations / elapsed : G_MAXDOUBLE;
+    g_test_maximized_result (rate, "%.0f results built and read per second", rate);
+
+    /* Timing is only checked when running performance tests */
+    if (g_test_perf ())
+        g_assert_cmpfloat (rate, >, THROUGHPUT_MIN_RESULTS_PER_SEC);
+}
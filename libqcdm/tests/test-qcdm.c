@@ -22,6 +22,7 @@
 #include "test-qcdm-escaping.h"
 #include "test-qcdm-com.h"
 #include "test-qcdm-result.h"
+#include "test-qcdm-logs.h"
 #include "test-qcdm-utils.h"
 
 typedef struct {
@@ -90,6 +91,15 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_result_uint32, NULL));
     g_test_suite_add (suite, TESTCASE (test_result_uint8, NULL));
     g_test_suite_add (suite, TESTCASE (test_result_uint8_array, NULL));
+    g_test_suite_add (suite, TESTCASE (test_result_uint16_array, NULL));
+    g_test_suite_add (suite, TESTCASE (test_result_duplicate, NULL));
+    g_test_suite_add (suite, TESTCASE (test_result_many, NULL));
+    g_test_suite_add (suite, TESTCASE (test_result_huge, NULL));
+    g_test_suite_add (suite, TESTCASE (test_result_allocations, NULL));
+    g_test_suite_add (suite, TESTCASE (test_result_throughput, NULL));
+    g_test_suite_add (suite, TESTCASE (test_log_item_cdma_reverse_power_control, NULL));
+    g_test_suite_add (suite, TESTCASE (test_log_item_cdma_reverse_power_control_short, NULL));
+    g_test_suite_add (suite, TESTCASE (test_log_item_cdma_reverse_power_control_unexpected, NULL));
 
     /* Live tests */
     if (port) {
@@ -1267,6 +1267,10 @@ set_initial_eps_cgdcont_ready (MMBaseModem  *_self,
 
     ctx = (SetInitialEpsContext *) g_task_get_task_data (task);
 
+    /* The context definitions changed (or may have changed, if the command
+     * failed), so don't rely on the cached list any more */
+    mm_broadband_modem_invalidate_cached_pdp_context_list (MM_BROADBAND_MODEM (self));
+
     if (!mm_base_modem_at_command_finish (_self, res, &ctx->saved_error)) {
         mm_obj_warn (self, "couldn't configure context %d settings: %s",
                      self->priv->initial_eps_bearer_cid, ctx->saved_error->message);
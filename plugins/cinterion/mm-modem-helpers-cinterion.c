@@ -752,9 +752,101 @@ mm_cinterion_build_band (GArray                        *bands,
     return TRUE;
 }
 
+/*****************************************************************************/
+/* Tokenizer helpers
+ *
+ * The responses and URCs parsed in the hot paths (e.g. ^SWWAN while polling the
+ * connection status) are tokenized in place, without compiling regular
+ * expressions or copying the matched fields.
+ */
+
+static const gchar *
+skip_spaces (const gchar *str)
+{
+    while (g_ascii_isspace (*str))
+        str++;
+    return str;
+}
+
+static const gchar *
+skip_digits (const gchar *str)
+{
+    while (g_ascii_isdigit (*str))
+        str++;
+    return str;
+}
+
+/* Same limits as mm_get_uint_from_str(), on a [start,end) span of digits */
+static gboolean
+uint_from_span (const gchar *start,
+                const gchar *end,
+                guint       *out)
+{
+    guint64 num = 0;
+
+    if (start == end)
+        return FALSE;
+
+    for (; start < end; start++) {
+        num = (num * 10) + (*start - '0');
+        if (num > G_MAXUINT)
+            return FALSE;
+    }
+
+    *out = (guint) num;
+    return TRUE;
+}
+
+/* Same as mm_get_string_unquoted_from_match_info(), on a [start,end) span */
+static gchar *
+string_unquoted_from_span (const gchar *start,
+                           const gchar *end)
+{
+    if ((end - start >= 2) && (start[0] == '"') && (end[-1] == '"')) {
+        start++;
+        end--;
+        while (start < end && g_ascii_isspace (*start))
+            start++;
+        while (end > start && g_ascii_isspace (end[-1]))
+            end--;
+    }
+
+    return (end > start) ? g_strndup (start, end - start) : NULL;
+}
+
 /*****************************************************************************/
 /* Single ^SIND response parser */
 
+#define SIND_PREFIX "^SIND:"
+
+/* Looks for the trailing ",<mode>,<value>" fields of a ^SIND line, which must
+ * be the last ones in the line as the description may contain commas */
+static gboolean
+sind_find_fields (const gchar  *descr_start,
+                  const gchar  *line_end,
+                  const gchar **mode_start,
+                  const gchar **value_start)
+{
+    const gchar *comma;
+
+    for (comma = line_end; comma > descr_start; ) {
+        const gchar *aux;
+
+        comma--;
+        if (*comma != ',')
+            continue;
+        aux = skip_digits (comma + 1);
+        if (aux == comma + 1 || *aux != ',')
+            continue;
+        if (!g_ascii_isdigit (aux[1]))
+            continue;
+        *mode_start = comma + 1;
+        *value_start = aux + 1;
+        return TRUE;
+    }
+    return FALSE;
+}
+
 gboolean
 mm_cinterion_parse_sind_response (const gchar *response,
                                   gchar **description,
@@ -762,8 +854,7 @@ mm_cinterion_parse_sind_response (const gchar *response,
                                   guint *value,
                                   GError **error)
 {
-    GRegex *r;
-    GMatchInfo *match_info;
+    const gchar *prefix;
     guint errors = 0;
 
     if (!response) {
@@ -771,24 +862,31 @@ mm_cinterion_parse_sind_response (const gchar *response,
         return FALSE;
     }
 
-    r = g_regex_new ("\\^SIND:\\s*(.*),(\\d+),(\\d+)(\\r\\n)?", 0, 0, NULL);
-    g_assert (r != NULL);
+    for (prefix = strstr (response, SIND_PREFIX); prefix; prefix = strstr (prefix + 1, SIND_PREFIX)) {
+        const gchar *descr_start;
+        const gchar *line_end;
+        const gchar *mode_start;
+        const gchar *value_start;
+
+        descr_start = skip_spaces (prefix + strlen (SIND_PREFIX));
+        line_end = descr_start + strcspn (descr_start, "\r\n");
+        if (!sind_find_fields (descr_start, line_end, &mode_start, &value_start))
+            continue;
 
-    if (g_regex_match (r, response, 0, &match_info)) {
         if (description) {
-            *description = mm_get_string_unquoted_from_match_info (match_info, 1);
+            *description = string_unquoted_from_span (descr_start, mode_start - 1);
             if (*description == NULL)
                 errors++;
         }
-        if (mode && !mm_get_uint_from_match_info (match_info, 2, mode))
+        if (mode && !uint_from_span (mode_start, value_start - 1, mode))
             errors++;
-        if (value && !mm_get_uint_from_match_info (match_info, 3, value))
+        if (value && !uint_from_span (value_start, skip_digits (value_start), value))
             errors++;
-    } else
-        errors++;
+        break;
+    }
 
-    g_match_info_free (match_info);
-    g_regex_unref (r);
+    if (!prefix)
+        errors++;
 
     if (errors > 0) {
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED, "Failed parsing ^SIND response");
@@ -829,15 +927,15 @@ enum {
     MM_SWWAN_STATE_CONNECTED    =  1,
 };
 
+#define SWWAN_PREFIX "^SWWAN:"
+
 MMBearerConnectionStatus
 mm_cinterion_parse_swwan_response (const gchar  *response,
                                    guint         cid,
                                    gpointer      log_object,
                                    GError      **error)
 {
-    GRegex                   *r;
-    GMatchInfo               *match_info;
-    GError                   *inner_error = NULL;
+    const gchar              *prefix;
     MMBearerConnectionStatus  status;
 
     g_assert (response);
@@ -847,25 +945,33 @@ mm_cinterion_parse_swwan_response (const gchar  *response,
     if (!response[0])
         return MM_BEARER_CONNECTION_STATUS_DISCONNECTED;
 
-    if (!g_str_has_prefix (response, "^SWWAN:")) {
+    if (!g_str_has_prefix (response, SWWAN_PREFIX)) {
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
                      "Couldn't parse ^SWWAN response: '%s'", response);
         return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
     }
 
-    r = g_regex_new ("\\^SWWAN:\\s*(\\d+),\\s*(\\d+)(?:,\\s*(\\d+))?(?:\\r\\n)?",
-                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
-    g_assert (r != NULL);
-
     status = MM_BEARER_CONNECTION_STATUS_UNKNOWN;
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, &inner_error);
-    while (!inner_error && g_match_info_matches (match_info)) {
-        guint read_state;
-        guint read_cid;
-
-        if (!mm_get_uint_from_match_info (match_info, 1, &read_cid))
+    for (prefix = strstr (response, SWWAN_PREFIX); prefix; prefix = strstr (prefix + 1, SWWAN_PREFIX)) {
+        const gchar *cid_start;
+        const gchar *cid_end;
+        const gchar *state_start;
+        const gchar *state_end;
+        guint        read_state;
+        guint        read_cid;
+
+        cid_start = skip_spaces (prefix + strlen (SWWAN_PREFIX));
+        cid_end = skip_digits (cid_start);
+        if (cid_end == cid_start || *cid_end != ',')
+            continue;
+        state_start = skip_spaces (cid_end + 1);
+        state_end = skip_digits (state_start);
+        if (state_end == state_start)
+            continue;
+
+        if (!uint_from_span (cid_start, cid_end, &read_cid))
             mm_obj_warn (log_object, "couldn't read cid in ^SWWAN response: %s", response);
-        else if (!mm_get_uint_from_match_info (match_info, 2, &read_state))
+        else if (!uint_from_span (state_start, state_end, &read_state))
             mm_obj_warn (log_object, "couldn't read state in ^SWWAN response: %s", response);
         else if (read_cid == cid) {
             if (read_state == MM_SWWAN_STATE_CONNECTED) {
@@ -879,12 +985,8 @@ mm_cinterion_parse_swwan_response (const gchar  *response,
             mm_obj_warn (log_object, "invalid state read in ^SWWAN response: %u", read_state);
             break;
         }
-        g_match_info_next (match_info, &inner_error);
     }
 
-    g_match_info_free (match_info);
-    g_regex_unref (r);
-
     if (status == MM_BEARER_CONNECTION_STATUS_UNKNOWN)
         g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
                      "No state returned for CID %u", cid);
@@ -903,6 +1005,8 @@ mm_cinterion_parse_swwan_response (const gchar  *response,
  *   OK
  */
 
+#define SGAUTH_PREFIX "^SGAUTH:"
+
 gboolean
 mm_cinterion_parse_sgauth_response (const gchar          *response,
                                     guint                 cid,
@@ -910,26 +1014,44 @@ mm_cinterion_parse_sgauth_response (const gchar          *response,
                                     gchar               **out_username,
                                     GError              **error)
 {
-    g_autoptr(GRegex)     r = NULL;
-    g_autoptr(GMatchInfo) match_info = NULL;
-
-    r = g_regex_new ("\\^SGAUTH:\\s*(\\d+),(\\d+),?\"?([a-zA-Z0-9_-]+)?\"?", 0, 0, NULL);
-    g_assert (r != NULL);
-
-    g_regex_match_full (r, response, strlen (response), 0, 0, &match_info, NULL);
-    while (g_match_info_matches (match_info)) {
-        guint sgauth_cid = 0;
-
-        if (mm_get_uint_from_match_info (match_info, 1, &sgauth_cid) &&
-            (sgauth_cid == cid)) {
-            guint cinterion_auth_type = 0;
-
-            mm_get_uint_from_match_info (match_info, 2, &cinterion_auth_type);
-            *out_auth = mm_auth_type_from_cinterion_auth_type (cinterion_auth_type);
-            *out_username = mm_get_string_unquoted_from_match_info (match_info, 3);
-            return TRUE;
-        }
-        g_match_info_next (match_info, NULL);
+    const gchar *prefix;
+
+    for (prefix = strstr (response, SGAUTH_PREFIX); prefix; prefix = strstr (prefix + 1, SGAUTH_PREFIX)) {
+        const gchar *cid_start;
+        const gchar *cid_end;
+        const gchar *auth_start;
+        const gchar *auth_end;
+        const gchar *username_start;
+        const gchar *username_end;
+        guint        sgauth_cid = 0;
+        guint        cinterion_auth_type = 0;
+
+        cid_start = skip_spaces (prefix + strlen (SGAUTH_PREFIX));
+        cid_end = skip_digits (cid_start);
+        if (cid_end == cid_start || *cid_end != ',')
+            continue;
+        auth_start = cid_end + 1;
+        auth_end = skip_digits (auth_start);
+        if (auth_end == auth_start)
+            continue;
+
+        if (!uint_from_span (cid_start, cid_end, &sgauth_cid) || (sgauth_cid != cid))
+            continue;
+
+        /* Optional, and optionally quoted, username */
+        username_start = auth_end;
+        if (*username_start == ',')
+            username_start++;
+        if (*username_start == '"')
+            username_start++;
+        for (username_end = username_start;
+             g_ascii_isalnum (*username_end) || *username_end == '_' || *username_end == '-';
+             username_end++);
+
+        uint_from_span (auth_start, auth_end, &cinterion_auth_type);
+        *out_auth = mm_auth_type_from_cinterion_auth_type (cinterion_auth_type);
+        *out_username = (username_end > username_start) ? g_strndup (username_start, username_end - username_start) : NULL;
+        return TRUE;
     }
 
     g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND,
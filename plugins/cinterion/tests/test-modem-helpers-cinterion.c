@@ -1711,6 +1711,198 @@ test_sgauth_response (void)
     g_assert (!result);
 }
 
+/*****************************************************************************/
+/* Compare the ^SWWAN, ^SGAUTH and ^SIND tokenizers against the regex based
+ * parsers they replaced, on randomly built responses */
+
+#define FUZZ_ITERATIONS 5000
+
+static MMBearerConnectionStatus
+regex_parse_swwan_response (const gchar *response,
+                            guint        cid)
+{
+    g_autoptr(GRegex)     r = NULL;
+    g_autoptr(GMatchInfo) match_info = NULL;
+
+    if (!response[0])
+        return MM_BEARER_CONNECTION_STATUS_DISCONNECTED;
+    if (!g_str_has_prefix (response, "^SWWAN:"))
+        return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
+
+    r = g_regex_new ("\\^SWWAN:\\s*(\\d+),\\s*(\\d+)(?:,\\s*(\\d+))?(?:\\r\\n)?",
+                     G_REGEX_DOLLAR_ENDONLY | G_REGEX_RAW, 0, NULL);
+    g_assert (r);
+
+    g_regex_match (r, response, 0, &match_info);
+    while (g_match_info_matches (match_info)) {
+        guint read_state;
+        guint read_cid;
+
+        if (mm_get_uint_from_match_info (match_info, 1, &read_cid) &&
+            mm_get_uint_from_match_info (match_info, 2, &read_state) &&
+            read_cid == cid) {
+            if (read_state == 1)
+                return MM_BEARER_CONNECTION_STATUS_CONNECTED;
+            if (read_state == 0)
+                return MM_BEARER_CONNECTION_STATUS_DISCONNECTED;
+            return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
+        }
+        g_match_info_next (match_info, NULL);
+    }
+    return MM_BEARER_CONNECTION_STATUS_UNKNOWN;
+}
+
+static gboolean
+regex_parse_sgauth_response (const gchar          *response,
+                             guint                 cid,
+                             MMBearerAllowedAuth  *out_auth,
+                             gchar               **out_username)
+{
+    g_autoptr(GRegex)     r = NULL;
+    g_autoptr(GMatchInfo) match_info = NULL;
+
+    r = g_regex_new ("\\^SGAUTH:\\s*(\\d+),(\\d+),?\"?([a-zA-Z0-9_-]+)?\"?", 0, 0, NULL);
+    g_assert (r);
+
+    g_regex_match (r, response, 0, &match_info);
+    while (g_match_info_matches (match_info)) {
+        guint sgauth_cid = 0;
+
+        if (mm_get_uint_from_match_info (match_info, 1, &sgauth_cid) && (sgauth_cid == cid)) {
+            guint cinterion_auth_type = 0;
+
+            mm_get_uint_from_match_info (match_info, 2, &cinterion_auth_type);
+            *out_auth = mm_auth_type_from_cinterion_auth_type (cinterion_auth_type);
+            *out_username = mm_get_string_unquoted_from_match_info (match_info, 3);
+            return TRUE;
+        }
+        g_match_info_next (match_info, NULL);
+    }
+    return FALSE;
+}
+
+static gboolean
+regex_parse_sind_response (const gchar  *response,
+                           gchar       **description,
+                           guint        *mode,
+                           guint        *value)
+{
+    g_autoptr(GRegex)     r = NULL;
+    g_autoptr(GMatchInfo) match_info = NULL;
+
+    r = g_regex_new ("\\^SIND:\\s*(.*),(\\d+),(\\d+)(\\r\\n)?", 0, 0, NULL);
+    g_assert (r);
+
+    if (!g_regex_match (r, response, 0, &match_info))
+        return FALSE;
+
+    *description = mm_get_string_unquoted_from_match_info (match_info, 1);
+    return (*description &&
+            mm_get_uint_from_match_info (match_info, 2, mode) &&
+            mm_get_uint_from_match_info (match_info, 3, value));
+}
+
+static const gchar *fuzz_numbers[] = {
+    "0", "1", "2", "3", "12", "007", "4294967295", "4294967296", "99999999999999999999999"
+};
+
+static gchar *
+fuzz_build_response (GRand              *rand,
+                     const gchar *const *pieces,
+                     guint               n_pieces)
+{
+    GString *str;
+    guint    n;
+
+    str = g_string_new (NULL);
+    if (g_rand_int_range (rand, 0, 5))
+        g_string_append (str, pieces[0]);
+    for (n = g_rand_int_range (rand, 0, 15); n > 0; n--) {
+        if (g_rand_boolean (rand))
+            g_string_append (str, fuzz_numbers[g_rand_int_range (rand, 0, G_N_ELEMENTS (fuzz_numbers))]);
+        else
+            g_string_append (str, pieces[g_rand_int_range (rand, 0, n_pieces)]);
+    }
+    return g_string_free (str, FALSE);
+}
+
+static void
+test_swwan_fuzz (void)
+{
+    g_autoptr(GRand) rand = NULL;
+    guint            i;
+
+    static const gchar *pieces[] = { "^SWWAN:", "^SWWAN: ", " ", ",", ", ", "\r\n", "\t", "x" };
+
+    rand = g_rand_new_with_seed (1);
+    for (i = 0; i < FUZZ_ITERATIONS; i++) {
+        g_autofree gchar *response = NULL;
+        guint             cid;
+
+        response = fuzz_build_response (rand, pieces, G_N_ELEMENTS (pieces));
+        cid = g_rand_int_range (rand, 0, 4);
+        g_assert_cmpint (mm_cinterion_parse_swwan_response (response, cid, NULL, NULL), ==,
+                         regex_parse_swwan_response (response, cid));
+    }
+}
+
+static void
+test_sgauth_fuzz (void)
+{
+    g_autoptr(GRand) rand = NULL;
+    guint            i;
+
+    static const gchar *pieces[] = { "^SGAUTH:", "^SGAUTH: ", ",", "\"", "vf", "user_1-a", "\r\n", " ", "." };
+
+    rand = g_rand_new_with_seed (1);
+    for (i = 0; i < FUZZ_ITERATIONS; i++) {
+        g_autofree gchar    *response = NULL;
+        g_autofree gchar    *username = NULL;
+        g_autofree gchar    *expected_username = NULL;
+        MMBearerAllowedAuth  auth = MM_BEARER_ALLOWED_AUTH_UNKNOWN;
+        MMBearerAllowedAuth  expected_auth = MM_BEARER_ALLOWED_AUTH_UNKNOWN;
+        gboolean             found;
+        guint                cid;
+
+        response = fuzz_build_response (rand, pieces, G_N_ELEMENTS (pieces));
+        cid = g_rand_int_range (rand, 0, 4);
+        found = mm_cinterion_parse_sgauth_response (response, cid, &auth, &username, NULL);
+        g_assert_cmpint (found, ==, regex_parse_sgauth_response (response, cid, &expected_auth, &expected_username));
+        g_assert_cmpuint (auth, ==, expected_auth);
+        g_assert_cmpstr (username, ==, expected_username);
+    }
+}
+
+static void
+test_sind_fuzz (void)
+{
+    g_autoptr(GRand) rand = NULL;
+    guint            i;
+
+    static const gchar *pieces[] = { "^SIND:", "^SIND: ", ",", "\"", " ", "psinfo", "a b", "\r\n", "\n", "x" };
+
+    rand = g_rand_new_with_seed (1);
+    for (i = 0; i < FUZZ_ITERATIONS; i++) {
+        g_autofree gchar *response = NULL;
+        g_autofree gchar *description = NULL;
+        g_autofree gchar *expected_description = NULL;
+        guint             mode = 0;
+        guint             value = 0;
+        guint             expected_mode = 0;
+        guint             expected_value = 0;
+        gboolean          parsed;
+
+        response = fuzz_build_response (rand, pieces, G_N_ELEMENTS (pieces));
+        parsed = mm_cinterion_parse_sind_response (response, &description, &mode, &value, NULL);
+        g_assert_cmpint (parsed, ==, regex_parse_sind_response (response, &expected_description, &expected_mode, &expected_value));
+        if (parsed) {
+            g_assert_cmpstr (description, ==, expected_description);
+            g_assert_cmpuint (mode, ==, expected_mode);
+            g_assert_cmpuint (value, ==, expected_value);
+        }
+    }
+}
+
 /*****************************************************************************/
 
 int main (int argc, char **argv)
@@ -1745,6 +1937,9 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/cinterion/smoni/query_response_to_signal", test_smoni_response_to_signal);
     g_test_add_func ("/MM/cinterion/scfg/provcfg",            test_provcfg_response);
     g_test_add_func ("/MM/cinterion/sgauth",                  test_sgauth_response);
+    g_test_add_func ("/MM/cinterion/swwan/fuzz",              test_swwan_fuzz);
+    g_test_add_func ("/MM/cinterion/sgauth/fuzz",             test_sgauth_fuzz);
+    g_test_add_func ("/MM/cinterion/sind/fuzz",               test_sind_fuzz);
 
     return g_test_run ();
 }
@@ -81,6 +81,13 @@ typedef enum {
     FEATURE_SUPPORTED
 } FeatureSupport;
 
+typedef enum {
+    URC_GROUP_NONE  = 0,
+    URC_GROUP_3GPP  = 1 << 0,
+    URC_GROUP_CDMA  = 1 << 1,
+    URC_GROUP_VOICE = 1 << 2,
+} UrcGroup;
+
 typedef struct {
     MMSignal *cdma;
     MMSignal *evdo;
@@ -91,46 +98,14 @@ typedef struct {
 } DetailedSignal;
 
 struct _MMBroadbandModemHuaweiPrivate {
-    /* Regex for signal quality related notifications */
-    GRegex *rssi_regex;
-    GRegex *rssilvl_regex;
-    GRegex *hrssilvl_regex;
-
-    /* Regex for access-technology related notifications */
-    GRegex *mode_regex;
-
-    /* Regex for connection status related notifications */
-    GRegex *dsflowrpt_regex;
-    GRegex *ndisstat_regex;
-
-    /* Regex for voice management notifications */
-    GRegex *orig_regex;
-    GRegex *conf_regex;
-    GRegex *conn_regex;
-    GRegex *cend_regex;
-    GRegex *ddtmf_regex;
-
-    /* Regex to ignore */
-    GRegex *boot_regex;
-    GRegex *connect_regex;
-    GRegex *csnr_regex;
-    GRegex *cusatp_regex;
-    GRegex *cusatend_regex;
-    GRegex *dsdormant_regex;
-    GRegex *simst_regex;
-    GRegex *srvst_regex;
-    GRegex *stin_regex;
-    GRegex *hcsq_regex;
-    GRegex *pdpdeact_regex;
-    GRegex *ndisend_regex;
+    /* Table-driven "^TAG:" unsolicited messages, and groups of them for
+     * which processing is currently enabled */
+    GRegex   *urc_regex;
+    UrcGroup  urc_groups_enabled;
+
+    /* Other unsolicited messages to ignore */
+    GRegex *ignored_regex;
     GRegex *rfswitch_regex;
-    GRegex *position_regex;
-    GRegex *posend_regex;
-    GRegex *ecclist_regex;
-    GRegex *ltersrp_regex;
-    GRegex *cschannelinfo_regex;
-    GRegex *ccallstate_regex;
-    GRegex *eons_regex;
 
     FeatureSupport ndisdup_support;
     FeatureSupport rfswitch_support;
@@ -1508,17 +1483,31 @@ set_current_modes (MMIfaceModem *_self,
     }
 }
 
+/*****************************************************************************/
+/* Unsolicited message groups */
+
+static void
+set_urc_group_enabled (MMBroadbandModemHuawei *self,
+                       UrcGroup                group,
+                       gboolean                enable)
+{
+    if (enable)
+        self->priv->urc_groups_enabled |= group;
+    else
+        self->priv->urc_groups_enabled &= ~group;
+}
+
 /*****************************************************************************/
 /* Setup/Cleanup unsolicited events (3GPP interface) */
 
 static void
-huawei_signal_changed (MMPortSerialAt *port,
-                       GMatchInfo *match_info,
-                       MMBroadbandModemHuawei *self)
+huawei_signal_changed (MMBroadbandModemHuawei *self,
+                       const gchar            *args,
+                       gsize                   args_len)
 {
     guint quality = 0;
 
-    if (!mm_get_uint_from_match_info (match_info, 1, &quality))
+    if (!mm_huawei_parse_urc_uints (args, args_len, 10, &quality, 1))
         return;
 
     if (quality == 99) {
@@ -1533,24 +1522,23 @@ huawei_signal_changed (MMPortSerialAt *port,
 }
 
 static void
-huawei_mode_changed (MMPortSerialAt *port,
-                     GMatchInfo *match_info,
-                     MMBroadbandModemHuawei *self)
+huawei_mode_changed (MMBroadbandModemHuawei *self,
+                     const gchar            *args,
+                     gsize                   args_len)
 {
     MMModemAccessTechnology act = MM_MODEM_ACCESS_TECHNOLOGY_UNKNOWN;
     gchar *str;
-    gint a;
+    guint values[2] = { 0, 0 };
+    guint n_values;
+    guint a;
     guint32 mask = MM_MODEM_ACCESS_TECHNOLOGY_UNKNOWN;
 
-    str = g_match_info_fetch (match_info, 1);
-    a = atoi (str);
-    g_free (str);
+    n_values = mm_huawei_parse_urc_uints (args, args_len, 10, values, G_N_ELEMENTS (values));
+    a = values[0];
 
     /* CDMA/EVDO devices may not send this */
-    str = g_match_info_fetch (match_info, 2);
-    if (str[0])
-        act = huawei_sysinfo_submode_to_act (atoi (str));
-    g_free (str);
+    if (n_values > 1)
+        act = huawei_sysinfo_submode_to_act (values[1]);
 
     switch (a) {
     case 3:
@@ -1613,7 +1601,7 @@ huawei_mode_changed (MMPortSerialAt *port,
         break;
 
     default:
-        mm_obj_warn (self, "unexpected mode change value reported: '%d'", a);
+        mm_obj_warn (self, "unexpected mode change value reported: '%u'", a);
         return;
     }
 
@@ -1621,18 +1609,45 @@ huawei_mode_changed (MMPortSerialAt *port,
 }
 
 static void
-huawei_status_changed (MMPortSerialAt *port,
-                       GMatchInfo *match_info,
-                       MMBroadbandModemHuawei *self)
+bearer_report_stats_sample (MMBaseBearer      *bearer,
+                            MMHuaweiDsflowrpt *dsflowrpt)
 {
-    gchar *str;
-    gint n1, n2, n3, n4, n5, n6, n7;
+    /* ^DSFLOWRPT reports the counters of the single data connection */
+    if (mm_base_bearer_get_status (bearer) == MM_BEARER_STATUS_CONNECTED)
+        mm_base_bearer_report_stats_sample (bearer, dsflowrpt->rx_bytes, dsflowrpt->tx_bytes);
+}
 
-    str = g_match_info_fetch (match_info, 1);
-    if (sscanf (str, "%x,%x,%x,%x,%x,%x,%x", &n1, &n2, &n3, &n4, &n5, &n6, &n7))
-        mm_obj_dbg (self, "duration: %d up: %d Kbps down: %d Kbps total: %d total: %d\n",
-                    n1, n2 * 8 / 1000, n3  * 8 / 1000, n4 / 1024, n5 / 1024);
-    g_free (str);
+static void
+huawei_status_changed (MMBroadbandModemHuawei *self,
+                       const gchar            *args,
+                       gsize                   args_len)
+{
+    MMHuaweiDsflowrpt  dsflowrpt;
+    MMBearerList      *list = NULL;
+
+    if (!mm_huawei_parse_dsflowrpt (args, args_len, &dsflowrpt))
+        return;
+
+    mm_obj_dbg (self, "duration: %u up: %u Kbps down: %u Kbps total: %" G_GUINT64_FORMAT " total: %" G_GUINT64_FORMAT,
+                dsflowrpt.duration,
+                dsflowrpt.tx_rate * 8 / 1000,
+                dsflowrpt.rx_rate * 8 / 1000,
+                dsflowrpt.tx_bytes / 1024,
+                dsflowrpt.rx_bytes / 1024);
+
+    /* Feed the counters to the connected bearers, so that stats are
+     * available without explicitly querying the device */
+    g_object_get (self,
+                  MM_IFACE_MODEM_BEARER_LIST, &list,
+                  NULL);
+    if (!list)
+        return;
+
+    mm_bearer_list_foreach (list,
+                            (MMBearerListForeachFunc)bearer_report_stats_sample,
+                            &dsflowrpt);
+
+    g_object_unref (list);
 }
 
 typedef struct {
@@ -1657,16 +1672,16 @@ bearer_report_connection_status (MMBaseBearer *bearer,
 }
 
 static void
-huawei_ndisstat_changed (MMPortSerialAt *port,
-                         GMatchInfo *match_info,
-                         MMBroadbandModemHuawei *self)
+huawei_ndisstat_changed (MMBroadbandModemHuawei *self,
+                         const gchar            *args,
+                         gsize                   args_len)
 {
     gchar *str;
     NdisstatResult ndisstat_result;
     GError *error = NULL;
     MMBearerList *list = NULL;
 
-    str = g_match_info_fetch (match_info, 1);
+    str = g_strdup_printf ("^NDISSTAT:%.*s", (gint) args_len, args);
     if (!mm_huawei_parse_ndisstatqry_response (str,
                                                &ndisstat_result.ipv4_available,
                                                &ndisstat_result.ipv4_connected,
@@ -1762,9 +1777,9 @@ get_rsrq_db (guint rsrq, gdouble *out_val)
 }
 
 static void
-huawei_hcsq_changed (MMPortSerialAt *port,
-                     GMatchInfo *match_info,
-                     MMBroadbandModemHuawei *self)
+huawei_hcsq_changed (MMBroadbandModemHuawei *self,
+                     const gchar            *args,
+                     gsize                   args_len)
 {
     gchar *str;
     MMModemAccessTechnology act = MM_MODEM_ACCESS_TECHNOLOGY_UNKNOWN;
@@ -1776,7 +1791,7 @@ huawei_hcsq_changed (MMPortSerialAt *port,
     gdouble v;
     GError *error = NULL;
 
-    str = g_match_info_fetch (match_info, 1);
+    str = g_strdup_printf ("^HCSQ:%.*s", (gint) args_len, args);
     if (!mm_huawei_parse_hcsq_response (str,
                                         &act,
                                         &value1,
@@ -1794,17 +1809,16 @@ huawei_hcsq_changed (MMPortSerialAt *port,
 
     detailed_signal_clear (&self->priv->detailed_signal);
 
-    /* 2G */
-    if (act == MM_MODEM_ACCESS_TECHNOLOGY_GSM) {
+    switch (act) {
+    case MM_MODEM_ACCESS_TECHNOLOGY_GSM:
+        /* 2G */
         self->priv->detailed_signal.gsm = mm_signal_new ();
         /* value1: gsm_rssi */
         if (get_rssi_dbm (value1, &v))
             mm_signal_set_rssi (self->priv->detailed_signal.gsm, v);
-        return;
-    }
-
-    /* 3G */
-    if (act == MM_MODEM_ACCESS_TECHNOLOGY_UMTS) {
+        break;
+    case MM_MODEM_ACCESS_TECHNOLOGY_UMTS:
+        /* 3G */
         self->priv->detailed_signal.umts = mm_signal_new ();
         /* value1: wcdma_rssi */
         if (get_rssi_dbm (value1, &v))
@@ -1813,11 +1827,9 @@ huawei_hcsq_changed (MMPortSerialAt *port,
         /* value3: wcdma_ecio */
         if (get_ecio_db (value3, &v))
             mm_signal_set_ecio (self->priv->detailed_signal.umts, v);
-        return;
-    }
-
-    /* 4G */
-    if (act == MM_MODEM_ACCESS_TECHNOLOGY_LTE) {
+        break;
+    case MM_MODEM_ACCESS_TECHNOLOGY_LTE:
+        /* 4G */
         self->priv->detailed_signal.lte = mm_signal_new ();
         /* value1: lte_rssi */
         if (get_rssi_dbm (value1, &v))
@@ -1831,64 +1843,20 @@ huawei_hcsq_changed (MMPortSerialAt *port,
         /* value4: lte_rsrq */
         if (get_rsrq_db (value4, &v))
             mm_signal_set_rsrq (self->priv->detailed_signal.lte, v);
+        break;
+    default:
+        /* CDMA and EVDO not yet supported */
         return;
     }
 
-    /* CDMA and EVDO not yet supported */
-}
-
-static void
-set_3gpp_unsolicited_events_handlers (MMBroadbandModemHuawei *self,
-                                      gboolean enable)
-{
-    GList *ports, *l;
-
-    ports = mm_broadband_modem_huawei_get_at_port_list (self);
-
-    /* Enable/disable unsolicited events in given port */
-    for (l = ports; l; l = g_list_next (l)) {
-        MMPortSerialAt *port = MM_PORT_SERIAL_AT (l->data);
-
-        /* Signal quality related */
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->rssi_regex,
-            enable ? (MMPortSerialAtUnsolicitedMsgFn)huawei_signal_changed : NULL,
-            enable ? self : NULL,
-            NULL);
-
-        /* Access technology related */
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->mode_regex,
-            enable ? (MMPortSerialAtUnsolicitedMsgFn)huawei_mode_changed : NULL,
-            enable ? self : NULL,
-            NULL);
-
-        /* Connection status related */
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->dsflowrpt_regex,
-            enable ? (MMPortSerialAtUnsolicitedMsgFn)huawei_status_changed : NULL,
-            enable ? self : NULL,
-            NULL);
-
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->ndisstat_regex,
-            enable ? (MMPortSerialAtUnsolicitedMsgFn)huawei_ndisstat_changed : NULL,
-            enable ? self : NULL,
-            NULL);
-
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->hcsq_regex,
-            enable ? (MMPortSerialAtUnsolicitedMsgFn)huawei_hcsq_changed : NULL,
-            enable ? self : NULL,
-            NULL);
-    }
-
-    g_list_free_full (ports, g_object_unref);
+    /* Ignored unless extended signal indications were requested */
+    mm_iface_modem_signal_update (MM_IFACE_MODEM_SIGNAL (self),
+                                  NULL,
+                                  NULL,
+                                  self->priv->detailed_signal.gsm,
+                                  self->priv->detailed_signal.umts,
+                                  self->priv->detailed_signal.lte,
+                                  NULL);
 }
 
 static gboolean
@@ -1910,7 +1878,7 @@ parent_3gpp_setup_unsolicited_events_ready (MMIfaceModem3gpp *self,
         g_task_return_error (task, error);
     else {
         /* Our own setup now */
-        set_3gpp_unsolicited_events_handlers (MM_BROADBAND_MODEM_HUAWEI (self), TRUE);
+        set_urc_group_enabled (MM_BROADBAND_MODEM_HUAWEI (self), URC_GROUP_3GPP, TRUE);
         g_task_return_boolean (task, TRUE);
     }
     g_object_unref (task);
@@ -1956,7 +1924,7 @@ modem_3gpp_cleanup_unsolicited_events (MMIfaceModem3gpp *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     /* Our own cleanup first */
-    set_3gpp_unsolicited_events_handlers (MM_BROADBAND_MODEM_HUAWEI (self), FALSE);
+    set_urc_group_enabled (MM_BROADBAND_MODEM_HUAWEI (self), URC_GROUP_3GPP, FALSE);
 
     /* And now chain up parent's cleanup */
     iface_modem_3gpp_parent->cleanup_unsolicited_events (
@@ -2351,13 +2319,13 @@ decode (MMIfaceModem3gppUssd *self,
 /*****************************************************************************/
 
 static void
-huawei_1x_signal_changed (MMPortSerialAt *port,
-                          GMatchInfo *match_info,
-                          MMBroadbandModemHuawei *self)
+huawei_1x_signal_changed (MMBroadbandModemHuawei *self,
+                          const gchar            *args,
+                          gsize                   args_len)
 {
     guint quality = 0;
 
-    if (!mm_get_uint_from_match_info (match_info, 1, &quality))
+    if (!mm_huawei_parse_urc_uints (args, args_len, 10, &quality, 1))
         return;
 
     quality = MM_CLAMP_HIGH (quality, 100);
@@ -2366,13 +2334,13 @@ huawei_1x_signal_changed (MMPortSerialAt *port,
 }
 
 static void
-huawei_evdo_signal_changed (MMPortSerialAt *port,
-                            GMatchInfo *match_info,
-                            MMBroadbandModemHuawei *self)
+huawei_evdo_signal_changed (MMBroadbandModemHuawei *self,
+                            const gchar            *args,
+                            gsize                   args_len)
 {
     guint quality = 0;
 
-    if (!mm_get_uint_from_match_info (match_info, 1, &quality))
+    if (!mm_huawei_parse_urc_uints (args, args_len, 10, &quality, 1))
         return;
 
     quality = MM_CLAMP_HIGH (quality, 100);
@@ -2501,43 +2469,6 @@ modem_load_signal_quality (MMIfaceModem *self,
 /*****************************************************************************/
 /* Setup/Cleanup unsolicited events (CDMA interface) */
 
-static void
-set_cdma_unsolicited_events_handlers (MMBroadbandModemHuawei *self,
-                                      gboolean enable)
-{
-    GList *ports, *l;
-
-    ports = mm_broadband_modem_huawei_get_at_port_list (self);
-
-    /* Enable/disable unsolicited events in given port */
-    for (l = ports; l; l = g_list_next (l)) {
-        MMPortSerialAt *port = MM_PORT_SERIAL_AT (l->data);
-
-        /* Signal quality related */
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->rssilvl_regex,
-            enable ? (MMPortSerialAtUnsolicitedMsgFn)huawei_1x_signal_changed : NULL,
-            enable ? self : NULL,
-            NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->hrssilvl_regex,
-            enable ? (MMPortSerialAtUnsolicitedMsgFn)huawei_evdo_signal_changed : NULL,
-            enable ? self : NULL,
-            NULL);
-        /* Access technology related */
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->mode_regex,
-            enable ? (MMPortSerialAtUnsolicitedMsgFn)huawei_mode_changed : NULL,
-            enable ? self : NULL,
-            NULL);
-    }
-
-    g_list_free_full (ports, g_object_unref);
-}
-
 static gboolean
 modem_cdma_setup_cleanup_unsolicited_events_finish (MMIfaceModemCdma *self,
                                                     GAsyncResult *res,
@@ -2557,7 +2488,7 @@ parent_cdma_setup_unsolicited_events_ready (MMIfaceModemCdma *self,
         g_task_return_error (task, error);
     else {
         /* Our own setup now */
-        set_cdma_unsolicited_events_handlers (MM_BROADBAND_MODEM_HUAWEI (self), TRUE);
+        set_urc_group_enabled (MM_BROADBAND_MODEM_HUAWEI (self), URC_GROUP_CDMA, TRUE);
         g_task_return_boolean (task, TRUE);
     }
     g_object_unref (task);
@@ -2583,7 +2514,7 @@ modem_cdma_setup_unsolicited_events (MMIfaceModemCdma *self,
     }
 
     /* Otherwise just run our setup and complete */
-    set_cdma_unsolicited_events_handlers (MM_BROADBAND_MODEM_HUAWEI (self), TRUE);
+    set_urc_group_enabled (MM_BROADBAND_MODEM_HUAWEI (self), URC_GROUP_CDMA, TRUE);
     g_task_return_boolean (task, TRUE);
     g_object_unref (task);
 }
@@ -2612,7 +2543,7 @@ modem_cdma_cleanup_unsolicited_events (MMIfaceModemCdma *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     /* Our own cleanup first */
-    set_cdma_unsolicited_events_handlers (MM_BROADBAND_MODEM_HUAWEI (self), FALSE);
+    set_urc_group_enabled (MM_BROADBAND_MODEM_HUAWEI (self), URC_GROUP_CDMA, FALSE);
 
     /* Chain up parent's setup if needed */
     if (iface_modem_cdma_parent->cleanup_unsolicited_events &&
@@ -3069,27 +3000,25 @@ typedef enum {
 } HuaweiCallType;
 
 static void
-orig_received (MMPortSerialAt         *port,
-               GMatchInfo             *match_info,
-               MMBroadbandModemHuawei *self)
+orig_received (MMBroadbandModemHuawei *self,
+               const gchar            *args,
+               gsize                   args_len)
 {
     MMCallInfo call_info = { 0 };
-    guint      aux       = 0;
+    guint      values[2] = { 0, 0 };
+    guint      n_values;
 
-    if (!mm_get_uint_from_match_info (match_info, 2, &aux)) {
+    n_values = mm_huawei_parse_urc_uints (args, args_len, 10, values, G_N_ELEMENTS (values));
+    if (n_values < 2) {
         mm_obj_warn (self, "couldn't parse call type from ^ORIG");
         return;
     }
-    if (aux != HUAWEI_CALL_TYPE_VOICE && aux != HUAWEI_CALL_TYPE_EMERGENCY) {
+    if (values[1] != HUAWEI_CALL_TYPE_VOICE && values[1] != HUAWEI_CALL_TYPE_EMERGENCY) {
         mm_obj_dbg (self, "ignored ^ORIG for non-voice call");
         return;
     }
 
-    if (!mm_get_uint_from_match_info (match_info, 1, &aux)) {
-        mm_obj_warn (self, "couldn't parse call index from ^ORIG");
-        return;
-    }
-    call_info.index     = aux;
+    call_info.index     = values[0];
     call_info.state     = MM_CALL_STATE_DIALING;
     call_info.direction = MM_CALL_DIRECTION_OUTGOING;
 
@@ -3099,14 +3028,14 @@ orig_received (MMPortSerialAt         *port,
 }
 
 static void
-conf_received (MMPortSerialAt         *port,
-               GMatchInfo             *match_info,
-               MMBroadbandModemHuawei *self)
+conf_received (MMBroadbandModemHuawei *self,
+               const gchar            *args,
+               gsize                   args_len)
 {
     MMCallInfo call_info = { 0 };
     guint      aux       = 0;
 
-    if (!mm_get_uint_from_match_info (match_info, 1, &aux)) {
+    if (!mm_huawei_parse_urc_uints (args, args_len, 10, &aux, 1)) {
         mm_obj_warn (self, "couldn't parse call index from ^CONF");
         return;
     }
@@ -3120,14 +3049,14 @@ conf_received (MMPortSerialAt         *port,
 }
 
 static void
-conn_received (MMPortSerialAt         *port,
-               GMatchInfo             *match_info,
-               MMBroadbandModemHuawei *self)
+conn_received (MMBroadbandModemHuawei *self,
+               const gchar            *args,
+               gsize                   args_len)
 {
     MMCallInfo call_info = { 0 };
     guint      aux       = 0;
 
-    if (!mm_get_uint_from_match_info (match_info, 1, &aux)) {
+    if (!mm_huawei_parse_urc_uints (args, args_len, 10, &aux, 1)) {
         mm_obj_warn (self, "couldn't parse call index from ^CONN");
         return;
     }
@@ -3141,87 +3070,120 @@ conn_received (MMPortSerialAt         *port,
 }
 
 static void
-cend_received (MMPortSerialAt         *port,
-               GMatchInfo             *match_info,
-               MMBroadbandModemHuawei *self)
+cend_received (MMBroadbandModemHuawei *self,
+               const gchar            *args,
+               gsize                   args_len)
 {
     MMCallInfo call_info  = { 0 };
-    guint      aux        = 0;
+    guint      values[4]  = { 0, 0, 0, 0 };
+    guint      n_values;
 
     /* only index is mandatory */
-    if (!mm_get_uint_from_match_info (match_info, 1, &aux)) {
+    n_values = mm_huawei_parse_urc_uints (args, args_len, 10, values, G_N_ELEMENTS (values));
+    if (n_values < 1) {
         mm_obj_warn (self, "couldn't parse call index from ^CEND");
         return;
     }
-    call_info.index = aux;
+    call_info.index = values[0];
     call_info.state = MM_CALL_STATE_TERMINATED;
     call_info.direction = MM_CALL_DIRECTION_UNKNOWN;
 
     mm_obj_dbg (self, "call %u state updated: terminated", call_info.index);
-    if (mm_get_uint_from_match_info (match_info, 2, &aux))
-        mm_obj_dbg (self, "  call duration: %u seconds", aux);
-    if (mm_get_uint_from_match_info (match_info, 3, &aux))
-        mm_obj_dbg (self, "  end status code: %u", aux);
-    if (mm_get_uint_from_match_info (match_info, 4, &aux))
-        mm_obj_dbg (self, "  call control cause: %u", aux);
+    if (n_values > 1)
+        mm_obj_dbg (self, "  call duration: %u seconds", values[1]);
+    if (n_values > 2)
+        mm_obj_dbg (self, "  end status code: %u", values[2]);
+    if (n_values > 3)
+        mm_obj_dbg (self, "  call control cause: %u", values[3]);
 
     mm_iface_modem_voice_report_call (MM_IFACE_MODEM_VOICE (self), &call_info);
 }
 
+typedef enum {
+    HUAWEI_CALL_STATE_ORIGINATED = 0,
+    HUAWEI_CALL_STATE_PROCEEDING = 1,
+    HUAWEI_CALL_STATE_ALERTING   = 2,
+    HUAWEI_CALL_STATE_CONNECTED  = 3,
+    HUAWEI_CALL_STATE_RELEASED   = 4,
+    HUAWEI_CALL_STATE_INCOMING   = 5,
+    HUAWEI_CALL_STATE_WAITING    = 6,
+    HUAWEI_CALL_STATE_HELD       = 7,
+    HUAWEI_CALL_STATE_RETRIEVED  = 8,
+} HuaweiCallState;
+
 static void
-ddtmf_received (MMPortSerialAt         *port,
-                GMatchInfo             *match_info,
-                MMBroadbandModemHuawei *self)
+ccallstate_received (MMBroadbandModemHuawei *self,
+                     const gchar            *args,
+                     gsize                   args_len)
 {
-    gchar *dtmf;
+    MMCallInfo call_info = { 0 };
+    guint      values[3] = { 0, 0, 0 };
 
-    dtmf = g_match_info_fetch (match_info, 1);
-    mm_obj_dbg (self, "received DTMF: %s", dtmf);
-    /* call index unknown */
-    mm_iface_modem_voice_received_dtmf (MM_IFACE_MODEM_VOICE (self), 0, dtmf);
-    g_free (dtmf);
+    /* ^CCALLSTATE: <call_id>,<call_state>[,<voice_type>] */
+    if (mm_huawei_parse_urc_uints (args, args_len, 10, values, G_N_ELEMENTS (values)) < 2) {
+        mm_obj_warn (self, "couldn't parse call index and state from ^CCALLSTATE");
+        return;
+    }
+
+    call_info.index     = values[0];
+    call_info.direction = MM_CALL_DIRECTION_UNKNOWN;
+
+    switch (values[1]) {
+    case HUAWEI_CALL_STATE_ORIGINATED:
+    case HUAWEI_CALL_STATE_PROCEEDING:
+        call_info.state     = MM_CALL_STATE_DIALING;
+        call_info.direction = MM_CALL_DIRECTION_OUTGOING;
+        break;
+    case HUAWEI_CALL_STATE_ALERTING:
+        call_info.state     = MM_CALL_STATE_RINGING_OUT;
+        call_info.direction = MM_CALL_DIRECTION_OUTGOING;
+        break;
+    case HUAWEI_CALL_STATE_CONNECTED:
+    case HUAWEI_CALL_STATE_RETRIEVED:
+        call_info.state = MM_CALL_STATE_ACTIVE;
+        break;
+    case HUAWEI_CALL_STATE_RELEASED:
+        call_info.state = MM_CALL_STATE_TERMINATED;
+        break;
+    case HUAWEI_CALL_STATE_INCOMING:
+        call_info.state     = MM_CALL_STATE_RINGING_IN;
+        call_info.direction = MM_CALL_DIRECTION_INCOMING;
+        break;
+    case HUAWEI_CALL_STATE_WAITING:
+        call_info.state     = MM_CALL_STATE_WAITING;
+        call_info.direction = MM_CALL_DIRECTION_INCOMING;
+        break;
+    case HUAWEI_CALL_STATE_HELD:
+        call_info.state = MM_CALL_STATE_HELD;
+        break;
+    default:
+        mm_obj_dbg (self, "ignored ^CCALLSTATE with unknown call state: %u", values[1]);
+        return;
+    }
+
+    mm_obj_dbg (self, "call %u state updated: %s",
+                call_info.index, mm_call_state_get_string (call_info.state));
+
+    mm_iface_modem_voice_report_call (MM_IFACE_MODEM_VOICE (self), &call_info);
 }
 
 static void
-common_voice_setup_cleanup_unsolicited_events (MMBroadbandModemHuawei *self,
-                                               gboolean                enable)
-{
-    MMPortSerialAt *ports[2];
-    guint           i;
-
-    ports[0] = mm_base_modem_peek_port_primary   (MM_BASE_MODEM (self));
-    ports[1] = mm_base_modem_peek_port_secondary (MM_BASE_MODEM (self));
-
-    for (i = 0; i < G_N_ELEMENTS (ports); i++) {
-        if (!ports[i])
-            continue;
-
-        mm_port_serial_at_add_unsolicited_msg_handler (ports[i],
-                                                       self->priv->orig_regex,
-                                                       enable ? (MMPortSerialAtUnsolicitedMsgFn)orig_received : NULL,
-                                                       enable ? self : NULL,
-                                                       NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (ports[i],
-                                                       self->priv->conf_regex,
-                                                       enable ? (MMPortSerialAtUnsolicitedMsgFn)conf_received : NULL,
-                                                       enable ? self : NULL,
-                                                       NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (ports[i],
-                                                       self->priv->conn_regex,
-                                                       enable ? (MMPortSerialAtUnsolicitedMsgFn)conn_received : NULL,
-                                                       enable ? self : NULL,
-                                                       NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (ports[i],
-                                                       self->priv->cend_regex,
-                                                       enable ? (MMPortSerialAtUnsolicitedMsgFn)cend_received : NULL,
-                                                       enable ? self : NULL,
-                                                       NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (ports[i],
-                                                       self->priv->ddtmf_regex,
-                                                       enable ? (MMPortSerialAtUnsolicitedMsgFn)ddtmf_received : NULL,
-                                                       enable ? self : NULL,
-                                                       NULL);
+ddtmf_received (MMBroadbandModemHuawei *self,
+                const gchar            *args,
+                gsize                   args_len)
+{
+    gchar dtmf[2];
+
+    if (args_len != 1 || !args[0] || !strchr ("0123456789ABCD*#", args[0])) {
+        mm_obj_warn (self, "couldn't parse DTMF from ^DDTMF");
+        return;
     }
+
+    dtmf[0] = args[0];
+    dtmf[1] = '\0';
+    mm_obj_dbg (self, "received DTMF: %s", dtmf);
+    /* call index unknown */
+    mm_iface_modem_voice_received_dtmf (MM_IFACE_MODEM_VOICE (self), 0, dtmf);
 }
 
 /*****************************************************************************/
@@ -3249,7 +3211,7 @@ parent_voice_setup_unsolicited_events_ready (MMIfaceModemVoice *self,
     }
 
     /* Our own setup now */
-    common_voice_setup_cleanup_unsolicited_events (MM_BROADBAND_MODEM_HUAWEI (self), TRUE);
+    set_urc_group_enabled (MM_BROADBAND_MODEM_HUAWEI (self), URC_GROUP_VOICE, TRUE);
 
     g_task_return_boolean (task, TRUE);
     g_object_unref (task);
@@ -3306,7 +3268,7 @@ modem_voice_cleanup_unsolicited_events (MMIfaceModemVoice   *self,
     task = g_task_new (self, NULL, callback, user_data);
 
     /* cleanup our own */
-    common_voice_setup_cleanup_unsolicited_events (MM_BROADBAND_MODEM_HUAWEI (self), FALSE);
+    set_urc_group_enabled (MM_BROADBAND_MODEM_HUAWEI (self), URC_GROUP_VOICE, FALSE);
 
     /* Chain up parent's cleanup */
     iface_modem_voice_parent->cleanup_unsolicited_events (
@@ -4284,96 +4246,118 @@ signal_load_values (MMIfaceModemSignal *_self,
                               task);
 }
 
+/*****************************************************************************/
+/* Setup extended signal indications (Signal interface) */
+
+static gboolean
+signal_setup_indications_finish (MMIfaceModemSignal *self,
+                                 GAsyncResult *res,
+                                 GError **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+signal_setup_indications (MMIfaceModemSignal *self,
+                          guint rate_ms,
+                          GAsyncReadyCallback callback,
+                          gpointer user_data)
+{
+    GTask *task;
+
+    /* ^HCSQ URCs are sent by the modem on every signal change, and they're
+     * already processed as part of the 3GPP unsolicited events; nothing else
+     * to configure in the modem. */
+    task = g_task_new (self, NULL, callback, user_data);
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
 /*****************************************************************************/
 /* Setup ports (Broadband modem class) */
 
+typedef void (* UrcHandler) (MMBroadbandModemHuawei *self,
+                             const gchar            *args,
+                             gsize                   args_len);
+
+typedef struct {
+    UrcGroup   groups;
+    UrcHandler handler;
+} UrcHandlerInfo;
+
+/* URCs without handler are always ignored */
+static const UrcHandlerInfo urc_handlers[MM_HUAWEI_URC_LAST + 1] = {
+    [MM_HUAWEI_URC_RSSI]       = { URC_GROUP_3GPP,                  huawei_signal_changed      },
+    [MM_HUAWEI_URC_RSSILVL]    = { URC_GROUP_CDMA,                  huawei_1x_signal_changed   },
+    [MM_HUAWEI_URC_HRSSILVL]   = { URC_GROUP_CDMA,                  huawei_evdo_signal_changed },
+    [MM_HUAWEI_URC_MODE]       = { URC_GROUP_3GPP | URC_GROUP_CDMA, huawei_mode_changed        },
+    [MM_HUAWEI_URC_DSFLOWRPT]  = { URC_GROUP_3GPP,                  huawei_status_changed      },
+    [MM_HUAWEI_URC_NDISSTAT]   = { URC_GROUP_3GPP,                  huawei_ndisstat_changed    },
+    [MM_HUAWEI_URC_HCSQ]       = { URC_GROUP_3GPP,                  huawei_hcsq_changed        },
+    [MM_HUAWEI_URC_ORIG]       = { URC_GROUP_VOICE,                 orig_received              },
+    [MM_HUAWEI_URC_CONF]       = { URC_GROUP_VOICE,                 conf_received              },
+    [MM_HUAWEI_URC_CONN]       = { URC_GROUP_VOICE,                 conn_received              },
+    [MM_HUAWEI_URC_CEND]       = { URC_GROUP_VOICE,                 cend_received              },
+    [MM_HUAWEI_URC_DDTMF]      = { URC_GROUP_VOICE,                 ddtmf_received             },
+    [MM_HUAWEI_URC_CCALLSTATE] = { URC_GROUP_VOICE,                 ccallstate_received        },
+};
+
 static void
-set_ignored_unsolicited_events_handlers (MMBroadbandModemHuawei *self)
+huawei_urc_received (MMPortSerialAt         *port,
+                     GMatchInfo             *match_info,
+                     MMBroadbandModemHuawei *self)
+{
+    const gchar *str;
+    MMHuaweiUrc  urc;
+    gint         tag_start;
+    gint         tag_end;
+    gint         args_start;
+    gint         args_end;
+
+    if (!g_match_info_fetch_pos (match_info, 1, &tag_start, &tag_end) ||
+        !g_match_info_fetch_pos (match_info, 2, &args_start, &args_end))
+        return;
+
+    /* Positions refer to the port buffer; the handlers get the arguments
+     * in place, without copying them */
+    str = g_match_info_get_string (match_info);
+    urc = mm_huawei_urc_from_tag (&str[tag_start], tag_end - tag_start);
+
+    if (!urc_handlers[urc].handler || !(urc_handlers[urc].groups & self->priv->urc_groups_enabled))
+        return;
+
+    urc_handlers[urc].handler (self, &str[args_start], args_end - args_start);
+}
+
+static void
+set_unsolicited_events_handlers (MMBroadbandModemHuawei *self)
 {
     GList *ports, *l;
 
     ports = mm_broadband_modem_huawei_get_at_port_list (self);
 
-    /* Enable/disable unsolicited events in given port */
+    /* All known "^TAG:" URCs are matched by a single regex and dispatched
+     * by tag; processing of each of them depends on which groups are
+     * enabled at any given time. */
     for (l = ports; l; l = g_list_next (l)) {
         MMPortSerialAt *port = MM_PORT_SERIAL_AT (l->data);
 
         mm_port_serial_at_add_unsolicited_msg_handler (
             port,
-            self->priv->boot_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->connect_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->csnr_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->cusatp_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->cusatend_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->dsdormant_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->simst_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->srvst_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->stin_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->pdpdeact_regex,
-            NULL, NULL, NULL);
+            self->priv->urc_regex,
+            (MMPortSerialAtUnsolicitedMsgFn)huawei_urc_received,
+            self,
+            NULL);
         mm_port_serial_at_add_unsolicited_msg_handler (
             port,
-            self->priv->ndisend_regex,
+            self->priv->ignored_regex,
             NULL, NULL, NULL);
+        /* ^RFSWITCH is also the reply to ^RFSWITCH?, so it has its own
+         * regex to be able to disable it while that command runs */
         mm_port_serial_at_add_unsolicited_msg_handler (
             port,
             self->priv->rfswitch_regex,
             NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->position_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->posend_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->ecclist_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->ltersrp_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->cschannelinfo_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->ccallstate_regex,
-            NULL, NULL, NULL);
-        mm_port_serial_at_add_unsolicited_msg_handler (
-            port,
-            self->priv->eons_regex,
-            NULL, NULL, NULL);
     }
 
     g_list_free_full (ports, g_object_unref);
@@ -4395,12 +4379,8 @@ setup_ports (MMBroadbandModem *self)
     /* Call parent's setup ports first always */
     MM_BROADBAND_MODEM_CLASS (mm_broadband_modem_huawei_parent_class)->setup_ports (self);
 
-    /* Unsolicited messages to always ignore */
-    set_ignored_unsolicited_events_handlers (MM_BROADBAND_MODEM_HUAWEI (self));
-
-    /* Now reset the unsolicited messages we'll handle when enabled */
-    set_3gpp_unsolicited_events_handlers (MM_BROADBAND_MODEM_HUAWEI (self), FALSE);
-    set_cdma_unsolicited_events_handlers (MM_BROADBAND_MODEM_HUAWEI (self), FALSE);
+    /* Unsolicited messages are ignored until processing is enabled */
+    set_unsolicited_events_handlers (MM_BROADBAND_MODEM_HUAWEI (self));
 
     /* NMEA GPS monitoring */
     gps_data_port = mm_base_modem_peek_port_gps (MM_BASE_MODEM (self));
@@ -4446,74 +4426,11 @@ mm_broadband_modem_huawei_init (MMBroadbandModemHuawei *self)
                                               MM_TYPE_BROADBAND_MODEM_HUAWEI,
                                               MMBroadbandModemHuaweiPrivate);
     /* Prepare regular expressions to setup */
-    self->priv->rssi_regex = g_regex_new ("\\r\\n\\^RSSI:\\s*(\\d+)\\r\\n",
-                                           G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->rssilvl_regex = g_regex_new ("\\r\\n\\^RSSILVL:\\s*(\\d+)\\r+\\n",
-                                             G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->hrssilvl_regex = g_regex_new ("\\r\\n\\^HRSSILVL:\\s*(\\d+)\\r+\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-
-    /* 3GPP: <cr><lf>^MODE:5<cr><lf>
-     * CDMA: <cr><lf>^MODE: 2<cr><cr><lf>
-     */
-    self->priv->mode_regex = g_regex_new ("\\r\\n\\^MODE:\\s*(\\d*),?(\\d*)\\r+\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->dsflowrpt_regex = g_regex_new ("\\r\\n\\^DSFLOWRPT:(.+)\\r\\n",
-                                               G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ndisstat_regex = g_regex_new ("\\r\\n(\\^NDISSTAT:.+)\\r+\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-
-    self->priv->orig_regex = g_regex_new ("\\r\\n\\^ORIG:\\s*(\\d+),\\s*(\\d+)\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->conf_regex = g_regex_new ("\\r\\n\\^CONF:\\s*(\\d+)\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->conn_regex = g_regex_new ("\\r\\n\\^CONN:\\s*(\\d+),\\s*(\\d+)\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->cend_regex = g_regex_new ("\\r\\n\\^CEND:\\s*(\\d+),\\s*(\\d+),\\s*(\\d+)(?:,\\s*(\\d*))?\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ddtmf_regex = g_regex_new ("\\r\\n\\^DDTMF:\\s*([0-9A-D\\*\\#])\\r\\n",
-                                           G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-
-    self->priv->boot_regex = g_regex_new ("\\r\\n\\^BOOT:.+\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->connect_regex = g_regex_new ("\\r\\n\\^CONNECT .+\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->csnr_regex = g_regex_new ("\\r\\n\\^CSNR:.+\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->cusatp_regex = g_regex_new ("\\r\\n\\+CUSATP:.+\\r\\n",
-                                            G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->cusatend_regex = g_regex_new ("\\r\\n\\+CUSATEND\\r\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->dsdormant_regex = g_regex_new ("\\r\\n\\^DSDORMANT:.+\\r\\n",
-                                               G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->simst_regex = g_regex_new ("\\r\\n\\^SIMST:.+\\r\\n",
-                                           G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->srvst_regex = g_regex_new ("\\r\\n\\^SRVST:.+\\r\\n",
-                                           G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->stin_regex = g_regex_new ("\\r\\n\\^STIN:.+\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->hcsq_regex = g_regex_new ("\\r\\n(\\^HCSQ:.+)\\r+\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->pdpdeact_regex = g_regex_new ("\\r\\n\\^PDPDEACT:.+\\r+\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ndisend_regex = g_regex_new ("\\r\\n\\^NDISEND:.+\\r+\\n",
+    self->priv->urc_regex = mm_huawei_urc_regex_new ();
+    self->priv->ignored_regex = g_regex_new ("\\r\\n(?:\\^CONNECT .+|\\+CUSATP:.+|\\+CUSATEND)\\r\\n",
                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
     self->priv->rfswitch_regex = g_regex_new ("\\r\\n\\^RFSWITCH:.+\\r\\n",
                                               G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->position_regex = g_regex_new ("\\r\\n\\^POSITION:.+\\r\\n",
-                                              G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->posend_regex = g_regex_new ("\\r\\n\\^POSEND:.+\\r\\n",
-                                            G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ecclist_regex = g_regex_new ("\\r\\n\\^ECCLIST:.+\\r\\n",
-                                             G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ltersrp_regex = g_regex_new ("\\r\\n\\^LTERSRP:.+\\r\\n",
-                                             G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->cschannelinfo_regex = g_regex_new ("\\r\\n\\^CSCHANNELINFO:.+\\r\\n",
-                                                    G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->ccallstate_regex = g_regex_new ("\\r\\n\\^CCALLSTATE:.+\\r\\n",
-                                                G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
-    self->priv->eons_regex = g_regex_new ("\\r\\n\\^EONS:.+\\r\\n",
-                                          G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
 
     self->priv->ndisdup_support = FEATURE_SUPPORT_UNKNOWN;
     self->priv->rfswitch_support = FEATURE_SUPPORT_UNKNOWN;
@@ -4541,38 +4458,9 @@ finalize (GObject *object)
 {
     MMBroadbandModemHuawei *self = MM_BROADBAND_MODEM_HUAWEI (object);
 
-    g_regex_unref (self->priv->rssi_regex);
-    g_regex_unref (self->priv->rssilvl_regex);
-    g_regex_unref (self->priv->hrssilvl_regex);
-    g_regex_unref (self->priv->mode_regex);
-    g_regex_unref (self->priv->dsflowrpt_regex);
-    g_regex_unref (self->priv->ndisstat_regex);
-    g_regex_unref (self->priv->orig_regex);
-    g_regex_unref (self->priv->conf_regex);
-    g_regex_unref (self->priv->conn_regex);
-    g_regex_unref (self->priv->cend_regex);
-    g_regex_unref (self->priv->ddtmf_regex);
-
-    g_regex_unref (self->priv->boot_regex);
-    g_regex_unref (self->priv->connect_regex);
-    g_regex_unref (self->priv->csnr_regex);
-    g_regex_unref (self->priv->cusatp_regex);
-    g_regex_unref (self->priv->cusatend_regex);
-    g_regex_unref (self->priv->dsdormant_regex);
-    g_regex_unref (self->priv->simst_regex);
-    g_regex_unref (self->priv->srvst_regex);
-    g_regex_unref (self->priv->stin_regex);
-    g_regex_unref (self->priv->hcsq_regex);
-    g_regex_unref (self->priv->pdpdeact_regex);
-    g_regex_unref (self->priv->ndisend_regex);
+    g_regex_unref (self->priv->urc_regex);
+    g_regex_unref (self->priv->ignored_regex);
     g_regex_unref (self->priv->rfswitch_regex);
-    g_regex_unref (self->priv->position_regex);
-    g_regex_unref (self->priv->posend_regex);
-    g_regex_unref (self->priv->ecclist_regex);
-    g_regex_unref (self->priv->ltersrp_regex);
-    g_regex_unref (self->priv->cschannelinfo_regex);
-    g_regex_unref (self->priv->ccallstate_regex);
-    g_regex_unref (self->priv->eons_regex);
 
     if (self->priv->syscfg_supported_modes)
         g_array_unref (self->priv->syscfg_supported_modes);
@@ -4712,6 +4600,8 @@ iface_modem_signal_init (MMIfaceModemSignal *iface)
     iface->check_support_finish = signal_check_support_finish;
     iface->load_values = signal_load_values;
     iface->load_values_finish = signal_load_values_finish;
+    iface->setup_indications = signal_setup_indications;
+    iface->setup_indications_finish = signal_setup_indications_finish;
 }
 
 static void
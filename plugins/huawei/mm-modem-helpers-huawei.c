@@ -1561,3 +1561,182 @@ mm_huawei_parse_getportmode_response (const gchar  *response,
 
     return g_steal_pointer (&modes);
 }
+
+/*****************************************************************************/
+/* Unsolicited result codes */
+
+static const gchar *urc_tags[] = {
+    [MM_HUAWEI_URC_UNKNOWN]       = NULL,
+    [MM_HUAWEI_URC_RSSI]          = "RSSI",
+    [MM_HUAWEI_URC_RSSILVL]       = "RSSILVL",
+    [MM_HUAWEI_URC_HRSSILVL]      = "HRSSILVL",
+    [MM_HUAWEI_URC_MODE]          = "MODE",
+    [MM_HUAWEI_URC_DSFLOWRPT]     = "DSFLOWRPT",
+    [MM_HUAWEI_URC_NDISSTAT]      = "NDISSTAT",
+    [MM_HUAWEI_URC_HCSQ]          = "HCSQ",
+    [MM_HUAWEI_URC_ORIG]          = "ORIG",
+    [MM_HUAWEI_URC_CONF]          = "CONF",
+    [MM_HUAWEI_URC_CONN]          = "CONN",
+    [MM_HUAWEI_URC_CEND]          = "CEND",
+    [MM_HUAWEI_URC_DDTMF]         = "DDTMF",
+    [MM_HUAWEI_URC_CCALLSTATE]    = "CCALLSTATE",
+    [MM_HUAWEI_URC_BOOT]          = "BOOT",
+    [MM_HUAWEI_URC_CSNR]          = "CSNR",
+    [MM_HUAWEI_URC_DSDORMANT]     = "DSDORMANT",
+    [MM_HUAWEI_URC_SIMST]         = "SIMST",
+    [MM_HUAWEI_URC_SRVST]         = "SRVST",
+    [MM_HUAWEI_URC_STIN]          = "STIN",
+    [MM_HUAWEI_URC_PDPDEACT]      = "PDPDEACT",
+    [MM_HUAWEI_URC_NDISEND]       = "NDISEND",
+    [MM_HUAWEI_URC_POSITION]      = "POSITION",
+    [MM_HUAWEI_URC_POSEND]        = "POSEND",
+    [MM_HUAWEI_URC_ECCLIST]       = "ECCLIST",
+    [MM_HUAWEI_URC_LTERSRP]       = "LTERSRP",
+    [MM_HUAWEI_URC_CSCHANNELINFO] = "CSCHANNELINFO",
+    [MM_HUAWEI_URC_EONS]          = "EONS",
+};
+
+G_STATIC_ASSERT (G_N_ELEMENTS (urc_tags) == MM_HUAWEI_URC_LAST + 1);
+
+const gchar *
+mm_huawei_urc_get_tag (MMHuaweiUrc urc)
+{
+    g_return_val_if_fail (urc <= MM_HUAWEI_URC_LAST, NULL);
+
+    return urc_tags[urc];
+}
+
+GRegex *
+mm_huawei_urc_regex_new (void)
+{
+    GString *pattern;
+    GRegex  *regex;
+    guint    i;
+
+    /* e.g.: <cr><lf>^MODE:5,4<cr><lf>
+     *       <cr><lf>^MODE: 2<cr><cr><lf>
+     */
+    pattern = g_string_new ("\\r\\n\\^(");
+    for (i = MM_HUAWEI_URC_UNKNOWN + 1; i <= MM_HUAWEI_URC_LAST; i++) {
+        if (i > MM_HUAWEI_URC_UNKNOWN + 1)
+            g_string_append_c (pattern, '|');
+        g_string_append (pattern, urc_tags[i]);
+    }
+    g_string_append (pattern, "):[ ]*([^\\r\\n]*)\\r+\\n");
+
+    regex = g_regex_new (pattern->str, G_REGEX_RAW | G_REGEX_OPTIMIZE, 0, NULL);
+    g_assert (regex);
+    g_string_free (pattern, TRUE);
+    return regex;
+}
+
+MMHuaweiUrc
+mm_huawei_urc_from_tag (const gchar *tag,
+                        gsize        tag_len)
+{
+    guint i;
+
+    /* Allow the caret to be given or not */
+    if (tag_len > 0 && tag[0] == '^') {
+        tag++;
+        tag_len--;
+    }
+
+    for (i = MM_HUAWEI_URC_UNKNOWN + 1; i <= MM_HUAWEI_URC_LAST; i++) {
+        if (strlen (urc_tags[i]) == tag_len && memcmp (urc_tags[i], tag, tag_len) == 0)
+            return (MMHuaweiUrc) i;
+    }
+    return MM_HUAWEI_URC_UNKNOWN;
+}
+
+static gboolean
+parse_urc_uint64 (const gchar **str,
+                  const gchar  *end,
+                  guint         base,
+                  guint64      *out_value)
+{
+    const gchar *p;
+    guint64      value = 0;
+    gboolean     valid = FALSE;
+
+    p = *str;
+    while (p < end && *p == ' ')
+        p++;
+
+    for (; p < end; p++) {
+        gint digit;
+
+        digit = g_ascii_xdigit_value (*p);
+        if (digit < 0 || (guint) digit >= base)
+            break;
+        if (value > ((G_MAXUINT64 - digit) / base))
+            return FALSE;
+        value = (value * base) + digit;
+        valid = TRUE;
+    }
+
+    while (p < end && *p == ' ')
+        p++;
+
+    /* Fields must be followed by a separator or by the end of the string */
+    if (!valid || (p < end && *p != ','))
+        return FALSE;
+
+    *str = (p < end) ? (p + 1) : p;
+    *out_value = value;
+    return TRUE;
+}
+
+guint
+mm_huawei_parse_urc_uints (const gchar *str,
+                           gsize        str_len,
+                           guint        base,
+                           guint       *out_values,
+                           guint        n_values)
+{
+    const gchar *end;
+    guint        i;
+
+    g_assert (base == 10 || base == 16);
+
+    end = str + str_len;
+    for (i = 0; i < n_values; i++) {
+        guint64 value;
+
+        if (!parse_urc_uint64 (&str, end, base, &value) || value > G_MAXUINT)
+            break;
+        out_values[i] = (guint) value;
+    }
+    return i;
+}
+
+/*****************************************************************************/
+/* ^DSFLOWRPT unsolicited message parser */
+
+gboolean
+mm_huawei_parse_dsflowrpt (const gchar       *str,
+                           gsize              str_len,
+                           MMHuaweiDsflowrpt *out)
+{
+    const gchar *end;
+    guint64      values[5];
+    guint        i;
+
+    /* ^DSFLOWRPT: <curr_ds_time>,<tx_rate>,<rx_rate>,<curr_tx_flow>,<curr_rx_flow>,
+     *             <qos_tx_rate>,<qos_rx_rate>
+     * All fields given in hex; only the first five are needed */
+    end = str + str_len;
+    for (i = 0; i < G_N_ELEMENTS (values); i++) {
+        if (!parse_urc_uint64 (&str, end, 16, &values[i]))
+            return FALSE;
+    }
+    if (values[0] > G_MAXUINT || values[1] > G_MAXUINT || values[2] > G_MAXUINT)
+        return FALSE;
+
+    out->duration = (guint) values[0];
+    out->tx_rate  = (guint) values[1];
+    out->rx_rate  = (guint) values[2];
+    out->tx_bytes = values[3];
+    out->rx_bytes = values[4];
+    return TRUE;
+}
@@ -190,4 +190,77 @@ GArray *mm_huawei_parse_getportmode_response (const gchar  *response,
                                               gpointer      log_object,
                                               GError      **error);
 
+/*****************************************************************************/
+/* Unsolicited result codes */
+
+typedef enum { /*< underscore_name=mm_huawei_urc >*/
+    MM_HUAWEI_URC_UNKNOWN,
+    /* Processed */
+    MM_HUAWEI_URC_RSSI,
+    MM_HUAWEI_URC_RSSILVL,
+    MM_HUAWEI_URC_HRSSILVL,
+    MM_HUAWEI_URC_MODE,
+    MM_HUAWEI_URC_DSFLOWRPT,
+    MM_HUAWEI_URC_NDISSTAT,
+    MM_HUAWEI_URC_HCSQ,
+    MM_HUAWEI_URC_ORIG,
+    MM_HUAWEI_URC_CONF,
+    MM_HUAWEI_URC_CONN,
+    MM_HUAWEI_URC_CEND,
+    MM_HUAWEI_URC_DDTMF,
+    MM_HUAWEI_URC_CCALLSTATE,
+    /* Always ignored */
+    MM_HUAWEI_URC_BOOT,
+    MM_HUAWEI_URC_CSNR,
+    MM_HUAWEI_URC_DSDORMANT,
+    MM_HUAWEI_URC_SIMST,
+    MM_HUAWEI_URC_SRVST,
+    MM_HUAWEI_URC_STIN,
+    MM_HUAWEI_URC_PDPDEACT,
+    MM_HUAWEI_URC_NDISEND,
+    MM_HUAWEI_URC_POSITION,
+    MM_HUAWEI_URC_POSEND,
+    MM_HUAWEI_URC_ECCLIST,
+    MM_HUAWEI_URC_LTERSRP,
+    MM_HUAWEI_URC_CSCHANNELINFO,
+    MM_HUAWEI_URC_EONS,
+} MMHuaweiUrc;
+
+#define MM_HUAWEI_URC_LAST MM_HUAWEI_URC_EONS
+
+/* Returns the "^TAG" string of the URC, without the trailing colon */
+const gchar *mm_huawei_urc_get_tag (MMHuaweiUrc urc);
+
+/* Single regex matching all known "^TAG:" URCs; the tag is returned in
+ * match group 1 and the arguments in match group 2 */
+GRegex      *mm_huawei_urc_regex_new (void);
+
+/* Lookup of a URC by the tag in a (not necessarily NUL-terminated) string */
+MMHuaweiUrc  mm_huawei_urc_from_tag (const gchar *tag,
+                                     gsize        tag_len);
+
+/* Allocation-free parser of comma separated unsigned integer fields in a
+ * (not necessarily NUL-terminated) string. Parsing stops in the first empty
+ * or invalid field, and the number of fields read is returned. */
+guint        mm_huawei_parse_urc_uints (const gchar *str,
+                                        gsize        str_len,
+                                        guint        base,
+                                        guint       *out_values,
+                                        guint        n_values);
+
+/*****************************************************************************/
+/* ^DSFLOWRPT unsolicited message parser */
+
+typedef struct {
+    guint   duration;  /* seconds */
+    guint   tx_rate;   /* bytes/s */
+    guint   rx_rate;   /* bytes/s */
+    guint64 tx_bytes;
+    guint64 rx_bytes;
+} MMHuaweiDsflowrpt;
+
+gboolean mm_huawei_parse_dsflowrpt (const gchar        *str,
+                                    gsize               str_len,
+                                    MMHuaweiDsflowrpt  *out);
+
 #endif  /* MM_MODEM_HELPERS_HUAWEI_H */
@@ -16,6 +16,7 @@
 #include <glib.h>
 #include <glib-object.h>
 #include <locale.h>
+#include <string.h>
 #include <arpa/inet.h>
 
 #include <ModemManager.h>
@@ -1395,6 +1396,166 @@ test_getportmode (void)
     }
 }
 
+/*****************************************************************************/
+/* Test unsolicited result codes */
+
+static void
+test_urc_tags (void)
+{
+    guint i;
+
+    for (i = MM_HUAWEI_URC_UNKNOWN + 1; i <= MM_HUAWEI_URC_LAST; i++) {
+        const gchar *tag;
+
+        tag = mm_huawei_urc_get_tag ((MMHuaweiUrc) i);
+        g_assert (tag);
+        g_assert_cmpuint (mm_huawei_urc_from_tag (tag, strlen (tag)), ==, i);
+    }
+
+    /* Not NUL-terminated, and with caret */
+    g_assert_cmpuint (mm_huawei_urc_from_tag ("^RSSILVL:20", 8), ==, MM_HUAWEI_URC_RSSILVL);
+    g_assert_cmpuint (mm_huawei_urc_from_tag ("RSSILVL", 4), ==, MM_HUAWEI_URC_RSSI);
+    g_assert_cmpuint (mm_huawei_urc_from_tag ("RSSIL", 5), ==, MM_HUAWEI_URC_UNKNOWN);
+    g_assert_cmpuint (mm_huawei_urc_from_tag ("SYSINFOEX", 9), ==, MM_HUAWEI_URC_UNKNOWN);
+}
+
+typedef struct {
+    const gchar *str;
+    guint        base;
+    guint        n_values;
+    guint        values[4];
+} UrcUintsTest;
+
+static const UrcUintsTest urc_uints_tests[] = {
+    { "5",           10, 1, { 5 } },
+    { "5,4",         10, 2, { 5, 4 } },
+    { " 2",          10, 1, { 2 } },
+    { "1, 0",        10, 2, { 1, 0 } },
+    { "1,12,104,",   10, 3, { 1, 12, 104 } },
+    { "1,12,104,22", 10, 4, { 1, 12, 104, 22 } },
+    { "",            10, 0, { 0 } },
+    { ",4",          10, 0, { 0 } },
+    { "3,x",         10, 1, { 3 } },
+    { "3a",          10, 0, { 0 } },
+    { "3a,FF",       16, 2, { 0x3a, 0xff } },
+};
+
+static void
+test_urc_uints (void)
+{
+    guint partial[2];
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (urc_uints_tests); i++) {
+        guint values[4] = { 0 };
+        guint n_values;
+        guint j;
+
+        n_values = mm_huawei_parse_urc_uints (urc_uints_tests[i].str,
+                                              strlen (urc_uints_tests[i].str),
+                                              urc_uints_tests[i].base,
+                                              values,
+                                              G_N_ELEMENTS (values));
+        g_assert_cmpuint (n_values, ==, urc_uints_tests[i].n_values);
+        for (j = 0; j < n_values; j++)
+            g_assert_cmpuint (values[j], ==, urc_uints_tests[i].values[j]);
+    }
+
+    /* Only the given length is read */
+    g_assert_cmpuint (mm_huawei_parse_urc_uints ("12,34", 2, 10, partial, G_N_ELEMENTS (partial)), ==, 1);
+    g_assert_cmpuint (partial[0], ==, 12);
+}
+
+static void
+test_dsflowrpt (void)
+{
+    MMHuaweiDsflowrpt dsflowrpt;
+    const gchar       *str;
+
+    str = "0000240E,00000000,00000000,0000000000002D5D,0000000000010F33,0003E800,0003E800";
+    g_assert (mm_huawei_parse_dsflowrpt (str, strlen (str), &dsflowrpt));
+    g_assert_cmpuint (dsflowrpt.duration, ==, 0x240e);
+    g_assert_cmpuint (dsflowrpt.tx_rate, ==, 0);
+    g_assert_cmpuint (dsflowrpt.rx_rate, ==, 0);
+    g_assert_cmpuint (dsflowrpt.tx_bytes, ==, 0x2d5d);
+    g_assert_cmpuint (dsflowrpt.rx_bytes, ==, 0x10f33);
+
+    str = "00000012,00001F40,0000FA00,00000000000186A0,0000000100000000,0,0";
+    g_assert (mm_huawei_parse_dsflowrpt (str, strlen (str), &dsflowrpt));
+    g_assert_cmpuint (dsflowrpt.duration, ==, 18);
+    g_assert_cmpuint (dsflowrpt.tx_rate, ==, 8000);
+    g_assert_cmpuint (dsflowrpt.rx_rate, ==, 64000);
+    g_assert_cmpuint (dsflowrpt.tx_bytes, ==, 100000);
+    g_assert_cmpuint (dsflowrpt.rx_bytes, ==, G_GUINT64_CONSTANT (0x100000000));
+
+    str = "00000012,00001F40,0000FA00";
+    g_assert (!mm_huawei_parse_dsflowrpt (str, strlen (str), &dsflowrpt));
+    str = "00000012,00001F40,0000FA00,XYZ,0,0,0";
+    g_assert (!mm_huawei_parse_dsflowrpt (str, strlen (str), &dsflowrpt));
+}
+
+/* Chunk of a session recorded from an E3372 */
+static const gchar urc_session[] =
+    "\r\n^MODE:5,4\r\n"
+    "\r\n^RSSI:19\r\n"
+    "\r\n^SYSINFOEX:2,3,0,1,,3,\"WCDMA\",41,\"WCDMA\"\r\n"
+    "\r\nOK\r\n"
+    "\r\n^DSFLOWRPT:0000240E,00000000,00000000,0000000000002D5D,0000000000010F33,0003E800,0003E800\r\n"
+    "\r\n^HCSQ:\"LTE\",43,36,151,28\r\n"
+    "\r\n^MODE: 2\r\r\n"
+    "\r\n^NDISSTAT: 1,,,\"IPV4\"\r\n"
+    "\r\n^BOOT:25755152,0,0,0,75\r\n"
+    "\r\n^CEND:1,0,104,16\r\n"
+    "\r\n^DDTMF:5\r\n"
+    "\r\n^CCALLSTATE: 1,3,0\r\n"
+    "\r\n^RFSWITCH:1,1\r\n"
+    "\r\n^SRVST:2\r\n";
+
+static const struct {
+    MMHuaweiUrc  urc;
+    const gchar *args;
+} urc_session_expected[] = {
+    { MM_HUAWEI_URC_MODE,       "5,4" },
+    { MM_HUAWEI_URC_RSSI,       "19" },
+    { MM_HUAWEI_URC_DSFLOWRPT,  "0000240E,00000000,00000000,0000000000002D5D,0000000000010F33,0003E800,0003E800" },
+    { MM_HUAWEI_URC_HCSQ,       "\"LTE\",43,36,151,28" },
+    { MM_HUAWEI_URC_MODE,       "2" },
+    { MM_HUAWEI_URC_NDISSTAT,   "1,,,\"IPV4\"" },
+    { MM_HUAWEI_URC_BOOT,       "25755152,0,0,0,75" },
+    { MM_HUAWEI_URC_CEND,       "1,0,104,16" },
+    { MM_HUAWEI_URC_DDTMF,      "5" },
+    { MM_HUAWEI_URC_CCALLSTATE, "1,3,0" },
+    { MM_HUAWEI_URC_SRVST,      "2" },
+};
+
+static void
+test_urc_session (void)
+{
+    GRegex     *regex;
+    GMatchInfo *match_info = NULL;
+    guint       i = 0;
+
+    regex = mm_huawei_urc_regex_new ();
+    g_regex_match_full (regex, urc_session, strlen (urc_session), 0, 0, &match_info, NULL);
+    while (g_match_info_matches (match_info)) {
+        gint tag_start, tag_end, args_start, args_end;
+
+        g_assert_cmpuint (i, <, G_N_ELEMENTS (urc_session_expected));
+        g_assert (g_match_info_fetch_pos (match_info, 1, &tag_start, &tag_end));
+        g_assert (g_match_info_fetch_pos (match_info, 2, &args_start, &args_end));
+        g_assert_cmpuint (mm_huawei_urc_from_tag (&urc_session[tag_start], tag_end - tag_start), ==, urc_session_expected[i].urc);
+        g_assert_cmpuint (args_end - args_start, ==, strlen (urc_session_expected[i].args));
+        g_assert (memcmp (&urc_session[args_start], urc_session_expected[i].args, args_end - args_start) == 0);
+
+        i++;
+        g_match_info_next (match_info, NULL);
+    }
+    g_assert_cmpuint (i, ==, G_N_ELEMENTS (urc_session_expected));
+
+    g_match_info_free (match_info);
+    g_regex_unref (regex);
+}
+
 /*****************************************************************************/
 
 int main (int argc, char **argv)
@@ -1417,6 +1578,10 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/huawei/time", test_time);
     g_test_add_func ("/MM/huawei/hcsq", test_hcsq);
     g_test_add_func ("/MM/huawei/getportmode", test_getportmode);
+    g_test_add_func ("/MM/huawei/urc/tags", test_urc_tags);
+    g_test_add_func ("/MM/huawei/urc/uints", test_urc_uints);
+    g_test_add_func ("/MM/huawei/urc/session", test_urc_session);
+    g_test_add_func ("/MM/huawei/dsflowrpt", test_dsflowrpt);
 
     return g_test_run ();
 }
@@ -37,7 +37,7 @@
 
 /* Index of the array is the telit 2G band value [0-5]
  * The bitmask value here is built from the 2G MMModemBand values right away. */
-static const guint32 telit_2g_to_mm_band_mask[] = {
+static const guint64 telit_2g_to_mm_band_mask[] = {
     [0] = B2G_FLAG (MM_MODEM_BAND_EGSM) + B2G_FLAG (MM_MODEM_BAND_DCS),
     [1] = B2G_FLAG (MM_MODEM_BAND_EGSM) + B2G_FLAG (MM_MODEM_BAND_PCS),
     [2] = B2G_FLAG (MM_MODEM_BAND_DCS)  + B2G_FLAG (MM_MODEM_BAND_G850),
@@ -85,93 +85,108 @@ static const guint band_utran_index[] = {
 #define B3G_NUM(band) band_utran_index[band]
 #define B3G_FLAG(band) ((B3G_NUM (band) > 0) ? (1LL << (B3G_NUM (band) - B3G_NUM (MM_MODEM_BAND_TELIT_3G_FIRST))) : 0)
 
+/* Same bit as B3G_FLAG(), given the UTRAN band number instead of the
+ * MMModemBand, so that it can be used in constant initializers */
+#define U3G(num) (((guint64) 1) << ((num) - 1))
+
+/* Reverse of band_utran_index, used to convert 3G bitmasks back to MMModemBand
+ * values without iterating the whole band enumeration */
+static const MMModemBand utran_index_to_mm_band[] = {
+    [1]  = MM_MODEM_BAND_UTRAN_1,
+    [2]  = MM_MODEM_BAND_UTRAN_2,
+    [3]  = MM_MODEM_BAND_UTRAN_3,
+    [4]  = MM_MODEM_BAND_UTRAN_4,
+    [5]  = MM_MODEM_BAND_UTRAN_5,
+    [6]  = MM_MODEM_BAND_UTRAN_6,
+    [7]  = MM_MODEM_BAND_UTRAN_7,
+    [8]  = MM_MODEM_BAND_UTRAN_8,
+    [9]  = MM_MODEM_BAND_UTRAN_9,
+    [10] = MM_MODEM_BAND_UTRAN_10,
+    [11] = MM_MODEM_BAND_UTRAN_11,
+    [12] = MM_MODEM_BAND_UTRAN_12,
+    [13] = MM_MODEM_BAND_UTRAN_13,
+    [14] = MM_MODEM_BAND_UTRAN_14,
+    [19] = MM_MODEM_BAND_UTRAN_19,
+    [20] = MM_MODEM_BAND_UTRAN_20,
+    [21] = MM_MODEM_BAND_UTRAN_21,
+    [22] = MM_MODEM_BAND_UTRAN_22,
+    [25] = MM_MODEM_BAND_UTRAN_25,
+    [26] = MM_MODEM_BAND_UTRAN_26,
+    [32] = MM_MODEM_BAND_UTRAN_32,
+};
+
 /* Index of the arrays is the telit 3G band value.
- * The bitmask value here is built from the 3G MMModemBand values right away.
+ * The bitmask value here is built from the 3G UTRAN band numbers right away.
  *
  * We have 2 different sets of bands that are different for values >=12, because
  * the LM940/960 models support a different set of 3G bands.
  */
 
-#define TELIT_3G_TO_MM_BAND_MASK_DEFAULT_N_ELEMENTS 27
-static guint64 telit_3g_to_mm_band_mask_default[TELIT_3G_TO_MM_BAND_MASK_DEFAULT_N_ELEMENTS];
+static const guint64 telit_3g_to_mm_band_mask_default[] = {
+    [0]  = U3G (1),
+    [1]  = U3G (2),
+    [2]  = U3G (5),
+    [3]  = U3G (1) + U3G (2) + U3G (5),
+    [4]  = U3G (2) + U3G (5),
+    [5]  = U3G (8),
+    [6]  = U3G (1) + U3G (8),
+    [7]  = U3G (4),
+    [8]  = U3G (1) + U3G (5),
+    [9]  = U3G (1) + U3G (8) + U3G (5),
+    [10] = U3G (2) + U3G (4) + U3G (5),
+    [11] = U3G (1) + U3G (2) + U3G (4) + U3G (5) + U3G (8),
+    [12] = U3G (6),
+    [13] = U3G (3),
+    [14] = U3G (1) + U3G (2) + U3G (4) + U3G (5) + U3G (6),
+    [15] = U3G (1) + U3G (3) + U3G (8),
+    [16] = U3G (5) + U3G (8),
+    [17] = U3G (2) + U3G (4) + U3G (5) + U3G (6),
+    [18] = U3G (1) + U3G (5) + U3G (6) + U3G (8),
+    [19] = U3G (2) + U3G (6),
+    [20] = U3G (5) + U3G (6),
+    [21] = U3G (2) + U3G (5) + U3G (6),
+    [22] = U3G (1) + U3G (3) + U3G (5) + U3G (8),
+    [23] = U3G (1) + U3G (3),
+    [24] = U3G (1) + U3G (2) + U3G (4) + U3G (5),
+    [25] = U3G (19),
+    [26] = U3G (1) + U3G (5) + U3G (6) + U3G (8) + U3G (19),
+};
 
-#define TELIT_3G_TO_MM_BAND_MASK_ALTERNATE_N_ELEMENTS 20
-static guint64 telit_3g_to_mm_band_mask_alternate[TELIT_3G_TO_MM_BAND_MASK_ALTERNATE_N_ELEMENTS];
+static const guint64 telit_3g_to_mm_band_mask_alternate[] = {
+    [0]  = U3G (1),
+    [1]  = U3G (2),
+    [2]  = U3G (5),
+    [3]  = U3G (1) + U3G (2) + U3G (5),
+    [4]  = U3G (2) + U3G (5),
+    [5]  = U3G (8),
+    [6]  = U3G (1) + U3G (8),
+    [7]  = U3G (4),
+    [8]  = U3G (1) + U3G (5),
+    [9]  = U3G (1) + U3G (8) + U3G (5),
+    [10] = U3G (2) + U3G (4) + U3G (5),
+    [11] = U3G (1) + U3G (2) + U3G (4) + U3G (5) + U3G (8),
+    [12] = U3G (1) + U3G (3) + U3G (5) + U3G (8),
+    [13] = U3G (3),
+    [14] = U3G (1) + U3G (3) + U3G (5),
+    [15] = U3G (3) + U3G (5),
+    [16] = U3G (1) + U3G (2) + U3G (3) + U3G (4) + U3G (5) + U3G (8),
+    [17] = U3G (1) + U3G (2) + U3G (8),
+    [18] = U3G (1) + U3G (2) + U3G (4) + U3G (5) + U3G (8) + U3G (9) + U3G (19),
+    [19] = U3G (1) + U3G (2) + U3G (4) + U3G (5) + U3G (6) + U3G (8) + U3G (9) + U3G (19),
+};
 
 static void
-initialize_telit_3g_to_mm_band_masks (void)
+select_telit_3g_to_mm_band_mask (gboolean        modem_alternate_3g_bands,
+                                 const guint64 **mask,
+                                 guint          *n_elements)
 {
-    static gboolean initialized = FALSE;
-
-    /* We need to initialize the arrays in runtime because gcc < 8 doesn't like initializing
-     * with operations that are using the band_utran_index constant array elements */
-
-    if (initialized)
-        return;
-
-    telit_3g_to_mm_band_mask_default[0]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1);
-    telit_3g_to_mm_band_mask_default[1]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_2);
-    telit_3g_to_mm_band_mask_default[2]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_default[3]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_default[4]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_default[5]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_default[6]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_default[7]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_4);
-    telit_3g_to_mm_band_mask_default[8]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_default[9]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_default[10] = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_default[11] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
-                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_default[12] = B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
-    telit_3g_to_mm_band_mask_default[13] = B3G_FLAG (MM_MODEM_BAND_UTRAN_3);
-    telit_3g_to_mm_band_mask_default[14] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
-                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
-    telit_3g_to_mm_band_mask_default[15] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_default[16] = B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_default[17] = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) +
-                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
-    telit_3g_to_mm_band_mask_default[18] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6) +
-                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_default[19] = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
-    telit_3g_to_mm_band_mask_default[20] = B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
-    telit_3g_to_mm_band_mask_default[21] = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
-    telit_3g_to_mm_band_mask_default[22] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) +
-                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_default[23] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3);
-    telit_3g_to_mm_band_mask_default[24] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
-                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_default[25] = B3G_FLAG (MM_MODEM_BAND_UTRAN_19);
-    telit_3g_to_mm_band_mask_default[26] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6) +
-                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_8) + B3G_FLAG (MM_MODEM_BAND_UTRAN_19);
-
-    /* Initialize alternate 3G band set */
-    telit_3g_to_mm_band_mask_alternate[0]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1);
-    telit_3g_to_mm_band_mask_alternate[1]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_2);
-    telit_3g_to_mm_band_mask_alternate[2]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_alternate[3]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_alternate[4]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_alternate[5]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_alternate[6]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_alternate[7]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_4);
-    telit_3g_to_mm_band_mask_alternate[8]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_alternate[9]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_alternate[10] = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_alternate[11] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
-                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_alternate[12] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) +
-                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_alternate[13] = B3G_FLAG (MM_MODEM_BAND_UTRAN_3);
-    telit_3g_to_mm_band_mask_alternate[14] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_alternate[15] = B3G_FLAG (MM_MODEM_BAND_UTRAN_3) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
-    telit_3g_to_mm_band_mask_alternate[16] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3) +
-                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_4) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_alternate[17] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
-    telit_3g_to_mm_band_mask_alternate[18] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
-                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8) + B3G_FLAG (MM_MODEM_BAND_UTRAN_9) +
-                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_19);
-    telit_3g_to_mm_band_mask_alternate[19] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
-                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8) +
-                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_9) + B3G_FLAG (MM_MODEM_BAND_UTRAN_19);
+    if (modem_alternate_3g_bands) {
+        *mask = telit_3g_to_mm_band_mask_alternate;
+        *n_elements = G_N_ELEMENTS (telit_3g_to_mm_band_mask_alternate);
+    } else {
+        *mask = telit_3g_to_mm_band_mask_default;
+        *n_elements = G_N_ELEMENTS (telit_3g_to_mm_band_mask_default);
+    }
 }
 
 /*****************************************************************************/
@@ -208,16 +223,10 @@ mm_telit_build_bnd_request (GArray    *bands_array,
     const guint64 *telit_3g_to_mm_band_mask;
     guint          telit_3g_to_mm_band_mask_n_elements;
 
-    initialize_telit_3g_to_mm_band_masks ();
-
     /* Select correct 3G band mask */
-    if (modem_alternate_3g_bands) {
-        telit_3g_to_mm_band_mask = telit_3g_to_mm_band_mask_alternate;
-        telit_3g_to_mm_band_mask_n_elements = G_N_ELEMENTS (telit_3g_to_mm_band_mask_alternate);
-    } else {
-        telit_3g_to_mm_band_mask = telit_3g_to_mm_band_mask_default;
-        telit_3g_to_mm_band_mask_n_elements = G_N_ELEMENTS (telit_3g_to_mm_band_mask_default);
-    }
+    select_telit_3g_to_mm_band_mask (modem_alternate_3g_bands,
+                                     &telit_3g_to_mm_band_mask,
+                                     &telit_3g_to_mm_band_mask_n_elements);
 
     for (i = 0; i < bands_array->len; i++) {
         MMModemBand band;
@@ -373,170 +382,212 @@ mm_telit_build_bnd_request (GArray    *bands_array,
  *
  */
 
-static gboolean
-telit_get_2g_mm_bands (GMatchInfo  *match_info,
-                       gpointer     log_object,
-                       GArray     **bands,
-                       GError     **error)
-{
-    GError *inner_error = NULL;
-    GArray *values = NULL;
-    gchar  *match_str = NULL;
-    guint   i;
-
-    match_str = g_match_info_fetch_named (match_info, "Bands2G");
-    if (!match_str || match_str[0] == '\0') {
-        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                     "Could not find 2G band values from response");
-        goto out;
-    }
+typedef enum {
+    LOAD_BANDS_TYPE_SUPPORTED,
+    LOAD_BANDS_TYPE_CURRENT,
+} LoadBandsType;
 
-    values = mm_parse_uint_list (match_str, &inner_error);
-    if (!values)
-        goto out;
+/* Band values of a single access technology, pointing into the response */
+typedef struct {
+    const gchar *start;
+    const gchar *end;
+} BndGroup;
 
-    for (i = 0; i < values->len; i++) {
-        guint value;
+#define BND_PREFIX     "#BND:"
+#define BND_N_GROUPS   3
 
-        value = g_array_index (values, guint, i);
-        if (value < G_N_ELEMENTS (telit_2g_to_mm_band_mask)) {
-            guint j;
+/* Parses a decimal number taking the whole [str,end) span; the same inputs
+ * accepted by mm_get_u64_from_str() are accepted here */
+static gboolean
+bnd_parse_u64 (const gchar *str,
+               const gchar *end,
+               guint64     *out)
+{
+    guint64 num = 0;
 
-            for (j = MM_MODEM_BAND_TELIT_2G_FIRST; j <= MM_MODEM_BAND_TELIT_2G_LAST; j++) {
-                if ((telit_2g_to_mm_band_mask[value] & B2G_FLAG (j)) && !mm_common_bands_garray_lookup (*bands, j))
-                    *bands = g_array_append_val (*bands, j);
-            }
-        } else
-            mm_obj_dbg (log_object, "unhandled telit 2G band value configuration: %u", value);
-    }
+    if (str == end)
+        return FALSE;
 
-out:
-    g_free (match_str);
-    g_clear_pointer (&values, g_array_unref);
+    for (; str < end; str++) {
+        guint digit;
 
-    if (inner_error) {
-        g_propagate_error (error, inner_error);
-        return FALSE;
+        if (!g_ascii_isdigit (*str))
+            return FALSE;
+        digit = *str - '0';
+        if (num > (G_MAXUINT64 - digit) / 10)
+            return FALSE;
+        num = (num * 10) + digit;
     }
+
+    *out = num;
     return TRUE;
 }
 
-static gboolean
-telit_get_3g_mm_bands (GMatchInfo  *match_info,
-                       gpointer     log_object,
-                       gboolean     modem_alternate_3g_bands,
-                       GArray     **bands,
-                       GError     **error)
+static const gchar *
+bnd_skip_spaces (const gchar *str)
 {
-    GError        *inner_error = NULL;
-    GArray        *values = NULL;
-    gchar         *match_str = NULL;
-    guint          i;
-    const guint64 *telit_3g_to_mm_band_mask;
-    guint          telit_3g_to_mm_band_mask_n_elements;
-
-    initialize_telit_3g_to_mm_band_masks ();
+    while (g_ascii_isspace (*str))
+        str++;
+    return str;
+}
 
-    /* Select correct 3G band mask */
-    if (modem_alternate_3g_bands) {
-        telit_3g_to_mm_band_mask = telit_3g_to_mm_band_mask_alternate;
-        telit_3g_to_mm_band_mask_n_elements = G_N_ELEMENTS (telit_3g_to_mm_band_mask_alternate);
-    } else {
-        telit_3g_to_mm_band_mask = telit_3g_to_mm_band_mask_default;
-        telit_3g_to_mm_band_mask_n_elements = G_N_ELEMENTS (telit_3g_to_mm_band_mask_default);
+/* In the test response each group is a list of values or intervals given in
+ * parenthesis; in the query response each group is a single number */
+static const gchar *
+bnd_match_group (const gchar   *str,
+                 LoadBandsType  load_type,
+                 BndGroup      *group)
+{
+    if (load_type == LOAD_BANDS_TYPE_SUPPORTED) {
+        if (*str != '(')
+            return NULL;
+        group->start = ++str;
+        while (g_ascii_isdigit (*str) || *str == ',' || *str == '-')
+            str++;
+        group->end = str;
+        return (*str == ')') ? (str + 1) : NULL;
     }
 
-    match_str = g_match_info_fetch_named (match_info, "Bands3G");
-    if (!match_str || match_str[0] == '\0') {
-        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                     "Could not find 3G band values from response");
-        goto out;
-    }
+    group->start = str;
+    while (g_ascii_isdigit (*str))
+        str++;
+    group->end = str;
+    return (group->end > group->start) ? str : NULL;
+}
 
-    values = mm_parse_uint_list (match_str, &inner_error);
-    if (!values)
-        goto out;
+/* Splits the response in the 2G, 3G and 4G groups without copying them. The
+ * 2G group is mandatory, the others are optional and are left empty if not
+ * given. */
+static gboolean
+bnd_tokenize (const gchar   *response,
+              LoadBandsType  load_type,
+              BndGroup      *groups)
+{
+    const gchar *prefix;
 
-    for (i = 0; i < values->len; i++) {
-        guint value;
+    for (prefix = strstr (response, BND_PREFIX); prefix; prefix = strstr (prefix + 1, BND_PREFIX)) {
+        const gchar *aux;
+        guint        i;
 
-        value = g_array_index (values, guint, i);
+        memset (groups, 0, sizeof (BndGroup) * BND_N_GROUPS);
 
-        if (value < telit_3g_to_mm_band_mask_n_elements) {
-            guint j;
+        aux = bnd_match_group (bnd_skip_spaces (prefix + strlen (BND_PREFIX)), load_type, &groups[0]);
+        if (!aux)
+            continue;
 
-            for (j = 0; j < G_N_ELEMENTS (band_utran_index); j++) {
-                /* ignore non-3G bands */
-                if (band_utran_index[j] == 0)
-                    continue;
+        for (i = 1; i < BND_N_GROUPS && *aux == ','; i++) {
+            BndGroup     group;
+            const gchar *next;
 
-                if ((telit_3g_to_mm_band_mask[value] & B3G_FLAG (j)) && !mm_common_bands_garray_lookup (*bands, j))
-                    *bands = g_array_append_val (*bands, j);
-            }
-        } else
-            mm_obj_dbg (log_object, "unhandled telit 3G band value configuration: %u", value);
+            next = bnd_match_group (bnd_skip_spaces (aux + 1), load_type, &group);
+            if (!next)
+                break;
+            groups[i] = group;
+            aux = next;
+        }
+        return TRUE;
     }
 
-out:
-    g_free (match_str);
-    g_clear_pointer (&values, g_array_unref);
+    return FALSE;
+}
+
+/* Converts a list of telit band values (e.g. "0,2-4") into the bitmask of
+ * bands given by the lookup table */
+static gboolean
+telit_get_band_values_mask (const BndGroup  *group,
+                            const gchar     *tech,
+                            const guint64   *value_to_mask,
+                            guint            n_values,
+                            gpointer         log_object,
+                            guint64         *out_mask,
+                            GError         **error)
+{
+    const gchar *item;
+    guint64      mask = 0;
 
-    if (inner_error) {
-        g_propagate_error (error, inner_error);
+    if (group->start == group->end) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Could not find %s band values from response", tech);
         return FALSE;
     }
+
+    for (item = group->start; item; ) {
+        const gchar *item_end;
+        const gchar *interval;
+        guint64      start;
+        guint64      stop;
+        guint64      value;
+
+        item_end = memchr (item, ',', group->end - item);
+        if (!item_end)
+            item_end = group->end;
+
+        interval = memchr (item, '-', item_end - item);
+        if (interval) {
+            if (!bnd_parse_u64 (item, interval, &start) || !bnd_parse_u64 (interval + 1, item_end, &stop))
+                goto invalid;
+        } else {
+            if (!bnd_parse_u64 (item, item_end, &start))
+                goto invalid;
+            stop = start;
+        }
+        if (start > G_MAXUINT || stop > G_MAXUINT || start > stop)
+            goto invalid;
+
+        for (value = start; value < n_values && value <= stop; value++)
+            mask |= value_to_mask[value];
+        if (stop >= n_values)
+            mm_obj_dbg (log_object, "unhandled telit %s band value configuration: %" G_GUINT64_FORMAT "-%" G_GUINT64_FORMAT,
+                        tech, MAX (start, n_values), stop);
+
+        item = (item_end < group->end) ? (item_end + 1) : NULL;
+    }
+
+    *out_mask = mask;
     return TRUE;
+
+invalid:
+    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                 "Could not parse %s band values from response: '%.*s'",
+                 tech, (gint)(group->end - group->start), group->start);
+    return FALSE;
 }
 
 static gboolean
-telit_get_4g_mm_bands (GMatchInfo  *match_info,
-                       GArray     **bands,
-                       GError     **error)
+telit_get_4g_mask (const BndGroup  *group,
+                   guint64         *out_mask,
+                   GError         **error)
 {
-    GError       *inner_error = NULL;
-    MMModemBand   band;
-    gchar        *match_str = NULL;
-    guint64       value;
-    gchar       **tokens = NULL;
-
-    match_str = g_match_info_fetch_named (match_info, "Bands4G");
-    if (!match_str || match_str[0] == '\0') {
-        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+    const gchar *str;
+    const gchar *end;
+
+    if (group->start == group->end) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
                      "Could not find 4G band flags from response");
-        goto out;
+        return FALSE;
     }
 
-    /* splitting will never return NULL as string is not empty */
-    tokens = g_strsplit (match_str, "-", -1);
-
     /* If this is a range, get upper threshold, which contains the total supported mask */
-    if (!mm_get_u64_from_str (tokens[1] ? tokens[1] : tokens[0], &value)) {
-        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                     "Could not parse 4G band mask from string: '%s'", match_str);
-        goto out;
-    }
-
-    for (band = MM_MODEM_BAND_TELIT_4G_FIRST; band <= MM_MODEM_BAND_TELIT_4G_LAST; band++) {
-        if ((value & B4G_FLAG (band)) && !mm_common_bands_garray_lookup (*bands, band))
-            g_array_append_val (*bands, band);
+    str = memchr (group->start, '-', group->end - group->start);
+    if (str) {
+        str++;
+        end = memchr (str, '-', group->end - str);
+        if (!end)
+            end = group->end;
+    } else {
+        str = group->start;
+        end = group->end;
     }
 
-out:
-    g_strfreev (tokens);
-    g_free (match_str);
-
-    if (inner_error) {
-        g_propagate_error (error, inner_error);
+    if (!bnd_parse_u64 (str, end, out_mask)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Could not parse 4G band mask from string: '%.*s'",
+                     (gint)(group->end - group->start), group->start);
         return FALSE;
     }
     return TRUE;
 }
 
-typedef enum {
-    LOAD_BANDS_TYPE_SUPPORTED,
-    LOAD_BANDS_TYPE_CURRENT,
-} LoadBandsType;
-
 static GArray *
 common_parse_bnd_response (const gchar    *response,
                            gboolean        modem_is_2g,
@@ -547,50 +598,56 @@ common_parse_bnd_response (const gchar    *response,
                            gpointer        log_object,
                            GError        **error)
 {
-    GError     *inner_error = NULL;
-    GArray     *bands = NULL;
-    GMatchInfo *match_info = NULL;
-    GRegex     *r;
-
-    static const gchar *load_bands_regex[] = {
-        [LOAD_BANDS_TYPE_SUPPORTED] = "#BND:\\s*\\((?P<Bands2G>[0-9\\-,]*)\\)(,\\s*\\((?P<Bands3G>[0-9\\-,]*)\\))?(,\\s*\\((?P<Bands4G>[0-9\\-,]*)\\))?",
-        [LOAD_BANDS_TYPE_CURRENT]   = "#BND:\\s*(?P<Bands2G>\\d+)(,\\s*(?P<Bands3G>\\d+))?(,\\s*(?P<Bands4G>\\d+))?",
-    };
-
-    r = g_regex_new (load_bands_regex[load_type], G_REGEX_RAW, 0, NULL);
-    g_assert (r);
+    BndGroup       groups[BND_N_GROUPS];
+    guint64        mask2g = 0;
+    guint64        mask3g = 0;
+    guint64        mask4g = 0;
+    const guint64 *telit_3g_to_mm_band_mask;
+    guint          telit_3g_to_mm_band_mask_n_elements;
+    GArray        *bands;
+    MMModemBand    band;
+    guint          i;
 
-    if (!g_regex_match (r, response, 0, &match_info)) {
-        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+    if (!bnd_tokenize (response, load_type, groups)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
                      "Could not parse response '%s'", response);
-        goto out;
+        return NULL;
     }
 
-    if (!g_match_info_matches (match_info)) {
-        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                     "Could not find matches in response '%s'", response);
-        goto out;
-    }
+    select_telit_3g_to_mm_band_mask (modem_alternate_3g_bands,
+                                     &telit_3g_to_mm_band_mask,
+                                     &telit_3g_to_mm_band_mask_n_elements);
 
-    bands = g_array_new (TRUE, TRUE, sizeof (MMModemBand));
+    if (modem_is_2g &&
+        !telit_get_band_values_mask (&groups[0], "2G",
+                                     telit_2g_to_mm_band_mask, G_N_ELEMENTS (telit_2g_to_mm_band_mask),
+                                     log_object, &mask2g, error))
+        return NULL;
 
-    if (modem_is_2g && !telit_get_2g_mm_bands (match_info, log_object, &bands, &inner_error))
-        goto out;
+    if (modem_is_3g &&
+        !telit_get_band_values_mask (&groups[1], "3G",
+                                     telit_3g_to_mm_band_mask, telit_3g_to_mm_band_mask_n_elements,
+                                     log_object, &mask3g, error))
+        return NULL;
 
-    if (modem_is_3g && !telit_get_3g_mm_bands (match_info, log_object, modem_alternate_3g_bands, &bands, &inner_error))
-        goto out;
+    if (modem_is_4g && !telit_get_4g_mask (&groups[2], &mask4g, error))
+        return NULL;
 
-    if (modem_is_4g && !telit_get_4g_mm_bands (match_info, &bands, &inner_error))
-        goto out;
+    bands = g_array_new (TRUE, TRUE, sizeof (MMModemBand));
 
-out:
-    g_match_info_free (match_info);
-    g_regex_unref (r);
+    for (band = MM_MODEM_BAND_TELIT_2G_FIRST; band <= MM_MODEM_BAND_TELIT_2G_LAST; band++) {
+        if (mask2g & B2G_FLAG (band))
+            g_array_append_val (bands, band);
+    }
 
-    if (inner_error) {
-        g_propagate_error (error, inner_error);
-        g_clear_pointer (&bands, g_array_unref);
-        return NULL;
+    for (i = 1; i < G_N_ELEMENTS (utran_index_to_mm_band); i++) {
+        if ((mask3g & U3G (i)) && (utran_index_to_mm_band[i] != MM_MODEM_BAND_UNKNOWN))
+            g_array_append_val (bands, utran_index_to_mm_band[i]);
+    }
+
+    for (band = MM_MODEM_BAND_TELIT_4G_FIRST; band <= MM_MODEM_BAND_TELIT_4G_LAST; band++) {
+        if (mask4g & B4G_FLAG (band))
+            g_array_append_val (bands, band);
     }
 
     return bands;
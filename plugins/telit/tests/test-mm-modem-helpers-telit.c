@@ -291,6 +291,481 @@ test_parse_current_bands_response (void)
     }
 }
 
+/******************************************************************************/
+/* Reference #BND parser
+ *
+ * Copy of the regex based implementation that was used before the tokenizer;
+ * any randomly built response must be parsed by both in exactly the same way. */
+
+/* AT#BND 2G values */
+
+#define MM_MODEM_BAND_TELIT_2G_FIRST MM_MODEM_BAND_EGSM
+#define MM_MODEM_BAND_TELIT_2G_LAST  MM_MODEM_BAND_G850
+
+#define B2G_FLAG(band) (1 << (band - MM_MODEM_BAND_TELIT_2G_FIRST))
+
+/* Index of the array is the telit 2G band value [0-5]
+ * The bitmask value here is built from the 2G MMModemBand values right away. */
+static const guint32 reference_telit_2g_to_mm_band_mask[] = {
+    [0] = B2G_FLAG (MM_MODEM_BAND_EGSM) + B2G_FLAG (MM_MODEM_BAND_DCS),
+    [1] = B2G_FLAG (MM_MODEM_BAND_EGSM) + B2G_FLAG (MM_MODEM_BAND_PCS),
+    [2] = B2G_FLAG (MM_MODEM_BAND_DCS)  + B2G_FLAG (MM_MODEM_BAND_G850),
+    [3] = B2G_FLAG (MM_MODEM_BAND_PCS)  + B2G_FLAG (MM_MODEM_BAND_G850),
+    [4] = B2G_FLAG (MM_MODEM_BAND_EGSM) + B2G_FLAG (MM_MODEM_BAND_DCS) + B2G_FLAG (MM_MODEM_BAND_PCS),
+    [5] = B2G_FLAG (MM_MODEM_BAND_EGSM) + B2G_FLAG (MM_MODEM_BAND_DCS) + B2G_FLAG (MM_MODEM_BAND_PCS) + B2G_FLAG (MM_MODEM_BAND_G850),
+};
+
+/*****************************************************************************/
+/* AT#BND 3G values */
+
+/* NOTE: UTRAN_1 to UTRAN_9 enum values are NOT IN ORDER!
+ * E.g. numerically UTRAN_7 is after UTRAN_9...
+ *
+ * This array allows us to iterate them in a way which is a bit
+ * more friendly.
+ */
+static const guint reference_band_utran_index[] = {
+    [MM_MODEM_BAND_UTRAN_1] = 1,
+    [MM_MODEM_BAND_UTRAN_2] = 2,
+    [MM_MODEM_BAND_UTRAN_3] = 3,
+    [MM_MODEM_BAND_UTRAN_4] = 4,
+    [MM_MODEM_BAND_UTRAN_5] = 5,
+    [MM_MODEM_BAND_UTRAN_6] = 6,
+    [MM_MODEM_BAND_UTRAN_7] = 7,
+    [MM_MODEM_BAND_UTRAN_8] = 8,
+    [MM_MODEM_BAND_UTRAN_9] = 9,
+    [MM_MODEM_BAND_UTRAN_10] = 10,
+    [MM_MODEM_BAND_UTRAN_11] = 11,
+    [MM_MODEM_BAND_UTRAN_12] = 12,
+    [MM_MODEM_BAND_UTRAN_13] = 13,
+    [MM_MODEM_BAND_UTRAN_14] = 14,
+    [MM_MODEM_BAND_UTRAN_19] = 19,
+    [MM_MODEM_BAND_UTRAN_20] = 20,
+    [MM_MODEM_BAND_UTRAN_21] = 21,
+    [MM_MODEM_BAND_UTRAN_22] = 22,
+    [MM_MODEM_BAND_UTRAN_25] = 25,
+    [MM_MODEM_BAND_UTRAN_26] = 26,
+    [MM_MODEM_BAND_UTRAN_32] = 32,
+};
+
+#define MM_MODEM_BAND_TELIT_3G_FIRST MM_MODEM_BAND_UTRAN_1
+#define MM_MODEM_BAND_TELIT_3G_LAST  MM_MODEM_BAND_UTRAN_19
+
+#define B3G_NUM(band) reference_band_utran_index[band]
+#define B3G_FLAG(band) ((B3G_NUM (band) > 0) ? (1LL << (B3G_NUM (band) - B3G_NUM (MM_MODEM_BAND_TELIT_3G_FIRST))) : 0)
+
+/* Index of the arrays is the telit 3G band value.
+ * The bitmask value here is built from the 3G MMModemBand values right away.
+ *
+ * We have 2 different sets of bands that are different for values >=12, because
+ * the LM940/960 models support a different set of 3G bands.
+ */
+
+#define REFERENCE_TELIT_3G_TO_MM_BAND_MASK_DEFAULT_N_ELEMENTS 27
+static guint64 reference_telit_3g_to_mm_band_mask_default[REFERENCE_TELIT_3G_TO_MM_BAND_MASK_DEFAULT_N_ELEMENTS];
+
+#define REFERENCE_TELIT_3G_TO_MM_BAND_MASK_ALTERNATE_N_ELEMENTS 20
+static guint64 reference_telit_3g_to_mm_band_mask_alternate[REFERENCE_TELIT_3G_TO_MM_BAND_MASK_ALTERNATE_N_ELEMENTS];
+
+static void
+reference_initialize_telit_3g_to_mm_band_masks (void)
+{
+    static gboolean initialized = FALSE;
+
+    /* We need to initialize the arrays in runtime because gcc < 8 doesn't like initializing
+     * with operations that are using the reference_band_utran_index constant array elements */
+
+    if (initialized)
+        return;
+
+    reference_telit_3g_to_mm_band_mask_default[0]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1);
+    reference_telit_3g_to_mm_band_mask_default[1]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_2);
+    reference_telit_3g_to_mm_band_mask_default[2]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_default[3]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_default[4]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_default[5]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_default[6]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_default[7]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_4);
+    reference_telit_3g_to_mm_band_mask_default[8]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_default[9]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_default[10] = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_default[11] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
+                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_default[12] = B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
+    reference_telit_3g_to_mm_band_mask_default[13] = B3G_FLAG (MM_MODEM_BAND_UTRAN_3);
+    reference_telit_3g_to_mm_band_mask_default[14] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
+                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
+    reference_telit_3g_to_mm_band_mask_default[15] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_default[16] = B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_default[17] = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) +
+                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
+    reference_telit_3g_to_mm_band_mask_default[18] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6) +
+                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_default[19] = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
+    reference_telit_3g_to_mm_band_mask_default[20] = B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
+    reference_telit_3g_to_mm_band_mask_default[21] = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6);
+    reference_telit_3g_to_mm_band_mask_default[22] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) +
+                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_default[23] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3);
+    reference_telit_3g_to_mm_band_mask_default[24] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
+                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_default[25] = B3G_FLAG (MM_MODEM_BAND_UTRAN_19);
+    reference_telit_3g_to_mm_band_mask_default[26] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6) +
+                                           B3G_FLAG (MM_MODEM_BAND_UTRAN_8) + B3G_FLAG (MM_MODEM_BAND_UTRAN_19);
+
+    /* Initialize alternate 3G band set */
+    reference_telit_3g_to_mm_band_mask_alternate[0]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1);
+    reference_telit_3g_to_mm_band_mask_alternate[1]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_2);
+    reference_telit_3g_to_mm_band_mask_alternate[2]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_alternate[3]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_alternate[4]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_alternate[5]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_alternate[6]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_alternate[7]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_4);
+    reference_telit_3g_to_mm_band_mask_alternate[8]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_alternate[9]  = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_alternate[10] = B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_alternate[11] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
+                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_alternate[12] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) +
+                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_alternate[13] = B3G_FLAG (MM_MODEM_BAND_UTRAN_3);
+    reference_telit_3g_to_mm_band_mask_alternate[14] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_alternate[15] = B3G_FLAG (MM_MODEM_BAND_UTRAN_3) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5);
+    reference_telit_3g_to_mm_band_mask_alternate[16] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_3) +
+                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_4) + B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_alternate[17] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8);
+    reference_telit_3g_to_mm_band_mask_alternate[18] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
+                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8) + B3G_FLAG (MM_MODEM_BAND_UTRAN_9) +
+                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_19);
+    reference_telit_3g_to_mm_band_mask_alternate[19] = B3G_FLAG (MM_MODEM_BAND_UTRAN_1) + B3G_FLAG (MM_MODEM_BAND_UTRAN_2) + B3G_FLAG (MM_MODEM_BAND_UTRAN_4) +
+                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_5) + B3G_FLAG (MM_MODEM_BAND_UTRAN_6) + B3G_FLAG (MM_MODEM_BAND_UTRAN_8) +
+                                             B3G_FLAG (MM_MODEM_BAND_UTRAN_9) + B3G_FLAG (MM_MODEM_BAND_UTRAN_19);
+}
+
+/*****************************************************************************/
+/* AT#BND 4G values
+ *
+ * The Telit-specific value for 4G bands is a bitmask of the band values, given
+ * in hexadecimal or decimal format.
+ */
+
+#define MM_MODEM_BAND_TELIT_4G_FIRST MM_MODEM_BAND_EUTRAN_1
+#define MM_MODEM_BAND_TELIT_4G_LAST  MM_MODEM_BAND_EUTRAN_44
+
+#define B4G_FLAG(band) (((guint64) 1) << (band - MM_MODEM_BAND_TELIT_4G_FIRST))
+
+/*****************************************************************************/
+/* #BND response parser */
+
+static gboolean
+reference_telit_get_2g_mm_bands (GMatchInfo  *match_info,
+                                 gpointer     log_object,
+                                 GArray     **bands,
+                                 GError     **error)
+{
+    GError *inner_error = NULL;
+    GArray *values = NULL;
+    gchar  *match_str = NULL;
+    guint   i;
+
+    match_str = g_match_info_fetch_named (match_info, "Bands2G");
+    if (!match_str || match_str[0] == '\0') {
+        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Could not find 2G band values from response");
+        goto out;
+    }
+
+    values = mm_parse_uint_list (match_str, &inner_error);
+    if (!values)
+        goto out;
+
+    for (i = 0; i < values->len; i++) {
+        guint value;
+
+        value = g_array_index (values, guint, i);
+        if (value < G_N_ELEMENTS (reference_telit_2g_to_mm_band_mask)) {
+            guint j;
+
+            for (j = MM_MODEM_BAND_TELIT_2G_FIRST; j <= MM_MODEM_BAND_TELIT_2G_LAST; j++) {
+                if ((reference_telit_2g_to_mm_band_mask[value] & B2G_FLAG (j)) && !mm_common_bands_garray_lookup (*bands, j))
+                    *bands = g_array_append_val (*bands, j);
+            }
+        } else
+            mm_obj_dbg (log_object, "unhandled telit 2G band value configuration: %u", value);
+    }
+
+out:
+    g_free (match_str);
+    g_clear_pointer (&values, g_array_unref);
+
+    if (inner_error) {
+        g_propagate_error (error, inner_error);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean
+reference_telit_get_3g_mm_bands (GMatchInfo  *match_info,
+                                 gpointer     log_object,
+                                 gboolean     modem_alternate_3g_bands,
+                                 GArray     **bands,
+                                 GError     **error)
+{
+    GError        *inner_error = NULL;
+    GArray        *values = NULL;
+    gchar         *match_str = NULL;
+    guint          i;
+    const guint64 *telit_3g_to_mm_band_mask;
+    guint          telit_3g_to_mm_band_mask_n_elements;
+
+    reference_initialize_telit_3g_to_mm_band_masks ();
+
+    /* Select correct 3G band mask */
+    if (modem_alternate_3g_bands) {
+        telit_3g_to_mm_band_mask = reference_telit_3g_to_mm_band_mask_alternate;
+        telit_3g_to_mm_band_mask_n_elements = G_N_ELEMENTS (reference_telit_3g_to_mm_band_mask_alternate);
+    } else {
+        telit_3g_to_mm_band_mask = reference_telit_3g_to_mm_band_mask_default;
+        telit_3g_to_mm_band_mask_n_elements = G_N_ELEMENTS (reference_telit_3g_to_mm_band_mask_default);
+    }
+
+    match_str = g_match_info_fetch_named (match_info, "Bands3G");
+    if (!match_str || match_str[0] == '\0') {
+        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Could not find 3G band values from response");
+        goto out;
+    }
+
+    values = mm_parse_uint_list (match_str, &inner_error);
+    if (!values)
+        goto out;
+
+    for (i = 0; i < values->len; i++) {
+        guint value;
+
+        value = g_array_index (values, guint, i);
+
+        if (value < telit_3g_to_mm_band_mask_n_elements) {
+            guint j;
+
+            for (j = 0; j < G_N_ELEMENTS (reference_band_utran_index); j++) {
+                /* ignore non-3G bands */
+                if (reference_band_utran_index[j] == 0)
+                    continue;
+
+                if ((telit_3g_to_mm_band_mask[value] & B3G_FLAG (j)) && !mm_common_bands_garray_lookup (*bands, j))
+                    *bands = g_array_append_val (*bands, j);
+            }
+        } else
+            mm_obj_dbg (log_object, "unhandled telit 3G band value configuration: %u", value);
+    }
+
+out:
+    g_free (match_str);
+    g_clear_pointer (&values, g_array_unref);
+
+    if (inner_error) {
+        g_propagate_error (error, inner_error);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean
+reference_telit_get_4g_mm_bands (GMatchInfo  *match_info,
+                                 GArray     **bands,
+                                 GError     **error)
+{
+    GError       *inner_error = NULL;
+    MMModemBand   band;
+    gchar        *match_str = NULL;
+    guint64       value;
+    gchar       **tokens = NULL;
+
+    match_str = g_match_info_fetch_named (match_info, "Bands4G");
+    if (!match_str || match_str[0] == '\0') {
+        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Could not find 4G band flags from response");
+        goto out;
+    }
+
+    /* splitting will never return NULL as string is not empty */
+    tokens = g_strsplit (match_str, "-", -1);
+
+    /* If this is a range, get upper threshold, which contains the total supported mask */
+    if (!mm_get_u64_from_str (tokens[1] ? tokens[1] : tokens[0], &value)) {
+        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Could not parse 4G band mask from string: '%s'", match_str);
+        goto out;
+    }
+
+    for (band = MM_MODEM_BAND_TELIT_4G_FIRST; band <= MM_MODEM_BAND_TELIT_4G_LAST; band++) {
+        if ((value & B4G_FLAG (band)) && !mm_common_bands_garray_lookup (*bands, band))
+            g_array_append_val (*bands, band);
+    }
+
+out:
+    g_strfreev (tokens);
+    g_free (match_str);
+
+    if (inner_error) {
+        g_propagate_error (error, inner_error);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+typedef enum {
+    REFERENCE_LOAD_BANDS_TYPE_SUPPORTED,
+    REFERENCE_LOAD_BANDS_TYPE_CURRENT,
+} ReferenceLoadBandsType;
+
+static GArray *
+reference_common_parse_bnd_response (const gchar             *response,
+                                     gboolean                 modem_is_2g,
+                                     gboolean                 modem_is_3g,
+                                     gboolean                 modem_is_4g,
+                                     gboolean                 modem_alternate_3g_bands,
+                                     ReferenceLoadBandsType   load_type,
+                                     gpointer                 log_object,
+                                     GError                 **error)
+{
+    GError     *inner_error = NULL;
+    GArray     *bands = NULL;
+    GMatchInfo *match_info = NULL;
+    GRegex     *r;
+
+    static const gchar *load_bands_regex[] = {
+        [REFERENCE_LOAD_BANDS_TYPE_SUPPORTED] = "#BND:\\s*\\((?P<Bands2G>[0-9\\-,]*)\\)(,\\s*\\((?P<Bands3G>[0-9\\-,]*)\\))?(,\\s*\\((?P<Bands4G>[0-9\\-,]*)\\))?",
+        [REFERENCE_LOAD_BANDS_TYPE_CURRENT]   = "#BND:\\s*(?P<Bands2G>\\d+)(,\\s*(?P<Bands3G>\\d+))?(,\\s*(?P<Bands4G>\\d+))?",
+    };
+
+    r = g_regex_new (load_bands_regex[load_type], G_REGEX_RAW, 0, NULL);
+    g_assert (r);
+
+    if (!g_regex_match (r, response, 0, &match_info)) {
+        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Could not parse response '%s'", response);
+        goto out;
+    }
+
+    if (!g_match_info_matches (match_info)) {
+        g_set_error (&inner_error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "Could not find matches in response '%s'", response);
+        goto out;
+    }
+
+    bands = g_array_new (TRUE, TRUE, sizeof (MMModemBand));
+
+    if (modem_is_2g && !reference_telit_get_2g_mm_bands (match_info, log_object, &bands, &inner_error))
+        goto out;
+
+    if (modem_is_3g && !reference_telit_get_3g_mm_bands (match_info, log_object, modem_alternate_3g_bands, &bands, &inner_error))
+        goto out;
+
+    if (modem_is_4g && !reference_telit_get_4g_mm_bands (match_info, &bands, &inner_error))
+        goto out;
+
+out:
+    g_match_info_free (match_info);
+    g_regex_unref (r);
+
+    if (inner_error) {
+        g_propagate_error (error, inner_error);
+        g_clear_pointer (&bands, g_array_unref);
+        return NULL;
+    }
+
+    return bands;
+}
+
+/******************************************************************************/
+
+#define FUZZ_ITERATIONS 5000
+
+static gboolean
+bands_equal (GArray *a,
+             GArray *b)
+{
+    guint i;
+
+    if (!a || !b)
+        return (!a && !b);
+    if (a->len != b->len)
+        return FALSE;
+
+    mm_common_bands_garray_sort (a);
+    mm_common_bands_garray_sort (b);
+    for (i = 0; i < a->len; i++) {
+        if (g_array_index (a, MMModemBand, i) != g_array_index (b, MMModemBand, i))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static void
+common_test_bnd_fuzz (gboolean supported)
+{
+    g_autoptr(GRand) rand = NULL;
+    guint            i;
+
+    static const gchar *pieces[] = {
+        "#BND:", "#BND: ", "(", ")", ",", "-", " ", "\r\n", "x",
+        "0", "1", "3", "5", "12", "21", "4294967295", "18446744073709551616",
+    };
+
+    rand = g_rand_new_with_seed (1);
+    for (i = 0; i < FUZZ_ITERATIONS; i++) {
+        GString          *response;
+        GArray           *bands;
+        GArray           *expected_bands = NULL;
+        gboolean          is_2g, is_3g, is_4g, alternate;
+        guint             n;
+
+        response = g_string_new (g_rand_int_range (rand, 0, 5) ? "#BND: " : NULL);
+        for (n = g_rand_int_range (rand, 0, 20); n > 0; n--)
+            g_string_append (response, pieces[g_rand_int_range (rand, 0, G_N_ELEMENTS (pieces))]);
+
+        is_2g = g_rand_boolean (rand);
+        is_3g = g_rand_boolean (rand);
+        is_4g = g_rand_boolean (rand);
+        alternate = g_rand_boolean (rand);
+
+        bands = (supported ?
+                 mm_telit_parse_bnd_test_response (response->str, is_2g, is_3g, is_4g, alternate, NULL, NULL) :
+                 mm_telit_parse_bnd_query_response (response->str, is_2g, is_3g, is_4g, alternate, NULL, NULL));
+
+        expected_bands = reference_common_parse_bnd_response (response->str, is_2g, is_3g, is_4g, alternate,
+                                                              (supported ?
+                                                               REFERENCE_LOAD_BANDS_TYPE_SUPPORTED :
+                                                               REFERENCE_LOAD_BANDS_TYPE_CURRENT),
+                                                              NULL, NULL);
+
+        if (!bands_equal (bands, expected_bands))
+            g_error ("#BND response '%s' parsed differently than by the reference parser", response->str);
+
+        if (bands)
+            g_array_unref (bands);
+        if (expected_bands)
+            g_array_unref (expected_bands);
+        g_string_free (response, TRUE);
+    }
+}
+
+static void
+test_parse_supported_bands_fuzz (void)
+{
+    common_test_bnd_fuzz (TRUE);
+}
+
+static void
+test_parse_current_bands_fuzz (void)
+{
+    common_test_bnd_fuzz (FALSE);
+}
+
 /******************************************************************************/
 
 static void
@@ -580,6 +1055,8 @@ int main (int argc, char **argv)
 
     g_test_add_func ("/MM/telit/bands/supported/parse_bands_response", test_parse_supported_bands_response);
     g_test_add_func ("/MM/telit/bands/current/parse_bands_response", test_parse_current_bands_response);
+    g_test_add_func ("/MM/telit/bands/supported/parse_bands_response/fuzz", test_parse_supported_bands_fuzz);
+    g_test_add_func ("/MM/telit/bands/current/parse_bands_response/fuzz", test_parse_current_bands_fuzz);
     g_test_add_func ("/MM/telit/bands/current/set_bands/2g", test_telit_get_2g_bnd_flag);
     g_test_add_func ("/MM/telit/bands/current/set_bands/3g", test_telit_get_3g_bnd_flag);
     g_test_add_func ("/MM/telit/bands/current/set_bands/4g", test_telit_get_4g_bnd_flag);
@@ -29,6 +29,7 @@
 #define MM_LOG_NO_OBJECT
 #include "mm-log.h"
 #include "mm-base-manager.h"
+#include "mm-plugin-manager.h"
 #include "mm-context.h"
 
 #if defined WITH_SYSTEMD_SUSPEND_RESUME
@@ -61,6 +62,11 @@ quit_cb (gpointer user_data)
 static void
 sleeping_cb (MMSleepMonitor *sleep_monitor)
 {
+    if (mm_context_get_quick_suspend_resume ()) {
+        mm_dbg ("keeping devices... (sleeping)");
+        return;
+    }
+
     mm_dbg ("removing devices... (sleeping)");
     mm_base_manager_shutdown (manager, FALSE);
 }
@@ -68,6 +74,11 @@ sleeping_cb (MMSleepMonitor *sleep_monitor)
 static void
 resuming_cb (MMSleepMonitor *sleep_monitor)
 {
+    if (mm_context_get_quick_suspend_resume ()) {
+        mm_dbg ("revalidating devices... (resuming)");
+        mm_base_manager_sync (manager);
+    }
+
     mm_dbg ("re-scanning (resuming)");
     mm_base_manager_start (manager, FALSE);
 }
@@ -152,6 +163,23 @@ register_dbus_errors (void)
   g_dbus_error_register_error   (G_IO_ERROR,    G_IO_ERROR_CANCELLED,    MM_CORE_ERROR_DBUS_PREFIX ".Cancelled");
 }
 
+static gboolean
+generate_plugin_manifest (GError **error)
+{
+    g_autoptr(MMFilter)        filter = NULL;
+    g_autoptr(MMPluginManager) plugin_manager = NULL;
+
+    filter = mm_filter_new (mm_context_get_filter_policy (), error);
+    if (!filter)
+        return FALSE;
+
+    plugin_manager = mm_plugin_manager_new (mm_context_get_test_plugin_dir (), filter, error);
+    if (!plugin_manager)
+        return FALSE;
+
+    return mm_plugin_manager_write_manifest (plugin_manager, error);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -176,6 +204,16 @@ main (int argc, char *argv[])
     g_unix_signal_add (SIGTERM, quit_cb, NULL);
     g_unix_signal_add (SIGINT, quit_cb, NULL);
 
+    /* Generate plugin manifest and exit, if requested */
+    if (mm_context_get_generate_plugin_manifest ()) {
+        if (!generate_plugin_manifest (&error)) {
+            mm_warn ("couldn't generate plugin manifest: %s", error->message);
+            g_error_free (error);
+            exit (1);
+        }
+        exit (0);
+    }
+
     /* Early register all known errors */
     register_dbus_errors ();
 
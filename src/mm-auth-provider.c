@@ -27,11 +27,22 @@
 # include <polkit/polkit.h>
 #endif
 
+/* Positive authorization results are cached per (sender, action) for a short
+ * time, so that clients issuing lots of privileged calls don't pay a polkit
+ * round trip for each one of them. */
+#define AUTH_CACHE_TTL_SECS 30
+
 struct _MMAuthProvider {
     GObject parent;
 #if defined WITH_POLKIT
     PolkitAuthority *authority;
+    guint            authority_changed_id;
+
+    /* sender unique name -> CachedSender */
+    GHashTable      *cache;
 #endif
+    guint            cache_hits;
+    guint            cache_misses;
 };
 
 struct _MMAuthProviderClass {
@@ -55,8 +66,145 @@ mm_auth_provider_authorize_finish (MMAuthProvider  *self,
 
 #if defined WITH_POLKIT
 
+static void
+cache_flush (MMAuthProvider *self,
+             const gchar    *reason)
+{
+    if (!g_hash_table_size (self->cache))
+        return;
+
+    mm_obj_dbg (self, "flushing authorization cache (%s): %u hits, %u misses",
+                reason, self->cache_hits, self->cache_misses);
+    g_hash_table_remove_all (self->cache);
+}
+
+static void
+authority_changed_cb (PolkitAuthority *authority,
+                      MMAuthProvider  *self)
+{
+    /* Policies or sessions changed, nothing we cached can be trusted */
+    cache_flush (self, "authority changed");
+}
+
+/* Cached authorizations of a given sender, dropped as soon as the sender
+ * leaves the bus */
+typedef struct {
+    GHashTable      *actions; /* action -> expiration time */
+    GDBusConnection *connection;
+    guint            name_owner_changed_id;
+} CachedSender;
+
+static void
+cached_sender_free (CachedSender *cached)
+{
+    g_dbus_connection_signal_unsubscribe (cached->connection, cached->name_owner_changed_id);
+    g_object_unref (cached->connection);
+    g_hash_table_unref (cached->actions);
+    g_slice_free (CachedSender, cached);
+}
+
+static void
+name_owner_changed_cb (GDBusConnection *connection,
+                       const gchar     *sender_name,
+                       const gchar     *object_path,
+                       const gchar     *interface_name,
+                       const gchar     *signal_name,
+                       GVariant        *parameters,
+                       MMAuthProvider  *self)
+{
+    const gchar *name = NULL;
+    const gchar *new_owner = NULL;
+
+    g_variant_get (parameters, "(&s&s&s)", &name, NULL, &new_owner);
+
+    /* Only departures matter */
+    if (new_owner && new_owner[0])
+        return;
+
+    if (g_hash_table_remove (self->cache, name))
+        mm_obj_dbg (self, "removed cached authorizations for '%s'", name);
+}
+
+static gboolean
+cache_lookup (MMAuthProvider *self,
+              const gchar    *sender,
+              const gchar    *authorization)
+{
+    CachedSender *cached;
+    gpointer      expiration;
+
+    cached = g_hash_table_lookup (self->cache, sender);
+    if (!cached || !g_hash_table_lookup_extended (cached->actions, authorization, NULL, &expiration))
+        return FALSE;
+
+    if (g_get_monotonic_time () >= *((gint64 *)expiration)) {
+        g_hash_table_remove (cached->actions, authorization);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean
+cache_prune_actions (const gchar *authorization,
+                     gint64      *expiration,
+                     gint64      *now)
+{
+    return (*now >= *expiration);
+}
+
+static gboolean
+cache_prune_sender (const gchar  *sender,
+                    CachedSender *cached,
+                    gint64       *now)
+{
+    g_hash_table_foreach_remove (cached->actions, (GHRFunc)cache_prune_actions, now);
+    return !g_hash_table_size (cached->actions);
+}
+
+static void
+cache_add (MMAuthProvider  *self,
+           GDBusConnection *connection,
+           const gchar     *sender,
+           const gchar     *authorization)
+{
+    CachedSender *cached;
+    gint64       *expiration;
+    gint64        now;
+
+    /* The sender may have left the bus while the authorization was being
+     * checked, and so its departure may have been missed; drop all expired
+     * entries, so that those of senders already gone don't pile up. */
+    now = g_get_monotonic_time ();
+    g_hash_table_foreach_remove (self->cache, (GHRFunc)cache_prune_sender, &now);
+
+    cached = g_hash_table_lookup (self->cache, sender);
+    if (!cached) {
+        cached = g_slice_new0 (CachedSender);
+        cached->actions = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+        cached->connection = g_object_ref (connection);
+        /* Only the departure of this sender is listened to */
+        cached->name_owner_changed_id =
+            g_dbus_connection_signal_subscribe (connection,
+                                                "org.freedesktop.DBus",
+                                                "org.freedesktop.DBus",
+                                                "NameOwnerChanged",
+                                                "/org/freedesktop/DBus",
+                                                sender,
+                                                G_DBUS_SIGNAL_FLAGS_NONE,
+                                                (GDBusSignalCallback)name_owner_changed_cb,
+                                                self,
+                                                NULL);
+        g_hash_table_insert (self->cache, g_strdup (sender), cached);
+    }
+
+    expiration = g_new (gint64, 1);
+    *expiration = now + (AUTH_CACHE_TTL_SECS * G_USEC_PER_SEC);
+    g_hash_table_insert (cached->actions, g_strdup (authorization), expiration);
+}
+
 typedef struct {
     PolkitSubject         *subject;
+    gchar                 *sender;
     gchar                 *authorization;
     GDBusMethodInvocation *invocation;
 } AuthorizeContext;
@@ -65,6 +213,7 @@ static void
 authorize_context_free (AuthorizeContext *ctx)
 {
     g_object_unref (ctx->invocation);
+    g_free (ctx->sender);
     g_object_unref (ctx->subject);
     g_free (ctx->authorization);
     g_free (ctx);
@@ -75,6 +224,7 @@ check_authorization_ready (PolkitAuthority *authority,
                            GAsyncResult    *res,
                            GTask           *task)
 {
+    MMAuthProvider            *self;
     PolkitAuthorizationResult *pk_result;
     GError                    *error = NULL;
     AuthorizeContext          *ctx;
@@ -84,6 +234,7 @@ check_authorization_ready (PolkitAuthority *authority,
         return;
     }
 
+    self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
     pk_result = polkit_authority_check_authorization_finish (authority, res, &error);
     if (!pk_result) {
@@ -94,10 +245,15 @@ check_authorization_ready (PolkitAuthority *authority,
                                  error->message);
         g_error_free (error);
     } else {
-        if (polkit_authorization_result_get_is_authorized (pk_result))
-            /* Good! */
+        if (polkit_authorization_result_get_is_authorized (pk_result)) {
+            /* Good! Only definite positive results are ever cached */
+            if (ctx->sender)
+                cache_add (self,
+                           g_dbus_method_invocation_get_connection (ctx->invocation),
+                           ctx->sender,
+                           ctx->authorization);
             g_task_return_boolean (task, TRUE);
-        else if (polkit_authorization_result_get_is_challenge (pk_result))
+        } else if (polkit_authorization_result_get_is_challenge (pk_result))
             g_task_return_new_error (task,
                                      MM_CORE_ERROR,
                                      MM_CORE_ERROR_UNAUTHORIZED,
@@ -131,6 +287,7 @@ mm_auth_provider_authorize (MMAuthProvider        *self,
 #if defined WITH_POLKIT
     {
         AuthorizeContext *ctx;
+        const gchar      *sender;
 
         /* When creating the object, we actually allowed errors when looking for the
          * authority. If that is the case, we'll just forbid any incoming
@@ -142,10 +299,20 @@ mm_auth_provider_authorize (MMAuthProvider        *self,
             return;
         }
 
+        sender = g_dbus_method_invocation_get_sender (invocation);
+        if (sender && cache_lookup (self, sender, authorization)) {
+            self->cache_hits++;
+            g_task_return_boolean (task, TRUE);
+            g_object_unref (task);
+            return;
+        }
+        self->cache_misses++;
+
         ctx = g_new (AuthorizeContext, 1);
         ctx->invocation = g_object_ref (invocation);
+        ctx->sender = g_strdup (sender);
         ctx->authorization = g_strdup (authorization);
-        ctx->subject = polkit_system_bus_name_new (g_dbus_method_invocation_get_sender (ctx->invocation));
+        ctx->subject = polkit_system_bus_name_new (sender);
         g_task_set_task_data (task, ctx, (GDestroyNotify)authorize_context_free);
 
         polkit_authority_check_authorization (self->authority,
@@ -166,6 +333,21 @@ mm_auth_provider_authorize (MMAuthProvider        *self,
 
 /*****************************************************************************/
 
+void
+mm_auth_provider_get_cache_stats (MMAuthProvider *self,
+                                  guint          *hits,
+                                  guint          *misses)
+{
+    g_return_if_fail (MM_IS_AUTH_PROVIDER (self));
+
+    if (hits)
+        *hits = self->cache_hits;
+    if (misses)
+        *misses = self->cache_misses;
+}
+
+/*****************************************************************************/
+
 static gchar *
 log_object_build_id (MMLogObject *_self)
 {
@@ -188,7 +370,13 @@ mm_auth_provider_init (MMAuthProvider *self)
             mm_obj_warn (self, "failed to create PolicyKit authority: '%s'",
                          error ? error->message : "unknown");
             g_clear_error (&error);
-        }
+        } else
+            self->authority_changed_id = g_signal_connect (self->authority,
+                                                           "changed",
+                                                           G_CALLBACK (authority_changed_cb),
+                                                           self);
+
+        self->cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify)cached_sender_free);
     }
 #endif
 }
@@ -197,7 +385,14 @@ static void
 dispose (GObject *object)
 {
 #if defined WITH_POLKIT
-    g_clear_object (&(MM_AUTH_PROVIDER (object)->authority));
+    MMAuthProvider *self = MM_AUTH_PROVIDER (object);
+
+    if (self->authority && self->authority_changed_id) {
+        g_signal_handler_disconnect (self->authority, self->authority_changed_id);
+        self->authority_changed_id = 0;
+    }
+    g_clear_pointer (&self->cache, g_hash_table_unref);
+    g_clear_object (&self->authority);
 #endif
 
     G_OBJECT_CLASS (mm_auth_provider_parent_class)->dispose (object);
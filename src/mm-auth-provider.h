@@ -55,4 +55,10 @@ gboolean mm_auth_provider_authorize_finish (MMAuthProvider         *self,
                                             GAsyncResult           *res,
                                             GError                **error);
 
+/* Amount of authorization requests served from, or missed in, the cache of
+ * positive results since the daemon started */
+void     mm_auth_provider_get_cache_stats  (MMAuthProvider         *self,
+                                            guint                  *hits,
+                                            guint                  *misses);
+
 #endif /* MM_AUTH_PROVIDER_H */
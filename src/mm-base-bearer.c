@@ -46,6 +46,11 @@
 
 #define BEARER_STATS_UPDATE_TIMEOUT 30
 
+/* Stats samples pushed by the implementation are kept for 10s, and the
+ * throughput is computed over that window */
+#define BEARER_STATS_SAMPLE_WINDOW_US (10 * G_USEC_PER_SEC)
+#define BEARER_STATS_SAMPLES_MAX      16
+
 /* Initial connectivity check after 30s, then each 5s */
 #define BEARER_CONNECTION_MONITOR_INITIAL_TIMEOUT 30
 #define BEARER_CONNECTION_MONITOR_TIMEOUT          5
@@ -76,6 +81,12 @@ enum {
 
 static GParamSpec *properties[PROP_LAST];
 
+typedef struct {
+    gint64  timestamp;
+    guint64 rx_bytes;
+    guint64 tx_bytes;
+} StatsSample;
+
 struct _MMBaseBearerPrivate {
     /* The connection to the system bus */
     GDBusConnection *connection;
@@ -128,6 +139,10 @@ struct _MMBaseBearerPrivate {
     GTimer *duration_timer;
     /* Flag to specify whether reloading stats is supported or not */
     gboolean reload_stats_unsupported;
+    /* Ring of stats samples pushed by the implementation */
+    StatsSample stats_samples[BEARER_STATS_SAMPLES_MAX];
+    guint       stats_samples_first;
+    guint       n_stats_samples;
 };
 
 /*****************************************************************************/
@@ -253,12 +268,22 @@ bearer_update_interface_stats (MMBaseBearer *self)
         mm_bearer_stats_get_dictionary (self->priv->stats));
 }
 
+static void
+bearer_reset_stats_samples (MMBaseBearer *self)
+{
+    self->priv->stats_samples_first = 0;
+    self->priv->n_stats_samples = 0;
+    mm_bearer_stats_set_uplink_speed (self->priv->stats, 0);
+    mm_bearer_stats_set_downlink_speed (self->priv->stats, 0);
+}
+
 static void
 bearer_reset_ongoing_interface_stats (MMBaseBearer *self)
 {
     mm_bearer_stats_set_duration (self->priv->stats, 0);
     mm_bearer_stats_set_tx_bytes (self->priv->stats, 0);
     mm_bearer_stats_set_rx_bytes (self->priv->stats, 0);
+    bearer_reset_stats_samples (self);
     bearer_update_interface_stats (self);
 }
 
@@ -316,6 +341,13 @@ bearer_set_ongoing_interface_stats (MMBaseBearer *self,
 static void
 bearer_stats_stop (MMBaseBearer *self)
 {
+    /* The last cached byte counters are kept, but the throughput of a
+     * finished connection is meaningless */
+    if (self->priv->n_stats_samples) {
+        bearer_reset_stats_samples (self);
+        bearer_update_interface_stats (self);
+    }
+
     if (self->priv->duration_timer) {
         bearer_set_ongoing_interface_stats (self,
                                             (guint64) g_timer_elapsed (self->priv->duration_timer, NULL),
@@ -363,6 +395,18 @@ reload_stats_ready (MMBaseBearer *self,
                                         tx_bytes);
 }
 
+static gboolean
+bearer_stats_samples_recent (MMBaseBearer *self)
+{
+    const StatsSample *newest;
+
+    if (!self->priv->n_stats_samples)
+        return FALSE;
+
+    newest = &self->priv->stats_samples[(self->priv->stats_samples_first + self->priv->n_stats_samples - 1) % BEARER_STATS_SAMPLES_MAX];
+    return ((g_get_monotonic_time () - newest->timestamp) < (BEARER_STATS_UPDATE_TIMEOUT * G_USEC_PER_SEC));
+}
+
 static gboolean
 stats_update_cb (MMBaseBearer *self)
 {
@@ -370,8 +414,11 @@ stats_update_cb (MMBaseBearer *self)
     if (self->priv->status != MM_BEARER_STATUS_CONNECTED)
         return G_SOURCE_CONTINUE;
 
-    /* If the implementation knows how to update stat values, run it */
-    if (!self->priv->reload_stats_unsupported &&
+    /* If the implementation knows how to update stat values, run it; unless
+     * the implementation is already pushing samples, in which case there is
+     * no need to query the device. */
+    if (!bearer_stats_samples_recent (self) &&
+        !self->priv->reload_stats_unsupported &&
         MM_BASE_BEARER_GET_CLASS (self)->reload_stats &&
         MM_BASE_BEARER_GET_CLASS (self)->reload_stats_finish) {
         MM_BASE_BEARER_GET_CLASS (self)->reload_stats (
@@ -405,6 +452,71 @@ bearer_stats_start (MMBaseBearer *self)
     stats_update_cb (self);
 }
 
+void
+mm_base_bearer_report_stats_sample (MMBaseBearer *self,
+                                    guint64       rx_bytes,
+                                    guint64       tx_bytes)
+{
+    StatsSample *oldest;
+    StatsSample *newest;
+    gint64       now;
+    gint64       elapsed;
+    guint64      uplink_speed = 0;
+    guint64      downlink_speed = 0;
+
+    /* Samples are only meaningful while connected */
+    if (self->priv->status != MM_BEARER_STATUS_CONNECTED || !self->priv->duration_timer)
+        return;
+
+    now = g_get_monotonic_time ();
+
+    /* If the counters went backwards, the device restarted them (e.g. a
+     * reconnection not seen by us), so start a new window */
+    if (self->priv->n_stats_samples) {
+        newest = &self->priv->stats_samples[(self->priv->stats_samples_first + self->priv->n_stats_samples - 1) % BEARER_STATS_SAMPLES_MAX];
+        if (rx_bytes < newest->rx_bytes || tx_bytes < newest->tx_bytes)
+            bearer_reset_stats_samples (self);
+    }
+
+    /* Append the new sample, dropping the oldest one if the ring is full */
+    if (self->priv->n_stats_samples == BEARER_STATS_SAMPLES_MAX) {
+        self->priv->stats_samples_first = (self->priv->stats_samples_first + 1) % BEARER_STATS_SAMPLES_MAX;
+        self->priv->n_stats_samples--;
+    }
+    newest = &self->priv->stats_samples[(self->priv->stats_samples_first + self->priv->n_stats_samples) % BEARER_STATS_SAMPLES_MAX];
+    newest->timestamp = now;
+    newest->rx_bytes = rx_bytes;
+    newest->tx_bytes = tx_bytes;
+    self->priv->n_stats_samples++;
+
+    /* Drop samples that fell out of the window */
+    while (self->priv->n_stats_samples > 1 &&
+           (now - self->priv->stats_samples[self->priv->stats_samples_first].timestamp) > BEARER_STATS_SAMPLE_WINDOW_US) {
+        self->priv->stats_samples_first = (self->priv->stats_samples_first + 1) % BEARER_STATS_SAMPLES_MAX;
+        self->priv->n_stats_samples--;
+    }
+
+    /* Throughput over the whole window, in bits per second */
+    oldest = &self->priv->stats_samples[self->priv->stats_samples_first];
+    elapsed = now - oldest->timestamp;
+    if (elapsed > 0) {
+        downlink_speed = ((newest->rx_bytes - oldest->rx_bytes) * 8 * G_USEC_PER_SEC) / elapsed;
+        uplink_speed   = ((newest->tx_bytes - oldest->tx_bytes) * 8 * G_USEC_PER_SEC) / elapsed;
+    }
+
+    if (uplink_speed != mm_bearer_stats_get_uplink_speed (self->priv->stats) ||
+        downlink_speed != mm_bearer_stats_get_downlink_speed (self->priv->stats)) {
+        mm_bearer_stats_set_uplink_speed (self->priv->stats, uplink_speed);
+        mm_bearer_stats_set_downlink_speed (self->priv->stats, downlink_speed);
+        bearer_update_interface_stats (self);
+    }
+
+    bearer_set_ongoing_interface_stats (self,
+                                        (guint32) g_timer_elapsed (self->priv->duration_timer, NULL),
+                                        rx_bytes,
+                                        tx_bytes);
+}
+
 /*****************************************************************************/
 
 static void
@@ -174,4 +174,11 @@ void mm_base_bearer_disconnect_force (MMBaseBearer *self);
 void mm_base_bearer_report_connection_status (MMBaseBearer *self,
                                               MMBearerConnectionStatus status);
 
+/* Report traffic counters of the ongoing connection, e.g. received in URCs.
+ * Throughput is computed over the last few samples, and while samples are
+ * being reported the periodic reload_stats() is skipped. */
+void mm_base_bearer_report_stats_sample (MMBaseBearer *self,
+                                         guint64       rx_bytes,
+                                         guint64       tx_bytes);
+
 #endif /* MM_BASE_BEARER_H */
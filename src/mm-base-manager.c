@@ -86,6 +86,19 @@ struct _MMBaseManagerPrivate {
     MMFilter *filter;
     /* The container of devices being prepared */
     GHashTable *devices;
+    /* Index of the ports grabbed by the devices, "subsystem/name" -> physdev uid */
+    GHashTable *ports;
+    /* Kernel events pending to be processed, one per port */
+    GQueue     *kernel_event_batch;
+    GHashTable *kernel_event_batch_ports;
+    guint       kernel_event_batch_id;
+    gint64      kernel_event_batch_start;
+    /* Kernel event batch statistics, exported in the Test interface */
+    guint       kernel_event_batches;
+    gint64      kernel_event_batches_time;
+    gint64      kernel_event_batch_last_time;
+    guint       kernel_event_batch_ports_added;
+    guint       kernel_event_batch_ports_removed;
     /* The Object Manager server */
     GDBusObjectManagerServer *object_manager;
     /* The map of inhibited devices */
@@ -100,8 +113,44 @@ struct _MMBaseManagerPrivate {
 #endif
 };
 
+/* Kernel events are processed in batches, so that bursts (e.g. after a USB hub
+ * reset) are handled at once. A batch is processed once no new event has been
+ * received for the given window, or once it gets too old. */
+#define KERNEL_EVENT_BATCH_WINDOW_MS 200
+#define KERNEL_EVENT_BATCH_MAX_MS    1000
+
 /*****************************************************************************/
 
+static gchar *
+port_key_new (const gchar *subsystem,
+              const gchar *name)
+{
+    return g_strdup_printf ("%s/%s", subsystem, name);
+}
+
+static void
+port_index_add (MMBaseManager  *self,
+                MMKernelDevice *port,
+                const gchar    *physdev_uid)
+{
+    g_hash_table_insert (self->priv->ports,
+                         port_key_new (mm_kernel_device_get_subsystem (port), mm_kernel_device_get_name (port)),
+                         g_strdup (physdev_uid));
+}
+
+static MMDevice *
+port_index_lookup (MMBaseManager *self,
+                   const gchar   *subsystem,
+                   const gchar   *name)
+{
+    g_autofree gchar *key = NULL;
+    const gchar      *physdev_uid;
+
+    key = port_key_new (subsystem, name);
+    physdev_uid = g_hash_table_lookup (self->priv->ports, key);
+    return (physdev_uid ? g_hash_table_lookup (self->priv->devices, physdev_uid) : NULL);
+}
+
 static MMDevice *
 find_device_by_modem (MMBaseManager *manager,
                       MMBaseModem *modem)
@@ -125,6 +174,18 @@ find_device_by_port (MMBaseManager  *manager,
 {
     GHashTableIter iter;
     gpointer key, value;
+    MMDevice *device;
+
+    /* The index may be stale if the device released the port on its own, so
+     * always validate what it gives */
+    device = port_index_lookup (manager, mm_kernel_device_get_subsystem (port), mm_kernel_device_get_name (port));
+    if (device && mm_device_owns_port (device, port))
+        return device;
+
+    /* Renamed ports are not indexed by their new name, so these need a full
+     * lookup comparing the old device path */
+    if (!mm_kernel_device_has_property (port, "DEVPATH_OLD"))
+        return NULL;
 
     g_hash_table_iter_init (&iter, manager->priv->devices);
     while (g_hash_table_iter_next (&iter, &key, &value)) {
@@ -143,7 +204,14 @@ find_device_by_port_name (MMBaseManager *manager,
 {
     GHashTableIter iter;
     gpointer key, value;
+    MMDevice *device;
+
+    device = port_index_lookup (manager, subsystem, name);
+    if (device && mm_device_owns_port_name (device, subsystem, name))
+        return device;
 
+    /* Not all ports are indexed (e.g. the ones of virtual devices created
+     * through the Test interface), so fallback to a full lookup */
     g_hash_table_iter_init (&iter, manager->priv->devices);
     while (g_hash_table_iter_next (&iter, &key, &value)) {
         MMDevice *candidate = MM_DEVICE (value);
@@ -239,6 +307,15 @@ device_removed (MMBaseManager *self,
     g_assert (subsystem);
     g_assert (name);
     device = find_device_by_port_name (self, subsystem, name);
+
+    /* The port is gone, so it doesn't need to be indexed any more */
+    {
+        g_autofree gchar *key = NULL;
+
+        key = port_key_new (subsystem, name);
+        g_hash_table_remove (self->priv->ports, key);
+    }
+
     if (!device) {
         /* If the device was inhibited and the port is gone, untrack it.
          * This is only needed for ports that were tracked out of device objects.
@@ -325,8 +402,11 @@ device_added (MMBaseManager  *self,
         return;
 
     /* If already added, ignore new event */
-    if (find_device_by_port (self, port)) {
+    device = find_device_by_port (self, port);
+    if (device) {
         mm_obj_dbg (self, "port %s already added", name);
+        /* Index the port also with its new name, if renamed */
+        port_index_add (self, port, mm_device_get_uid (device));
         return;
     }
 
@@ -357,6 +437,176 @@ device_added (MMBaseManager  *self,
 
     /* Grab the port in the existing device. */
     mm_device_grab_port (device, port);
+    port_index_add (self, port, physdev_uid);
+}
+
+/*****************************************************************************/
+/* Kernel event batching */
+
+typedef struct {
+    gchar          *key;
+    gchar          *subsystem;
+    gchar          *name;
+    /* Whether the port was removed at some point during the batch */
+    gboolean        removed;
+    /* Last port info reported, if the port was added afterwards */
+    MMKernelDevice *added;
+    gboolean        manual_scan;
+} KernelEventBatchPort;
+
+static void
+kernel_event_batch_port_free (KernelEventBatchPort *batch_port)
+{
+    g_free (batch_port->key);
+    g_free (batch_port->subsystem);
+    g_free (batch_port->name);
+    g_clear_object (&batch_port->added);
+    g_slice_free (KernelEventBatchPort, batch_port);
+}
+
+static void
+kernel_event_batch_clear (MMBaseManager *self)
+{
+    if (self->priv->kernel_event_batch_id) {
+        g_source_remove (self->priv->kernel_event_batch_id);
+        self->priv->kernel_event_batch_id = 0;
+    }
+    g_hash_table_remove_all (self->priv->kernel_event_batch_ports);
+    g_queue_foreach (self->priv->kernel_event_batch, (GFunc) kernel_event_batch_port_free, NULL);
+    g_queue_clear (self->priv->kernel_event_batch);
+}
+
+static gboolean
+kernel_event_batch_process (MMBaseManager *self)
+{
+    g_autoptr(GPtrArray)  physdev_uids = NULL;
+    g_autoptr(GHashTable) physdev_ports = NULL;
+    GQueue               *batch;
+    GList                *l;
+    guint                 n_removed = 0;
+    guint                 n_added = 0;
+    guint                 i;
+    gint64                start;
+    gint64                elapsed;
+
+    self->priv->kernel_event_batch_id = 0;
+    start = g_get_monotonic_time ();
+
+    /* Take the whole batch, as processing it may lead to new events */
+    batch = self->priv->kernel_event_batch;
+    self->priv->kernel_event_batch = g_queue_new ();
+    g_hash_table_remove_all (self->priv->kernel_event_batch_ports);
+
+    /* Ports removed during the batch are processed first, including the ones
+     * added again afterwards, so that these get fully reprobed */
+    for (l = batch->head; l; l = g_list_next (l)) {
+        KernelEventBatchPort *batch_port = l->data;
+
+        if (batch_port->removed) {
+            device_removed (self, batch_port->subsystem, batch_port->name);
+            n_removed++;
+        }
+    }
+
+    /* Ports added are grouped by physical device, so that each device support
+     * check is launched with as many ports as possible already grabbed */
+    physdev_uids = g_ptr_array_new ();
+    physdev_ports = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) g_ptr_array_unref);
+    for (l = batch->head; l; l = g_list_next (l)) {
+        KernelEventBatchPort *batch_port = l->data;
+        const gchar          *physdev_uid;
+        GPtrArray            *ports;
+
+        if (!batch_port->added)
+            continue;
+
+        physdev_uid = mm_kernel_device_get_physdev_uid (batch_port->added);
+        if (!physdev_uid)
+            physdev_uid = batch_port->key;
+
+        ports = g_hash_table_lookup (physdev_ports, physdev_uid);
+        if (!ports) {
+            ports = g_ptr_array_new ();
+            g_hash_table_insert (physdev_ports, (gpointer) physdev_uid, ports);
+            g_ptr_array_add (physdev_uids, (gpointer) physdev_uid);
+        }
+        g_ptr_array_add (ports, batch_port);
+    }
+
+    for (i = 0; i < physdev_uids->len; i++) {
+        GPtrArray *ports;
+        guint      j;
+
+        ports = g_hash_table_lookup (physdev_ports, g_ptr_array_index (physdev_uids, i));
+        for (j = 0; j < ports->len; j++) {
+            KernelEventBatchPort *batch_port = g_ptr_array_index (ports, j);
+
+            device_added (self, batch_port->added, TRUE, batch_port->manual_scan);
+            n_added++;
+        }
+    }
+
+    elapsed = g_get_monotonic_time () - start;
+    self->priv->kernel_event_batches++;
+    self->priv->kernel_event_batches_time += elapsed;
+    self->priv->kernel_event_batch_last_time = elapsed;
+    self->priv->kernel_event_batch_ports_added += n_added;
+    self->priv->kernel_event_batch_ports_removed += n_removed;
+    mm_obj_dbg (self, "kernel event batch processed in %.3fms: %u ports removed, %u ports added in %u devices",
+                elapsed / 1000.0, n_removed, n_added, physdev_uids->len);
+
+    g_clear_pointer (&physdev_ports, g_hash_table_unref);
+    g_queue_free_full (batch, (GDestroyNotify) kernel_event_batch_port_free);
+    return G_SOURCE_REMOVE;
+}
+
+/* Adds a new kernel event to the batch; @added given for add events, NULL for
+ * remove events. Events on the same port are collapsed into a single one. */
+static void
+kernel_event_batch_add (MMBaseManager  *self,
+                        const gchar    *subsystem,
+                        const gchar    *name,
+                        MMKernelDevice *added,
+                        gboolean        manual_scan)
+{
+    g_autofree gchar     *key = NULL;
+    KernelEventBatchPort *batch_port;
+    gint64                now;
+
+    key = port_key_new (subsystem, name);
+    batch_port = g_hash_table_lookup (self->priv->kernel_event_batch_ports, key);
+    if (!batch_port) {
+        batch_port = g_slice_new0 (KernelEventBatchPort);
+        batch_port->key = g_steal_pointer (&key);
+        batch_port->subsystem = g_strdup (subsystem);
+        batch_port->name = g_strdup (name);
+        g_queue_push_tail (self->priv->kernel_event_batch, batch_port);
+        g_hash_table_insert (self->priv->kernel_event_batch_ports, batch_port->key, batch_port);
+    }
+
+    if (added) {
+        g_clear_object (&batch_port->added);
+        batch_port->added = g_object_ref (added);
+        batch_port->manual_scan = manual_scan;
+    } else {
+        /* Anything added earlier in the batch is gone already */
+        g_clear_object (&batch_port->added);
+        batch_port->removed = TRUE;
+    }
+
+    /* Debounce: wait for the burst to finish, but not forever */
+    now = g_get_monotonic_time ();
+    if (!self->priv->kernel_event_batch_id)
+        self->priv->kernel_event_batch_start = now;
+    else if ((now - self->priv->kernel_event_batch_start) < (KERNEL_EVENT_BATCH_MAX_MS - KERNEL_EVENT_BATCH_WINDOW_MS) * 1000) {
+        g_source_remove (self->priv->kernel_event_batch_id);
+        self->priv->kernel_event_batch_id = 0;
+    } else
+        return;
+
+    self->priv->kernel_event_batch_id = g_timeout_add (KERNEL_EVENT_BATCH_WINDOW_MS,
+                                                       (GSourceFunc) kernel_event_batch_process,
+                                                       self);
 }
 
 static gboolean
@@ -415,12 +665,12 @@ handle_kernel_event (MMBaseManager            *self,
         if (!kernel_device)
             return FALSE;
 
-        device_added (self, kernel_device, TRUE, TRUE);
+        kernel_event_batch_add (self, subsystem, name, kernel_device, TRUE);
         return TRUE;
     }
 
     if (g_strcmp0 (action, "remove") == 0) {
-        device_removed (self, subsystem, name);
+        kernel_event_batch_add (self, subsystem, name, NULL, FALSE);
         return TRUE;
     }
 
@@ -438,12 +688,16 @@ handle_uevent (MMBaseManager *self,
         g_autoptr(MMKernelDevice) kernel_device = NULL;
 
         kernel_device = mm_kernel_device_udev_new (self->priv->udev, device);
-        device_added (self, kernel_device, TRUE, FALSE);
+        kernel_event_batch_add (self,
+                                mm_kernel_device_get_subsystem (kernel_device),
+                                mm_kernel_device_get_name (kernel_device),
+                                kernel_device,
+                                FALSE);
         return;
     }
 
     if (g_str_equal (action, "remove")) {
-        device_removed (self, g_udev_device_get_subsystem (device), g_udev_device_get_name (device));
+        kernel_event_batch_add (self, g_udev_device_get_subsystem (device), g_udev_device_get_name (device), NULL, FALSE);
         return;
     }
 }
@@ -631,6 +885,9 @@ mm_base_manager_shutdown (MMBaseManager *self,
     /* Cancel all ongoing auth requests */
     g_cancellable_cancel (self->priv->authp_cancellable);
 
+    /* Kernel events not yet processed are no longer relevant */
+    kernel_event_batch_clear (self);
+
     if (disable) {
         g_hash_table_foreach (self->priv->devices, (GHFunc)foreach_disable, self);
 
@@ -645,6 +902,48 @@ mm_base_manager_shutdown (MMBaseManager *self,
     g_hash_table_foreach_remove (self->priv->devices, (GHRFunc)foreach_remove, self);
 }
 
+static void
+sync_ready (MMBaseModem   *modem,
+            GAsyncResult  *res,
+            MMBaseManager *self)
+{
+    g_autoptr(GError) error = NULL;
+
+    if (mm_base_modem_sync_finish (modem, res, &error)) {
+        mm_obj_dbg (self, "modem %s kept after resume", mm_base_modem_get_device (modem));
+        g_object_unref (self);
+        return;
+    }
+
+    /* If the modem cannot be revalidated, fallback to a full reprobe */
+    mm_obj_info (self, "modem %s needs to be reprobed after resume: %s",
+                 mm_base_modem_get_device (modem), error->message);
+    mm_base_modem_set_reprobe (modem, TRUE);
+    mm_base_modem_set_valid (modem, FALSE);
+    g_object_unref (self);
+}
+
+void
+mm_base_manager_sync (MMBaseManager *self)
+{
+    GHashTableIter iter;
+    gpointer       key;
+    gpointer       value;
+
+    g_return_if_fail (self != NULL);
+    g_return_if_fail (MM_IS_BASE_MANAGER (self));
+
+    /* Revalidate all the modems kept across the suspension */
+    g_hash_table_iter_init (&iter, self->priv->devices);
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+        MMBaseModem *modem;
+
+        modem = mm_device_peek_modem (MM_DEVICE (value));
+        if (modem)
+            mm_base_modem_sync (modem, (GAsyncReadyCallback)sync_ready, g_object_ref (self));
+    }
+}
+
 guint32
 mm_base_manager_num_modems (MMBaseManager *self)
 {
@@ -1190,6 +1489,75 @@ handle_inhibit_device (MmGdbusOrgFreedesktopModemManager1 *manager,
     return TRUE;
 }
 
+/*****************************************************************************/
+/* Test statistics */
+
+static gboolean
+handle_get_stats (MmGdbusTest           *skeleton,
+                  GDBusMethodInvocation *invocation,
+                  MMBaseManager         *self)
+{
+    GVariantBuilder builder;
+    GVariantBuilder manager_builder;
+    GHashTableIter  iter;
+    gpointer        value;
+    guint           auth_cache_hits;
+    guint           auth_cache_misses;
+    guint           plugins_list_builds;
+    guint           plugins_list_candidates;
+    gint64          plugins_list_time;
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sa{sv}}"));
+
+    /* Daemon-wide statistics */
+    g_variant_builder_init (&manager_builder, G_VARIANT_TYPE ("a{sv}"));
+    mm_auth_provider_get_cache_stats (self->priv->authp, &auth_cache_hits, &auth_cache_misses);
+    g_variant_builder_add (&manager_builder, "{sv}", "auth-cache-hits", g_variant_new_uint32 (auth_cache_hits));
+    g_variant_builder_add (&manager_builder, "{sv}", "auth-cache-misses", g_variant_new_uint32 (auth_cache_misses));
+    g_variant_builder_add (&manager_builder, "{sv}", "kernel-event-batches",
+                           g_variant_new_uint32 (self->priv->kernel_event_batches));
+    g_variant_builder_add (&manager_builder, "{sv}", "kernel-event-batches-time-ms",
+                           g_variant_new_double (self->priv->kernel_event_batches_time / 1000.0));
+    g_variant_builder_add (&manager_builder, "{sv}", "kernel-event-batch-last-time-ms",
+                           g_variant_new_double (self->priv->kernel_event_batch_last_time / 1000.0));
+    g_variant_builder_add (&manager_builder, "{sv}", "kernel-event-batch-ports-added",
+                           g_variant_new_uint32 (self->priv->kernel_event_batch_ports_added));
+    g_variant_builder_add (&manager_builder, "{sv}", "kernel-event-batch-ports-removed",
+                           g_variant_new_uint32 (self->priv->kernel_event_batch_ports_removed));
+    g_variant_builder_add (&manager_builder, "{sv}", "kernel-event-batch-pending",
+                           g_variant_new_boolean (self->priv->kernel_event_batch_id != 0 ||
+                                                  !g_queue_is_empty (self->priv->kernel_event_batch)));
+    mm_plugin_manager_get_plugins_list_stats (self->priv->plugin_manager,
+                                              &plugins_list_builds,
+                                              &plugins_list_candidates,
+                                              &plugins_list_time);
+    g_variant_builder_add (&manager_builder, "{sv}", "plugins-list-builds",
+                           g_variant_new_uint32 (plugins_list_builds));
+    g_variant_builder_add (&manager_builder, "{sv}", "plugins-list-candidates",
+                           g_variant_new_uint32 (plugins_list_candidates));
+    g_variant_builder_add (&manager_builder, "{sv}", "plugins-list-time-ms",
+                           g_variant_new_double (plugins_list_time / 1000.0));
+    g_variant_builder_add (&builder, "{s@a{sv}}", MM_DBUS_PATH, g_variant_builder_end (&manager_builder));
+
+    /* Per-modem statistics, only for the modems exported */
+    g_hash_table_iter_init (&iter, self->priv->devices);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+        MMBaseModem *modem;
+        const gchar *path;
+
+        modem = mm_device_peek_modem (MM_DEVICE (value));
+        if (!modem)
+            continue;
+        path = g_dbus_object_get_object_path (G_DBUS_OBJECT (modem));
+        if (!path)
+            continue;
+        g_variant_builder_add (&builder, "{s@a{sv}}", path, mm_base_modem_get_stats (modem));
+    }
+
+    mm_gdbus_test_complete_get_stats (skeleton, invocation, g_variant_builder_end (&builder));
+    return TRUE;
+}
+
 /*****************************************************************************/
 /* Test profile setup */
 
@@ -1387,6 +1755,11 @@ mm_base_manager_init (MMBaseManager *self)
 
     /* Setup internal lists of device objects */
     self->priv->devices = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
+    self->priv->ports = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+
+    /* Setup kernel event batching */
+    self->priv->kernel_event_batch = g_queue_new ();
+    self->priv->kernel_event_batch_ports = g_hash_table_new (g_str_hash, g_str_equal);
 
     /* Setup internal list of inhibited devices */
     self->priv->inhibited_devices = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify)inhibited_device_info_free);
@@ -1453,6 +1826,10 @@ initable_init (GInitable     *initable,
                           "handle-set-profile",
                           G_CALLBACK (handle_set_profile),
                           initable);
+        g_signal_connect (self->priv->test_skeleton,
+                          "handle-get-stats",
+                          G_CALLBACK (handle_get_stats),
+                          initable);
         if (!g_dbus_interface_skeleton_export (G_DBUS_INTERFACE_SKELETON (self->priv->test_skeleton),
                                                self->priv->connection,
                                                MM_DBUS_PATH,
@@ -1472,7 +1849,12 @@ finalize (GObject *object)
     g_free (self->priv->initial_kernel_events);
     g_free (self->priv->plugin_dir);
 
+    kernel_event_batch_clear (self);
+    g_queue_free (self->priv->kernel_event_batch);
+    g_hash_table_destroy (self->priv->kernel_event_batch_ports);
+
     g_hash_table_destroy (self->priv->inhibited_devices);
+    g_hash_table_destroy (self->priv->ports);
     g_hash_table_destroy (self->priv->devices);
 
 #if defined WITH_UDEV
@@ -66,6 +66,8 @@ void             mm_base_manager_start       (MMBaseManager *manager,
 void             mm_base_manager_shutdown    (MMBaseManager *manager,
                                               gboolean disable);
 
+void             mm_base_manager_sync        (MMBaseManager *manager);
+
 guint32          mm_base_manager_num_modems  (MMBaseManager *manager);
 
 #endif /* MM_BASE_MANAGER_H */
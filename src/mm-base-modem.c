@@ -131,6 +131,14 @@ struct _MMBaseModemPrivate {
     /* Additional port links grabbed after having
      * organized ports */
     GHashTable *link_ports;
+
+    /* Coalesced DBus property updates */
+    GMainContext *property_updates_context;
+    guint         property_updates_window_id;
+    GHashTable   *property_updates_pending;
+    guint         property_updates_changes;
+    guint         property_updates_emitted;
+    guint         property_updates_merged;
 };
 
 guint
@@ -155,10 +163,14 @@ serial_port_timed_out_cb (MMPortSerial *port,
         return;
     }
 
-    if (n_consecutive_timeouts > 1)
+    if (n_consecutive_timeouts > 1) {
         mm_obj_warn (self, "port %s timed out %u consecutive times",
                      mm_port_get_device (MM_PORT (port)),
                      n_consecutive_timeouts);
+        /* Help telling a wedged port from a just slow one */
+        if (n_consecutive_timeouts == 2)
+            mm_port_serial_log_latency_stats (port);
+    }
 }
 
 static MMPort *
@@ -689,6 +701,52 @@ mm_base_modem_enable (MMBaseModem         *self,
         NULL);
 }
 
+gboolean
+mm_base_modem_sync_finish (MMBaseModem   *self,
+                           GAsyncResult  *res,
+                           GError       **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+sync_ready (MMBaseModem  *self,
+            GAsyncResult *res,
+            GTask        *task)
+{
+    GError *error = NULL;
+
+    if (!MM_BASE_MODEM_GET_CLASS (self)->sync_finish (self, res, &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+void
+mm_base_modem_sync (MMBaseModem         *self,
+                    GAsyncReadyCallback  callback,
+                    gpointer             user_data)
+{
+    GTask *task;
+
+    task = g_task_new (self, self->priv->cancellable, callback, user_data);
+
+    if (!MM_BASE_MODEM_GET_CLASS (self)->sync ||
+        !MM_BASE_MODEM_GET_CLASS (self)->sync_finish) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
+                                 "Modem synchronization is unsupported");
+        g_object_unref (task);
+        return;
+    }
+
+    MM_BASE_MODEM_GET_CLASS (self)->sync (
+        self,
+        self->priv->cancellable,
+        (GAsyncReadyCallback) sync_ready,
+        task);
+}
+
 gboolean
 mm_base_modem_initialize_finish (MMBaseModem *self,
                                  GAsyncResult *res,
@@ -1680,6 +1738,166 @@ log_object_build_id (MMLogObject *_self)
     return g_strdup_printf ("modem%u", self->priv->dbus_id);
 }
 
+/*****************************************************************************/
+/* Coalesced DBus property updates
+ *
+ * The generated DBus skeletons schedule the PropertiesChanged emission in an
+ * idle source attached to the thread-default main context found when the
+ * skeleton is created. The skeletons created with
+ * mm_base_modem_create_interface_skeleton() use a per-modem main context
+ * instead, which is dispatched once the configured window has elapsed since
+ * the first pending change. This way, all updates done on all the interfaces
+ * of the modem during the window are emitted together, and multiple updates
+ * of the same interface end up in a single signal.
+ */
+
+static gboolean
+property_updates_window_cb (MMBaseModem *self)
+{
+    guint emitted;
+    guint merged;
+
+    self->priv->property_updates_window_id = 0;
+
+    while (g_main_context_iteration (self->priv->property_updates_context, FALSE))
+        ;
+
+    emitted = g_hash_table_size (self->priv->property_updates_pending);
+    merged = self->priv->property_updates_changes - emitted;
+    g_hash_table_remove_all (self->priv->property_updates_pending);
+    self->priv->property_updates_changes = 0;
+
+    self->priv->property_updates_emitted += emitted;
+    self->priv->property_updates_merged += merged;
+
+    mm_obj_dbg (self, "property updates flushed: %u signals emitted, %u updates merged (total: %u emitted, %u merged)",
+                emitted, merged, self->priv->property_updates_emitted, self->priv->property_updates_merged);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void
+property_updates_notify_cb (GObject     *skeleton,
+                            GParamSpec  *pspec,
+                            MMBaseModem *self)
+{
+    /* Already torn down */
+    if (!self->priv->property_updates_pending)
+        return;
+
+    /* The skeleton is just used as key, never dereferenced */
+    g_hash_table_add (self->priv->property_updates_pending, skeleton);
+    self->priv->property_updates_changes++;
+
+    if (!self->priv->property_updates_window_id)
+        self->priv->property_updates_window_id = g_timeout_add (mm_context_get_properties_changed_window (),
+                                                                (GSourceFunc) property_updates_window_cb,
+                                                                self);
+}
+
+gpointer
+mm_base_modem_create_interface_skeleton (MMBaseModem *self,
+                                         GType        skeleton_type)
+{
+    gpointer skeleton;
+
+    g_assert (g_type_is_a (skeleton_type, G_TYPE_DBUS_INTERFACE_SKELETON));
+
+    if (!self->priv->property_updates_context)
+        return g_object_new (skeleton_type, NULL);
+
+    g_main_context_push_thread_default (self->priv->property_updates_context);
+    skeleton = g_object_new (skeleton_type, NULL);
+    g_main_context_pop_thread_default (self->priv->property_updates_context);
+
+    g_signal_connect_object (skeleton,
+                             "notify",
+                             G_CALLBACK (property_updates_notify_cb),
+                             self,
+                             0);
+    return skeleton;
+}
+
+void
+mm_base_modem_get_property_updates_stats (MMBaseModem *self,
+                                          guint       *emitted,
+                                          guint       *merged)
+{
+    if (emitted)
+        *emitted = self->priv->property_updates_emitted;
+    if (merged)
+        *merged = self->priv->property_updates_merged;
+}
+
+static void
+property_updates_setup (MMBaseModem *self)
+{
+    if (!mm_context_get_properties_changed_window ())
+        return;
+
+    self->priv->property_updates_context = g_main_context_new ();
+    self->priv->property_updates_pending = g_hash_table_new (g_direct_hash, g_direct_equal);
+}
+
+static void
+property_updates_teardown (MMBaseModem *self)
+{
+    if (self->priv->property_updates_window_id) {
+        g_source_remove (self->priv->property_updates_window_id);
+        self->priv->property_updates_window_id = 0;
+    }
+
+    /* The skeletons keep a reference to the context, and the sources of the
+     * pending emissions keep a reference to the skeletons; so dispatch them
+     * right away to break the cycle. The skeletons are already unexported at
+     * this point, so nothing is really emitted. */
+    if (self->priv->property_updates_context) {
+        while (g_main_context_iteration (self->priv->property_updates_context, FALSE))
+            ;
+        g_main_context_unref (self->priv->property_updates_context);
+        self->priv->property_updates_context = NULL;
+    }
+
+    if (self->priv->property_updates_pending) {
+        g_hash_table_unref (self->priv->property_updates_pending);
+        self->priv->property_updates_pending = NULL;
+    }
+}
+
+/*****************************************************************************/
+/* Internal statistics */
+
+GVariant *
+mm_base_modem_get_stats (MMBaseModem *self)
+{
+    GVariantBuilder builder;
+    GHashTableIter  iter;
+    gpointer        value;
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+
+    g_variant_builder_add (&builder, "{sv}", "property-updates-emitted",
+                           g_variant_new_uint32 (self->priv->property_updates_emitted));
+    g_variant_builder_add (&builder, "{sv}", "property-updates-merged",
+                           g_variant_new_uint32 (self->priv->property_updates_merged));
+
+    /* Response latencies of each serial port */
+    g_hash_table_iter_init (&iter, self->priv->ports);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+        g_autofree gchar *key = NULL;
+
+        if (!MM_IS_PORT_SERIAL (value))
+            continue;
+        key = g_strdup_printf ("serial-latency-%s", mm_port_get_device (MM_PORT (value)));
+        g_variant_builder_add (&builder, "{sv}", key, mm_port_serial_get_latency_stats (MM_PORT_SERIAL (value)));
+    }
+
+    if (MM_BASE_MODEM_GET_CLASS (self)->add_stats)
+        MM_BASE_MODEM_GET_CLASS (self)->add_stats (self, &builder);
+
+    return g_variant_builder_end (&builder);
+}
+
 /*****************************************************************************/
 
 static void
@@ -1711,6 +1929,8 @@ mm_base_modem_init (MMBaseModem *self)
 
     setup_ports_table (&self->priv->ports);
     setup_ports_table (&self->priv->link_ports);
+
+    property_updates_setup (self);
 }
 
 static void
@@ -1870,6 +2090,8 @@ dispose (GObject *object)
     teardown_ports_table (self, &self->priv->link_ports);
     teardown_ports_table (self, &self->priv->ports);
 
+    property_updates_teardown (self);
+
     g_clear_object (&self->priv->connection);
 
     G_OBJECT_CLASS (mm_base_modem_parent_class)->dispose (object);
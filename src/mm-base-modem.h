@@ -108,6 +108,23 @@ struct _MMBaseModemClass {
                                 GAsyncResult *res,
                                 GError **error);
 
+    /* Modem synchronization.
+     * When resuming in quick suspend/resume mode, this method revalidates
+     * the modem state and re-arms unsolicited events, so that the modem
+     * object can be kept instead of being reprobed */
+    void (* sync) (MMBaseModem *self,
+                   GCancellable *cancellable,
+                   GAsyncReadyCallback callback,
+                   gpointer user_data);
+    gboolean (*sync_finish) (MMBaseModem *self,
+                             GAsyncResult *res,
+                             GError **error);
+
+    /* Internal statistics of the modem implementation, optional; added to
+     * the ones of the base modem in mm_base_modem_get_stats() */
+    void (* add_stats) (MMBaseModem     *self,
+                        GVariantBuilder *builder);
+
     /* signals */
     void (* link_port_grabbed)  (MMBaseModem *self,
                                  MMPort      *link_port);
@@ -231,6 +248,25 @@ gboolean mm_base_modem_disable_finish (MMBaseModem *self,
                                        GAsyncResult *res,
                                        GError **error);
 
+void     mm_base_modem_sync        (MMBaseModem *self,
+                                    GAsyncReadyCallback callback,
+                                    gpointer user_data);
+gboolean mm_base_modem_sync_finish (MMBaseModem *self,
+                                    GAsyncResult *res,
+                                    GError **error);
+
 void mm_base_modem_process_sim_event (MMBaseModem *self);
 
+/* Create a DBus interface skeleton whose property updates are coalesced with
+ * the ones of all the other skeletons of the modem */
+gpointer mm_base_modem_create_interface_skeleton  (MMBaseModem *self,
+                                                   GType        skeleton_type);
+void     mm_base_modem_get_property_updates_stats (MMBaseModem *self,
+                                                   guint       *emitted,
+                                                   guint       *merged);
+
+/* Internal statistics of the modem, as a 'a{sv}' dictionary, exposed through
+ * the Test interface */
+GVariant *mm_base_modem_get_stats (MMBaseModem *self);
+
 #endif /* MM_BASE_MODEM_H */
@@ -1033,13 +1033,85 @@ sms_store (MMBaseSms *self,
 /*****************************************************************************/
 /* Send the SMS */
 
+/*
+ * All SMS objects of the same modem share a submit state, stored in the modem
+ * object. This is not a queue: messages are still sent as soon as requested,
+ * and the AT port serializes their commands. The state only keeps track of
+ * the messages being sent, so that the link to the SMSC can be kept open
+ * (+CMMS=1) while more parts or messages are waiting to be sent, and collects
+ * latency and throughput statistics.
+ */
+
+#define SUBMIT_STATE_TAG "sms-submit-state-tag"
+
+static GQuark submit_state_quark;
+
+typedef struct {
+    guint    n_pending;
+    gboolean cmms_unsupported;
+    gint64   last_completed;
+    /* Statistics collected since the state was last idle */
+    gint64   busy_since;
+    guint    n_sent;
+    guint    n_failed;
+    guint    n_parts_sent;
+    gint64   total_latency;
+    /* Statistics collected since the modem was created */
+    guint    n_sent_total;
+    guint    n_failed_total;
+    guint    n_parts_sent_total;
+    gint64   total_latency_total;
+} SmsSubmitState;
+
+static SmsSubmitState *
+peek_submit_state (MMBaseModem *modem,
+                   gboolean     create)
+{
+    SmsSubmitState *submit;
+
+    if (G_UNLIKELY (!submit_state_quark))
+        submit_state_quark = g_quark_from_static_string (SUBMIT_STATE_TAG);
+
+    submit = g_object_get_qdata (G_OBJECT (modem), submit_state_quark);
+    if (!submit && create) {
+        submit = g_new0 (SmsSubmitState, 1);
+        g_object_set_qdata_full (G_OBJECT (modem), submit_state_quark, submit, g_free);
+    }
+    return submit;
+}
+
+void
+mm_base_sms_add_submit_stats (MMBaseModem     *modem,
+                              GVariantBuilder *builder)
+{
+    SmsSubmitState *submit;
+
+    submit = peek_submit_state (modem, FALSE);
+    if (!submit)
+        return;
+
+    g_variant_builder_add (builder, "{sv}", "sms-sent", g_variant_new_uint32 (submit->n_sent_total));
+    g_variant_builder_add (builder, "{sv}", "sms-failed", g_variant_new_uint32 (submit->n_failed_total));
+    g_variant_builder_add (builder, "{sv}", "sms-parts-sent", g_variant_new_uint32 (submit->n_parts_sent_total));
+    g_variant_builder_add (builder, "{sv}", "sms-average-latency-ms",
+                           g_variant_new_uint32 (submit->n_sent_total ?
+                                                 (guint) ((submit->total_latency_total / submit->n_sent_total) / 1000) :
+                                                 0));
+}
+
 typedef struct {
     MMBaseModem *modem;
+    SmsSubmitState *submit;
     gboolean need_unlock;
     gboolean from_storage;
     gboolean use_pdu_mode;
     GList *current;
-    gchar *msg_data;
+    /* Commands and message data of each part, pre-encoded before sending
+     * the first one (generic send only) */
+    GPtrArray *cmds;
+    GPtrArray *msg_data;
+    guint current_i;
+    gint64 started;
 } SmsSendContext;
 
 static void
@@ -1048,8 +1120,11 @@ sms_send_context_free (SmsSendContext *ctx)
     /* Unlock mem2 storage if we had the lock */
     if (ctx->need_unlock)
         mm_broadband_modem_unlock_sms_storages (MM_BROADBAND_MODEM (ctx->modem), FALSE, TRUE);
+    if (ctx->cmds)
+        g_ptr_array_unref (ctx->cmds);
+    if (ctx->msg_data)
+        g_ptr_array_unref (ctx->msg_data);
     g_object_unref (ctx->modem);
-    g_free (ctx->msg_data);
     g_free (ctx);
 }
 
@@ -1061,8 +1136,102 @@ sms_send_finish (MMBaseSms *self,
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
+static void
+sms_send_complete (GTask  *task,
+                   GError *error)
+{
+    MMBaseSms *self;
+    SmsSendContext *ctx;
+    SmsSubmitState *submit;
+    gint64 now;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+    submit = ctx->submit;
+
+    now = g_get_monotonic_time ();
+    g_assert (submit->n_pending > 0);
+    submit->n_pending--;
+    submit->last_completed = now;
+
+    if (error) {
+        submit->n_failed++;
+        submit->n_failed_total++;
+    } else {
+        submit->n_sent++;
+        submit->n_parts_sent += ctx->current_i;
+        submit->total_latency += now - ctx->started;
+        submit->n_sent_total++;
+        submit->n_parts_sent_total += ctx->current_i;
+        submit->total_latency_total += now - ctx->started;
+        mm_obj_dbg (self, "SMS sent in %" G_GINT64_FORMAT "ms (%u parts)",
+                    (now - ctx->started) / 1000, ctx->current_i);
+    }
+
+    /* Report throughput once a batch of messages has been sent */
+    if (submit->n_pending == 0) {
+        if (submit->n_sent + submit->n_failed > 1) {
+            gdouble elapsed;
+
+            elapsed = (gdouble)(now - submit->busy_since) / G_USEC_PER_SEC;
+            mm_obj_info (self, "SMS submission idle: %u messages (%u parts) sent and %u failed in %.1fs "
+                         "(%.1f messages/min, average latency %" G_GINT64_FORMAT "ms)",
+                         submit->n_sent, submit->n_parts_sent, submit->n_failed, elapsed,
+                         elapsed > 0 ? (submit->n_sent * 60.0) / elapsed : 0.0,
+                         submit->n_sent ? (submit->total_latency / submit->n_sent) / 1000 : 0);
+        }
+        submit->n_sent = 0;
+        submit->n_failed = 0;
+        submit->n_parts_sent = 0;
+        submit->total_latency = 0;
+    }
+
+    if (error)
+        g_task_return_error (task, error);
+    else
+        g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
 static void sms_send_next_part (GTask *task);
 
+static gboolean
+sms_send_encode_parts (MMBaseSms       *self,
+                       SmsSendContext  *ctx,
+                       GError         **error)
+{
+    GList *l;
+
+    if (ctx->cmds)
+        return TRUE;
+
+    /* Encode all parts before sending the first one, so that once the
+     * sending starts each part is written right after the previous one is
+     * acknowledged, and so that a part failing to encode doesn't leave the
+     * message half-sent */
+    ctx->cmds = g_ptr_array_new_with_free_func (g_free);
+    ctx->msg_data = g_ptr_array_new_with_free_func (g_free);
+    for (l = self->priv->parts; l; l = g_list_next (l)) {
+        gchar *cmd = NULL;
+        gchar *msg_data = NULL;
+
+        if (!sms_get_store_or_send_command (self,
+                                            (MMSmsPart *)l->data,
+                                            ctx->use_pdu_mode,
+                                            TRUE,
+                                            &cmd,
+                                            &msg_data,
+                                            error))
+            return FALSE;
+
+        g_assert (cmd != NULL);
+        g_assert (msg_data != NULL);
+        g_ptr_array_add (ctx->cmds, cmd);
+        g_ptr_array_add (ctx->msg_data, msg_data);
+    }
+    return TRUE;
+}
+
 static gint
 read_message_reference_from_reply (const gchar *response,
                                    GError **error)
@@ -1100,15 +1269,13 @@ send_generic_msg_data_ready (MMBaseModem *modem,
 
     response = mm_base_modem_at_command_finish (modem, res, &error);
     if (error) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
+        sms_send_complete (task, error);
         return;
     }
 
     message_reference = read_message_reference_from_reply (response, &error);
     if (error) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
+        sms_send_complete (task, error);
         return;
     }
 
@@ -1118,6 +1285,7 @@ send_generic_msg_data_ready (MMBaseModem *modem,
                                        (guint)message_reference);
 
     ctx->current = g_list_next (ctx->current);
+    ctx->current_i++;
     sms_send_next_part (task);
 }
 
@@ -1131,8 +1299,7 @@ send_generic_ready (MMBaseModem *modem,
 
     mm_base_modem_at_command_finish (modem, res, &error);
     if (error) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
+        sms_send_complete (task, error);
         return;
     }
 
@@ -1144,7 +1311,7 @@ send_generic_ready (MMBaseModem *modem,
      * with AT+ and suffixed with <CR><LF>), plus, we want it to be
      * sent right away (not queued after other AT commands). */
     mm_base_modem_at_command_raw (ctx->modem,
-                                  ctx->msg_data,
+                                  g_ptr_array_index (ctx->msg_data, ctx->current_i),
                                   MM_BASE_SMS_DEFAULT_SEND_TIMEOUT,
                                   FALSE,
                                   (GAsyncReadyCallback)send_generic_msg_data_ready,
@@ -1168,8 +1335,7 @@ send_from_storage_ready (MMBaseModem *modem,
     response = mm_base_modem_at_command_finish (modem, res, &error);
     if (error) {
         if (g_error_matches (error, MM_SERIAL_ERROR, MM_SERIAL_ERROR_RESPONSE_TIMEOUT)) {
-            g_task_return_error (task, error);
-            g_object_unref (task);
+            sms_send_complete (task, error);
             return;
         }
 
@@ -1183,8 +1349,7 @@ send_from_storage_ready (MMBaseModem *modem,
 
     message_reference = read_message_reference_from_reply (response, &error);
     if (error) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
+        sms_send_complete (task, error);
         return;
     }
 
@@ -1192,6 +1357,7 @@ send_from_storage_ready (MMBaseModem *modem,
                                        (guint)message_reference);
 
     ctx->current = g_list_next (ctx->current);
+    ctx->current_i++;
     sms_send_next_part (task);
 }
 
@@ -1208,8 +1374,7 @@ sms_send_next_part (GTask *task)
 
     if (!ctx->current) {
         /* Done we are */
-        g_task_return_boolean (task, TRUE);
-        g_object_unref (task);
+        sms_send_complete (task, NULL);
         return;
     }
 
@@ -1227,33 +1392,72 @@ sms_send_next_part (GTask *task)
         return;
     }
 
-    /* Generic send */
-
-    g_clear_pointer (&ctx->msg_data, g_free);
-
-    if (!sms_get_store_or_send_command (self,
-                                        (MMSmsPart *)ctx->current->data,
-                                        ctx->use_pdu_mode,
-                                        TRUE,
-                                        &cmd,
-                                        &ctx->msg_data,
-                                        &error)) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
+    /* Generic send; parts are encoded right away if not already done (e.g.
+     * when falling back from a send from storage) */
+    if (!sms_send_encode_parts (self, ctx, &error)) {
+        sms_send_complete (task, error);
         return;
     }
 
-    g_assert (cmd != NULL);
-    g_assert (ctx->msg_data != NULL);
-
     /* no network involved in this initial AT command, so lower timeout */
     mm_base_modem_at_command (ctx->modem,
-                              cmd,
+                              g_ptr_array_index (ctx->cmds, ctx->current_i),
                               10,
                               FALSE,
                               (GAsyncReadyCallback)send_generic_ready,
                               task);
-    g_free (cmd);
+}
+
+static void
+cmms_ready (MMBaseModem  *modem,
+            GAsyncResult *res,
+            GTask        *task)
+{
+    MMBaseSms *self;
+    SmsSendContext *ctx;
+    GError *error = NULL;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    /* Not critical, parts are sent anyway */
+    if (!mm_base_modem_at_command_finish (modem, res, &error)) {
+        mm_obj_dbg (self, "couldn't keep the SMS relay link open: %s", error->message);
+        /* Don't retry on modems rejecting the command */
+        if (mm_3gpp_cmms_error_is_unsupported (error))
+            ctx->submit->cmms_unsupported = TRUE;
+        g_error_free (error);
+    }
+
+    sms_send_next_part (task);
+}
+
+static void
+sms_send_start (GTask *task)
+{
+    MMBaseSms *self;
+    SmsSendContext *ctx;
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    ctx->current = self->priv->parts;
+
+    if (!mm_3gpp_sms_submit_keep_link_open (g_list_length (ctx->current),
+                                            ctx->submit->n_pending,
+                                            ctx->submit->last_completed,
+                                            ctx->started,
+                                            ctx->submit->cmms_unsupported)) {
+        sms_send_next_part (task);
+        return;
+    }
+
+    mm_base_modem_at_command (ctx->modem,
+                              "+CMMS=1",
+                              3,
+                              FALSE,
+                              (GAsyncReadyCallback)cmms_ready,
+                              task);
 }
 
 static void
@@ -1261,17 +1465,14 @@ send_lock_sms_storages_ready (MMBroadbandModem *modem,
                               GAsyncResult *res,
                               GTask *task)
 {
-    MMBaseSms *self;
     SmsSendContext *ctx;
     GError *error = NULL;
 
     if (!mm_broadband_modem_lock_sms_storages_finish (modem, res, &error)) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
+        sms_send_complete (task, error);
         return;
     }
 
-    self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
     /* We are now locked. Whatever result we have here, we need to make sure
@@ -1279,8 +1480,7 @@ send_lock_sms_storages_ready (MMBroadbandModem *modem,
     ctx->need_unlock = TRUE;
 
     /* Go on to send the parts */
-    ctx->current = self->priv->parts;
-    sms_send_next_part (task);
+    sms_send_start (task);
 }
 
 static void
@@ -1294,10 +1494,21 @@ sms_send (MMBaseSms *self,
     /* Setup the context */
     ctx = g_new0 (SmsSendContext, 1);
     ctx->modem = g_object_ref (self->priv->modem);
+    ctx->started = g_get_monotonic_time ();
+
+    /* Register the message in the submit state of the modem */
+    ctx->submit = peek_submit_state (ctx->modem, TRUE);
+    if (ctx->submit->n_pending++ == 0)
+        ctx->submit->busy_since = ctx->started;
 
     task = g_task_new (self, NULL, callback, user_data);
     g_task_set_task_data (task, ctx, (GDestroyNotify)sms_send_context_free);
 
+    /* Different ways to do it if on PDU or text mode */
+    g_object_get (self->priv->modem,
+                  MM_IFACE_MODEM_MESSAGING_SMS_PDU_MODE, &ctx->use_pdu_mode,
+                  NULL);
+
     /* If the SMS is STORED, try to send from storage */
     ctx->from_storage = (mm_base_sms_get_storage (self) != MM_SMS_STORAGE_UNKNOWN);
     if (ctx->from_storage) {
@@ -1312,12 +1523,7 @@ sms_send (MMBaseSms *self,
         return;
     }
 
-    /* Different ways to do it if on PDU or text mode */
-    g_object_get (self->priv->modem,
-                  MM_IFACE_MODEM_MESSAGING_SMS_PDU_MODE, &ctx->use_pdu_mode,
-                  NULL);
-    ctx->current = self->priv->parts;
-    sms_send_next_part (task);
+    sms_send_start (task);
 }
 
 /*****************************************************************************/
@@ -132,4 +132,8 @@ gboolean mm_base_sms_delete_finish (MMBaseSms *self,
                                     GAsyncResult *res,
                                     GError **error);
 
+/* Adds the statistics of the SMS sent by the given modem */
+void mm_base_sms_add_submit_stats (MMBaseModem     *modem,
+                                   GVariantBuilder *builder);
+
 #endif /* MM_BASE_SMS_H */
@@ -415,10 +415,12 @@ static void cleanup_event_report_unsolicited_events (MMBearerQmi *self,
 typedef enum {
     CONNECT_STEP_FIRST,
     CONNECT_STEP_OPEN_QMI_PORT,
+    CONNECT_STEP_ALLOCATE_WDS_CLIENTS,
     CONNECT_STEP_SETUP_DATA_FORMAT,
     CONNECT_STEP_SETUP_LINK,
     CONNECT_STEP_SETUP_LINK_MASTER_UP,
     CONNECT_STEP_IP_METHOD,
+    CONNECT_STEP_WAIT_WDS_CLIENTS,
     CONNECT_STEP_IPV4,
     CONNECT_STEP_WDS_CLIENT_IPV4,
     CONNECT_STEP_IP_FAMILY_IPV4,
@@ -458,6 +460,9 @@ typedef struct {
 
     MMBearerIpMethod ip_method;
 
+    guint    n_wds_clients_allocating;
+    gboolean wds_clients_waiting;
+
     gboolean ipv4;
     gboolean running_ipv4;
     QmiClientWds *client_ipv4;
@@ -1336,6 +1341,53 @@ qmi_port_allocate_client_ready (MMPortQmi *qmi,
     connect_context_step (task);
 }
 
+static void
+qmi_port_allocate_client_early_ready (MMPortQmi    *qmi,
+                                      GAsyncResult *res,
+                                      GTask        *task)
+{
+    ConnectContext    *ctx;
+    g_autoptr(GError)  error = NULL;
+
+    ctx = g_task_get_task_data (task);
+
+    /* Errors are not fatal here, the allocation is retried (and the error
+     * reported) once the client is actually needed */
+    if (!mm_port_qmi_allocate_client_finish (qmi, res, &error))
+        mm_obj_dbg (ctx->self, "couldn't allocate WDS client in advance: %s", error->message);
+
+    g_assert (ctx->n_wds_clients_allocating > 0);
+    ctx->n_wds_clients_allocating--;
+
+    /* Resume the connection sequence if it was waiting for the clients */
+    if (!ctx->n_wds_clients_allocating && ctx->wds_clients_waiting) {
+        ctx->wds_clients_waiting = FALSE;
+        connect_context_step (task);
+    }
+
+    g_object_unref (task);
+}
+
+static void
+allocate_client_early (GTask         *task,
+                       MMPortQmiFlag  flag)
+{
+    ConnectContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+
+    if (mm_port_qmi_peek_client (ctx->qmi, QMI_SERVICE_WDS, flag))
+        return;
+
+    ctx->n_wds_clients_allocating++;
+    mm_port_qmi_allocate_client (ctx->qmi,
+                                 QMI_SERVICE_WDS,
+                                 flag,
+                                 g_task_get_cancellable (task),
+                                 (GAsyncReadyCallback)qmi_port_allocate_client_early_ready,
+                                 g_object_ref (task));
+}
+
 static void
 master_interface_up_ready (MMPortNet    *link,
                            GAsyncResult *res,
@@ -1534,6 +1586,16 @@ connect_context_step (GTask *task)
         ctx->step++;
         /* fall through */
 
+    case CONNECT_STEP_ALLOCATE_WDS_CLIENTS:
+        /* The WDS clients are allocated in parallel to the data format and
+         * link setup, as these operations are independent from each other */
+        if (ctx->ipv4)
+            allocate_client_early (task, MM_PORT_QMI_FLAG_WDS_IPV4);
+        if (ctx->ipv6)
+            allocate_client_early (task, MM_PORT_QMI_FLAG_WDS_IPV6);
+        ctx->step++;
+        /* fall through */
+
     case CONNECT_STEP_SETUP_DATA_FORMAT: {
         MMPortQmiSetupDataFormatAction action;
 
@@ -1602,6 +1664,15 @@ connect_context_step (GTask *task)
         ctx->step++;
         /* fall through */
 
+    case CONNECT_STEP_WAIT_WDS_CLIENTS:
+        if (ctx->n_wds_clients_allocating) {
+            mm_obj_dbg (self, "waiting for WDS clients to be allocated...");
+            ctx->wds_clients_waiting = TRUE;
+            return;
+        }
+        ctx->step++;
+        /* fall through */
+
     case CONNECT_STEP_IPV4:
         /* If no IPv4 setup needed, jump to IPv6 */
         if (!ctx->ipv4) {
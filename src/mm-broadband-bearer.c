@@ -661,11 +661,20 @@ cgdcont_set_ready (MMBaseModem  *modem,
     mm_base_modem_at_command_full_finish (modem, res, &error);
     if (error) {
         mm_obj_warn (self, "couldn't initialize context: %s", error->message);
+        if (MM_IS_BROADBAND_MODEM (modem))
+            mm_broadband_modem_invalidate_cached_pdp_context_list (MM_BROADBAND_MODEM (modem));
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
     }
 
+    /* Keep the cached context list in sync with what we just defined */
+    if (MM_IS_BROADBAND_MODEM (modem))
+        mm_broadband_modem_update_cached_pdp_context (MM_BROADBAND_MODEM (modem),
+                                                      ctx->cid,
+                                                      ctx->ip_family,
+                                                      mm_bearer_properties_get_apn (mm_base_bearer_peek_config (MM_BASE_BEARER (self))));
+
     ctx->step++;
     cid_selection_3gpp_context_step (task);
 }
@@ -758,12 +767,19 @@ cgdcont_query_ready (MMBaseModem  *modem,
 
     /* Build context list */
     ctx->context_list = mm_3gpp_parse_cgdcont_read_response (response, &error);
+    if (error) {
+        mm_obj_dbg (self, "failed parsing currently defined contexts: %s", error->message);
+        g_clear_error (&error);
+        goto out;
+    }
+
+    /* A successfully parsed list (even an empty one) can be reused in
+     * the next connection attempts */
+    if (MM_IS_BROADBAND_MODEM (modem))
+        mm_broadband_modem_set_cached_pdp_context_list (MM_BROADBAND_MODEM (modem), ctx->context_list);
+
     if (!ctx->context_list) {
-        if (error) {
-            mm_obj_dbg (self, "failed parsing currently defined contexts: %s", error->message);
-            g_clear_error (&error);
-        } else
-            mm_obj_dbg (self, "no contexts currently defined");
+        mm_obj_dbg (self, "no contexts currently defined");
         goto out;
     }
 
@@ -795,6 +811,15 @@ cid_selection_3gpp_query_current (GTask *task)
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
+    /* Avoid the +CGDCONT? round trip if we already know the contexts */
+    if (MM_IS_BROADBAND_MODEM (ctx->modem) &&
+        mm_broadband_modem_get_cached_pdp_context_list (MM_BROADBAND_MODEM (ctx->modem), &ctx->context_list)) {
+        mm_obj_dbg (self, "using cached list of %u PDP contexts", g_list_length (ctx->context_list));
+        ctx->step++;
+        cid_selection_3gpp_context_step (task);
+        return;
+    }
+
     mm_obj_dbg (self, "checking currently defined contexts...");
     mm_base_modem_at_command_full (ctx->modem,
                                    ctx->primary,
@@ -1013,6 +1038,10 @@ dial_3gpp_ready (MMBroadbandBearer *self,
     if (!ctx->data) {
         /* Clear CID when it failed to connect. */
         self->priv->cid = 0;
+        /* The context definitions may not be what we think they are, so
+         * query them again in the next attempt */
+        if (MM_IS_BROADBAND_MODEM (ctx->modem))
+            mm_broadband_modem_invalidate_cached_pdp_context_list (MM_BROADBAND_MODEM (ctx->modem));
         g_task_return_error (task, error);
         g_object_unref (task);
         return;
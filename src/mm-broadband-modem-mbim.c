@@ -94,6 +94,18 @@ enum {
 };
 #endif
 
+/* Queries sent together with the device services one during initialization,
+ * see init_prefetch_requests */
+typedef enum {
+    INIT_PREFETCH_DEVICE_CAPS,
+    INIT_PREFETCH_SUBSCRIBER_READY_STATUS,
+    INIT_PREFETCH_RADIO_STATE,
+    INIT_PREFETCH_PIN,
+    INIT_PREFETCH_PIN_LIST,
+    INIT_PREFETCH_LTE_ATTACH_CONFIGURATION,
+    INIT_PREFETCH_LAST
+} InitPrefetch;
+
 struct _MMBroadbandModemMbimPrivate {
     /* Queried and cached capabilities */
     MbimCellularClass caps_cellular_class;
@@ -136,6 +148,15 @@ struct _MMBroadbandModemMbimPrivate {
     /* For notifying when the mbim-proxy connection is dead */
     gulong mbim_device_removed_id;
 
+    /* SMS sync */
+    GArray   *sms_sync_pending_indices;
+    guint     sms_sync_timeout_id;
+    gboolean  sms_sync_running;
+
+    /* Results prefetched during initialization */
+    gpointer init_prefetched[INIT_PREFETCH_LAST];
+    gint64   init_prefetch_time;
+
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
     gboolean qmi_unsupported;
     /* Flag when QMI-based capability/mode switching is in use */
@@ -169,6 +190,397 @@ peek_device (gpointer self,
     return TRUE;
 }
 
+/*****************************************************************************/
+/* Typed results of the basic queries
+ *
+ * The responses of the queries that may be prefetched during initialization
+ * are parsed into these, both when prefetched and when queried on demand. */
+
+static gpointer
+command_response_parse (MbimDevice                *device,
+                        GAsyncResult              *res,
+                        MMPortMbimBatchParseFunc   parse,
+                        GError                   **error)
+{
+    g_autoptr(MbimMessage) response = NULL;
+
+    response = mbim_device_command_finish (device, res, error);
+    if (!response || !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, error))
+        return NULL;
+    return parse (response, error);
+}
+
+typedef struct {
+    guint32                    n_elements;
+    MbimDeviceServiceElement **elements;
+} DeviceServices;
+
+static void
+device_services_free (DeviceServices *services)
+{
+    mbim_device_service_element_array_free (services->elements);
+    g_slice_free (DeviceServices, services);
+}
+
+static gpointer
+device_services_response_parse (MbimMessage  *response,
+                                GError      **error)
+{
+    DeviceServices *services;
+
+    services = g_slice_new0 (DeviceServices);
+    if (!mbim_message_device_services_response_parse (
+            response,
+            &services->n_elements,
+            NULL, /* max_dss_sessions */
+            &services->elements,
+            error)) {
+        g_slice_free (DeviceServices, services);
+        return NULL;
+    }
+    return services;
+}
+
+typedef struct {
+    MbimCellularClass  cellular_class;
+    MbimDataClass      data_class;
+    MbimSmsCaps        sms;
+    guint32            max_sessions;
+    gchar             *custom_data_class;
+    gchar             *device_id;
+    gchar             *firmware_info;
+    gchar             *hardware_info;
+} DeviceCaps;
+
+static void
+device_caps_free (DeviceCaps *caps)
+{
+    g_free (caps->custom_data_class);
+    g_free (caps->device_id);
+    g_free (caps->firmware_info);
+    g_free (caps->hardware_info);
+    g_slice_free (DeviceCaps, caps);
+}
+
+static gpointer
+device_caps_response_parse (MbimMessage  *response,
+                            GError      **error)
+{
+    DeviceCaps *caps;
+
+    caps = g_slice_new0 (DeviceCaps);
+    if (!mbim_message_device_caps_response_parse (
+            response,
+            NULL, /* device_type */
+            &caps->cellular_class,
+            NULL, /* voice_class */
+            NULL, /* sim_class */
+            &caps->data_class,
+            &caps->sms,
+            NULL, /* ctrl_caps */
+            &caps->max_sessions,
+            &caps->custom_data_class,
+            &caps->device_id,
+            &caps->firmware_info,
+            &caps->hardware_info,
+            error)) {
+        device_caps_free (caps);
+        return NULL;
+    }
+    return caps;
+}
+
+typedef struct {
+    MbimSubscriberReadyState ready_state;
+} SubscriberReadyStatus;
+
+static void
+subscriber_ready_status_free (SubscriberReadyStatus *status)
+{
+    g_slice_free (SubscriberReadyStatus, status);
+}
+
+static gpointer
+subscriber_ready_status_response_parse (MbimMessage  *response,
+                                        GError      **error)
+{
+    SubscriberReadyStatus *status;
+
+    status = g_slice_new0 (SubscriberReadyStatus);
+    if (!mbim_message_subscriber_ready_status_response_parse (
+            response,
+            &status->ready_state,
+            NULL, /* subscriber_id */
+            NULL, /* sim_iccid */
+            NULL, /* ready_info */
+            NULL, /* telephone_numbers_count */
+            NULL, /* telephone_numbers */
+            error)) {
+        subscriber_ready_status_free (status);
+        return NULL;
+    }
+    return status;
+}
+
+typedef struct {
+    MbimRadioSwitchState hardware_radio_state;
+    MbimRadioSwitchState software_radio_state;
+} RadioState;
+
+static void
+radio_state_free (RadioState *state)
+{
+    g_slice_free (RadioState, state);
+}
+
+static gpointer
+radio_state_response_parse (MbimMessage  *response,
+                            GError      **error)
+{
+    RadioState *state;
+
+    state = g_slice_new0 (RadioState);
+    if (!mbim_message_radio_state_response_parse (
+            response,
+            &state->hardware_radio_state,
+            &state->software_radio_state,
+            error)) {
+        radio_state_free (state);
+        return NULL;
+    }
+    return state;
+}
+
+typedef struct {
+    MbimPinType  pin_type;
+    MbimPinState pin_state;
+    guint32      remaining_attempts;
+} PinState;
+
+static void
+pin_state_free (PinState *state)
+{
+    g_slice_free (PinState, state);
+}
+
+static gpointer
+pin_response_parse (MbimMessage  *response,
+                    GError      **error)
+{
+    PinState *state;
+
+    state = g_slice_new0 (PinState);
+    if (!mbim_message_pin_response_parse (
+            response,
+            &state->pin_type,
+            &state->pin_state,
+            &state->remaining_attempts,
+            error)) {
+        pin_state_free (state);
+        return NULL;
+    }
+    return state;
+}
+
+typedef struct {
+    MMModem3gppFacility enabled_facilities;
+} PinList;
+
+static void
+pin_list_free (PinList *list)
+{
+    g_slice_free (PinList, list);
+}
+
+static gpointer
+pin_list_response_parse (MbimMessage  *response,
+                         GError      **error)
+{
+    PinList     *list;
+    MbimPinDesc *pin_desc_pin1;
+    MbimPinDesc *pin_desc_pin2;
+    MbimPinDesc *pin_desc_device_sim_pin;
+    MbimPinDesc *pin_desc_device_first_sim_pin;
+    MbimPinDesc *pin_desc_network_pin;
+    MbimPinDesc *pin_desc_network_subset_pin;
+    MbimPinDesc *pin_desc_service_provider_pin;
+    MbimPinDesc *pin_desc_corporate_pin;
+
+    if (!mbim_message_pin_list_response_parse (
+            response,
+            &pin_desc_pin1,
+            &pin_desc_pin2,
+            &pin_desc_device_sim_pin,
+            &pin_desc_device_first_sim_pin,
+            &pin_desc_network_pin,
+            &pin_desc_network_subset_pin,
+            &pin_desc_service_provider_pin,
+            &pin_desc_corporate_pin,
+            NULL, /* pin_desc_subsidy_lock */
+            NULL, /* pin_desc_custom */
+            error))
+        return NULL;
+
+    list = g_slice_new0 (PinList);
+
+    if (pin_desc_pin1->pin_mode == MBIM_PIN_MODE_ENABLED)
+        list->enabled_facilities |= MM_MODEM_3GPP_FACILITY_SIM;
+    mbim_pin_desc_free (pin_desc_pin1);
+
+    if (pin_desc_pin2->pin_mode == MBIM_PIN_MODE_ENABLED)
+        list->enabled_facilities |= MM_MODEM_3GPP_FACILITY_FIXED_DIALING;
+    mbim_pin_desc_free (pin_desc_pin2);
+
+    if (pin_desc_device_sim_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
+        list->enabled_facilities |= MM_MODEM_3GPP_FACILITY_PH_SIM;
+    mbim_pin_desc_free (pin_desc_device_sim_pin);
+
+    if (pin_desc_device_first_sim_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
+        list->enabled_facilities |= MM_MODEM_3GPP_FACILITY_PH_FSIM;
+    mbim_pin_desc_free (pin_desc_device_first_sim_pin);
+
+    if (pin_desc_network_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
+        list->enabled_facilities |= MM_MODEM_3GPP_FACILITY_NET_PERS;
+    mbim_pin_desc_free (pin_desc_network_pin);
+
+    if (pin_desc_network_subset_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
+        list->enabled_facilities |= MM_MODEM_3GPP_FACILITY_NET_SUB_PERS;
+    mbim_pin_desc_free (pin_desc_network_subset_pin);
+
+    if (pin_desc_service_provider_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
+        list->enabled_facilities |= MM_MODEM_3GPP_FACILITY_PROVIDER_PERS;
+    mbim_pin_desc_free (pin_desc_service_provider_pin);
+
+    if (pin_desc_corporate_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
+        list->enabled_facilities |= MM_MODEM_3GPP_FACILITY_CORP_PERS;
+    mbim_pin_desc_free (pin_desc_corporate_pin);
+
+    return list;
+}
+
+typedef struct {
+    guint32                      n_configurations;
+    MbimLteAttachConfiguration **configurations;
+} LteAttachConfigurations;
+
+static void
+lte_attach_configurations_free (LteAttachConfigurations *configurations)
+{
+    mbim_lte_attach_configuration_array_free (configurations->configurations);
+    g_slice_free (LteAttachConfigurations, configurations);
+}
+
+static gpointer
+lte_attach_configuration_response_parse (MbimMessage  *response,
+                                         GError      **error)
+{
+    LteAttachConfigurations *configurations;
+
+    configurations = g_slice_new0 (LteAttachConfigurations);
+    if (!mbim_message_ms_basic_connect_extensions_lte_attach_configuration_response_parse (
+            response,
+            &configurations->n_configurations,
+            &configurations->configurations,
+            error)) {
+        g_slice_free (LteAttachConfigurations, configurations);
+        return NULL;
+    }
+    return configurations;
+}
+
+/*****************************************************************************/
+/* Results prefetched during initialization */
+
+/* Prefetched results are only used by the initialization steps that run
+ * right after the prefetch; anything older is considered stale. */
+#define INIT_PREFETCH_MAX_AGE_SECS 10
+
+typedef struct {
+    const gchar              *name;
+    MbimMessage            *(* message_new) (GError **error);
+    MMPortMbimBatchParseFunc  parse;
+    GDestroyNotify            result_free;
+} InitPrefetchRequest;
+
+/* The LTE attach configuration query is sent even before knowing whether the
+ * device supports it (that is only known once the device services reply is
+ * processed); devices without support just reply with an error status. */
+static const InitPrefetchRequest init_prefetch_requests[INIT_PREFETCH_LAST] = {
+    [INIT_PREFETCH_DEVICE_CAPS] = {
+        "device caps",
+        mbim_message_device_caps_query_new,
+        device_caps_response_parse,
+        (GDestroyNotify) device_caps_free
+    },
+    [INIT_PREFETCH_SUBSCRIBER_READY_STATUS] = {
+        "subscriber ready status",
+        mbim_message_subscriber_ready_status_query_new,
+        subscriber_ready_status_response_parse,
+        (GDestroyNotify) subscriber_ready_status_free
+    },
+    [INIT_PREFETCH_RADIO_STATE] = {
+        "radio state",
+        mbim_message_radio_state_query_new,
+        radio_state_response_parse,
+        (GDestroyNotify) radio_state_free
+    },
+    [INIT_PREFETCH_PIN] = {
+        "pin",
+        mbim_message_pin_query_new,
+        pin_response_parse,
+        (GDestroyNotify) pin_state_free
+    },
+    [INIT_PREFETCH_PIN_LIST] = {
+        "pin list",
+        mbim_message_pin_list_query_new,
+        pin_list_response_parse,
+        (GDestroyNotify) pin_list_free
+    },
+    [INIT_PREFETCH_LTE_ATTACH_CONFIGURATION] = {
+        "lte attach configuration",
+        mbim_message_ms_basic_connect_extensions_lte_attach_configuration_query_new,
+        lte_attach_configuration_response_parse,
+        (GDestroyNotify) lte_attach_configurations_free
+    },
+};
+
+static void
+init_prefetch_drop (MMBroadbandModemMbim *self,
+                    InitPrefetch          which)
+{
+    if (self->priv->init_prefetched[which]) {
+        init_prefetch_requests[which].result_free (self->priv->init_prefetched[which]);
+        self->priv->init_prefetched[which] = NULL;
+    }
+}
+
+static void
+init_prefetch_clear (MMBroadbandModemMbim *self)
+{
+    guint i;
+
+    for (i = 0; i < INIT_PREFETCH_LAST; i++)
+        init_prefetch_drop (self, i);
+}
+
+/* Each prefetched result is used at most once, so that any later query
+ * always goes to the device. The result is transferred to the caller. */
+static gpointer
+init_prefetch_take (MMBroadbandModemMbim *self,
+                    InitPrefetch          which)
+{
+    if (!self->priv->init_prefetched[which])
+        return NULL;
+
+    if ((g_get_monotonic_time () - self->priv->init_prefetch_time) > (INIT_PREFETCH_MAX_AGE_SECS * G_USEC_PER_SEC)) {
+        init_prefetch_clear (self);
+        return NULL;
+    }
+
+    mm_obj_dbg (self, "using %s result prefetched during initialization", init_prefetch_requests[which].name);
+    return g_steal_pointer (&self->priv->init_prefetched[which]);
+}
+
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
 
 static QmiClient *
@@ -421,49 +833,52 @@ complete_current_capabilities (GTask *task)
 }
 
 static void
-device_caps_query_ready (MbimDevice *device,
-                         GAsyncResult *res,
-                         GTask *task)
+device_caps_query_process (GTask      *task,
+                           DeviceCaps *caps,
+                           GError     *error)
 {
     MMBroadbandModemMbim           *self;
-    MbimMessage                    *response;
-    GError                         *error = NULL;
     LoadCurrentCapabilitiesContext *ctx;
 
     self = g_task_get_source_object (task);
     ctx  = g_task_get_task_data (task);
 
-    response = mbim_device_command_finish (device, res, &error);
-    if (!response ||
-        !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
-        !mbim_message_device_caps_response_parse (
-            response,
-            NULL, /* device_type */
-            &self->priv->caps_cellular_class,
-            NULL, /* voice_class */
-            NULL, /* sim_class */
-            &self->priv->caps_data_class,
-            &self->priv->caps_sms,
-            NULL, /* ctrl_caps */
-            &self->priv->caps_max_sessions,
-            &self->priv->caps_custom_data_class,
-            &self->priv->caps_device_id,
-            &self->priv->caps_firmware_info,
-            &self->priv->caps_hardware_info,
-            &error)) {
+    if (!caps) {
         g_task_return_error (task, error);
         g_object_unref (task);
-        goto out;
+        return;
     }
 
+    self->priv->caps_cellular_class = caps->cellular_class;
+    self->priv->caps_data_class = caps->data_class;
+    self->priv->caps_sms = caps->sms;
+    self->priv->caps_max_sessions = caps->max_sessions;
+    g_free (self->priv->caps_custom_data_class);
+    self->priv->caps_custom_data_class = g_steal_pointer (&caps->custom_data_class);
+    g_free (self->priv->caps_device_id);
+    self->priv->caps_device_id = g_steal_pointer (&caps->device_id);
+    g_free (self->priv->caps_firmware_info);
+    self->priv->caps_firmware_info = g_steal_pointer (&caps->firmware_info);
+    g_free (self->priv->caps_hardware_info);
+    self->priv->caps_hardware_info = g_steal_pointer (&caps->hardware_info);
+    device_caps_free (caps);
+
     ctx->current_mbim = mm_modem_capability_from_mbim_device_caps (self->priv->caps_cellular_class,
                                                                    self->priv->caps_data_class,
                                                                    self->priv->caps_custom_data_class);
     complete_current_capabilities (task);
+}
 
-out:
-    if (response)
-        mbim_message_unref (response);
+static void
+device_caps_query_ready (MbimDevice   *device,
+                         GAsyncResult *res,
+                         GTask        *task)
+{
+    DeviceCaps *caps;
+    GError     *error = NULL;
+
+    caps = command_response_parse (device, res, device_caps_response_parse, &error);
+    device_caps_query_process (task, caps, error);
 }
 
 static void
@@ -471,12 +886,20 @@ load_current_capabilities_mbim (GTask *task)
 {
     MMBroadbandModemMbim           *self;
     MbimMessage                    *message;
+    DeviceCaps                     *caps;
     LoadCurrentCapabilitiesContext *ctx;
 
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
     mm_obj_dbg (self, "loading current capabilities...");
+
+    caps = init_prefetch_take (self, INIT_PREFETCH_DEVICE_CAPS);
+    if (caps) {
+        device_caps_query_process (task, caps, NULL);
+        return;
+    }
+
     message = mbim_message_device_caps_query_new (NULL);
     mbim_device_command (ctx->device,
                          message,
@@ -1050,32 +1473,20 @@ modem_load_unlock_required_finish (MMIfaceModem *self,
 }
 
 static void
-pin_query_ready (MbimDevice *device,
-                 GAsyncResult *res,
-                 GTask *task)
+pin_query_process (GTask    *task,
+                   PinState *state,
+                   GError   *error)
 {
-    MbimMessage *response;
-    GError *error = NULL;
-    MbimPinType pin_type;
-    MbimPinState pin_state;
-
-    response = mbim_device_command_finish (device, res, &error);
-    if (response &&
-        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
-        mbim_message_pin_response_parse (
-            response,
-            &pin_type,
-            &pin_state,
-            NULL,
-            &error)) {
+    if (state) {
         MMModemLock unlock_required;
 
-        if (pin_state == MBIM_PIN_STATE_UNLOCKED)
+        if (state->pin_state == MBIM_PIN_STATE_UNLOCKED)
             unlock_required = MM_MODEM_LOCK_NONE;
         else
-            unlock_required = mm_modem_lock_from_mbim_pin_type (pin_type);
+            unlock_required = mm_modem_lock_from_mbim_pin_type (state->pin_type);
 
         g_task_return_int (task, unlock_required);
+        pin_state_free (state);
     }
     /* VZ20M reports an error when SIM-PIN is required... */
     else if (g_error_matches (error, MBIM_STATUS_ERROR, MBIM_STATUS_ERROR_PIN_REQUIRED)) {
@@ -1086,39 +1497,38 @@ pin_query_ready (MbimDevice *device,
         g_task_return_error (task, error);
 
     g_object_unref (task);
+}
 
-    if (response)
-        mbim_message_unref (response);
+static void
+pin_query_ready (MbimDevice *device,
+                 GAsyncResult *res,
+                 GTask *task)
+{
+    PinState *state;
+    GError *error = NULL;
+
+    state = command_response_parse (device, res, pin_response_parse, &error);
+    pin_query_process (task, state, error);
 }
 
 static gboolean wait_for_sim_ready (GTask *task);
 
 static void
-unlock_required_subscriber_ready_state_ready (MbimDevice *device,
-                                              GAsyncResult *res,
-                                              GTask *task)
+unlock_required_subscriber_ready_state_process (GTask                 *task,
+                                                SubscriberReadyStatus *status,
+                                                GError                *error)
 {
     LoadUnlockRequiredContext *ctx;
     MMBroadbandModemMbim *self;
-    MbimMessage *response;
-    GError *error = NULL;
     MbimSubscriberReadyState ready_state = MBIM_SUBSCRIBER_READY_STATE_NOT_INITIALIZED;
 
     ctx = g_task_get_task_data (task);
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
-    if (response &&
-        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
-        mbim_message_subscriber_ready_status_response_parse (
-            response,
-            &ready_state,
-            NULL, /* subscriber_id */
-            NULL, /* sim_iccid */
-            NULL, /* ready_info */
-            NULL, /* telephone_numbers_count */
-            NULL, /* telephone_numbers */
-            &error)) {
+    if (status) {
+        ready_state = status->ready_state;
+        subscriber_ready_status_free (status);
+
         switch (ready_state) {
         case MBIM_SUBSCRIBER_READY_STATE_NOT_INITIALIZED:
         case MBIM_SUBSCRIBER_READY_STATE_INITIALIZED:
@@ -1146,7 +1556,7 @@ unlock_required_subscriber_ready_state_ready (MbimDevice *device,
     if (error) {
         g_task_return_error (task, error);
         g_object_unref (task);
-        goto out;
+        return;
     }
 
     /* Need to retry? */
@@ -1163,37 +1573,52 @@ unlock_required_subscriber_ready_state_ready (MbimDevice *device,
             g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_RETRY,
                                      "SIM not ready yet (retry)");
         g_object_unref (task);
-        goto out;
+        return;
     }
 
     /* Initialized but locked? */
     if (ready_state == MBIM_SUBSCRIBER_READY_STATE_DEVICE_LOCKED) {
         MbimMessage *message;
+        PinState    *state;
 
         /* Query which lock is to unlock */
+        state = init_prefetch_take (self, INIT_PREFETCH_PIN);
+        if (state) {
+            pin_query_process (task, state, NULL);
+            return;
+        }
+
         message = mbim_message_pin_query_new (NULL);
-        mbim_device_command (device,
+        mbim_device_command (ctx->device,
                              message,
                              10,
                              NULL,
                              (GAsyncReadyCallback)pin_query_ready,
                              task);
         mbim_message_unref (message);
-        goto out;
+        return;
     }
 
     /* Initialized! */
     if (ready_state == MBIM_SUBSCRIBER_READY_STATE_INITIALIZED) {
         g_task_return_boolean (task, TRUE);
         g_object_unref (task);
-        goto out;
+        return;
     }
 
     g_assert_not_reached ();
+}
 
-out:
-    if (response)
-        mbim_message_unref (response);
+static void
+unlock_required_subscriber_ready_state_ready (MbimDevice *device,
+                                              GAsyncResult *res,
+                                              GTask *task)
+{
+    SubscriberReadyStatus *status;
+    GError *error = NULL;
+
+    status = command_response_parse (device, res, subscriber_ready_status_response_parse, &error);
+    unlock_required_subscriber_ready_state_process (task, status, error);
 }
 
 static gboolean
@@ -1201,6 +1626,17 @@ wait_for_sim_ready (GTask *task)
 {
     LoadUnlockRequiredContext *ctx;
     MbimMessage *message;
+    SubscriberReadyStatus *status;
+
+    status = init_prefetch_take (g_task_get_source_object (task), INIT_PREFETCH_SUBSCRIBER_READY_STATUS);
+    if (status) {
+        unlock_required_subscriber_ready_state_process (task, status, NULL);
+        return G_SOURCE_REMOVE;
+    }
+
+    /* The SIM state may have changed since the prefetch, so don't rely on the
+     * prefetched PIN state either */
+    init_prefetch_drop (g_task_get_source_object (task), INIT_PREFETCH_PIN);
 
     ctx = g_task_get_task_data (task);
     message = mbim_message_subscriber_ready_status_query_new (NULL);
@@ -1249,30 +1685,17 @@ modem_load_unlock_retries_finish (MMIfaceModem *self,
 }
 
 static void
-pin_query_unlock_retries_ready (MbimDevice *device,
-                                GAsyncResult *res,
-                                GTask *task)
+pin_query_unlock_retries_process (GTask    *task,
+                                  PinState *state,
+                                  GError   *error)
 {
-    MbimMessage *response;
-    GError *error = NULL;
-    MbimPinType pin_type;
-    guint32 remaining_attempts;
-
-    response = mbim_device_command_finish (device, res, &error);
-    if (response &&
-        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
-        mbim_message_pin_response_parse (
-            response,
-            &pin_type,
-            NULL,
-            &remaining_attempts,
-            &error)) {
+    if (state) {
         MMIfaceModem *self;
         MMModemLock lock;
         MMUnlockRetries *retries;
 
         self = g_task_get_source_object (task);
-        lock = mm_modem_lock_from_mbim_pin_type (pin_type);
+        lock = mm_modem_lock_from_mbim_pin_type (state->pin_type);
         retries = mm_unlock_retries_new ();
 
         /* If PIN1 is disabled and we have tried to enable it with a wrong PIN,
@@ -1308,17 +1731,27 @@ pin_query_unlock_retries_ready (MbimDevice *device,
 
         /* According to the MBIM specification, RemainingAttempts is set to
          * 0xffffffff if the device does not support this information. */
-        if (remaining_attempts != G_MAXUINT32)
-            mm_unlock_retries_set (retries, lock, remaining_attempts);
+        if (state->remaining_attempts != G_MAXUINT32)
+            mm_unlock_retries_set (retries, lock, state->remaining_attempts);
 
         g_task_return_pointer (task, retries, g_object_unref);
+        pin_state_free (state);
     } else
         g_task_return_error (task, error);
 
     g_object_unref (task);
+}
 
-    if (response)
-        mbim_message_unref (response);
+static void
+pin_query_unlock_retries_ready (MbimDevice *device,
+                                GAsyncResult *res,
+                                GTask *task)
+{
+    PinState *state;
+    GError *error = NULL;
+
+    state = command_response_parse (device, res, pin_response_parse, &error);
+    pin_query_unlock_retries_process (task, state, error);
 }
 
 static void
@@ -1328,6 +1761,7 @@ modem_load_unlock_retries (MMIfaceModem *self,
 {
     MbimDevice *device;
     MbimMessage *message;
+    PinState *state;
     GTask *task;
 
     if (!peek_device (self, &device, callback, user_data))
@@ -1335,6 +1769,12 @@ modem_load_unlock_retries (MMIfaceModem *self,
 
     task = g_task_new (self, NULL, callback, user_data);
 
+    state = init_prefetch_take (MM_BROADBAND_MODEM_MBIM (self), INIT_PREFETCH_PIN);
+    if (state) {
+        pin_query_unlock_retries_process (task, state, NULL);
+        return;
+    }
+
     message = mbim_message_pin_query_new (NULL);
     mbim_device_command (device,
                          message,
@@ -1431,37 +1871,35 @@ modem_load_power_state_finish (MMIfaceModem *self,
 }
 
 static void
-radio_state_query_ready (MbimDevice *device,
-                         GAsyncResult *res,
-                         GTask *task)
+radio_state_query_process (GTask      *task,
+                           RadioState *radio_state,
+                           GError     *error)
 {
-    MbimMessage *response;
-    GError *error = NULL;
-    MbimRadioSwitchState hardware_radio_state;
-    MbimRadioSwitchState software_radio_state;
-
-    response = mbim_device_command_finish (device, res, &error);
-    if (response &&
-        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
-        mbim_message_radio_state_response_parse (
-            response,
-            &hardware_radio_state,
-            &software_radio_state,
-            &error)) {
+    if (radio_state) {
         MMModemPowerState state;
 
-        if (hardware_radio_state == MBIM_RADIO_SWITCH_STATE_OFF ||
-            software_radio_state == MBIM_RADIO_SWITCH_STATE_OFF)
+        if (radio_state->hardware_radio_state == MBIM_RADIO_SWITCH_STATE_OFF ||
+            radio_state->software_radio_state == MBIM_RADIO_SWITCH_STATE_OFF)
             state = MM_MODEM_POWER_STATE_LOW;
         else
             state = MM_MODEM_POWER_STATE_ON;
         g_task_return_int (task, state);
+        radio_state_free (radio_state);
     } else
         g_task_return_error (task, error);
     g_object_unref (task);
+}
+
+static void
+radio_state_query_ready (MbimDevice *device,
+                         GAsyncResult *res,
+                         GTask *task)
+{
+    RadioState *radio_state;
+    GError *error = NULL;
 
-    if (response)
-        mbim_message_unref (response);
+    radio_state = command_response_parse (device, res, radio_state_response_parse, &error);
+    radio_state_query_process (task, radio_state, error);
 }
 
 static void
@@ -1471,6 +1909,7 @@ modem_load_power_state (MMIfaceModem *self,
 {
     MbimDevice *device;
     MbimMessage *message;
+    RadioState *radio_state;
     GTask *task;
 
     if (!peek_device (self, &device, callback, user_data))
@@ -1478,6 +1917,12 @@ modem_load_power_state (MMIfaceModem *self,
 
     task = g_task_new (self, NULL, callback, user_data);
 
+    radio_state = init_prefetch_take (MM_BROADBAND_MODEM_MBIM (self), INIT_PREFETCH_RADIO_STATE);
+    if (radio_state) {
+        radio_state_query_process (task, radio_state, NULL);
+        return;
+    }
+
     message = mbim_message_radio_state_query_new (NULL);
     mbim_device_command (device,
                          message,
@@ -2307,28 +2752,14 @@ allocate_next_qmi_client (GTask *task)
 #endif
 
 static void
-query_device_services_ready (MbimDevice   *device,
-                             GAsyncResult *res,
-                             GTask        *task)
+process_device_services (MMBroadbandModemMbim *self,
+                         DeviceServices       *services,
+                         GError               *error)
 {
-    MMBroadbandModemMbim *self;
-    MbimMessage *response;
-    GError *error = NULL;
-    MbimDeviceServiceElement **device_services;
-    guint32 device_services_count;
-
-    self = g_task_get_source_object (task);
-
-    response = mbim_device_command_finish (device, res, &error);
-    if (response &&
-        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
-        mbim_message_device_services_response_parse (
-            response,
-            &device_services_count,
-            NULL, /* max_dss_sessions */
-            &device_services,
-            &error)) {
-        guint32 i;
+    if (services) {
+        MbimDeviceServiceElement **device_services = services->elements;
+        guint32                    device_services_count = services->n_elements;
+        guint32                    i;
 
         for (i = 0; i < device_services_count; i++) {
             MbimService service;
@@ -2385,16 +2816,51 @@ query_device_services_ready (MbimDevice   *device,
 
             /* no optional features to check in remaining services */
         }
-        mbim_device_service_element_array_free (device_services);
+        device_services_free (services);
     } else {
         /* Ignore error */
         mm_obj_warn (self, "couldn't query device services: %s", error->message);
         g_error_free (error);
     }
+}
 
-    if (response)
-        mbim_message_unref (response);
+static void
+query_device_services_ready (MMPortMbim   *mbim,
+                             GAsyncResult *res,
+                             GTask        *task)
+{
+    MMBroadbandModemMbim      *self;
+    g_autoptr(MMPortMbimBatch) batch = NULL;
+    DeviceServices            *services;
+    GError                    *error = NULL;
+    guint                      i;
+
+    self = g_task_get_source_object (task);
+
+    batch = mm_port_mbim_command_batch_finish (mbim, res, &error);
+    if (!batch) {
+        process_device_services (self, NULL, error);
+        goto out;
+    }
 
+    /* First result in the batch is always the device services one */
+    services = mm_port_mbim_batch_take_result (batch, 0, &error);
+    process_device_services (self, services, error);
+
+    /* Keep the remaining successful results around for the initialization
+     * steps that need them; failed ones are just ignored, and those steps
+     * will query the device by themselves. */
+    init_prefetch_clear (self);
+    self->priv->init_prefetch_time = g_get_monotonic_time ();
+    for (i = 0; i < INIT_PREFETCH_LAST; i++) {
+        g_autoptr(GError) inner_error = NULL;
+
+        self->priv->init_prefetched[i] = mm_port_mbim_batch_take_result (batch, i + 1, &inner_error);
+        if (!self->priv->init_prefetched[i])
+            mm_obj_dbg (self, "couldn't prefetch %s: %s", init_prefetch_requests[i].name, inner_error->message);
+    }
+
+out:
 #if defined WITH_QMI && QMI_MBIM_QMUX_SUPPORTED
     allocate_next_qmi_client (task);
 #else
@@ -2405,27 +2871,38 @@ query_device_services_ready (MbimDevice   *device,
 static void
 query_device_services (GTask *task)
 {
-    MMBroadbandModem *self;
+    MMBroadbandModem             *self;
     InitializationStartedContext *ctx;
-    MbimMessage *message;
-    MbimDevice *device;
+    MMPortMbimBatchRequest        requests[1 + INIT_PREFETCH_LAST];
+    guint                         i;
 
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
 
-    device = mm_port_mbim_peek_device (ctx->mbim);
-    g_assert (device);
-
+    /* The device services query is sent together with other independent
+     * queries that later initialization steps would otherwise issue one by
+     * one, so that all of them are in flight at once */
     mm_obj_dbg (self, "querying device services...");
 
-    message = mbim_message_device_services_query_new (NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)query_device_services_ready,
-                         task);
-    mbim_message_unref (message);
+    requests[0].message = mbim_message_device_services_query_new (NULL);
+    requests[0].parse = device_services_response_parse;
+    requests[0].result_free = (GDestroyNotify) device_services_free;
+    for (i = 0; i < INIT_PREFETCH_LAST; i++) {
+        requests[i + 1].message = init_prefetch_requests[i].message_new (NULL);
+        requests[i + 1].parse = init_prefetch_requests[i].parse;
+        requests[i + 1].result_free = init_prefetch_requests[i].result_free;
+    }
+
+    mm_port_mbim_command_batch (ctx->mbim,
+                                requests,
+                                G_N_ELEMENTS (requests),
+                                10,
+                                NULL,
+                                (GAsyncReadyCallback)query_device_services_ready,
+                                task);
+
+    for (i = 0; i < G_N_ELEMENTS (requests); i++)
+        mbim_message_unref (requests[i].message);
 }
 
 static void
@@ -2646,80 +3123,29 @@ modem_3gpp_load_enabled_facility_locks_finish (MMIfaceModem3gpp *self,
     return (MMModem3gppFacility)value;
 }
 
+static void
+pin_list_query_process (GTask   *task,
+                        PinList *list,
+                        GError  *error)
+{
+    if (list) {
+        g_task_return_int (task, list->enabled_facilities);
+        pin_list_free (list);
+    } else
+        g_task_return_error (task, error);
+    g_object_unref (task);
+}
+
 static void
 pin_list_query_ready (MbimDevice *device,
                       GAsyncResult *res,
                       GTask *task)
 {
-    MbimMessage *response;
+    PinList *list;
     GError *error = NULL;
-    MbimPinDesc *pin_desc_pin1;
-    MbimPinDesc *pin_desc_pin2;
-    MbimPinDesc *pin_desc_device_sim_pin;
-    MbimPinDesc *pin_desc_device_first_sim_pin;
-    MbimPinDesc *pin_desc_network_pin;
-    MbimPinDesc *pin_desc_network_subset_pin;
-    MbimPinDesc *pin_desc_service_provider_pin;
-    MbimPinDesc *pin_desc_corporate_pin;
-
-    response = mbim_device_command_finish (device, res, &error);
-    if (response &&
-        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
-        mbim_message_pin_list_response_parse (
-            response,
-            &pin_desc_pin1,
-            &pin_desc_pin2,
-            &pin_desc_device_sim_pin,
-            &pin_desc_device_first_sim_pin,
-            &pin_desc_network_pin,
-            &pin_desc_network_subset_pin,
-            &pin_desc_service_provider_pin,
-            &pin_desc_corporate_pin,
-            NULL, /* pin_desc_subsidy_lock */
-            NULL, /* pin_desc_custom */
-            &error)) {
-        MMModem3gppFacility mask = MM_MODEM_3GPP_FACILITY_NONE;
-
-        if (pin_desc_pin1->pin_mode == MBIM_PIN_MODE_ENABLED)
-            mask |= MM_MODEM_3GPP_FACILITY_SIM;
-        mbim_pin_desc_free (pin_desc_pin1);
-
-        if (pin_desc_pin2->pin_mode == MBIM_PIN_MODE_ENABLED)
-            mask |= MM_MODEM_3GPP_FACILITY_FIXED_DIALING;
-        mbim_pin_desc_free (pin_desc_pin2);
-
-        if (pin_desc_device_sim_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
-            mask |= MM_MODEM_3GPP_FACILITY_PH_SIM;
-        mbim_pin_desc_free (pin_desc_device_sim_pin);
-
-        if (pin_desc_device_first_sim_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
-            mask |= MM_MODEM_3GPP_FACILITY_PH_FSIM;
-        mbim_pin_desc_free (pin_desc_device_first_sim_pin);
-
-        if (pin_desc_network_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
-            mask |= MM_MODEM_3GPP_FACILITY_NET_PERS;
-        mbim_pin_desc_free (pin_desc_network_pin);
-
-        if (pin_desc_network_subset_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
-            mask |= MM_MODEM_3GPP_FACILITY_NET_SUB_PERS;
-        mbim_pin_desc_free (pin_desc_network_subset_pin);
-
-        if (pin_desc_service_provider_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
-            mask |= MM_MODEM_3GPP_FACILITY_PROVIDER_PERS;
-        mbim_pin_desc_free (pin_desc_service_provider_pin);
-
-        if (pin_desc_corporate_pin->pin_mode == MBIM_PIN_MODE_ENABLED)
-            mask |= MM_MODEM_3GPP_FACILITY_CORP_PERS;
-        mbim_pin_desc_free (pin_desc_corporate_pin);
-
-        g_task_return_int (task, mask);
-    } else
-        g_task_return_error (task, error);
 
-    g_object_unref (task);
-
-    if (response)
-        mbim_message_unref (response);
+    list = command_response_parse (device, res, pin_list_response_parse, &error);
+    pin_list_query_process (task, list, error);
 }
 
 static void
@@ -2729,6 +3155,7 @@ modem_3gpp_load_enabled_facility_locks (MMIfaceModem3gpp *self,
 {
     MbimDevice *device;
     MbimMessage *message;
+    PinList *list;
     GTask *task;
 
     if (!peek_device (self, &device, callback, user_data))
@@ -2736,6 +3163,12 @@ modem_3gpp_load_enabled_facility_locks (MMIfaceModem3gpp *self,
 
     task = g_task_new (self, NULL, callback, user_data);
 
+    list = init_prefetch_take (MM_BROADBAND_MODEM_MBIM (self), INIT_PREFETCH_PIN_LIST);
+    if (list) {
+        pin_list_query_process (task, list, NULL);
+        return;
+    }
+
     message = mbim_message_pin_list_query_new (NULL);
     mbim_device_command (device,
                          message,
@@ -2907,43 +3340,32 @@ common_process_lte_attach_configuration (MMBroadbandModemMbim        *self,
 }
 
 static void
-lte_attach_configuration_query_ready (MbimDevice   *device,
-                                      GAsyncResult *res,
-                                      GTask        *task)
+lte_attach_configuration_query_process (GTask                   *task,
+                                        LteAttachConfigurations *configurations,
+                                        GError                  *error)
 {
-    MMBroadbandModemMbim        *self;
-    MbimMessage                 *response;
-    GError                      *error = NULL;
-    MMBearerProperties          *properties = NULL;
-    guint32                      n_configurations = 0;
-    MbimLteAttachConfiguration **configurations = NULL;
-    guint                        i;
+    MMBroadbandModemMbim *self;
+    MMBearerProperties   *properties = NULL;
+    guint                 i;
 
     self = g_task_get_source_object (task);
 
-    response = mbim_device_command_finish (device, res, &error);
-    if (!response ||
-        !mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) ||
-        !mbim_message_ms_basic_connect_extensions_lte_attach_configuration_response_parse (
-            response,
-            &n_configurations,
-            &configurations,
-            &error)) {
+    if (!configurations) {
         g_task_return_error (task, error);
         g_object_unref (task);
-        goto out;
+        return;
     }
 
     /* We should always receive 3 configurations but the MBIM API doesn't force
      * that so we'll just assume we don't get always the same fixed number */
-    for (i = 0; i < n_configurations; i++) {
+    for (i = 0; i < configurations->n_configurations; i++) {
         /* We only support configuring the HOME settings */
-        if (configurations[i]->roaming != MBIM_LTE_ATTACH_CONTEXT_ROAMING_CONTROL_HOME)
+        if (configurations->configurations[i]->roaming != MBIM_LTE_ATTACH_CONTEXT_ROAMING_CONTROL_HOME)
             continue;
-        properties = common_process_lte_attach_configuration (self, configurations[i], &error);
+        properties = common_process_lte_attach_configuration (self, configurations->configurations[i], &error);
         break;
     }
-    mbim_lte_attach_configuration_array_free (configurations);
+    lte_attach_configurations_free (configurations);
 
     if (!properties && !error)
         error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_NOT_FOUND,
@@ -2955,10 +3377,18 @@ lte_attach_configuration_query_ready (MbimDevice   *device,
     else
         g_task_return_error (task, error);
     g_object_unref (task);
+}
 
- out:
-    if (response)
-        mbim_message_unref (response);
+static void
+lte_attach_configuration_query_ready (MbimDevice   *device,
+                                      GAsyncResult *res,
+                                      GTask        *task)
+{
+    LteAttachConfigurations *configurations;
+    GError                  *error = NULL;
+
+    configurations = command_response_parse (device, res, lte_attach_configuration_response_parse, &error);
+    lte_attach_configuration_query_process (task, configurations, error);
 }
 
 static void
@@ -2966,10 +3396,11 @@ modem_3gpp_load_initial_eps_bearer_settings (MMIfaceModem3gpp    *_self,
                                              GAsyncReadyCallback  callback,
                                              gpointer             user_data)
 {
-    MMBroadbandModemMbim *self = MM_BROADBAND_MODEM_MBIM (_self);
-    MbimDevice           *device;
-    MbimMessage          *message;
-    GTask                *task;
+    MMBroadbandModemMbim    *self = MM_BROADBAND_MODEM_MBIM (_self);
+    MbimDevice              *device;
+    MbimMessage             *message;
+    LteAttachConfigurations *configurations;
+    GTask                   *task;
 
     if (!peek_device (self, &device, callback, user_data))
         return;
@@ -2983,6 +3414,12 @@ modem_3gpp_load_initial_eps_bearer_settings (MMIfaceModem3gpp    *_self,
         return;
     }
 
+    configurations = init_prefetch_take (self, INIT_PREFETCH_LTE_ATTACH_CONFIGURATION);
+    if (configurations) {
+        lte_attach_configuration_query_process (task, configurations, NULL);
+        return;
+    }
+
     message = mbim_message_ms_basic_connect_extensions_lte_attach_configuration_query_new (NULL);
     mbim_device_command (device,
                          message,
@@ -3479,71 +3916,226 @@ basic_connect_notification (MMBroadbandModemMbim *self,
     }
 }
 
+/*****************************************************************************/
+/* SMS sync
+ *
+ * New message store status notifications are not processed right away;
+ * instead, the indices of the new messages are accumulated during a short
+ * window, so that bursts of incoming messages are read together. If there
+ * are enough new messages, a single query for all unread messages is used,
+ * otherwise each new message is read by index, with several reads in
+ * flight at the same time.
+ */
+
+#define SMS_SYNC_WINDOW_MS           200
+#define SMS_SYNC_MAX_INDEX_READS     8
+#define SMS_SYNC_NEW_FLAG_THRESHOLD  16
+
+typedef struct {
+    MMBroadbandModemMbim *self;
+    MbimDevice           *device;
+    GArray               *indices;
+    guint                 n_in_flight;
+    guint                 n_parts;
+    gint64                start;
+} SmsSyncContext;
+
+static void sms_sync_schedule (MMBroadbandModemMbim *self);
+
 static void
-alert_sms_read_query_ready (MbimDevice *device,
-                            GAsyncResult *res,
-                            MMBroadbandModemMbim *self)
+sms_sync_context_complete_and_free (SmsSyncContext *ctx)
 {
-    MbimMessage *response;
-    GError *error = NULL;
-    guint32 messages_count;
-    MbimSmsPduReadRecord **pdu_messages;
+    MMBroadbandModemMbim *self;
 
-    response = mbim_device_command_finish (device, res, &error);
-    if (response &&
-        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &error) &&
-        mbim_message_sms_read_response_parse (
+    self = ctx->self;
+    mm_obj_dbg (self, "SMS sync finished: %u parts read in %" G_GINT64_FORMAT "ms",
+                ctx->n_parts, (g_get_monotonic_time () - ctx->start) / 1000);
+
+    g_array_unref (ctx->indices);
+    g_object_unref (ctx->device);
+    g_slice_free (SmsSyncContext, ctx);
+
+    /* Launch a new sync if more messages were notified meanwhile */
+    self->priv->sms_sync_running = FALSE;
+    if (self->priv->sms_sync_pending_indices->len)
+        sms_sync_schedule (self);
+    g_object_unref (self);
+}
+
+static guint
+sms_sync_process_response (SmsSyncContext *ctx,
+                           MbimMessage    *response,
+                           GError        **error)
+{
+    guint32                 messages_count;
+    MbimSmsPduReadRecord  **pdu_messages;
+    guint                   i;
+
+    if (!mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, error) ||
+        !mbim_message_sms_read_response_parse (
             response,
             NULL,
             &messages_count,
             &pdu_messages,
             NULL, /* cdma_messages */
-            &error)) {
-        guint i;
+            error))
+        return 0;
 
-        for (i = 0; i < messages_count; i++)
-            add_sms_part (self, pdu_messages[i]);
-        mbim_sms_pdu_read_record_array_free (pdu_messages);
+    for (i = 0; i < messages_count; i++) {
+        guint j;
+
+        add_sms_part (ctx->self, pdu_messages[i]);
+
+        /* No need to read by index the messages already received */
+        for (j = 0; j < ctx->indices->len; j++) {
+            if (g_array_index (ctx->indices, guint32, j) == pdu_messages[i]->message_index) {
+                g_array_remove_index_fast (ctx->indices, j);
+                break;
+            }
+        }
     }
+    mbim_sms_pdu_read_record_array_free (pdu_messages);
 
-    if (error) {
-        mm_obj_dbg (self, "flash message reading failed: %s", error->message);
-        g_error_free (error);
+    ctx->n_parts += messages_count;
+    return messages_count;
+}
+
+static void sms_sync_read_next_indices (SmsSyncContext *ctx);
+
+static void
+sms_sync_read_index_ready (MbimDevice     *device,
+                           GAsyncResult   *res,
+                           SmsSyncContext *ctx)
+{
+    g_autoptr(MbimMessage)  response = NULL;
+    g_autoptr(GError)       error = NULL;
+
+    g_assert (ctx->n_in_flight > 0);
+    ctx->n_in_flight--;
+
+    response = mbim_device_command_finish (device, res, &error);
+    if (!response || !sms_sync_process_response (ctx, response, &error))
+        mm_obj_dbg (ctx->self, "new message reading failed: %s",
+                    error ? error->message : "no messages");
+
+    sms_sync_read_next_indices (ctx);
+}
+
+static void
+sms_sync_read_next_indices (SmsSyncContext *ctx)
+{
+    while (ctx->indices->len && (ctx->n_in_flight < SMS_SYNC_MAX_INDEX_READS)) {
+        g_autoptr(MbimMessage) message = NULL;
+        guint32                index;
+
+        index = g_array_index (ctx->indices, guint32, 0);
+        g_array_remove_index (ctx->indices, 0);
+
+        mm_obj_dbg (ctx->self, "reading new SMS at index '%u'", index);
+        message = mbim_message_sms_read_query_new (MBIM_SMS_FORMAT_PDU,
+                                                   MBIM_SMS_FLAG_INDEX,
+                                                   index,
+                                                   NULL);
+        ctx->n_in_flight++;
+        mbim_device_command (ctx->device,
+                             message,
+                             10,
+                             NULL,
+                             (GAsyncReadyCallback)sms_sync_read_index_ready,
+                             ctx);
     }
 
-    if (response)
-        mbim_message_unref (response);
+    if (!ctx->n_in_flight)
+        sms_sync_context_complete_and_free (ctx);
+}
 
-    g_object_unref (self);
+static void
+sms_sync_read_new_ready (MbimDevice     *device,
+                         GAsyncResult   *res,
+                         SmsSyncContext *ctx)
+{
+    g_autoptr(MbimMessage)  response = NULL;
+    g_autoptr(GError)       error = NULL;
+
+    response = mbim_device_command_finish (device, res, &error);
+    if (!response || !sms_sync_process_response (ctx, response, &error))
+        mm_obj_dbg (ctx->self, "reading all new messages failed: %s",
+                    error ? error->message : "no messages");
+
+    /* Whatever was not returned, read by index */
+    sms_sync_read_next_indices (ctx);
+}
+
+static gboolean
+sms_sync_run (MMBroadbandModemMbim *self)
+{
+    MMPortMbim     *port;
+    MbimDevice     *device;
+    SmsSyncContext *ctx;
+
+    self->priv->sms_sync_timeout_id = 0;
+
+    port = mm_broadband_modem_mbim_peek_port_mbim (self);
+    device = port ? mm_port_mbim_peek_device (port) : NULL;
+    if (!device) {
+        g_array_set_size (self->priv->sms_sync_pending_indices, 0);
+        return G_SOURCE_REMOVE;
+    }
+
+    ctx = g_slice_new0 (SmsSyncContext);
+    ctx->self = g_object_ref (self);
+    ctx->device = g_object_ref (device);
+    ctx->start = g_get_monotonic_time ();
+    ctx->indices = g_steal_pointer (&self->priv->sms_sync_pending_indices);
+    self->priv->sms_sync_pending_indices = g_array_new (FALSE, FALSE, sizeof (guint32));
+    self->priv->sms_sync_running = TRUE;
+
+    mm_obj_dbg (self, "SMS sync started: %u new messages notified", ctx->indices->len);
+
+    if (ctx->indices->len >= SMS_SYNC_NEW_FLAG_THRESHOLD) {
+        g_autoptr(MbimMessage) message = NULL;
+
+        message = mbim_message_sms_read_query_new (MBIM_SMS_FORMAT_PDU,
+                                                   MBIM_SMS_FLAG_NEW,
+                                                   0, /* message index, unused */
+                                                   NULL);
+        mbim_device_command (device,
+                             message,
+                             10,
+                             NULL,
+                             (GAsyncReadyCallback)sms_sync_read_new_ready,
+                             ctx);
+    } else
+        sms_sync_read_next_indices (ctx);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void
+sms_sync_schedule (MMBroadbandModemMbim *self)
+{
+    /* If a sync is running, a new one is scheduled when it finishes */
+    if (self->priv->sms_sync_timeout_id || self->priv->sms_sync_running)
+        return;
+
+    self->priv->sms_sync_timeout_id = g_timeout_add (SMS_SYNC_WINDOW_MS,
+                                                     (GSourceFunc) sms_sync_run,
+                                                     self);
 }
 
 static void
 sms_notification_read_stored_sms (MMBroadbandModemMbim *self,
                                   guint32 index)
 {
-    MMPortMbim *port;
-    MbimDevice *device;
-    MbimMessage *message;
+    guint i;
 
-    port = mm_broadband_modem_mbim_peek_port_mbim (self);
-    if (!port)
-        return;
-    device = mm_port_mbim_peek_device (port);
-    if (!device)
-        return;
+    for (i = 0; i < self->priv->sms_sync_pending_indices->len; i++) {
+        if (g_array_index (self->priv->sms_sync_pending_indices, guint32, i) == index)
+            return;
+    }
 
-    mm_obj_dbg (self, "reading new SMS at index '%u'", index);
-    message = mbim_message_sms_read_query_new (MBIM_SMS_FORMAT_PDU,
-                                               MBIM_SMS_FLAG_INDEX,
-                                               index,
-                                               NULL);
-    mbim_device_command (device,
-                         message,
-                         10,
-                         NULL,
-                         (GAsyncReadyCallback)alert_sms_read_query_ready,
-                         g_object_ref (self));
-    mbim_message_unref (message);
+    g_array_append_val (self->priv->sms_sync_pending_indices, index);
+    sms_sync_schedule (self);
 }
 
 static void
@@ -5699,6 +6291,7 @@ mm_broadband_modem_mbim_init (MMBroadbandModemMbim *self)
     self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self,
                                               MM_TYPE_BROADBAND_MODEM_MBIM,
                                               MMBroadbandModemMbimPrivate);
+    self->priv->sms_sync_pending_indices = g_array_new (FALSE, FALSE, sizeof (guint32));
 }
 
 static void
@@ -5707,6 +6300,11 @@ dispose (GObject *object)
     MMBroadbandModemMbim *self = MM_BROADBAND_MODEM_MBIM (object);
     MMPortMbim *mbim;
 
+    if (self->priv->sms_sync_timeout_id) {
+        g_source_remove (self->priv->sms_sync_timeout_id);
+        self->priv->sms_sync_timeout_id = 0;
+    }
+
     /* If any port cleanup is needed, it must be done during dispose(), as
      * the modem object will be affected by an explciit g_object_run_dispose()
      * that will remove all port references right away */
@@ -5737,6 +6335,8 @@ finalize (GObject *object)
     g_free (self->priv->current_operator_id);
     g_free (self->priv->current_operator_name);
     g_list_free_full (self->priv->pco_list, g_object_unref);
+    g_array_unref (self->priv->sms_sync_pending_indices);
+    init_prefetch_clear (self);
 
     G_OBJECT_CLASS (mm_broadband_modem_mbim_parent_class)->finalize (object);
 }
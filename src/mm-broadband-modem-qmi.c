@@ -72,6 +72,17 @@ G_DEFINE_TYPE_EXTENDED (MMBroadbandModemQmi, mm_broadband_modem_qmi, MM_TYPE_BRO
                         G_IMPLEMENT_INTERFACE (MM_TYPE_IFACE_MODEM_FIRMWARE, iface_modem_firmware_init)
                         G_IMPLEMENT_INTERFACE (MM_TYPE_SHARED_QMI, shared_qmi_init))
 
+/* DMS queries sent all at once right after the QMI clients are allocated
+ * during initialization, see dms_prefetch_requests */
+typedef enum {
+    DMS_PREFETCH_MANUFACTURER,
+    DMS_PREFETCH_MODEL,
+    DMS_PREFETCH_REVISION,
+    DMS_PREFETCH_HARDWARE_REVISION,
+    DMS_PREFETCH_IDS,
+    DMS_PREFETCH_LAST
+} DmsPrefetch;
+
 struct _MMBroadbandModemQmiPrivate {
     /* Cached device IDs, retrieved by the modem interface when loading device
      * IDs, and used afterwards in the 3GPP and CDMA interfaces. */
@@ -112,6 +123,20 @@ struct _MMBroadbandModemQmiPrivate {
 #endif /* WITH_NEWEST_QMI_COMMANDS */
     guint network_reject_indication_id;
 
+    /* NAS state mirror, fed by indications */
+    gint64 nas_registration_timestamp;
+    gint64 nas_signal_quality_timestamp;
+    guint8 nas_signal_quality;
+#if defined WITH_NEWEST_QMI_COMMANDS
+    gint64 nas_signal_values_timestamp;
+    MMSignal *nas_signal_cdma;
+    MMSignal *nas_signal_evdo;
+    MMSignal *nas_signal_gsm;
+    MMSignal *nas_signal_umts;
+    MMSignal *nas_signal_lte;
+    MMSignal *nas_signal_nr5g;
+#endif /* WITH_NEWEST_QMI_COMMANDS */
+
     /* CDMA activation helpers */
     MMModemCdmaActivationState activation_state;
     guint activation_event_report_indication_id;
@@ -145,6 +170,10 @@ struct _MMBroadbandModemQmiPrivate {
 
     /* For notifying when the qmi-proxy connection is dead */
     guint qmi_device_removed_id;
+
+    /* DMS outputs prefetched during initialization */
+    gpointer dms_prefetched[DMS_PREFETCH_LAST];
+    gint64   dms_prefetch_time;
 };
 
 /*****************************************************************************/
@@ -363,6 +392,60 @@ modem_create_bearer_list (MMIfaceModem *self)
     return mm_bearer_list_new (n, n_multiplexed);
 }
 
+/*****************************************************************************/
+/* DMS outputs prefetched during initialization */
+
+/* Prefetched outputs are only used by the initialization steps that run
+ * right after the prefetch; anything older is considered stale. */
+#define DMS_PREFETCH_MAX_AGE_SECS 10
+
+static const MMPortQmiBatchRequest dms_prefetch_requests[DMS_PREFETCH_LAST] = {
+    [DMS_PREFETCH_MANUFACTURER]      = MM_PORT_QMI_BATCH_REQUEST (DMS, dms, get_manufacturer),
+    [DMS_PREFETCH_MODEL]             = MM_PORT_QMI_BATCH_REQUEST (DMS, dms, get_model),
+    [DMS_PREFETCH_REVISION]          = MM_PORT_QMI_BATCH_REQUEST (DMS, dms, get_revision),
+    [DMS_PREFETCH_HARDWARE_REVISION] = MM_PORT_QMI_BATCH_REQUEST (DMS, dms, get_hardware_revision),
+    [DMS_PREFETCH_IDS]               = MM_PORT_QMI_BATCH_REQUEST (DMS, dms, get_ids),
+};
+
+static const gchar *dms_prefetch_names[DMS_PREFETCH_LAST] = {
+    [DMS_PREFETCH_MANUFACTURER]      = "manufacturer",
+    [DMS_PREFETCH_MODEL]             = "model",
+    [DMS_PREFETCH_REVISION]          = "revision",
+    [DMS_PREFETCH_HARDWARE_REVISION] = "hardware revision",
+    [DMS_PREFETCH_IDS]               = "ids",
+};
+
+static void
+dms_prefetch_clear (MMBroadbandModemQmi *self)
+{
+    guint i;
+
+    for (i = 0; i < DMS_PREFETCH_LAST; i++) {
+        if (self->priv->dms_prefetched[i]) {
+            dms_prefetch_requests[i].output_unref (self->priv->dms_prefetched[i]);
+            self->priv->dms_prefetched[i] = NULL;
+        }
+    }
+}
+
+/* Each prefetched output is used at most once, so that any later query
+ * always goes to the device. The output is transferred to the caller. */
+static gpointer
+dms_prefetch_take (MMBroadbandModemQmi *self,
+                   DmsPrefetch          which)
+{
+    if (!self->priv->dms_prefetched[which])
+        return NULL;
+
+    if ((g_get_monotonic_time () - self->priv->dms_prefetch_time) > (DMS_PREFETCH_MAX_AGE_SECS * G_USEC_PER_SEC)) {
+        dms_prefetch_clear (self);
+        return NULL;
+    }
+
+    mm_obj_dbg (self, "using %s prefetched during initialization", dms_prefetch_names[which]);
+    return g_steal_pointer (&self->priv->dms_prefetched[which]);
+}
+
 /*****************************************************************************/
 /* Manufacturer loading (Modem interface) */
 
@@ -374,6 +457,16 @@ modem_load_manufacturer_finish (MMIfaceModem *self,
     return g_task_propagate_pointer (G_TASK (res), error);
 }
 
+static void
+dms_get_manufacturer_process (GTask *task,
+                              QmiMessageDmsGetManufacturerOutput *output)
+{
+    const gchar *str;
+
+    qmi_message_dms_get_manufacturer_output_get_manufacturer (output, &str, NULL);
+    g_task_return_pointer (task, g_strdup (str), g_free);
+}
+
 static void
 dms_get_manufacturer_ready (QmiClientDms *client,
                             GAsyncResult *res,
@@ -389,12 +482,8 @@ dms_get_manufacturer_ready (QmiClientDms *client,
     } else if (!qmi_message_dms_get_manufacturer_output_get_result (output, &error)) {
         g_prefix_error (&error, "Couldn't get Manufacturer: ");
         g_task_return_error (task, error);
-    } else {
-        const gchar *str;
-
-        qmi_message_dms_get_manufacturer_output_get_manufacturer (output, &str, NULL);
-        g_task_return_pointer (task, g_strdup (str), g_free);
-    }
+    } else
+        dms_get_manufacturer_process (task, output);
 
     if (output)
         qmi_message_dms_get_manufacturer_output_unref (output);
@@ -408,19 +497,31 @@ modem_load_manufacturer (MMIfaceModem *self,
                          gpointer user_data)
 {
     QmiClient *client = NULL;
+    QmiMessageDmsGetManufacturerOutput *output;
+    GTask *task;
 
     if (!mm_shared_qmi_ensure_client (MM_SHARED_QMI (self),
                                       QMI_SERVICE_DMS, &client,
                                       callback, user_data))
         return;
 
+    task = g_task_new (self, NULL, callback, user_data);
+
+    output = dms_prefetch_take (MM_BROADBAND_MODEM_QMI (self), DMS_PREFETCH_MANUFACTURER);
+    if (output) {
+        dms_get_manufacturer_process (task, output);
+        qmi_message_dms_get_manufacturer_output_unref (output);
+        g_object_unref (task);
+        return;
+    }
+
     mm_obj_dbg (self, "loading manufacturer...");
     qmi_client_dms_get_manufacturer (QMI_CLIENT_DMS (client),
                                      NULL,
                                      5,
                                      NULL,
                                      (GAsyncReadyCallback)dms_get_manufacturer_ready,
-                                     g_task_new (self, NULL, callback, user_data));
+                                     task);
 }
 
 /*****************************************************************************/
@@ -434,6 +535,16 @@ modem_load_model_finish (MMIfaceModem *self,
     return g_task_propagate_pointer (G_TASK (res), error);
 }
 
+static void
+dms_get_model_process (GTask *task,
+                       QmiMessageDmsGetModelOutput *output)
+{
+    const gchar *str;
+
+    qmi_message_dms_get_model_output_get_model (output, &str, NULL);
+    g_task_return_pointer (task, g_strdup (str), g_free);
+}
+
 static void
 dms_get_model_ready (QmiClientDms *client,
                      GAsyncResult *res,
@@ -449,12 +560,8 @@ dms_get_model_ready (QmiClientDms *client,
     } else if (!qmi_message_dms_get_model_output_get_result (output, &error)) {
         g_prefix_error (&error, "Couldn't get Model: ");
         g_task_return_error (task, error);
-    } else {
-        const gchar *str;
-
-        qmi_message_dms_get_model_output_get_model (output, &str, NULL);
-        g_task_return_pointer (task, g_strdup (str), g_free);
-    }
+    } else
+        dms_get_model_process (task, output);
 
     if (output)
         qmi_message_dms_get_model_output_unref (output);
@@ -468,19 +575,31 @@ modem_load_model (MMIfaceModem *self,
                   gpointer user_data)
 {
     QmiClient *client = NULL;
+    QmiMessageDmsGetModelOutput *output;
+    GTask *task;
 
     if (!mm_shared_qmi_ensure_client (MM_SHARED_QMI (self),
                                       QMI_SERVICE_DMS, &client,
                                       callback, user_data))
         return;
 
+    task = g_task_new (self, NULL, callback, user_data);
+
+    output = dms_prefetch_take (MM_BROADBAND_MODEM_QMI (self), DMS_PREFETCH_MODEL);
+    if (output) {
+        dms_get_model_process (task, output);
+        qmi_message_dms_get_model_output_unref (output);
+        g_object_unref (task);
+        return;
+    }
+
     mm_obj_dbg (self, "loading model...");
     qmi_client_dms_get_model (QMI_CLIENT_DMS (client),
                               NULL,
                               5,
                               NULL,
                               (GAsyncReadyCallback)dms_get_model_ready,
-                              g_task_new (self, NULL, callback, user_data));
+                              task);
 }
 
 /*****************************************************************************/
@@ -494,6 +613,16 @@ modem_load_revision_finish (MMIfaceModem *self,
     return g_task_propagate_pointer (G_TASK (res), error);
 }
 
+static void
+dms_get_revision_process (GTask *task,
+                          QmiMessageDmsGetRevisionOutput *output)
+{
+    const gchar *str;
+
+    qmi_message_dms_get_revision_output_get_revision (output, &str, NULL);
+    g_task_return_pointer (task, g_strdup (str), g_free);
+}
+
 static void
 dms_get_revision_ready (QmiClientDms *client,
                         GAsyncResult *res,
@@ -509,12 +638,8 @@ dms_get_revision_ready (QmiClientDms *client,
     } else if (!qmi_message_dms_get_revision_output_get_result (output, &error)) {
         g_prefix_error (&error, "Couldn't get Revision: ");
         g_task_return_error (task, error);
-    } else {
-        const gchar *str;
-
-        qmi_message_dms_get_revision_output_get_revision (output, &str, NULL);
-        g_task_return_pointer (task, g_strdup (str), g_free);
-    }
+    } else
+        dms_get_revision_process (task, output);
 
     if (output)
         qmi_message_dms_get_revision_output_unref (output);
@@ -528,19 +653,31 @@ modem_load_revision (MMIfaceModem *self,
                      gpointer user_data)
 {
     QmiClient *client = NULL;
+    QmiMessageDmsGetRevisionOutput *output;
+    GTask *task;
 
     if (!mm_shared_qmi_ensure_client (MM_SHARED_QMI (self),
                                       QMI_SERVICE_DMS, &client,
                                       callback, user_data))
         return;
 
+    task = g_task_new (self, NULL, callback, user_data);
+
+    output = dms_prefetch_take (MM_BROADBAND_MODEM_QMI (self), DMS_PREFETCH_REVISION);
+    if (output) {
+        dms_get_revision_process (task, output);
+        qmi_message_dms_get_revision_output_unref (output);
+        g_object_unref (task);
+        return;
+    }
+
     mm_obj_dbg (self, "loading revision...");
     qmi_client_dms_get_revision (QMI_CLIENT_DMS (client),
                                  NULL,
                                  5,
                                  NULL,
                                  (GAsyncReadyCallback)dms_get_revision_ready,
-                                 g_task_new (self, NULL, callback, user_data));
+                                 task);
 }
 
 /*****************************************************************************/
@@ -554,6 +691,16 @@ modem_load_hardware_revision_finish (MMIfaceModem *self,
     return g_task_propagate_pointer (G_TASK (res), error);
 }
 
+static void
+dms_get_hardware_revision_process (GTask *task,
+                                   QmiMessageDmsGetHardwareRevisionOutput *output)
+{
+    const gchar *str;
+
+    qmi_message_dms_get_hardware_revision_output_get_revision (output, &str, NULL);
+    g_task_return_pointer (task, g_strdup (str), g_free);
+}
+
 static void
 dms_get_hardware_revision_ready (QmiClientDms *client,
                                  GAsyncResult *res,
@@ -569,12 +716,8 @@ dms_get_hardware_revision_ready (QmiClientDms *client,
     } else if (!qmi_message_dms_get_hardware_revision_output_get_result (output, &error)) {
         g_prefix_error (&error, "Couldn't get Hardware Revision: ");
         g_task_return_error (task, error);
-    } else {
-        const gchar *str;
-
-        qmi_message_dms_get_hardware_revision_output_get_revision (output, &str, NULL);
-        g_task_return_pointer (task, g_strdup (str), g_free);
-    }
+    } else
+        dms_get_hardware_revision_process (task, output);
 
     if (output)
         qmi_message_dms_get_hardware_revision_output_unref (output);
@@ -588,19 +731,31 @@ modem_load_hardware_revision (MMIfaceModem *self,
                               gpointer user_data)
 {
     QmiClient *client = NULL;
+    QmiMessageDmsGetHardwareRevisionOutput *output;
+    GTask *task;
 
     if (!mm_shared_qmi_ensure_client (MM_SHARED_QMI (self),
                                       QMI_SERVICE_DMS, &client,
                                       callback, user_data))
         return;
 
+    task = g_task_new (self, NULL, callback, user_data);
+
+    output = dms_prefetch_take (MM_BROADBAND_MODEM_QMI (self), DMS_PREFETCH_HARDWARE_REVISION);
+    if (output) {
+        dms_get_hardware_revision_process (task, output);
+        qmi_message_dms_get_hardware_revision_output_unref (output);
+        g_object_unref (task);
+        return;
+    }
+
     mm_obj_dbg (self, "loading hardware revision...");
     qmi_client_dms_get_hardware_revision (QMI_CLIENT_DMS (client),
                                           NULL,
                                           5,
                                           NULL,
                                           (GAsyncReadyCallback)dms_get_hardware_revision_ready,
-                                          g_task_new (self, NULL, callback, user_data));
+                                          task);
 }
 
 /*****************************************************************************/
@@ -615,32 +770,13 @@ modem_load_equipment_identifier_finish (MMIfaceModem *self,
 }
 
 static void
-dms_get_ids_ready (QmiClientDms *client,
-                   GAsyncResult *res,
-                   GTask *task)
+dms_get_ids_process (GTask *task,
+                     QmiMessageDmsGetIdsOutput *output)
 {
     MMBroadbandModemQmi *self;
-    QmiMessageDmsGetIdsOutput *output = NULL;
-    GError *error = NULL;
     const gchar *str;
     guint len;
 
-    output = qmi_client_dms_get_ids_finish (client, res, &error);
-    if (!output) {
-        g_prefix_error (&error, "QMI operation failed: ");
-        g_task_return_error (task, error);
-        g_object_unref (task);
-        return;
-    }
-
-    if (!qmi_message_dms_get_ids_output_get_result (output, &error)) {
-        g_prefix_error (&error, "Couldn't get IDs: ");
-        g_task_return_error (task, error);
-        g_object_unref (task);
-        qmi_message_dms_get_ids_output_unref (output);
-        return;
-    }
-
     self = g_task_get_source_object (task);
 
     /* In order:
@@ -688,6 +824,33 @@ dms_get_ids_ready (QmiClientDms *client,
         str = "unknown";
 
     g_task_return_pointer (task, g_strdup (str), g_free);
+}
+
+static void
+dms_get_ids_ready (QmiClientDms *client,
+                   GAsyncResult *res,
+                   GTask *task)
+{
+    QmiMessageDmsGetIdsOutput *output = NULL;
+    GError *error = NULL;
+
+    output = qmi_client_dms_get_ids_finish (client, res, &error);
+    if (!output) {
+        g_prefix_error (&error, "QMI operation failed: ");
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    if (!qmi_message_dms_get_ids_output_get_result (output, &error)) {
+        g_prefix_error (&error, "Couldn't get IDs: ");
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        qmi_message_dms_get_ids_output_unref (output);
+        return;
+    }
+
+    dms_get_ids_process (task, output);
     g_object_unref (task);
 
     qmi_message_dms_get_ids_output_unref (output);
@@ -699,19 +862,31 @@ modem_load_equipment_identifier (MMIfaceModem *self,
                                  gpointer user_data)
 {
     QmiClient *client = NULL;
+    QmiMessageDmsGetIdsOutput *output;
+    GTask *task;
 
     if (!mm_shared_qmi_ensure_client (MM_SHARED_QMI (self),
                                       QMI_SERVICE_DMS, &client,
                                       callback, user_data))
         return;
 
+    task = g_task_new (self, NULL, callback, user_data);
+
+    output = dms_prefetch_take (MM_BROADBAND_MODEM_QMI (self), DMS_PREFETCH_IDS);
+    if (output) {
+        dms_get_ids_process (task, output);
+        qmi_message_dms_get_ids_output_unref (output);
+        g_object_unref (task);
+        return;
+    }
+
     mm_obj_dbg (self, "loading equipment identifier...");
     qmi_client_dms_get_ids (QMI_CLIENT_DMS (client),
                             NULL,
                             5,
                             NULL,
                             (GAsyncReadyCallback)dms_get_ids_ready,
-                            g_task_new (self, NULL, callback, user_data));
+                            task);
 }
 
 /*****************************************************************************/
@@ -1314,6 +1489,131 @@ modem_load_supported_ip_families (MMIfaceModem *self,
     g_object_unref (task);
 }
 
+/*****************************************************************************/
+/* NAS state mirror
+ *
+ * Registration and signal information received in NAS indications is kept
+ * here, so that registration checks and signal loads can be served without
+ * any QMI request while the indications are enabled. The mirror is only
+ * trusted up to a maximum age, after which an explicit request is sent again
+ * just in case an indication was lost. */
+
+#define NAS_STATE_REGISTRATION_MAX_AGE_SECS 120
+#define NAS_STATE_SIGNAL_MAX_AGE_SECS        60
+
+static gboolean
+nas_state_is_fresh (gint64 timestamp,
+                    guint  max_age_secs)
+{
+    return (timestamp && ((g_get_monotonic_time () - timestamp) < ((gint64) max_age_secs * G_USEC_PER_SEC)));
+}
+
+static void
+nas_state_invalidate_registration (MMBroadbandModemQmi *self)
+{
+    self->priv->nas_registration_timestamp = 0;
+}
+
+static void
+nas_state_invalidate_signal (MMBroadbandModemQmi *self)
+{
+    self->priv->nas_signal_quality_timestamp = 0;
+#if defined WITH_NEWEST_QMI_COMMANDS
+    self->priv->nas_signal_values_timestamp = 0;
+    g_clear_object (&self->priv->nas_signal_cdma);
+    g_clear_object (&self->priv->nas_signal_evdo);
+    g_clear_object (&self->priv->nas_signal_gsm);
+    g_clear_object (&self->priv->nas_signal_umts);
+    g_clear_object (&self->priv->nas_signal_lte);
+    g_clear_object (&self->priv->nas_signal_nr5g);
+#endif /* WITH_NEWEST_QMI_COMMANDS */
+}
+
+static void
+nas_state_update_signal_quality (MMBroadbandModemQmi *self,
+                                 guint8               quality)
+{
+    self->priv->nas_signal_quality = quality;
+    self->priv->nas_signal_quality_timestamp = g_get_monotonic_time ();
+}
+
+#if defined WITH_NEWEST_QMI_COMMANDS
+
+static void
+nas_state_update_signal_values (MMBroadbandModemQmi *self,
+                                MMSignal            *cdma,
+                                MMSignal            *evdo,
+                                MMSignal            *gsm,
+                                MMSignal            *umts,
+                                MMSignal            *lte,
+                                MMSignal            *nr5g)
+{
+    g_set_object (&self->priv->nas_signal_cdma, cdma);
+    g_set_object (&self->priv->nas_signal_evdo, evdo);
+    g_set_object (&self->priv->nas_signal_gsm,  gsm);
+    g_set_object (&self->priv->nas_signal_umts, umts);
+    g_set_object (&self->priv->nas_signal_lte,  lte);
+    g_set_object (&self->priv->nas_signal_nr5g, nr5g);
+    self->priv->nas_signal_values_timestamp = g_get_monotonic_time ();
+}
+
+#endif /* WITH_NEWEST_QMI_COMMANDS */
+
+void
+mm_broadband_modem_qmi_refresh_nas_state (MMBroadbandModemQmi *self)
+{
+    /* Next loads will be sent to the modem, and the responses will be used
+     * to fill in the mirror again */
+    mm_obj_dbg (self, "NAS state mirror invalidated");
+    nas_state_invalidate_registration (self);
+    nas_state_invalidate_signal (self);
+}
+
+/*****************************************************************************/
+/* Modem synchronization (Base modem class) */
+
+static gboolean
+modem_sync_finish (MMBaseModem   *self,
+                   GAsyncResult  *res,
+                   GError       **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+parent_modem_sync_ready (MMBaseModem  *self,
+                         GAsyncResult *res,
+                         GTask        *task)
+{
+    GError *error = NULL;
+
+    if (!MM_BASE_MODEM_CLASS (mm_broadband_modem_qmi_parent_class)->sync_finish (self, res, &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+static void
+modem_sync (MMBaseModem         *self,
+            GCancellable        *cancellable,
+            GAsyncReadyCallback  callback,
+            gpointer             user_data)
+{
+    GTask *task;
+
+    task = g_task_new (self, cancellable, callback, user_data);
+
+    /* Indications may have been lost while suspended, so make sure the
+     * registration checks run during the sync really query the modem */
+    mm_broadband_modem_qmi_refresh_nas_state (MM_BROADBAND_MODEM_QMI (self));
+
+    MM_BASE_MODEM_CLASS (mm_broadband_modem_qmi_parent_class)->sync (self,
+                                                                     cancellable,
+                                                                     (GAsyncReadyCallback) parent_modem_sync_ready,
+                                                                     task);
+}
+
 /*****************************************************************************/
 /* Load signal quality (Modem interface) */
 
@@ -1495,6 +1795,8 @@ get_signal_info_ready (QmiClientNas *client,
         return;
     }
 
+    nas_state_update_signal_quality (self, quality);
+
     /* We update the access technologies directly here when loading signal
      * quality. It goes a bit out of context, but we can do it nicely */
     mm_iface_modem_update_access_technologies (
@@ -1604,6 +1906,8 @@ get_signal_strength_ready (QmiClientNas *client,
         return;
     }
 
+    nas_state_update_signal_quality (self, quality);
+
     /* We update the access technologies directly here when loading signal
      * quality. It goes a bit out of context, but we can do it nicely */
     mm_iface_modem_update_access_technologies (
@@ -1620,10 +1924,11 @@ get_signal_strength_ready (QmiClientNas *client,
 #endif /* WITH_NEWEST_QMI_COMMANDS */
 
 static void
-load_signal_quality (MMIfaceModem *self,
+load_signal_quality (MMIfaceModem *_self,
                      GAsyncReadyCallback callback,
                      gpointer user_data)
 {
+    MMBroadbandModemQmi *self = MM_BROADBAND_MODEM_QMI (_self);
     QmiClient *client = NULL;
     GTask *task;
 
@@ -1634,6 +1939,14 @@ load_signal_quality (MMIfaceModem *self,
 
     task = g_task_new (self, NULL, callback, user_data);
 
+    if (self->priv->unsolicited_events_enabled &&
+        nas_state_is_fresh (self->priv->nas_signal_quality_timestamp, NAS_STATE_SIGNAL_MAX_AGE_SECS)) {
+        mm_obj_dbg (self, "signal quality loaded from NAS state mirror");
+        g_task_return_int (task, self->priv->nas_signal_quality);
+        g_object_unref (task);
+        return;
+    }
+
     mm_obj_dbg (self, "loading signal quality...");
 
 #if defined WITH_NEWEST_QMI_COMMANDS
@@ -2981,6 +3294,7 @@ get_serving_system_3gpp_ready (QmiClientNas *client,
     self = g_task_get_source_object (task);
 
     common_process_serving_system_3gpp (self, output, NULL);
+    self->priv->nas_registration_timestamp = g_get_monotonic_time ();
 
     g_task_return_boolean (task, TRUE);
     g_object_unref (task);
@@ -3461,6 +3775,8 @@ common_process_system_info_3gpp (MMBroadbandModemQmi *self,
     if (has_lte_info)
         mm_iface_modem_3gpp_update_eps_registration_state (MM_IFACE_MODEM_3GPP (self), ps_registration_state);
     mm_iface_modem_3gpp_update_location (MM_IFACE_MODEM_3GPP (self), lac, tac, cid);
+
+    self->priv->nas_registration_timestamp = g_get_monotonic_time ();
 }
 
 static void
@@ -3500,7 +3816,7 @@ get_system_info_ready (QmiClientNas *client,
 #endif /* WITH_NEWEST_QMI_COMMANDS */
 
 static void
-modem_3gpp_run_registration_checks (MMIfaceModem3gpp    *self,
+modem_3gpp_run_registration_checks (MMIfaceModem3gpp    *_self,
                                     gboolean             is_cs_supported,
                                     gboolean             is_ps_supported,
                                     gboolean             is_eps_supported,
@@ -3508,6 +3824,7 @@ modem_3gpp_run_registration_checks (MMIfaceModem3gpp    *self,
                                     GAsyncReadyCallback  callback,
                                     gpointer             user_data)
 {
+    MMBroadbandModemQmi *self = MM_BROADBAND_MODEM_QMI (_self);
     GTask *task;
     QmiClient *client = NULL;
 
@@ -3518,6 +3835,16 @@ modem_3gpp_run_registration_checks (MMIfaceModem3gpp    *self,
 
     task = g_task_new (self, NULL, callback, user_data);
 
+    /* The registration state reported in the last indication is already
+     * exposed in the interface, nothing else to do */
+    if (self->priv->unsolicited_registration_events_enabled &&
+        nas_state_is_fresh (self->priv->nas_registration_timestamp, NAS_STATE_REGISTRATION_MAX_AGE_SECS)) {
+        mm_obj_dbg (self, "registration state loaded from NAS state mirror");
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
+    }
+
 #if defined WITH_NEWEST_QMI_COMMANDS
     qmi_client_nas_get_system_info (QMI_CLIENT_NAS (client),
                                     NULL,
@@ -3605,6 +3932,7 @@ ri_serving_system_or_system_info_ready (QmiClientNas *client,
 
     /* Just ignore errors for now */
     self->priv->unsolicited_registration_events_enabled = ctx->enable;
+    nas_state_invalidate_registration (self);
     g_task_return_boolean (task, TRUE);
     g_object_unref (task);
 }
@@ -4681,9 +5009,10 @@ serving_system_indication_cb (QmiClientNas *client,
                               QmiIndicationNasServingSystemOutput *output,
                               MMBroadbandModemQmi *self)
 {
-    if (mm_iface_modem_is_3gpp (MM_IFACE_MODEM (self)))
+    if (mm_iface_modem_is_3gpp (MM_IFACE_MODEM (self))) {
         common_process_serving_system_3gpp (self, NULL, output);
-    else if (mm_iface_modem_is_cdma (MM_IFACE_MODEM (self)))
+        self->priv->nas_registration_timestamp = g_get_monotonic_time ();
+    } else if (mm_iface_modem_is_cdma (MM_IFACE_MODEM (self)))
         common_process_serving_system_cdma (self, NULL, output);
 }
 
@@ -5072,6 +5401,22 @@ common_enable_disable_unsolicited_events_signal_info (GTask *task)
         task);
 }
 
+static void
+config_signal_info_input_set_rssi_thresholds (QmiMessageNasConfigSignalInfoInput *input)
+{
+    /* RSSI values go between -105 and -60 for 3GPP technologies,
+     * and from -105 to -90 in 3GPP2 technologies (approx). */
+    static const gint8 thresholds_data[] = { -100, -97, -95, -92, -90, -85, -80, -75, -70, -65 };
+    g_autoptr(GArray)  thresholds = NULL;
+
+    thresholds = g_array_sized_new (FALSE, FALSE, sizeof (gint8), G_N_ELEMENTS (thresholds_data));
+    g_array_append_vals (thresholds, thresholds_data, G_N_ELEMENTS (thresholds_data));
+    qmi_message_nas_config_signal_info_input_set_rssi_threshold (
+        input,
+        thresholds,
+        NULL);
+}
+
 static void
 config_signal_info_ready (QmiClientNas *client,
                           GAsyncResult *res,
@@ -5106,21 +5451,7 @@ common_enable_disable_unsolicited_events_signal_info_config (GTask *task)
     }
 
     input = qmi_message_nas_config_signal_info_input_new ();
-
-    /* Prepare thresholds, separated 20 each */
-    {
-        /* RSSI values go between -105 and -60 for 3GPP technologies,
-         * and from -105 to -90 in 3GPP2 technologies (approx). */
-        static const gint8 thresholds_data[] = { -100, -97, -95, -92, -90, -85, -80, -75, -70, -65 };
-        g_autoptr(GArray)  thresholds = NULL;
-
-        thresholds = g_array_sized_new (FALSE, FALSE, sizeof (gint8), G_N_ELEMENTS (thresholds_data));
-        g_array_append_vals (thresholds, thresholds_data, G_N_ELEMENTS (thresholds_data));
-        qmi_message_nas_config_signal_info_input_set_rssi_threshold (
-            input,
-            thresholds,
-            NULL);
-    }
+    config_signal_info_input_set_rssi_thresholds (input);
 
     qmi_client_nas_config_signal_info (
         ctx->client_nas,
@@ -5154,6 +5485,7 @@ common_enable_disable_unsolicited_events (MMBroadbandModemQmi *self,
         return;
     }
     self->priv->unsolicited_events_enabled = enable;
+    nas_state_invalidate_signal (self);
 
     client_nas = mm_shared_qmi_peek_client (MM_SHARED_QMI (self),
                                             QMI_SERVICE_NAS,
@@ -5307,6 +5639,7 @@ nas_event_report_indication_cb (QmiClientNas                      *client,
                         signal_strength,
                         quality);
 
+            nas_state_update_signal_quality (self, quality);
             mm_iface_modem_update_signal_quality (MM_IFACE_MODEM (self), quality);
             mm_iface_modem_update_access_technologies (
                 MM_IFACE_MODEM (self),
@@ -5322,6 +5655,75 @@ nas_event_report_indication_cb (QmiClientNas                      *client,
 
 #if defined WITH_NEWEST_QMI_COMMANDS
 
+static gdouble get_db_from_sinr_level (MMBroadbandModemQmi *self,
+                                       QmiNasEvdoSinrLevel  level);
+
+static void
+nas_signal_info_indication_update_values (MMBroadbandModemQmi              *self,
+                                          QmiIndicationNasSignalInfoOutput *output)
+{
+    g_autoptr(MMSignal)  cdma = NULL;
+    g_autoptr(MMSignal)  evdo = NULL;
+    g_autoptr(MMSignal)  gsm = NULL;
+    g_autoptr(MMSignal)  umts = NULL;
+    g_autoptr(MMSignal)  lte = NULL;
+    g_autoptr(MMSignal)  nr5g = NULL;
+    gint8                rssi;
+    gint16               ecio;
+    QmiNasEvdoSinrLevel  sinr_level;
+    gint32               io;
+    gint8                rsrq;
+    gint16               rsrp;
+    gint16               snr;
+    gint16               rsrq_5g;
+
+    if (qmi_indication_nas_signal_info_output_get_cdma_signal_strength (output, &rssi, &ecio, NULL)) {
+        cdma = mm_signal_new ();
+        mm_signal_set_rssi (cdma, (gdouble)rssi);
+        mm_signal_set_ecio (cdma, ((gdouble)ecio) * (-0.5));
+    }
+
+    if (qmi_indication_nas_signal_info_output_get_hdr_signal_strength (output, &rssi, &ecio, &sinr_level, &io, NULL)) {
+        evdo = mm_signal_new ();
+        mm_signal_set_rssi (evdo, (gdouble)rssi);
+        mm_signal_set_ecio (evdo, ((gdouble)ecio) * (-0.5));
+        mm_signal_set_sinr (evdo, get_db_from_sinr_level (self, sinr_level));
+        mm_signal_set_io (evdo, (gdouble)io);
+    }
+
+    if (qmi_indication_nas_signal_info_output_get_gsm_signal_strength (output, &rssi, NULL)) {
+        gsm = mm_signal_new ();
+        mm_signal_set_rssi (gsm, (gdouble)rssi);
+    }
+
+    if (qmi_indication_nas_signal_info_output_get_wcdma_signal_strength (output, &rssi, &ecio, NULL)) {
+        umts = mm_signal_new ();
+        mm_signal_set_rssi (umts, (gdouble)rssi);
+        mm_signal_set_ecio (umts, ((gdouble)ecio) * (-0.5));
+    }
+
+    if (qmi_indication_nas_signal_info_output_get_lte_signal_strength (output, &rssi, &rsrq, &rsrp, &snr, NULL)) {
+        lte = mm_signal_new ();
+        mm_signal_set_rssi (lte, (gdouble)rssi);
+        mm_signal_set_rsrq (lte, (gdouble)rsrq);
+        mm_signal_set_rsrp (lte, (gdouble)rsrp);
+        mm_signal_set_snr (lte, (0.1) * ((gdouble)snr));
+    }
+
+    if (qmi_indication_nas_signal_info_output_get_5g_signal_strength (output, &rsrp, &snr, NULL)) {
+        nr5g = mm_signal_new ();
+        mm_signal_set_rsrp (nr5g, (gdouble)rsrp);
+        mm_signal_set_snr (nr5g, (gdouble)snr);
+        if (qmi_indication_nas_signal_info_output_get_5g_signal_strength_extended (output, &rsrq_5g, NULL))
+            mm_signal_set_rsrq (nr5g, (gdouble)rsrq_5g);
+    }
+
+    nas_state_update_signal_values (self, cdma, evdo, gsm, umts, lte, nr5g);
+
+    /* Ignored unless extended signal indications were requested */
+    mm_iface_modem_signal_update (MM_IFACE_MODEM_SIGNAL (self), cdma, evdo, gsm, umts, lte, nr5g);
+}
+
 static void
 nas_signal_info_indication_cb (QmiClientNas                     *client,
                                QmiIndicationNasSignalInfoOutput *output,
@@ -5349,12 +5751,15 @@ nas_signal_info_indication_cb (QmiClientNas                     *client,
                                         lte_rssi,
                                         &quality,
                                         &act)) {
+        nas_state_update_signal_quality (self, quality);
         mm_iface_modem_update_signal_quality (MM_IFACE_MODEM (self), quality);
         mm_iface_modem_update_access_technologies (
             MM_IFACE_MODEM (self),
             act,
             (MM_IFACE_MODEM_3GPP_ALL_ACCESS_TECHNOLOGIES_MASK | MM_IFACE_MODEM_CDMA_ALL_ACCESS_TECHNOLOGIES_MASK));
     }
+
+    nas_signal_info_indication_update_values (self, output);
 }
 
 #endif /* WITH_NEWEST_QMI_COMMANDS */
@@ -9372,7 +9777,9 @@ signal_load_values_result_free (SignalLoadValuesResult *result)
     g_clear_object (&result->cdma);
     g_clear_object (&result->evdo);
     g_clear_object (&result->gsm);
+    g_clear_object (&result->umts);
     g_clear_object (&result->lte);
+    g_clear_object (&result->nr5g);
     g_slice_free (SignalLoadValuesResult, result);
 }
 
@@ -9751,11 +10158,20 @@ signal_load_values_context_step (GTask *task)
 
     case SIGNAL_LOAD_VALUES_STEP_SIGNAL_LAST:
         /* If any result is set, succeed */
-        if (VALUES_RESULT_LOADED (ctx))
+        if (VALUES_RESULT_LOADED (ctx)) {
+#if defined WITH_NEWEST_QMI_COMMANDS
+            nas_state_update_signal_values (g_task_get_source_object (task),
+                                            ctx->values_result->cdma,
+                                            ctx->values_result->evdo,
+                                            ctx->values_result->gsm,
+                                            ctx->values_result->umts,
+                                            ctx->values_result->lte,
+                                            ctx->values_result->nr5g);
+#endif
             g_task_return_pointer (task,
                                    g_steal_pointer (&ctx->values_result),
                                    (GDestroyNotify)signal_load_values_result_free);
-        else
+        } else
             g_task_return_new_error (task,
                                      MM_CORE_ERROR,
                                      MM_CORE_ERROR_FAILED,
@@ -9789,6 +10205,31 @@ signal_load_values (MMIfaceModemSignal  *self,
                                       callback, user_data))
         return;
 
+#if defined WITH_NEWEST_QMI_COMMANDS
+    {
+        MMBroadbandModemQmi *modem = MM_BROADBAND_MODEM_QMI (self);
+
+        if (modem->priv->unsolicited_events_enabled &&
+            nas_state_is_fresh (modem->priv->nas_signal_values_timestamp, NAS_STATE_SIGNAL_MAX_AGE_SECS)) {
+            SignalLoadValuesResult *values_result;
+
+            mm_obj_dbg (self, "extended signal information loaded from NAS state mirror");
+            values_result = g_slice_new0 (SignalLoadValuesResult);
+            values_result->cdma = modem->priv->nas_signal_cdma ? g_object_ref (modem->priv->nas_signal_cdma) : NULL;
+            values_result->evdo = modem->priv->nas_signal_evdo ? g_object_ref (modem->priv->nas_signal_evdo) : NULL;
+            values_result->gsm  = modem->priv->nas_signal_gsm  ? g_object_ref (modem->priv->nas_signal_gsm)  : NULL;
+            values_result->umts = modem->priv->nas_signal_umts ? g_object_ref (modem->priv->nas_signal_umts) : NULL;
+            values_result->lte  = modem->priv->nas_signal_lte  ? g_object_ref (modem->priv->nas_signal_lte)  : NULL;
+            values_result->nr5g = modem->priv->nas_signal_nr5g ? g_object_ref (modem->priv->nas_signal_nr5g) : NULL;
+
+            task = g_task_new (self, cancellable, callback, user_data);
+            g_task_return_pointer (task, values_result, (GDestroyNotify)signal_load_values_result_free);
+            g_object_unref (task);
+            return;
+        }
+    }
+#endif /* WITH_NEWEST_QMI_COMMANDS */
+
     ctx = g_slice_new0 (SignalLoadValuesContext);
     ctx->client = g_object_ref (client);
     ctx->step = SIGNAL_LOAD_VALUES_STEP_SIGNAL_FIRST;
@@ -9799,6 +10240,103 @@ signal_load_values (MMIfaceModemSignal  *self,
     signal_load_values_context_step (task);
 }
 
+#if defined WITH_NEWEST_QMI_COMMANDS
+
+/*****************************************************************************/
+/* Setup extended signal indications (Signal interface) */
+
+static gboolean
+signal_setup_indications_finish (MMIfaceModemSignal  *self,
+                                 GAsyncResult        *res,
+                                 GError             **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+signal_config_signal_info_ready (QmiClientNas *client,
+                                 GAsyncResult *res,
+                                 GTask        *task)
+{
+    g_autoptr(QmiMessageNasConfigSignalInfoOutput)  output = NULL;
+    GError                                         *error = NULL;
+
+    output = qmi_client_nas_config_signal_info_finish (client, res, &error);
+    if (!output || !qmi_message_nas_config_signal_info_output_get_result (output, &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+static void
+signal_setup_indications (MMIfaceModemSignal  *self,
+                          guint                rate_ms,
+                          GAsyncReadyCallback  callback,
+                          gpointer             user_data)
+{
+    g_autoptr(QmiMessageNasConfigSignalInfoInput)  input = NULL;
+    GTask                                         *task;
+    QmiClient                                     *client = NULL;
+
+    if (!mm_shared_qmi_ensure_client (MM_SHARED_QMI (self),
+                                      QMI_SERVICE_NAS, &client,
+                                      callback, user_data))
+        return;
+
+    task = g_task_new (self, NULL, callback, user_data);
+
+    /* Signal info indications are registered along with the 3GPP unsolicited events */
+    if (!MM_BROADBAND_MODEM_QMI (self)->priv->unsolicited_events_enabled) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE,
+                                 "Signal info indications not enabled");
+        g_object_unref (task);
+        return;
+    }
+
+    /* RSSI thresholds are always required, they drive the signal quality updates */
+    input = qmi_message_nas_config_signal_info_input_new ();
+    config_signal_info_input_set_rssi_thresholds (input);
+
+    /* The modem reports on every threshold crossing, and also periodically
+     * for LTE; updates more frequent than the requested rate are coalesced
+     * by the interface. */
+    if (rate_ms) {
+        static const gint16 rsrp_thresholds_data[] = { -128, -124, -120, -116, -112, -108, -104, -100, -96, -92, -88, -84, -80 };
+        static const gint8  rsrq_thresholds_data[] = { -19, -17, -15, -13, -11, -9, -7, -5 };
+        static const gint16 snr_thresholds_data[]  = { -50, 0, 50, 100, 150, 200, 250 };
+        g_autoptr(GArray)   rsrp_thresholds = NULL;
+        g_autoptr(GArray)   rsrq_thresholds = NULL;
+        g_autoptr(GArray)   snr_thresholds = NULL;
+
+        rsrp_thresholds = g_array_sized_new (FALSE, FALSE, sizeof (gint16), G_N_ELEMENTS (rsrp_thresholds_data));
+        g_array_append_vals (rsrp_thresholds, rsrp_thresholds_data, G_N_ELEMENTS (rsrp_thresholds_data));
+        qmi_message_nas_config_signal_info_input_set_rsrp_threshold (input, rsrp_thresholds, NULL);
+
+        rsrq_thresholds = g_array_sized_new (FALSE, FALSE, sizeof (gint8), G_N_ELEMENTS (rsrq_thresholds_data));
+        g_array_append_vals (rsrq_thresholds, rsrq_thresholds_data, G_N_ELEMENTS (rsrq_thresholds_data));
+        qmi_message_nas_config_signal_info_input_set_rsrq_threshold (input, rsrq_thresholds, NULL);
+
+        /* LTE SNR thresholds given in units of 0.1 dB */
+        snr_thresholds = g_array_sized_new (FALSE, FALSE, sizeof (gint16), G_N_ELEMENTS (snr_thresholds_data));
+        g_array_append_vals (snr_thresholds, snr_thresholds_data, G_N_ELEMENTS (snr_thresholds_data));
+        qmi_message_nas_config_signal_info_input_set_lte_snr_threshold (input, snr_thresholds, NULL);
+
+        /* Report every second, averaged over one second */
+        qmi_message_nas_config_signal_info_input_set_lte_report (input, 1, 1, NULL);
+    }
+
+    mm_obj_dbg (self, "%s extended signal indications...", rate_ms ? "enabling" : "disabling");
+    qmi_client_nas_config_signal_info (QMI_CLIENT_NAS (client),
+                                       input,
+                                       5,
+                                       NULL,
+                                       (GAsyncReadyCallback)signal_config_signal_info_ready,
+                                       task);
+}
+
+#endif /* WITH_NEWEST_QMI_COMMANDS */
+
 /*****************************************************************************/
 /* Reset data interfaces during initialization */
 
@@ -10169,6 +10707,60 @@ untrack_qmi_device_removed (MMBroadbandModemQmi *self,
     self->priv->qmi_device_removed_id = 0;
 }
 
+static void
+dms_prefetch_ready (MMPortQmi    *qmi,
+                    GAsyncResult *res,
+                    GTask        *task)
+{
+    MMBroadbandModemQmi       *self;
+    g_autoptr(MMPortQmiBatch)  batch = NULL;
+    g_autoptr(GError)          error = NULL;
+    guint                      i;
+
+    self = g_task_get_source_object (task);
+
+    batch = mm_port_qmi_command_batch_finish (qmi, res, &error);
+    if (!batch) {
+        mm_obj_dbg (self, "couldn't prefetch DMS info: %s", error->message);
+        parent_initialization_started (task);
+        return;
+    }
+
+    /* Keep the successful outputs around for the initialization steps that
+     * need them; failed ones are just ignored, and those steps will query
+     * the device by themselves. */
+    dms_prefetch_clear (self);
+    self->priv->dms_prefetch_time = g_get_monotonic_time ();
+    for (i = 0; i < DMS_PREFETCH_LAST; i++) {
+        g_autoptr(GError) inner_error = NULL;
+
+        self->priv->dms_prefetched[i] = mm_port_qmi_batch_take_output (batch, i, &inner_error);
+        if (!self->priv->dms_prefetched[i])
+            mm_obj_dbg (self, "couldn't prefetch %s: %s", dms_prefetch_names[i], inner_error->message);
+    }
+
+    parent_initialization_started (task);
+}
+
+static void
+dms_prefetch (GTask *task)
+{
+    InitializationStartedContext *ctx;
+
+    ctx = g_task_get_task_data (task);
+
+    /* The DMS queries that the modem interface initialization would issue
+     * one by one are all sent at once here, so that they are in flight
+     * together while the parent initialization runs */
+    mm_port_qmi_command_batch (ctx->qmi,
+                               dms_prefetch_requests,
+                               G_N_ELEMENTS (dms_prefetch_requests),
+                               5,
+                               NULL,
+                               (GAsyncReadyCallback)dms_prefetch_ready,
+                               task);
+}
+
 static void allocate_next_client (GTask *task);
 
 static void
@@ -10212,7 +10804,7 @@ allocate_next_client (GTask *task)
             g_object_unref (task);
             return;
         }
-        parent_initialization_started (task);
+        dms_prefetch (task);
         return;
     }
 
@@ -10402,6 +10994,8 @@ finalize (GObject *object)
     g_free (self->priv->esn);
     g_free (self->priv->current_operator_id);
     g_free (self->priv->current_operator_description);
+    nas_state_invalidate_signal (self);
+    dms_prefetch_clear (self);
     if (self->priv->supported_bands)
         g_array_unref (self->priv->supported_bands);
 
@@ -10680,6 +11274,10 @@ iface_modem_signal_init (MMIfaceModemSignal *iface)
     iface->check_support_finish = signal_check_support_finish;
     iface->load_values = signal_load_values;
     iface->load_values_finish = signal_load_values_finish;
+#if defined WITH_NEWEST_QMI_COMMANDS
+    iface->setup_indications = signal_setup_indications;
+    iface->setup_indications_finish = signal_setup_indications_finish;
+#endif
 }
 
 static void
@@ -10735,6 +11333,7 @@ static void
 mm_broadband_modem_qmi_class_init (MMBroadbandModemQmiClass *klass)
 {
     GObjectClass *object_class = G_OBJECT_CLASS (klass);
+    MMBaseModemClass *base_modem_class = MM_BASE_MODEM_CLASS (klass);
     MMBroadbandModemClass *broadband_modem_class = MM_BROADBAND_MODEM_CLASS (klass);
 
     g_type_class_add_private (object_class, sizeof (MMBroadbandModemQmiPrivate));
@@ -10744,6 +11343,9 @@ mm_broadband_modem_qmi_class_init (MMBroadbandModemQmiClass *klass)
     object_class->finalize = finalize;
     object_class->dispose = dispose;
 
+    base_modem_class->sync = modem_sync;
+    base_modem_class->sync_finish = modem_sync_finish;
+
     broadband_modem_class->initialization_started = initialization_started;
     broadband_modem_class->initialization_started_finish = initialization_started_finish;
     broadband_modem_class->enabling_started = enabling_started;
@@ -63,4 +63,8 @@ MMPortQmi *mm_broadband_modem_qmi_get_port_qmi_for_data  (MMBroadbandModemQmi  *
                                                           QmiSioPort           *out_sio_port,
                                                           GError              **error);
 
+/* Force the next registration and signal loads to be sent to the modem
+ * instead of served from the indication-fed NAS state mirror */
+void       mm_broadband_modem_qmi_refresh_nas_state      (MMBroadbandModemQmi  *self);
+
 #endif /* MM_BROADBAND_MODEM_QMI_H */
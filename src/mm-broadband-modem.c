@@ -150,6 +150,10 @@ struct _MMBroadbandModemPrivate {
     gboolean sim_hot_swap_configured;
     gboolean periodic_signal_check_disabled;
     gboolean periodic_access_tech_check_disabled;
+    gint64 resume_timestamp;
+    gulong resume_state_id;
+    gboolean pdp_context_list_cached;
+    GList *pdp_context_list;
 
     /*<--- Modem interface --->*/
     /* Properties */
@@ -2013,6 +2017,51 @@ qcdm_evdo_pilot_sets_log_handle (MMPortSerialQcdm *port,
     qcdm_result_unref (result);
 }
 
+static void
+qcdm_cdma_reverse_power_control_log_handle (MMPortSerialQcdm *port,
+                                            GPtrArray *log_buffers,
+                                            gpointer user_data)
+{
+    MMBroadbandModem *self = MM_BROADBAND_MODEM (user_data);
+    guint i;
+    guint n_records = 0;
+    guint rx_agc_sum = 0;
+    guint tx_power_sum = 0;
+
+    /* Power control reports come in bursts, so just summarize all the ones
+     * received in the same read */
+    for (i = 0; i < log_buffers->len; i++) {
+        GByteArray *log_buffer = g_ptr_array_index (log_buffers, i);
+        QcdmResult *result;
+        uint32_t num = 0;
+        uint32_t j;
+
+        result = qcdm_log_item_cdma_reverse_power_control_new ((const char *) log_buffer->data,
+                                                               log_buffer->len,
+                                                               NULL);
+        if (!result)
+            continue;
+
+        qcdm_log_item_cdma_reverse_power_control_get_num (result, &num);
+        for (j = 0; j < num; j++) {
+            uint8_t rx_agc = 0;
+            uint8_t tx_power = 0;
+            uint8_t tx_gain_adjust = 0;
+
+            if (!qcdm_log_item_cdma_reverse_power_control_get_record (result, j, &rx_agc, &tx_power, &tx_gain_adjust))
+                break;
+            rx_agc_sum += rx_agc;
+            tx_power_sum += tx_power;
+            n_records++;
+        }
+        qcdm_result_unref (result);
+    }
+
+    if (n_records > 0)
+        mm_obj_dbg (self, "CDMA reverse power control: %u records in %u reports, average Rx AGC %u, average Tx power %u",
+                    n_records, log_buffers->len, rx_agc_sum / n_records, tx_power_sum / n_records);
+}
+
 typedef struct {
     MMPortSerial *at_port;
     MMPortSerial *qcdm_port;
@@ -3053,6 +3102,37 @@ cgev_process_pdp (MMBroadbandModem *self,
     g_free (pdp_type);
 }
 
+static gboolean
+cgev_changes_pdp_contexts (MM3gppCgev type)
+{
+    /* Activations and deactivations we requested ourselves don't modify the
+     * context definitions; network initiated ones may create or remove them */
+    switch (type) {
+    case MM_3GPP_CGEV_NW_ACT_PRIMARY:
+    case MM_3GPP_CGEV_NW_DEACT_PRIMARY:
+    case MM_3GPP_CGEV_NW_ACT_SECONDARY:
+    case MM_3GPP_CGEV_NW_DEACT_SECONDARY:
+    case MM_3GPP_CGEV_NW_DEACT_PDP:
+    case MM_3GPP_CGEV_NW_REACT:
+    case MM_3GPP_CGEV_NW_MODIFY:
+    case MM_3GPP_CGEV_ME_MODIFY:
+        return TRUE;
+    case MM_3GPP_CGEV_UNKNOWN:
+    case MM_3GPP_CGEV_NW_DETACH:
+    case MM_3GPP_CGEV_ME_DETACH:
+    case MM_3GPP_CGEV_NW_CLASS:
+    case MM_3GPP_CGEV_ME_CLASS:
+    case MM_3GPP_CGEV_ME_ACT_PRIMARY:
+    case MM_3GPP_CGEV_ME_DEACT_PRIMARY:
+    case MM_3GPP_CGEV_ME_ACT_SECONDARY:
+    case MM_3GPP_CGEV_ME_DEACT_SECONDARY:
+    case MM_3GPP_CGEV_ME_DEACT_PDP:
+    case MM_3GPP_CGEV_REJECT:
+    default:
+        return FALSE;
+    }
+}
+
 static void
 cgev_received (MMPortSerialAt   *port,
                GMatchInfo       *info,
@@ -3067,6 +3147,9 @@ cgev_received (MMPortSerialAt   *port,
 
     type = mm_3gpp_parse_cgev_indication_action (str);
 
+    if (cgev_changes_pdp_contexts (type))
+        mm_broadband_modem_invalidate_cached_pdp_context_list (self);
+
     switch (type) {
     case MM_3GPP_CGEV_NW_DETACH:
     case MM_3GPP_CGEV_ME_DETACH:
@@ -8577,6 +8660,11 @@ logcmd_qcdm_ready (MMPortSerialQcdm *port,
                                                      ctx->setup ? qcdm_evdo_pilot_sets_log_handle : NULL,
                                                      self,
                                                      NULL);
+    mm_port_serial_qcdm_add_unsolicited_msg_batch_handler (port,
+                                                           DM_LOG_ITEM_CDMA_REVERSE_POWER_CONTROL,
+                                                           ctx->setup ? qcdm_cdma_reverse_power_control_log_handle : NULL,
+                                                           self,
+                                                           NULL);
 
     qcdm_result_unref (result);
 
@@ -8602,11 +8690,11 @@ modem_cdma_setup_cleanup_unsolicited_events (MMBroadbandModem *self,
     CdmaUnsolicitedEventsContext *ctx;
     GTask *task;
     GByteArray *logcmd;
-    uint16_t log_items[] = { DM_LOG_ITEM_EVDO_PILOT_SETS_V2, 0 };
+    uint16_t log_items[] = { DM_LOG_ITEM_EVDO_PILOT_SETS_V2, DM_LOG_ITEM_CDMA_REVERSE_POWER_CONTROL, 0 };
     GError *error = NULL;
 
     ctx = g_new0 (CdmaUnsolicitedEventsContext, 1);
-    ctx->setup = TRUE;
+    ctx->setup = setup;
 
     task = g_task_new (self, NULL, callback, user_data);
     g_task_set_task_data (task, ctx, (GDestroyNotify)cdma_unsolicited_events_context_free);
@@ -10021,6 +10109,164 @@ modem_time_check_support (MMIfaceModemTime *self,
                                user_data);
 }
 
+/*****************************************************************************/
+/* Setup/Cleanup unsolicited events (Time interface) */
+
+static gboolean
+modem_time_setup_cleanup_unsolicited_events_finish (MMIfaceModemTime  *self,
+                                                    GAsyncResult      *res,
+                                                    GError           **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+ctz_received (MMPortSerialAt   *port,
+              GMatchInfo       *match_info,
+              MMBroadbandModem *self)
+{
+    g_autofree gchar             *iso8601 = NULL;
+    g_autoptr(MMNetworkTimezone)  tz = NULL;
+    g_autoptr(GError)             error = NULL;
+
+    if (!mm_3gpp_parse_ctz_urc (match_info, &iso8601, &tz, &error)) {
+        mm_obj_dbg (self, "couldn't process network timezone URC: %s", error->message);
+        return;
+    }
+
+    mm_obj_dbg (self, "network timezone URC received");
+    if (iso8601)
+        mm_iface_modem_time_update_network_time (MM_IFACE_MODEM_TIME (self), iso8601);
+    mm_iface_modem_time_update_network_timezone (MM_IFACE_MODEM_TIME (self), tz);
+}
+
+static void
+set_time_unsolicited_events_handlers (MMIfaceModemTime    *self,
+                                      gboolean             enable,
+                                      GAsyncReadyCallback  callback,
+                                      gpointer             user_data)
+{
+    MMPortSerialAt *ports[2];
+    GRegex         *ctz_regex;
+    guint           i;
+    GTask          *task;
+
+    ctz_regex = mm_3gpp_ctz_regex_get ();
+    ports[0] = mm_base_modem_peek_port_primary (MM_BASE_MODEM (self));
+    ports[1] = mm_base_modem_peek_port_secondary (MM_BASE_MODEM (self));
+
+    for (i = 0; i < G_N_ELEMENTS (ports); i++) {
+        if (!ports[i])
+            continue;
+        mm_obj_dbg (self, "%s network timezone URC handlers in %s",
+                    enable ? "setting" : "removing",
+                    mm_port_get_device (MM_PORT (ports[i])));
+        mm_port_serial_at_add_unsolicited_msg_handler (
+            ports[i],
+            ctz_regex,
+            enable ? (MMPortSerialAtUnsolicitedMsgFn) ctz_received : NULL,
+            enable ? self : NULL,
+            NULL);
+    }
+
+    g_regex_unref (ctz_regex);
+
+    task = g_task_new (self, NULL, callback, user_data);
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+static void
+modem_time_setup_unsolicited_events (MMIfaceModemTime    *self,
+                                     GAsyncReadyCallback  callback,
+                                     gpointer             user_data)
+{
+    set_time_unsolicited_events_handlers (self, TRUE, callback, user_data);
+}
+
+static void
+modem_time_cleanup_unsolicited_events (MMIfaceModemTime    *self,
+                                       GAsyncReadyCallback  callback,
+                                       gpointer             user_data)
+{
+    set_time_unsolicited_events_handlers (self, FALSE, callback, user_data);
+}
+
+/*****************************************************************************/
+/* Enable/Disable unsolicited events (Time interface) */
+
+static const MMBaseModemAtCommand time_unsolicited_enable_sequence[] = {
+    /* Extended reporting (+CTZE) includes DST and local time; fall back to
+     * the basic timezone reporting (+CTZV) otherwise */
+    { "+CTZR=2", 3, TRUE, mm_base_modem_response_processor_continue_on_error },
+    { "+CTZR=1", 3, TRUE, mm_base_modem_response_processor_no_result },
+    { NULL }
+};
+
+static gboolean
+modem_time_enable_unsolicited_events_finish (MMIfaceModemTime  *self,
+                                             GAsyncResult      *res,
+                                             GError           **error)
+{
+    GError *inner_error = NULL;
+
+    mm_base_modem_at_sequence_finish (MM_BASE_MODEM (self), res, NULL, &inner_error);
+    if (inner_error) {
+        g_propagate_error (error, inner_error);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static void
+modem_time_enable_unsolicited_events (MMIfaceModemTime    *self,
+                                      GAsyncReadyCallback  callback,
+                                      gpointer             user_data)
+{
+    mm_base_modem_at_sequence (MM_BASE_MODEM (self),
+                               time_unsolicited_enable_sequence,
+                               NULL, /* response_processor_context */
+                               NULL, /* response_processor_context_free */
+                               callback,
+                               user_data);
+}
+
+static gboolean
+modem_time_disable_unsolicited_events_finish (MMIfaceModemTime  *self,
+                                              GAsyncResult      *res,
+                                              GError           **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+ctzr_disable_ready (MMBaseModem  *self,
+                    GAsyncResult *res,
+                    GTask        *task)
+{
+    g_autoptr(GError) error = NULL;
+
+    /* Not critical, the URC handlers are removed anyway */
+    if (!mm_base_modem_at_command_finish (self, res, &error))
+        mm_obj_dbg (self, "couldn't disable network timezone reporting: %s", error->message);
+
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+static void
+modem_time_disable_unsolicited_events (MMIfaceModemTime    *self,
+                                       GAsyncReadyCallback  callback,
+                                       gpointer             user_data)
+{
+    mm_base_modem_at_command (MM_BASE_MODEM (self),
+                              "+CTZR=0",
+                              3,
+                              TRUE,
+                              (GAsyncReadyCallback)ctzr_disable_ready,
+                              g_task_new (self, NULL, callback, user_data));
+}
+
 /*****************************************************************************/
 /* Check support (Signal interface) */
 
@@ -11119,6 +11365,9 @@ enabling_step (GTask *task)
         return;
 
     case ENABLING_STEP_STARTED:
+        /* Context definitions may have been changed while we were disabled */
+        mm_broadband_modem_invalidate_cached_pdp_context_list (ctx->self);
+
         if (MM_BROADBAND_MODEM_GET_CLASS (ctx->self)->enabling_started &&
             MM_BROADBAND_MODEM_GET_CLASS (ctx->self)->enabling_started_finish) {
             MM_BROADBAND_MODEM_GET_CLASS (ctx->self)->enabling_started (ctx->self,
@@ -11355,6 +11604,372 @@ enable (MMBaseModem *self,
     g_object_unref (task);
 }
 
+/*****************************************************************************/
+/* Quick resume synchronization */
+
+typedef enum {
+    SYNCING_STEP_FIRST,
+    SYNCING_STEP_REOPEN_PORTS,
+    SYNCING_STEP_EQUIPMENT_IDENTIFIER,
+    SYNCING_STEP_SIM_IDENTIFIER,
+    SYNCING_STEP_POWER_STATE,
+    SYNCING_STEP_IFACE_3GPP,
+    SYNCING_STEP_LAST,
+} SyncingStep;
+
+typedef struct {
+    SyncingStep  step;
+    GList       *ports;
+    gint64       start;
+} SyncingContext;
+
+static void syncing_step (GTask *task);
+
+static void
+syncing_context_free (SyncingContext *ctx)
+{
+    g_list_free_full (ctx->ports, g_object_unref);
+    g_free (ctx);
+}
+
+static gboolean
+modem_sync_finish (MMBaseModem   *self,
+                   GAsyncResult  *res,
+                   GError       **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+report_time_to_registered (MMBroadbandModem *self)
+{
+    if (!self->priv->resume_timestamp || self->priv->modem_state < MM_MODEM_STATE_REGISTERED)
+        return;
+
+    mm_obj_info (self, "registered %.3f s after quick resume",
+                 (g_get_monotonic_time () - self->priv->resume_timestamp) / (gdouble) G_USEC_PER_SEC);
+
+    self->priv->resume_timestamp = 0;
+    if (self->priv->resume_state_id) {
+        g_signal_handler_disconnect (self, self->priv->resume_state_id);
+        self->priv->resume_state_id = 0;
+    }
+}
+
+static void
+resume_modem_state_changed (MMBroadbandModem *self,
+                            GParamSpec       *pspec)
+{
+    report_time_to_registered (self);
+}
+
+static void
+sync_iface_modem_3gpp_ready (MMIfaceModem3gpp *self,
+                             GAsyncResult     *res,
+                             GTask            *task)
+{
+    SyncingContext *ctx;
+    GError         *error = NULL;
+
+    if (!mm_iface_modem_3gpp_sync_finish (self, res, &error)) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    ctx = g_task_get_task_data (task);
+    ctx->step++;
+    syncing_step (task);
+}
+
+static void
+sync_load_power_state_ready (MMIfaceModem *self,
+                             GAsyncResult *res,
+                             GTask        *task)
+{
+    SyncingContext    *ctx;
+    MMModemPowerState  power_state;
+    MMModemPowerState  previous;
+    GError            *error = NULL;
+
+    power_state = MM_IFACE_MODEM_GET_INTERFACE (self)->load_power_state_finish (self, res, &error);
+    if (error) {
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    previous = mm_gdbus_modem_get_power_state (MM_GDBUS_MODEM (MM_BROADBAND_MODEM (self)->priv->modem_dbus_skeleton));
+    if (previous != MM_MODEM_POWER_STATE_UNKNOWN && power_state != previous) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE,
+                                 "Power state changed while suspended: %s -> %s",
+                                 mm_modem_power_state_get_string (previous),
+                                 mm_modem_power_state_get_string (power_state));
+        g_object_unref (task);
+        return;
+    }
+
+    ctx = g_task_get_task_data (task);
+    ctx->step++;
+    syncing_step (task);
+}
+
+static void
+sync_load_sim_identifier_ready (MMBaseSim    *sim,
+                                GAsyncResult *res,
+                                GTask        *task)
+{
+    MMBroadbandModem *self;
+    SyncingContext   *ctx;
+    const gchar      *previous;
+    g_autofree gchar *sim_identifier = NULL;
+    GError           *error = NULL;
+
+    self = g_task_get_source_object (task);
+
+    sim_identifier = mm_base_sim_load_sim_identifier_finish (sim, res, &error);
+    if (!sim_identifier) {
+        g_prefix_error (&error, "Couldn't revalidate SIM identifier: ");
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    previous = mm_gdbus_sim_get_sim_identifier (MM_GDBUS_SIM (sim));
+    if (g_strcmp0 (previous, sim_identifier) != 0) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE,
+                                 "SIM identifier changed while suspended");
+        g_object_unref (task);
+        return;
+    }
+
+    mm_obj_dbg (self, "SIM identifier revalidated");
+    ctx = g_task_get_task_data (task);
+    ctx->step++;
+    syncing_step (task);
+}
+
+static void
+sync_load_equipment_identifier_ready (MMIfaceModem *self,
+                                      GAsyncResult *res,
+                                      GTask        *task)
+{
+    SyncingContext   *ctx;
+    const gchar      *previous;
+    g_autofree gchar *equipment_identifier = NULL;
+    GError           *error = NULL;
+
+    equipment_identifier = MM_IFACE_MODEM_GET_INTERFACE (self)->load_equipment_identifier_finish (self, res, &error);
+    if (!equipment_identifier) {
+        g_prefix_error (&error, "Couldn't revalidate equipment identifier: ");
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    previous = mm_gdbus_modem_get_equipment_identifier (MM_GDBUS_MODEM (MM_BROADBAND_MODEM (self)->priv->modem_dbus_skeleton));
+    if (g_strcmp0 (previous, equipment_identifier) != 0) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE,
+                                 "Equipment identifier changed while suspended");
+        g_object_unref (task);
+        return;
+    }
+
+    mm_obj_dbg (self, "equipment identifier revalidated");
+    ctx = g_task_get_task_data (task);
+    ctx->step++;
+    syncing_step (task);
+}
+
+static void
+sync_reopen_port_ready (MMPortSerial *port,
+                        GAsyncResult *res,
+                        GTask        *task)
+{
+    GError *error = NULL;
+
+    if (!mm_port_serial_reopen_finish (port, res, &error)) {
+        g_prefix_error (&error, "Couldn't reopen port %s: ", mm_port_get_device (MM_PORT (port)));
+        g_task_return_error (task, error);
+        g_object_unref (task);
+        return;
+    }
+
+    /* Keep on with the next port, if any */
+    syncing_step (task);
+}
+
+static void
+syncing_step (GTask *task)
+{
+    MMBroadbandModem *self;
+    SyncingContext   *ctx;
+
+    /* Don't run new steps if we're cancelled */
+    if (g_task_return_error_if_cancelled (task)) {
+        g_object_unref (task);
+        return;
+    }
+
+    self = g_task_get_source_object (task);
+    ctx = g_task_get_task_data (task);
+
+    switch (ctx->step) {
+    case SYNCING_STEP_FIRST:
+        ctx->step++;
+        /* fall through */
+
+    case SYNCING_STEP_REOPEN_PORTS:
+        if (ctx->ports) {
+            MMPortSerial *port;
+
+            port = MM_PORT_SERIAL (ctx->ports->data);
+            ctx->ports = g_list_delete_link (ctx->ports, ctx->ports);
+            mm_port_serial_reopen (port, 0, (GAsyncReadyCallback)sync_reopen_port_ready, task);
+            g_object_unref (port);
+            return;
+        }
+        ctx->step++;
+        /* fall through */
+
+    case SYNCING_STEP_EQUIPMENT_IDENTIFIER:
+        if (MM_IFACE_MODEM_GET_INTERFACE (self)->load_equipment_identifier &&
+            MM_IFACE_MODEM_GET_INTERFACE (self)->load_equipment_identifier_finish) {
+            MM_IFACE_MODEM_GET_INTERFACE (self)->load_equipment_identifier (
+                MM_IFACE_MODEM (self),
+                (GAsyncReadyCallback)sync_load_equipment_identifier_ready,
+                task);
+            return;
+        }
+        ctx->step++;
+        /* fall through */
+
+    case SYNCING_STEP_SIM_IDENTIFIER:
+        if (self->priv->modem_sim) {
+            mm_base_sim_load_sim_identifier (self->priv->modem_sim,
+                                             (GAsyncReadyCallback)sync_load_sim_identifier_ready,
+                                             task);
+            return;
+        }
+        ctx->step++;
+        /* fall through */
+
+    case SYNCING_STEP_POWER_STATE:
+        if (MM_IFACE_MODEM_GET_INTERFACE (self)->load_power_state &&
+            MM_IFACE_MODEM_GET_INTERFACE (self)->load_power_state_finish) {
+            MM_IFACE_MODEM_GET_INTERFACE (self)->load_power_state (
+                MM_IFACE_MODEM (self),
+                (GAsyncReadyCallback)sync_load_power_state_ready,
+                task);
+            return;
+        }
+        ctx->step++;
+        /* fall through */
+
+    case SYNCING_STEP_IFACE_3GPP:
+        if (self->priv->modem_state >= MM_MODEM_STATE_ENABLED && self->priv->modem_3gpp_dbus_skeleton) {
+            mm_obj_dbg (self, "re-arming unsolicited events in the Modem 3GPP interface...");
+            mm_iface_modem_3gpp_sync (MM_IFACE_MODEM_3GPP (self),
+                                      g_task_get_cancellable (task),
+                                      (GAsyncReadyCallback)sync_iface_modem_3gpp_ready,
+                                      task);
+            return;
+        }
+        ctx->step++;
+        /* fall through */
+
+    case SYNCING_STEP_LAST:
+        mm_obj_info (self, "modem revalidated %.3f s after quick resume",
+                     (g_get_monotonic_time () - ctx->start) / (gdouble) G_USEC_PER_SEC);
+
+        /* Report how long it takes to get registered, either right away or
+         * as soon as the registration checks bring us to that state */
+        if (self->priv->modem_state >= MM_MODEM_STATE_ENABLED) {
+            self->priv->resume_timestamp = ctx->start;
+            report_time_to_registered (self);
+            if (self->priv->resume_timestamp && !self->priv->resume_state_id)
+                self->priv->resume_state_id = g_signal_connect (self,
+                                                                "notify::" MM_IFACE_MODEM_STATE,
+                                                                G_CALLBACK (resume_modem_state_changed),
+                                                                NULL);
+        }
+
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
+
+    default:
+        break;
+    }
+
+    g_assert_not_reached ();
+}
+
+static void
+modem_sync (MMBaseModem         *self,
+            GCancellable        *cancellable,
+            GAsyncReadyCallback  callback,
+            gpointer             user_data)
+{
+    SyncingContext *ctx;
+    GTask          *task;
+    MMPortSerial   *ports[3];
+    guint           i;
+
+    task = g_task_new (self, cancellable, callback, user_data);
+
+    /* Only modems in a stable state can be synchronized, for all the others
+     * a full reprobe is the safest choice */
+    switch (MM_BROADBAND_MODEM (self)->priv->modem_state) {
+    case MM_MODEM_STATE_FAILED:
+    case MM_MODEM_STATE_UNKNOWN:
+    case MM_MODEM_STATE_INITIALIZING:
+    case MM_MODEM_STATE_ENABLING:
+    case MM_MODEM_STATE_DISABLING:
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE,
+                                 "Cannot sync modem: not in a stable state");
+        g_object_unref (task);
+        return;
+    case MM_MODEM_STATE_LOCKED:
+    case MM_MODEM_STATE_DISABLED:
+    case MM_MODEM_STATE_ENABLED:
+    case MM_MODEM_STATE_SEARCHING:
+    case MM_MODEM_STATE_REGISTERED:
+    case MM_MODEM_STATE_DISCONNECTING:
+    case MM_MODEM_STATE_CONNECTING:
+    case MM_MODEM_STATE_CONNECTED:
+    default:
+        break;
+    }
+
+    ctx = g_new0 (SyncingContext, 1);
+    ctx->step = SYNCING_STEP_FIRST;
+    ctx->start = g_get_monotonic_time ();
+    g_task_set_task_data (task, ctx, (GDestroyNotify)syncing_context_free);
+
+    /* Only the ports that were kept open across the suspension need to be reopened */
+    ports[0] = MM_PORT_SERIAL (mm_base_modem_peek_port_primary (self));
+    ports[1] = MM_PORT_SERIAL (mm_base_modem_peek_port_secondary (self));
+    ports[2] = MM_PORT_SERIAL (mm_base_modem_peek_port_qcdm (self));
+    for (i = 0; i < G_N_ELEMENTS (ports); i++) {
+        if (ports[i] && mm_port_serial_is_open (ports[i]))
+            ctx->ports = g_list_append (ctx->ports, g_object_ref (ports[i]));
+    }
+
+    syncing_step (task);
+}
+
+/*****************************************************************************/
+
+static void
+add_stats (MMBaseModem     *self,
+           GVariantBuilder *builder)
+{
+    g_variant_builder_add (builder, "{sv}", "network-timezone-polls-skipped",
+                           g_variant_new_uint32 (mm_iface_modem_time_get_network_timezone_polls_skipped (MM_IFACE_MODEM_TIME (self))));
+    mm_base_sms_add_submit_stats (self, builder);
+}
+
 /*****************************************************************************/
 
 typedef enum {
@@ -11952,6 +12567,86 @@ mm_broadband_modem_create_device_identifier (MMBroadbandModem *self,
 
 /*****************************************************************************/
 
+gboolean
+mm_broadband_modem_get_cached_pdp_context_list (MMBroadbandModem  *self,
+                                                GList            **out_list)
+{
+    if (!self->priv->pdp_context_list_cached)
+        return FALSE;
+
+    *out_list = mm_3gpp_pdp_context_list_copy (self->priv->pdp_context_list);
+    return TRUE;
+}
+
+void
+mm_broadband_modem_set_cached_pdp_context_list (MMBroadbandModem *self,
+                                                GList            *list)
+{
+    mm_3gpp_pdp_context_list_free (self->priv->pdp_context_list);
+    self->priv->pdp_context_list = mm_3gpp_pdp_context_list_copy (list);
+    self->priv->pdp_context_list_cached = TRUE;
+}
+
+static gint
+pdp_context_cmp_cid (const MM3gppPdpContext *pdp,
+                     gconstpointer           cid)
+{
+    return (pdp->cid == GPOINTER_TO_UINT (cid)) ? 0 : 1;
+}
+
+static gint
+pdp_context_cmp (const MM3gppPdpContext *a,
+                 const MM3gppPdpContext *b)
+{
+    return (a->cid > b->cid) - (a->cid < b->cid);
+}
+
+void
+mm_broadband_modem_update_cached_pdp_context (MMBroadbandModem *self,
+                                              guint             cid,
+                                              MMBearerIpFamily  pdp_type,
+                                              const gchar      *apn)
+{
+    MM3gppPdpContext *pdp;
+    GList            *l;
+
+    /* Nothing to update if we don't know the full list */
+    if (!self->priv->pdp_context_list_cached)
+        return;
+
+    l = g_list_find_custom (self->priv->pdp_context_list,
+                            GUINT_TO_POINTER (cid),
+                            (GCompareFunc) pdp_context_cmp_cid);
+    if (l) {
+        pdp = l->data;
+        g_free (pdp->apn);
+    } else {
+        /* Keep the list sorted by CID, as the +CGDCONT? parser does */
+        pdp = g_slice_new0 (MM3gppPdpContext);
+        pdp->cid = cid;
+        self->priv->pdp_context_list = g_list_insert_sorted (self->priv->pdp_context_list,
+                                                             pdp,
+                                                             (GCompareFunc) pdp_context_cmp);
+    }
+
+    pdp->pdp_type = pdp_type;
+    pdp->apn = g_strdup (apn);
+}
+
+void
+mm_broadband_modem_invalidate_cached_pdp_context_list (MMBroadbandModem *self)
+{
+    if (!self->priv->pdp_context_list_cached)
+        return;
+
+    mm_obj_dbg (self, "PDP context list cache invalidated");
+    mm_3gpp_pdp_context_list_free (self->priv->pdp_context_list);
+    self->priv->pdp_context_list = NULL;
+    self->priv->pdp_context_list_cached = FALSE;
+}
+
+/*****************************************************************************/
+
 void
 mm_broadband_modem_sim_hot_swap_detected (MMBroadbandModem *self)
 {
@@ -12337,6 +13032,7 @@ finalize (GObject *object)
         mm_3gpp_creg_regex_destroy (self->priv->modem_3gpp_registration_regex);
 
     g_free (self->priv->carrier_config_mapping);
+    mm_3gpp_pdp_context_list_free (self->priv->pdp_context_list);
 
     G_OBJECT_CLASS (mm_broadband_modem_parent_class)->finalize (object);
 }
@@ -12662,6 +13358,14 @@ iface_modem_time_init (MMIfaceModemTime *iface)
     iface->load_network_time_finish = modem_time_load_network_time_finish;
     iface->load_network_timezone = modem_time_load_network_timezone;
     iface->load_network_timezone_finish = modem_time_load_network_timezone_finish;
+    iface->setup_unsolicited_events = modem_time_setup_unsolicited_events;
+    iface->setup_unsolicited_events_finish = modem_time_setup_cleanup_unsolicited_events_finish;
+    iface->cleanup_unsolicited_events = modem_time_cleanup_unsolicited_events;
+    iface->cleanup_unsolicited_events_finish = modem_time_setup_cleanup_unsolicited_events_finish;
+    iface->enable_unsolicited_events = modem_time_enable_unsolicited_events;
+    iface->enable_unsolicited_events_finish = modem_time_enable_unsolicited_events_finish;
+    iface->disable_unsolicited_events = modem_time_disable_unsolicited_events;
+    iface->disable_unsolicited_events_finish = modem_time_disable_unsolicited_events_finish;
 }
 
 static void
@@ -12703,6 +13407,9 @@ mm_broadband_modem_class_init (MMBroadbandModemClass *klass)
     base_modem_class->enable_finish = enable_finish;
     base_modem_class->disable = disable;
     base_modem_class->disable_finish = disable_finish;
+    base_modem_class->sync = modem_sync;
+    base_modem_class->sync_finish = modem_sync_finish;
+    base_modem_class->add_stats = add_stats;
 
     klass->setup_ports = setup_ports;
     klass->initialization_started = initialization_started;
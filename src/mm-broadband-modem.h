@@ -120,6 +120,18 @@ gboolean mm_broadband_modem_lock_sms_storages_finish (MMBroadbandModem *self,
 void     mm_broadband_modem_unlock_sms_storages      (MMBroadbandModem *self,
                                                       gboolean mem1,
                                                       gboolean mem2);
+/* Cache of the PDP contexts defined in the modem (+CGDCONT?), so that bearer
+ * connections don't need to query them every time */
+gboolean mm_broadband_modem_get_cached_pdp_context_list   (MMBroadbandModem  *self,
+                                                           GList            **out_list);
+void     mm_broadband_modem_set_cached_pdp_context_list   (MMBroadbandModem  *self,
+                                                           GList             *list);
+void     mm_broadband_modem_update_cached_pdp_context     (MMBroadbandModem  *self,
+                                                           guint              cid,
+                                                           MMBearerIpFamily   pdp_type,
+                                                           const gchar       *apn);
+void     mm_broadband_modem_invalidate_cached_pdp_context_list (MMBroadbandModem *self);
+
 /* Helper to update SIM hot swap */
 void mm_broadband_modem_sim_hot_swap_detected (MMBroadbandModem *self);
 
@@ -590,40 +590,107 @@ mm_charset_can_convert_to (const gchar    *utf8,
 /******************************************************************************/
 /* GSM-7 pack/unpack operations */
 
+static inline guint8
+gsm_septet_at (const guint8 *gsm,
+               guint32       i,
+               guint8        start_offset)  /* in _bits_ */
+{
+    guint8 bits_here, bits_in_next, octet, offset, c;
+    guint32 start_bit;
+
+    start_bit = start_offset + (i * 7); /* Overall bit offset of char in buffer */
+    offset = start_bit % 8;  /* Offset to start of char in this byte */
+    bits_here = offset ? (8 - offset) : 7;
+    bits_in_next = 7 - bits_here;
+
+    /* Grab bits in the current byte */
+    octet = gsm[start_bit / 8];
+    c = (octet >> offset) & (0xFF >> (8 - bits_here));
+
+    /* Grab any bits that spilled over to next byte */
+    if (bits_in_next) {
+        octet = gsm[(start_bit / 8) + 1];
+        c |= (octet & (0xFF >> (8 - bits_in_next))) << bits_here;
+    }
+    return c;
+}
+
 guint8 *
 mm_charset_gsm_unpack (const guint8 *gsm,
                        guint32       num_septets,
                        guint8        start_offset,  /* in _bits_ */
                        guint32      *out_unpacked_len)
 {
-    GByteArray *unpacked;
+    guint8 *unpacked;
     guint i;
 
-    unpacked = g_byte_array_sized_new (num_septets + 1);
+    unpacked = g_malloc (num_septets + 1);
+    for (i = 0; i < num_septets; i++)
+        unpacked[i] = gsm_septet_at (gsm, i, start_offset);
+
+    *out_unpacked_len = num_septets;
+    return unpacked;
+}
+
+gchar *
+mm_charset_gsm_packed_to_utf8 (const guint8  *gsm,
+                               guint32        num_septets,
+                               guint8         start_offset,  /* in _bits_ */
+                               gboolean       translit,
+                               GError       **error)
+{
+    g_autofree gchar *utf8 = NULL;
+    gsize             utf8_len = 0;
+    guint32           n_pending_at = 0;
+    guint32           i;
+
+    /* No septet expands to more than 3 bytes of UTF-8, so a single
+     * allocation is enough for the whole string */
+    utf8 = g_malloc (num_septets * 3 + 1);
 
     for (i = 0; i < num_septets; i++) {
-        guint8 bits_here, bits_in_next, octet, offset, c;
-        guint32 start_bit;
-
-        start_bit = start_offset + (i * 7); /* Overall bit offset of char in buffer */
-        offset = start_bit % 8;  /* Offset to start of char in this byte */
-        bits_here = offset ? (8 - offset) : 7;
-        bits_in_next = 7 - bits_here;
-
-        /* Grab bits in the current byte */
-        octet = gsm[start_bit / 8];
-        c = (octet >> offset) & (0xFF >> (8 - bits_here));
-
-        /* Grab any bits that spilled over to next byte */
-        if (bits_in_next) {
-            octet = gsm[(start_bit / 8) + 1];
-            c |= (octet & (0xFF >> (8 - bits_in_next))) << bits_here;
+        guint8 c;
+        guint8 uchars[3];
+        guint8 ulen;
+
+        c = gsm_septet_at (gsm, i, start_offset);
+
+        /* 0x00 is '@', unless followed only by 0x00 up to the end of the
+         * message, in which case it's padding (see the GSM unpacked to UTF-8
+         * conversion above). Emit them only once something else follows. */
+        if (c == 0x00) {
+            n_pending_at++;
+            continue;
+        }
+        for (; n_pending_at > 0; n_pending_at--)
+            utf8[utf8_len++] = '@';
+
+        if (c == GSM_ESCAPE_CHAR) {
+            /* Extended alphabet, decode next char */
+            ulen = ((i + 1) < num_septets) ?
+                gsm_ext_char_to_utf8 (gsm_septet_at (gsm, i + 1, start_offset), uchars) :
+                0;
+            if (ulen)
+                i += 1;
+        } else {
+            /* Default alphabet */
+            ulen = gsm_def_char_to_utf8 (c, uchars);
+        }
+
+        if (ulen) {
+            memcpy (&utf8[utf8_len], uchars, ulen);
+            utf8_len += ulen;
+        } else if (translit) {
+            utf8[utf8_len++] = translit_fallback[0];
+        } else {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "Invalid conversion from GSM7");
+            return NULL;
         }
-        g_byte_array_append (unpacked, &c, 1);
     }
 
-    *out_unpacked_len = unpacked->len;
-    return g_byte_array_free (unpacked, FALSE);
+    utf8[utf8_len] = '\0';
+    return g_steal_pointer (&utf8);
 }
 
 guint8 *
@@ -828,6 +895,16 @@ mm_modem_charset_bytearray_to_utf8 (GByteArray      *bytearray,
                                     MMModemCharset   charset,
                                     gboolean         translit,
                                     GError         **error)
+{
+    return mm_modem_charset_bytes_to_utf8 (bytearray->data, bytearray->len, charset, translit, error);
+}
+
+gchar *
+mm_modem_charset_bytes_to_utf8 (const guint8    *data,
+                                gsize            len,
+                                MMModemCharset   charset,
+                                gboolean         translit,
+                                GError         **error)
 {
     const CharsetSettings *settings;
     g_autofree gchar      *utf8 = NULL;
@@ -842,8 +919,8 @@ mm_modem_charset_bytearray_to_utf8 (GByteArray      *bytearray,
 
     switch (charset) {
         case MM_MODEM_CHARSET_GSM:
-            utf8 = (gchar *) charset_gsm_unpacked_to_utf8 (bytearray->data,
-                                                           bytearray->len,
+            utf8 = (gchar *) charset_gsm_unpacked_to_utf8 (data,
+                                                           len,
                                                            translit,
                                                            error);
             break;
@@ -854,8 +931,8 @@ mm_modem_charset_bytearray_to_utf8 (GByteArray      *bytearray,
         case MM_MODEM_CHARSET_PCDN:
         case MM_MODEM_CHARSET_UCS2:
         case MM_MODEM_CHARSET_UTF16:
-            utf8 = charset_iconv_to_utf8 (bytearray->data,
-                                          bytearray->len,
+            utf8 = charset_iconv_to_utf8 (data,
+                                          len,
                                           settings,
                                           translit,
                                           error);
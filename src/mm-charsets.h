@@ -51,6 +51,15 @@ guint8 *mm_charset_gsm_pack (const guint8 *src,
                              guint8        start_offset,  /* in bits */
                              guint32      *out_packed_len);
 
+/* Unpacks the given GSM-7 septets and converts them to UTF-8 in a single
+ * pass, without building the intermediate unpacked buffer. Behaves as
+ * mm_charset_gsm_unpack() followed by mm_modem_charset_bytearray_to_utf8(). */
+gchar *mm_charset_gsm_packed_to_utf8 (const guint8  *gsm,
+                                      guint32        num_septets,
+                                      guint8         start_offset,  /* in bits */
+                                      gboolean       translit,
+                                      GError       **error);
+
 /*****************************************************************************************/
 
 /*
@@ -92,6 +101,14 @@ gchar *mm_modem_charset_bytearray_to_utf8 (GByteArray      *bytearray,
                                            gboolean         translit,
                                            GError         **error);
 
+/* Same as mm_modem_charset_bytearray_to_utf8(), for input not already held
+ * in a GByteArray */
+gchar *mm_modem_charset_bytes_to_utf8 (const guint8    *data,
+                                       gsize            len,
+                                       MMModemCharset   charset,
+                                       gboolean         translit,
+                                       GError         **error);
+
 /*
  * Convert into an UTF-8 encoded string the input string, which is
  * encoded in the given charset. Those charsets that allow embedded NUL
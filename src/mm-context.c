@@ -41,6 +41,11 @@ static gboolean      debug;
 static MMFilterRule  filter_policy = MM_FILTER_POLICY_STRICT;
 static gboolean      no_auto_scan = NO_AUTO_SCAN_DEFAULT;
 static const gchar  *initial_kernel_events;
+static gint          properties_changed_window;
+static gboolean      generate_plugin_manifest;
+#if defined WITH_SYSTEMD_SUSPEND_RESUME
+static gboolean      quick_suspend_resume;
+#endif
 
 static gboolean
 filter_policy_option_arg (const gchar  *option_name,
@@ -90,6 +95,23 @@ static const GOptionEntry entries[] = {
         "Path to initial kernel events file",
         "[PATH]"
     },
+    {
+        "properties-changed-window", 0, 0, G_OPTION_ARG_INT, &properties_changed_window,
+        "Coalesce DBus property updates of each modem during the given time, in milliseconds",
+        "[MS]"
+    },
+    {
+        "generate-plugin-manifest", 0, 0, G_OPTION_ARG_NONE, &generate_plugin_manifest,
+        "Generate the manifest to load plugins on demand, and exit",
+        NULL
+    },
+#if defined WITH_SYSTEMD_SUSPEND_RESUME
+    {
+        "quick-suspend-resume", 0, 0, G_OPTION_ARG_NONE, &quick_suspend_resume,
+        "Keep modems across suspend and revalidate them on resume instead of reprobing",
+        NULL
+    },
+#endif
     {
         "debug", 0, 0, G_OPTION_ARG_NONE, &debug,
         "Run with extended debugging capabilities",
@@ -132,6 +154,26 @@ mm_context_get_filter_policy (void)
     return filter_policy;
 }
 
+guint
+mm_context_get_properties_changed_window (void)
+{
+    return (guint) MAX (properties_changed_window, 0);
+}
+
+gboolean
+mm_context_get_generate_plugin_manifest (void)
+{
+    return generate_plugin_manifest;
+}
+
+#if defined WITH_SYSTEMD_SUSPEND_RESUME
+gboolean
+mm_context_get_quick_suspend_resume (void)
+{
+    return quick_suspend_resume;
+}
+#endif
+
 /*****************************************************************************/
 /* Log context */
 
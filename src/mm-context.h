@@ -31,6 +31,11 @@ void mm_context_init (gint    argc,
 gboolean     mm_context_get_debug                 (void);
 const gchar *mm_context_get_initial_kernel_events (void);
 gboolean     mm_context_get_no_auto_scan          (void);
+guint        mm_context_get_properties_changed_window (void);
+gboolean     mm_context_get_generate_plugin_manifest  (void);
+#if defined WITH_SYSTEMD_SUSPEND_RESUME
+gboolean     mm_context_get_quick_suspend_resume      (void);
+#endif
 
 /* Filter support */
 MMFilterRule mm_context_get_filter_policy (void);
@@ -2341,6 +2341,183 @@ mm_iface_modem_3gpp_enable (MMIfaceModem3gpp *self,
 
 /*****************************************************************************/
 
+typedef enum {
+    SYNCING_STEP_FIRST,
+    SYNCING_STEP_ENABLE_UNSOLICITED_EVENTS,
+    SYNCING_STEP_ENABLE_UNSOLICITED_REGISTRATION_EVENTS,
+    SYNCING_STEP_REGISTRATION_CHECKS,
+    SYNCING_STEP_LAST
+} SyncingStep;
+
+static void interface_syncing_step (GTask *task);
+
+gboolean
+mm_iface_modem_3gpp_sync_finish (MMIfaceModem3gpp  *self,
+                                 GAsyncResult      *res,
+                                 GError           **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+sync_enable_unsolicited_events_ready (MMIfaceModem3gpp *self,
+                                      GAsyncResult     *res,
+                                      GTask            *task)
+{
+    SyncingStep *step;
+    GError      *error = NULL;
+
+    if (!MM_IFACE_MODEM_3GPP_GET_INTERFACE (self)->enable_unsolicited_events_finish (self, res, &error)) {
+        /* This error shouldn't be treated as critical */
+        mm_obj_dbg (self, "re-enabling unsolicited events failed: %s", error->message);
+        g_error_free (error);
+    }
+
+    step = g_task_get_task_data (task);
+    (*step)++;
+    interface_syncing_step (task);
+}
+
+static void
+sync_enable_unsolicited_registration_events_ready (MMIfaceModem3gpp *self,
+                                                   GAsyncResult     *res,
+                                                   GTask            *task)
+{
+    SyncingStep *step;
+    GError      *error = NULL;
+
+    if (!MM_IFACE_MODEM_3GPP_GET_INTERFACE (self)->enable_unsolicited_registration_events_finish (self, res, &error)) {
+        /* This error shouldn't be treated as critical */
+        mm_obj_dbg (self, "re-enabling unsolicited registration events failed: %s", error->message);
+        g_error_free (error);
+        periodic_registration_check_enable (self);
+    }
+
+    step = g_task_get_task_data (task);
+    (*step)++;
+    interface_syncing_step (task);
+}
+
+static void
+sync_registration_checks_ready (MMIfaceModem3gpp *self,
+                                GAsyncResult     *res,
+                                GTask            *task)
+{
+    SyncingStep *step;
+    GError      *error = NULL;
+
+    if (!mm_iface_modem_3gpp_run_registration_checks_finish (self, res, &error)) {
+        /* This error shouldn't be treated as critical */
+        mm_obj_dbg (self, "registration checks after sync failed: %s", error->message);
+        g_error_free (error);
+    }
+
+    step = g_task_get_task_data (task);
+    (*step)++;
+    interface_syncing_step (task);
+}
+
+static void
+interface_syncing_step (GTask *task)
+{
+    MMIfaceModem3gpp *self;
+    SyncingStep      *step;
+
+    /* Don't run new steps if we're cancelled */
+    if (g_task_return_error_if_cancelled (task)) {
+        g_object_unref (task);
+        return;
+    }
+
+    self = g_task_get_source_object (task);
+    step = g_task_get_task_data (task);
+
+    switch (*step) {
+    case SYNCING_STEP_FIRST:
+        (*step)++;
+        /* fall through */
+
+    case SYNCING_STEP_ENABLE_UNSOLICITED_EVENTS:
+        /* The unsolicited message handlers are still in place in the ports,
+         * we only need to make sure the modem keeps on sending them */
+        if (MM_IFACE_MODEM_3GPP_GET_INTERFACE (self)->enable_unsolicited_events &&
+            MM_IFACE_MODEM_3GPP_GET_INTERFACE (self)->enable_unsolicited_events_finish) {
+            MM_IFACE_MODEM_3GPP_GET_INTERFACE (self)->enable_unsolicited_events (
+                self,
+                (GAsyncReadyCallback)sync_enable_unsolicited_events_ready,
+                task);
+            return;
+        }
+        (*step)++;
+        /* fall through */
+
+    case SYNCING_STEP_ENABLE_UNSOLICITED_REGISTRATION_EVENTS: {
+        gboolean cs_supported = FALSE;
+        gboolean ps_supported = FALSE;
+        gboolean eps_supported = FALSE;
+
+        g_object_get (self,
+                      MM_IFACE_MODEM_3GPP_CS_NETWORK_SUPPORTED, &cs_supported,
+                      MM_IFACE_MODEM_3GPP_PS_NETWORK_SUPPORTED, &ps_supported,
+                      MM_IFACE_MODEM_3GPP_EPS_NETWORK_SUPPORTED, &eps_supported,
+                      NULL);
+
+        if (MM_IFACE_MODEM_3GPP_GET_INTERFACE (self)->enable_unsolicited_registration_events &&
+            MM_IFACE_MODEM_3GPP_GET_INTERFACE (self)->enable_unsolicited_registration_events_finish) {
+            MM_IFACE_MODEM_3GPP_GET_INTERFACE (self)->enable_unsolicited_registration_events (
+                self,
+                cs_supported,
+                ps_supported,
+                eps_supported,
+                (GAsyncReadyCallback)sync_enable_unsolicited_registration_events_ready,
+                task);
+            return;
+        }
+        (*step)++;
+    } /* fall through */
+
+    case SYNCING_STEP_REGISTRATION_CHECKS:
+        /* Refresh the registration state, which may have changed while
+         * suspended without us receiving any URC */
+        mm_iface_modem_3gpp_run_registration_checks (
+            self,
+            (GAsyncReadyCallback)sync_registration_checks_ready,
+            task);
+        return;
+
+    case SYNCING_STEP_LAST:
+        /* We are done without errors! */
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
+
+    default:
+        break;
+    }
+
+    g_assert_not_reached ();
+}
+
+void
+mm_iface_modem_3gpp_sync (MMIfaceModem3gpp    *self,
+                          GCancellable        *cancellable,
+                          GAsyncReadyCallback  callback,
+                          gpointer             user_data)
+{
+    SyncingStep *step;
+    GTask       *task;
+
+    step = g_new0 (SyncingStep, 1);
+    *step = SYNCING_STEP_FIRST;
+
+    task = g_task_new (self, cancellable, callback, user_data);
+    g_task_set_task_data (task, step, g_free);
+
+    interface_syncing_step (task);
+}
+
+/*****************************************************************************/
+
 typedef struct _InitializationContext InitializationContext;
 static void interface_initialization_step (GTask *task);
 
@@ -2630,7 +2807,7 @@ mm_iface_modem_3gpp_initialize (MMIfaceModem3gpp *self,
                   MM_IFACE_MODEM_3GPP_DBUS_SKELETON, &skeleton,
                   NULL);
     if (!skeleton) {
-        skeleton = mm_gdbus_modem3gpp_skeleton_new ();
+        skeleton = mm_base_modem_create_interface_skeleton (MM_BASE_MODEM (self), MM_GDBUS_TYPE_MODEM3GPP_SKELETON);
 
         /* Set all initial property defaults */
         mm_gdbus_modem3gpp_set_imei (skeleton, NULL);
@@ -265,6 +265,15 @@ gboolean mm_iface_modem_3gpp_disable_finish (MMIfaceModem3gpp *self,
                                              GAsyncResult *res,
                                              GError **error);
 
+/* Sync Modem 3GPP interface after a quick resume (async) */
+void     mm_iface_modem_3gpp_sync        (MMIfaceModem3gpp *self,
+                                          GCancellable *cancellable,
+                                          GAsyncReadyCallback callback,
+                                          gpointer user_data);
+gboolean mm_iface_modem_3gpp_sync_finish (MMIfaceModem3gpp *self,
+                                          GAsyncResult *res,
+                                          GError **error);
+
 /* Shutdown Modem 3GPP interface */
 void mm_iface_modem_3gpp_shutdown (MMIfaceModem3gpp *self);
 
@@ -1891,7 +1891,7 @@ mm_iface_modem_cdma_initialize (MMIfaceModemCdma *self,
                   MM_IFACE_MODEM_CDMA_DBUS_SKELETON, &skeleton,
                   NULL);
     if (!skeleton) {
-        skeleton = mm_gdbus_modem_cdma_skeleton_new ();
+        skeleton = mm_base_modem_create_interface_skeleton (MM_BASE_MODEM (self), MM_GDBUS_TYPE_MODEM_CDMA_SKELETON);
 
         /* Set all initial property defaults */
         mm_gdbus_modem_cdma_set_meid (skeleton, NULL);
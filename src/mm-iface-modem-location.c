@@ -1952,7 +1952,7 @@ mm_iface_modem_location_initialize (MMIfaceModemLocation *self,
                   MM_IFACE_MODEM_LOCATION_DBUS_SKELETON, &skeleton,
                   NULL);
     if (!skeleton) {
-        skeleton = mm_gdbus_modem_location_skeleton_new ();
+        skeleton = mm_base_modem_create_interface_skeleton (MM_BASE_MODEM (self), MM_GDBUS_TYPE_MODEM_LOCATION_SKELETON);
 
         /* Set all initial property defaults */
         mm_gdbus_modem_location_set_capabilities (skeleton, MM_MODEM_LOCATION_SOURCE_NONE);
@@ -94,7 +94,9 @@ struct _MMIfaceModemLocation {
                                         GAsyncResult *res,
                                         GError **error);
 
-    /* Inject assistance data (async) */
+    /* Inject assistance data (async).
+     * The data is owned by the caller, and is ensured to be valid until the
+     * operation is completed. */
     void     (* inject_assistance_data)       (MMIfaceModemLocation  *self,
                                                const guint8          *data,
                                                gsize                  data_size,
@@ -39,23 +39,122 @@ mm_iface_modem_signal_bind_simple_status (MMIfaceModemSignal *self,
 
 /*****************************************************************************/
 
+/* Maximum number of recent samples kept */
+#define HISTORY_MAX_SAMPLES 100
+
+/* Polling is only a fallback, every sample costs a modem round trip */
+#define MIN_POLLING_PERIOD_MS 1000
+
+typedef enum {
+    SIGNAL_VALUE_CDMA,
+    SIGNAL_VALUE_EVDO,
+    SIGNAL_VALUE_GSM,
+    SIGNAL_VALUE_UMTS,
+    SIGNAL_VALUE_LTE,
+    SIGNAL_VALUE_NR5G,
+    SIGNAL_VALUE_LAST
+} SignalValue;
+
+static const struct {
+    const gchar *key;
+    void (* set) (MmGdbusModemSignal *object,
+                  GVariant           *value);
+} signal_values[SIGNAL_VALUE_LAST] = {
+    [SIGNAL_VALUE_CDMA] = { "cdma", mm_gdbus_modem_signal_set_cdma },
+    [SIGNAL_VALUE_EVDO] = { "evdo", mm_gdbus_modem_signal_set_evdo },
+    [SIGNAL_VALUE_GSM]  = { "gsm",  mm_gdbus_modem_signal_set_gsm  },
+    [SIGNAL_VALUE_UMTS] = { "umts", mm_gdbus_modem_signal_set_umts },
+    [SIGNAL_VALUE_LTE]  = { "lte",  mm_gdbus_modem_signal_set_lte  },
+    [SIGNAL_VALUE_NR5G] = { "nr5g", mm_gdbus_modem_signal_set_nr5g },
+};
+
 typedef struct {
-    guint rate;
-    guint timeout_source;
+    /* Polling */
+    guint     rate;
+    guint     timeout_period;
+    guint     timeout_source;
+    /* Indications */
+    guint     indication_rate;
+    gboolean  indications_enabled;
+    gint64    last_published;
+    guint     throttle_source;
+    GVariant *pending[SIGNAL_VALUE_LAST];
+    /* Ring buffer of recent samples, oldest one at history_first */
+    GVariant *history[HISTORY_MAX_SAMPLES];
+    guint     history_first;
+    guint     history_n;
 } RefreshContext;
 
+static void
+clear_pending (RefreshContext *ctx)
+{
+    guint i;
+
+    for (i = 0; i < SIGNAL_VALUE_LAST; i++)
+        g_clear_pointer (&ctx->pending[i], g_variant_unref);
+}
+
 static void
 refresh_context_free (RefreshContext *ctx)
 {
+    guint i;
+
     if (ctx->timeout_source)
         g_source_remove (ctx->timeout_source);
+    if (ctx->throttle_source)
+        g_source_remove (ctx->throttle_source);
+    clear_pending (ctx);
+    for (i = 0; i < ctx->history_n; i++)
+        g_variant_unref (ctx->history[(ctx->history_first + i) % HISTORY_MAX_SAMPLES]);
     g_slice_free (RefreshContext, ctx);
 }
 
+static RefreshContext *
+peek_refresh_context (MMIfaceModemSignal *self)
+{
+    if (G_UNLIKELY (!refresh_context_quark))
+        refresh_context_quark  = g_quark_from_static_string (REFRESH_CONTEXT_TAG);
+
+    return g_object_get_qdata (G_OBJECT (self), refresh_context_quark);
+}
+
+static RefreshContext *
+ensure_refresh_context (MMIfaceModemSignal *self)
+{
+    RefreshContext *ctx;
+
+    ctx = peek_refresh_context (self);
+    if (!ctx) {
+        ctx = g_slice_new0 (RefreshContext);
+        g_object_set_qdata_full (G_OBJECT (self),
+                                 refresh_context_quark,
+                                 ctx,
+                                 (GDestroyNotify)refresh_context_free);
+    }
+    return ctx;
+}
+
+static void
+history_push (RefreshContext *ctx,
+              GVariant       *sample)
+{
+    guint i;
+
+    i = (ctx->history_first + ctx->history_n) % HISTORY_MAX_SAMPLES;
+    if (ctx->history_n == HISTORY_MAX_SAMPLES) {
+        /* Full, overwrite the oldest one */
+        g_variant_unref (ctx->history[i]);
+        ctx->history_first = (ctx->history_first + 1) % HISTORY_MAX_SAMPLES;
+    } else
+        ctx->history_n++;
+    ctx->history[i] = g_variant_ref_sink (sample);
+}
+
 static void
 clear_values (MMIfaceModemSignal *self)
 {
     g_autoptr(MmGdbusModemSignalSkeleton) skeleton = NULL;
+    guint                                 i;
 
     g_object_get (self,
                   MM_IFACE_MODEM_SIGNAL_DBUS_SKELETON, &skeleton,
@@ -63,47 +162,18 @@ clear_values (MMIfaceModemSignal *self)
     if (!skeleton)
         return;
 
-    mm_gdbus_modem_signal_set_cdma (MM_GDBUS_MODEM_SIGNAL (skeleton), NULL);
-    mm_gdbus_modem_signal_set_evdo (MM_GDBUS_MODEM_SIGNAL (skeleton), NULL);
-    mm_gdbus_modem_signal_set_gsm  (MM_GDBUS_MODEM_SIGNAL (skeleton), NULL);
-    mm_gdbus_modem_signal_set_umts (MM_GDBUS_MODEM_SIGNAL (skeleton), NULL);
-    mm_gdbus_modem_signal_set_lte  (MM_GDBUS_MODEM_SIGNAL (skeleton), NULL);
-    mm_gdbus_modem_signal_set_nr5g (MM_GDBUS_MODEM_SIGNAL (skeleton), NULL);
+    for (i = 0; i < SIGNAL_VALUE_LAST; i++)
+        signal_values[i].set (MM_GDBUS_MODEM_SIGNAL (skeleton), NULL);
 }
 
 static void
-load_values_ready (MMIfaceModemSignal *self,
-                   GAsyncResult       *res)
+publish_values (MMIfaceModemSignal  *self,
+                GVariant           **dicts)
 {
-    g_autoptr(GError)   error = NULL;
-    g_autoptr(MMSignal) cdma = NULL;
-    g_autoptr(GVariant) dict_cdma = NULL;
-    g_autoptr(MMSignal) evdo = NULL;
-    g_autoptr(GVariant) dict_evdo = NULL;
-    g_autoptr(MMSignal) gsm = NULL;
-    g_autoptr(GVariant) dict_gsm = NULL;
-    g_autoptr(MMSignal) umts = NULL;
-    g_autoptr(GVariant) dict_umts = NULL;
-    g_autoptr(MMSignal) lte = NULL;
-    g_autoptr(GVariant) dict_lte = NULL;
-    g_autoptr(MMSignal) nr5g = NULL;
-    g_autoptr(GVariant) dict_nr5g = NULL;
     g_autoptr(MmGdbusModemSignalSkeleton) skeleton = NULL;
-
-    if (!MM_IFACE_MODEM_SIGNAL_GET_INTERFACE (self)->load_values_finish (
-            self,
-            res,
-            &cdma,
-            &evdo,
-            &gsm,
-            &umts,
-            &lte,
-            &nr5g,
-            &error)) {
-        mm_obj_warn (self, "couldn't load extended signal information: %s", error->message);
-        clear_values (self);
-        return;
-    }
+    RefreshContext                       *ctx;
+    GVariantBuilder                       builder;
+    guint                                 i;
 
     g_object_get (self,
                   MM_IFACE_MODEM_SIGNAL_DBUS_SKELETON, &skeleton,
@@ -113,32 +183,61 @@ load_values_ready (MMIfaceModemSignal *self,
         return;
     }
 
-    if (cdma)
-        dict_cdma = mm_signal_get_dictionary (cdma);
-    mm_gdbus_modem_signal_set_cdma (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_cdma);
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
+    g_variant_builder_add (&builder, "{sv}", "timestamp", g_variant_new_uint64 (g_get_real_time () / 1000));
+    for (i = 0; i < SIGNAL_VALUE_LAST; i++) {
+        signal_values[i].set (MM_GDBUS_MODEM_SIGNAL (skeleton), dicts[i]);
+        if (dicts[i])
+            g_variant_builder_add (&builder, "{sv}", signal_values[i].key, dicts[i]);
+    }
 
-    if (evdo)
-        dict_evdo = mm_signal_get_dictionary (evdo);
-    mm_gdbus_modem_signal_set_evdo (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_evdo);
+    /* Flush right away */
+    g_dbus_interface_skeleton_flush (G_DBUS_INTERFACE_SKELETON (skeleton));
 
-    if (gsm)
-        dict_gsm = mm_signal_get_dictionary (gsm);
-    mm_gdbus_modem_signal_set_gsm (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_gsm);
+    ctx = peek_refresh_context (self);
+    if (ctx)
+        history_push (ctx, g_variant_builder_end (&builder));
+    else
+        g_variant_builder_clear (&builder);
+}
 
-    if (umts)
-        dict_umts = mm_signal_get_dictionary (umts);
-    mm_gdbus_modem_signal_set_umts (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_umts);
+static void
+load_values_ready (MMIfaceModemSignal *self,
+                   GAsyncResult       *res)
+{
+    g_autoptr(GError)  error = NULL;
+    MMSignal          *values[SIGNAL_VALUE_LAST] = { NULL };
+    GVariant          *dicts[SIGNAL_VALUE_LAST] = { NULL };
+    guint              i;
+
+    if (!MM_IFACE_MODEM_SIGNAL_GET_INTERFACE (self)->load_values_finish (
+            self,
+            res,
+            &values[SIGNAL_VALUE_CDMA],
+            &values[SIGNAL_VALUE_EVDO],
+            &values[SIGNAL_VALUE_GSM],
+            &values[SIGNAL_VALUE_UMTS],
+            &values[SIGNAL_VALUE_LTE],
+            &values[SIGNAL_VALUE_NR5G],
+            &error)) {
+        mm_obj_warn (self, "couldn't load extended signal information: %s", error->message);
+        clear_values (self);
+        return;
+    }
 
-    if (lte)
-        dict_lte = mm_signal_get_dictionary (lte);
-    mm_gdbus_modem_signal_set_lte (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_lte);
+    for (i = 0; i < SIGNAL_VALUE_LAST; i++) {
+        if (values[i]) {
+            dicts[i] = mm_signal_get_dictionary (values[i]);
+            g_object_unref (values[i]);
+        }
+    }
 
-    if (nr5g)
-        dict_nr5g = mm_signal_get_dictionary (nr5g);
-    mm_gdbus_modem_signal_set_nr5g (MM_GDBUS_MODEM_SIGNAL (skeleton), dict_nr5g);
+    publish_values (self, dicts);
 
-    /* Flush right away */
-    g_dbus_interface_skeleton_flush (G_DBUS_INTERFACE_SKELETON (skeleton));
+    for (i = 0; i < SIGNAL_VALUE_LAST; i++) {
+        if (dicts[i])
+            g_variant_unref (dicts[i]);
+    }
 }
 
 static gboolean
@@ -152,13 +251,49 @@ refresh_context_cb (MMIfaceModemSignal *self)
     return G_SOURCE_CONTINUE;
 }
 
+static void
+refresh_context_update_polling (MMIfaceModemSignal *self,
+                                RefreshContext     *ctx)
+{
+    guint period = 0;
+
+    /* When indication-driven reporting is requested, only poll if the modem
+     * couldn't be configured to report the values by itself */
+    if (ctx->indication_rate) {
+        if (!ctx->indications_enabled)
+            period = MAX (ctx->indication_rate, MIN_POLLING_PERIOD_MS);
+    } else
+        period = ctx->rate * 1000;
+
+    if (period == ctx->timeout_period)
+        return;
+
+    ctx->timeout_period = period;
+    if (ctx->timeout_source) {
+        g_source_remove (ctx->timeout_source);
+        ctx->timeout_source = 0;
+    }
+
+    if (!period) {
+        mm_obj_dbg (self, "extended signal information polling disabled");
+        return;
+    }
+
+    mm_obj_dbg (self, "extended signal information polling enabled (period: %u ms)", period);
+    if (period % 1000 == 0)
+        ctx->timeout_source = g_timeout_add_seconds (period / 1000, (GSourceFunc) refresh_context_cb, self);
+    else
+        ctx->timeout_source = g_timeout_add (period, (GSourceFunc) refresh_context_cb, self);
+
+    /* Also launch right away */
+    refresh_context_cb (self);
+}
+
 static void
 teardown_refresh_context (MMIfaceModemSignal *self)
 {
     clear_values (self);
-    if (G_UNLIKELY (!refresh_context_quark))
-        refresh_context_quark  = g_quark_from_static_string (REFRESH_CONTEXT_TAG);
-    if (g_object_get_qdata (G_OBJECT (self), refresh_context_quark)) {
+    if (peek_refresh_context (self)) {
         mm_obj_dbg (self, "extended signal information reporting disabled");
         g_object_set_qdata (G_OBJECT (self), refresh_context_quark, NULL);
     }
@@ -173,9 +308,7 @@ setup_refresh_context (MMIfaceModemSignal *self,
     MmGdbusModemSignal *skeleton;
     RefreshContext *ctx;
     MMModemState modem_state;
-
-    if (G_UNLIKELY (!refresh_context_quark))
-        refresh_context_quark  = g_quark_from_static_string (REFRESH_CONTEXT_TAG);
+    guint indication_rate;
 
     g_object_get (self,
                   MM_IFACE_MODEM_SIGNAL_DBUS_SKELETON, &skeleton,
@@ -193,13 +326,13 @@ setup_refresh_context (MMIfaceModemSignal *self,
         mm_gdbus_modem_signal_set_rate (skeleton, new_rate);
     else
         new_rate = mm_gdbus_modem_signal_get_rate (skeleton);
+    indication_rate = mm_gdbus_modem_signal_get_indication_rate (skeleton);
     g_object_unref (skeleton);
 
     /* User disabling? */
-    if (new_rate == 0) {
+    if (new_rate == 0 && indication_rate == 0) {
         mm_obj_dbg (self, "extended signal information reporting disabled (rate: 0 seconds)");
-        clear_values (self);
-        g_object_set_qdata (G_OBJECT (self), refresh_context_quark, NULL);
+        teardown_refresh_context (self);
         return TRUE;
     }
 
@@ -209,32 +342,191 @@ setup_refresh_context (MMIfaceModemSignal *self,
     }
 
     /* Setup refresh context */
-    ctx = g_object_get_qdata (G_OBJECT (self), refresh_context_quark);
+    ctx = ensure_refresh_context (self);
+
+    /* We're enabling, compare to old rate */
+    if (ctx->rate != new_rate) {
+        mm_obj_dbg (self, "extended signal information reporting enabled (rate: %u seconds)", new_rate);
+        ctx->rate = new_rate;
+    }
+
+    /* Polling period depends on both the rate and the indications setup */
+    refresh_context_update_polling (self, ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+static void
+publish_pending (MMIfaceModemSignal *self,
+                 RefreshContext     *ctx)
+{
+    ctx->last_published = g_get_monotonic_time ();
+    publish_values (self, ctx->pending);
+    clear_pending (ctx);
+}
+
+static gboolean
+throttle_cb (MMIfaceModemSignal *self)
+{
+    RefreshContext *ctx;
+
+    ctx = peek_refresh_context (self);
+    g_assert (ctx);
+    ctx->throttle_source = 0;
+    publish_pending (self, ctx);
+    return G_SOURCE_REMOVE;
+}
+
+void
+mm_iface_modem_signal_update (MMIfaceModemSignal *self,
+                              MMSignal           *cdma,
+                              MMSignal           *evdo,
+                              MMSignal           *gsm,
+                              MMSignal           *umts,
+                              MMSignal           *lte,
+                              MMSignal           *nr5g)
+{
+    RefreshContext *ctx;
+    MMSignal       *values[SIGNAL_VALUE_LAST] = { cdma, evdo, gsm, umts, lte, nr5g };
+    gint64          elapsed_ms;
+    guint           i;
+
+    /* Only processed while the indication-driven reporting is enabled */
+    ctx = peek_refresh_context (self);
+    if (!ctx || !ctx->indications_enabled)
+        return;
+
+    /* Newer values always replace the ones not yet published */
+    clear_pending (ctx);
+    for (i = 0; i < SIGNAL_VALUE_LAST; i++) {
+        if (values[i])
+            ctx->pending[i] = mm_signal_get_dictionary (values[i]);
+    }
+
+    /* Already waiting to publish */
+    if (ctx->throttle_source)
+        return;
+
+    elapsed_ms = (g_get_monotonic_time () - ctx->last_published) / 1000;
+    if (ctx->last_published && elapsed_ms < ctx->indication_rate) {
+        ctx->throttle_source = g_timeout_add ((guint)(ctx->indication_rate - elapsed_ms),
+                                              (GSourceFunc) throttle_cb,
+                                              self);
+        return;
+    }
+
+    publish_pending (self, ctx);
+}
+
+/*****************************************************************************/
+
+static gboolean
+setup_indications_finish (MMIfaceModemSignal  *self,
+                          GAsyncResult        *res,
+                          GError             **error)
+{
+    return g_task_propagate_boolean (G_TASK (res), error);
+}
+
+static void
+setup_indications_complete (MMIfaceModemSignal *self,
+                            GTask              *task)
+{
+    RefreshContext *ctx;
+
+    ctx = peek_refresh_context (self);
+    if (ctx) {
+        if (!ctx->rate && !ctx->indication_rate)
+            teardown_refresh_context (self);
+        else {
+            refresh_context_update_polling (self, ctx);
+            /* Indications may only be sent on changes, so load the initial
+             * values right away */
+            if (ctx->indications_enabled)
+                refresh_context_cb (self);
+        }
+    }
+
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
+static void
+modem_setup_indications_ready (MMIfaceModemSignal *self,
+                               GAsyncResult       *res,
+                               GTask              *task)
+{
+    g_autoptr(GError)  error = NULL;
+    RefreshContext    *ctx;
+    guint              rate;
+
+    rate = GPOINTER_TO_UINT (g_task_get_task_data (task));
+    ctx = peek_refresh_context (self);
+
+    if (!MM_IFACE_MODEM_SIGNAL_GET_INTERFACE (self)->setup_indications_finish (self, res, &error)) {
+        if (rate)
+            mm_obj_dbg (self, "couldn't enable extended signal indications, will poll instead: %s", error->message);
+        else
+            mm_obj_dbg (self, "couldn't disable extended signal indications: %s", error->message);
+    } else if (rate && ctx && ctx->indication_rate == rate) {
+        mm_obj_dbg (self, "extended signal indications enabled (rate: %u ms)", rate);
+        ctx->indications_enabled = TRUE;
+    }
+
+    setup_indications_complete (self, task);
+}
+
+static void
+setup_indications (MMIfaceModemSignal  *self,
+                   guint                new_rate,
+                   GAsyncReadyCallback  callback,
+                   gpointer             user_data)
+{
+    RefreshContext *ctx;
+    GTask          *task;
+    gboolean        was_enabled;
+
+    task = g_task_new (self, NULL, callback, user_data);
+    g_task_set_task_data (task, GUINT_TO_POINTER (new_rate), NULL);
+
+    ctx = new_rate ? ensure_refresh_context (self) : peek_refresh_context (self);
     if (!ctx) {
-        ctx = g_slice_new0 (RefreshContext);
-        g_object_set_qdata_full (G_OBJECT (self),
-                                 refresh_context_quark,
-                                 ctx,
-                                 (GDestroyNotify)refresh_context_free);
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
     }
 
-    /* We're enabling, compare to old rate */
-    if (ctx->rate == new_rate) {
-        /* Already there */
-        return TRUE;
+    /* Any value pending to be published is from the previous setup */
+    if (ctx->throttle_source) {
+        g_source_remove (ctx->throttle_source);
+        ctx->throttle_source = 0;
     }
+    clear_pending (ctx);
 
-    /* Update refresh context */
-    mm_obj_dbg (self, "extended signal information reporting enabled (rate: %u seconds)", new_rate);
-    ctx->rate = new_rate;
-    if (ctx->timeout_source)
-        g_source_remove (ctx->timeout_source);
-    ctx->timeout_source = g_timeout_add_seconds (ctx->rate, (GSourceFunc) refresh_context_cb, self);
+    was_enabled = ctx->indications_enabled;
+    ctx->indications_enabled = FALSE;
+    ctx->indication_rate = new_rate;
 
-    /* Also launch right away */
-    refresh_context_cb (self);
+    if (!MM_IFACE_MODEM_SIGNAL_GET_INTERFACE (self)->setup_indications ||
+        !MM_IFACE_MODEM_SIGNAL_GET_INTERFACE (self)->setup_indications_finish) {
+        if (new_rate)
+            mm_obj_dbg (self, "extended signal indications unsupported, will poll instead");
+        setup_indications_complete (self, task);
+        return;
+    }
 
-    return TRUE;
+    /* Nothing to disable in the modem */
+    if (!new_rate && !was_enabled) {
+        setup_indications_complete (self, task);
+        return;
+    }
+
+    MM_IFACE_MODEM_SIGNAL_GET_INTERFACE (self)->setup_indications (
+        self,
+        new_rate,
+        (GAsyncReadyCallback)modem_setup_indications_ready,
+        task);
 }
 
 /*****************************************************************************/
@@ -295,6 +587,144 @@ handle_setup (MmGdbusModemSignal *skeleton,
 
 /*****************************************************************************/
 
+static void
+handle_setup_indications_ready (MMIfaceModemSignal *self,
+                                GAsyncResult       *res,
+                                HandleSetupContext *ctx)
+{
+    GError *error = NULL;
+
+    if (!setup_indications_finish (self, res, &error))
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+    else
+        mm_gdbus_modem_signal_complete_setup_indications (ctx->skeleton, ctx->invocation);
+    handle_setup_context_free (ctx);
+}
+
+static void
+handle_setup_indications_auth_ready (MMBaseModem *self,
+                                     GAsyncResult *res,
+                                     HandleSetupContext *ctx)
+{
+    GError *error = NULL;
+    MMModemState modem_state = MM_MODEM_STATE_UNKNOWN;
+
+    if (!mm_base_modem_authorize_finish (self, res, &error)) {
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_setup_context_free (ctx);
+        return;
+    }
+
+    mm_gdbus_modem_signal_set_indication_rate (ctx->skeleton, ctx->rate);
+
+    /* Will be applied when the modem gets enabled */
+    g_object_get (self,
+                  MM_IFACE_MODEM_STATE, &modem_state,
+                  NULL);
+    if (modem_state < MM_MODEM_STATE_ENABLING) {
+        mm_obj_dbg (self, "extended signal indications setup delayed (modem not yet enabled)");
+        mm_gdbus_modem_signal_complete_setup_indications (ctx->skeleton, ctx->invocation);
+        handle_setup_context_free (ctx);
+        return;
+    }
+
+    setup_indications (ctx->self,
+                       ctx->rate,
+                       (GAsyncReadyCallback)handle_setup_indications_ready,
+                       ctx);
+}
+
+static gboolean
+handle_setup_indications (MmGdbusModemSignal *skeleton,
+                          GDBusMethodInvocation *invocation,
+                          guint rate,
+                          MMIfaceModemSignal *self)
+{
+    HandleSetupContext *ctx;
+
+    ctx = g_slice_new (HandleSetupContext);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->self = g_object_ref (self);
+    ctx->rate = rate;
+
+    mm_base_modem_authorize (MM_BASE_MODEM (self),
+                             invocation,
+                             MM_AUTHORIZATION_DEVICE_CONTROL,
+                             (GAsyncReadyCallback)handle_setup_indications_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    GDBusMethodInvocation *invocation;
+    MmGdbusModemSignal *skeleton;
+    MMIfaceModemSignal *self;
+} HandleGetHistoryContext;
+
+static void
+handle_get_history_context_free (HandleGetHistoryContext *ctx)
+{
+    g_object_unref (ctx->invocation);
+    g_object_unref (ctx->skeleton);
+    g_object_unref (ctx->self);
+    g_slice_free (HandleGetHistoryContext, ctx);
+}
+
+static void
+handle_get_history_auth_ready (MMBaseModem *self,
+                               GAsyncResult *res,
+                               HandleGetHistoryContext *ctx)
+{
+    GError *error = NULL;
+    RefreshContext *refresh_ctx;
+    GVariantBuilder builder;
+    guint i;
+
+    if (!mm_base_modem_authorize_finish (self, res, &error)) {
+        g_dbus_method_invocation_take_error (ctx->invocation, error);
+        handle_get_history_context_free (ctx);
+        return;
+    }
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("aa{sv}"));
+    refresh_ctx = peek_refresh_context (ctx->self);
+    if (refresh_ctx) {
+        for (i = 0; i < refresh_ctx->history_n; i++)
+            g_variant_builder_add_value (&builder,
+                                         refresh_ctx->history[(refresh_ctx->history_first + i) % HISTORY_MAX_SAMPLES]);
+    }
+
+    mm_gdbus_modem_signal_complete_get_history (ctx->skeleton,
+                                                ctx->invocation,
+                                                g_variant_builder_end (&builder));
+    handle_get_history_context_free (ctx);
+}
+
+static gboolean
+handle_get_history (MmGdbusModemSignal *skeleton,
+                    GDBusMethodInvocation *invocation,
+                    MMIfaceModemSignal *self)
+{
+    HandleGetHistoryContext *ctx;
+
+    ctx = g_slice_new (HandleGetHistoryContext);
+    ctx->invocation = g_object_ref (invocation);
+    ctx->skeleton = g_object_ref (skeleton);
+    ctx->self = g_object_ref (self);
+
+    mm_base_modem_authorize (MM_BASE_MODEM (self),
+                             invocation,
+                             MM_AUTHORIZATION_DEVICE_CONTROL,
+                             (GAsyncReadyCallback)handle_get_history_auth_ready,
+                             ctx);
+    return TRUE;
+}
+
+/*****************************************************************************/
+
 gboolean
 mm_iface_modem_signal_disable_finish (MMIfaceModemSignal *self,
                                       GAsyncResult *res,
@@ -303,16 +733,35 @@ mm_iface_modem_signal_disable_finish (MMIfaceModemSignal *self,
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
+static void
+disable_indications_ready (MMIfaceModemSignal *self,
+                           GAsyncResult       *res,
+                           GTask              *task)
+{
+    /* Errors disabling the indications in the modem are not fatal */
+    setup_indications_finish (self, res, NULL);
+    teardown_refresh_context (self);
+    g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
 void
 mm_iface_modem_signal_disable (MMIfaceModemSignal *self,
                                GAsyncReadyCallback callback,
                                gpointer user_data)
 {
+    RefreshContext *ctx;
     GTask *task;
 
-    teardown_refresh_context (self);
-
     task = g_task_new (self, NULL, callback, user_data);
+
+    ctx = peek_refresh_context (self);
+    if (ctx && ctx->indications_enabled) {
+        setup_indications (self, 0, (GAsyncReadyCallback)disable_indications_ready, task);
+        return;
+    }
+
+    teardown_refresh_context (self);
     g_task_return_boolean (task, TRUE);
     g_object_unref (task);
 }
@@ -327,22 +776,51 @@ mm_iface_modem_signal_enable_finish (MMIfaceModemSignal *self,
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
+static void
+enable_indications_ready (MMIfaceModemSignal *self,
+                          GAsyncResult       *res,
+                          GTask              *task)
+{
+    GError *error = NULL;
+
+    if (!setup_indications_finish (self, res, &error))
+        g_task_return_error (task, error);
+    else
+        g_task_return_boolean (task, TRUE);
+    g_object_unref (task);
+}
+
 void
 mm_iface_modem_signal_enable (MMIfaceModemSignal *self,
                               GCancellable *cancellable,
                               GAsyncReadyCallback callback,
                               gpointer user_data)
 {
+    g_autoptr(MmGdbusModemSignalSkeleton) skeleton = NULL;
     GTask *task;
     GError *error = NULL;
 
     task = g_task_new (self, cancellable, callback, user_data);
 
-    if (!setup_refresh_context (self, FALSE, 0, &error))
+    if (!setup_refresh_context (self, FALSE, 0, &error)) {
         g_task_return_error (task, error);
-    else
-        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
+        return;
+    }
 
+    /* Re-apply the indications setup requested by the user, if any */
+    g_object_get (self,
+                  MM_IFACE_MODEM_SIGNAL_DBUS_SKELETON, &skeleton,
+                  NULL);
+    if (skeleton && mm_gdbus_modem_signal_get_indication_rate (MM_GDBUS_MODEM_SIGNAL (skeleton))) {
+        setup_indications (self,
+                           mm_gdbus_modem_signal_get_indication_rate (MM_GDBUS_MODEM_SIGNAL (skeleton)),
+                           (GAsyncReadyCallback)enable_indications_ready,
+                           task);
+        return;
+    }
+
+    g_task_return_boolean (task, TRUE);
     g_object_unref (task);
 }
 
@@ -481,6 +959,14 @@ interface_initialization_step (GTask *task)
                           "handle-setup",
                           G_CALLBACK (handle_setup),
                           self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-setup-indications",
+                          G_CALLBACK (handle_setup_indications),
+                          self);
+        g_signal_connect (ctx->skeleton,
+                          "handle-get-history",
+                          G_CALLBACK (handle_get_history),
+                          self);
         /* Finally, export the new interface */
         mm_gdbus_object_skeleton_set_modem_signal (MM_GDBUS_OBJECT_SKELETON (self),
                                                    MM_GDBUS_MODEM_SIGNAL (ctx->skeleton));
@@ -511,7 +997,7 @@ mm_iface_modem_signal_initialize (MMIfaceModemSignal *self,
                   MM_IFACE_MODEM_SIGNAL_DBUS_SKELETON, &skeleton,
                   NULL);
     if (!skeleton) {
-        skeleton = mm_gdbus_modem_signal_skeleton_new ();
+        skeleton = mm_base_modem_create_interface_skeleton (MM_BASE_MODEM (self), MM_GDBUS_TYPE_MODEM_SIGNAL_SKELETON);
         g_object_set (self,
                       MM_IFACE_MODEM_SIGNAL_DBUS_SKELETON, skeleton,
                       NULL);
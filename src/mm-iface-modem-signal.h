@@ -56,6 +56,17 @@ struct _MMIfaceModemSignal {
                                      MMSignal **lte,
                                      MMSignal **nr5g,
                                      GError **error);
+
+    /* Setup modem-side threshold or periodic indications (async, optional).
+     * A rate of 0 disables them. Values received afterwards must be reported
+     * with mm_iface_modem_signal_update(). */
+    void     (* setup_indications)        (MMIfaceModemSignal *self,
+                                           guint rate_ms,
+                                           GAsyncReadyCallback callback,
+                                           gpointer user_data);
+    gboolean (* setup_indications_finish) (MMIfaceModemSignal *self,
+                                           GAsyncResult *res,
+                                           GError **error);
 };
 
 GType mm_iface_modem_signal_get_type (void);
@@ -90,6 +101,15 @@ gboolean mm_iface_modem_signal_disable_finish (MMIfaceModemSignal *self,
 /* Shutdown Signal interface */
 void mm_iface_modem_signal_shutdown (MMIfaceModemSignal *self);
 
+/* Report new extended signal values received via indications */
+void mm_iface_modem_signal_update (MMIfaceModemSignal *self,
+                                   MMSignal *cdma,
+                                   MMSignal *evdo,
+                                   MMSignal *gsm,
+                                   MMSignal *umts,
+                                   MMSignal *lte,
+                                   MMSignal *nr5g);
+
 /* Bind properties for simple GetStatus() */
 void mm_iface_modem_signal_bind_simple_status (MMIfaceModemSignal *self,
                                                MMSimpleStatus *status);
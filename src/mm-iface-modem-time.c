@@ -24,10 +24,12 @@
 #define SUPPORT_CHECKED_TAG          "time-support-checked-tag"
 #define SUPPORTED_TAG                "time-supported-tag"
 #define NETWORK_TIMEZONE_CONTEXT_TAG "time-network-timezone-context"
+#define NETWORK_TIMEZONE_SKIPPED_TAG "time-network-timezone-skipped"
 
 static GQuark support_checked_quark;
 static GQuark supported_quark;
 static GQuark network_timezone_context_quark;
+static GQuark network_timezone_skipped_quark;
 
 /*****************************************************************************/
 
@@ -145,6 +147,10 @@ handle_get_network_time (MmGdbusModemTime      *skeleton,
  * information up to NETWORK_TIMEZONE_POLL_RETRIES times. As soon as one of
  * the retries succeeds, we stop polling as we don't expect the timezone
  * information to change while registered in the same network.
+ *
+ * If the modem reports timezone updates itself (e.g. +CTZE/+CTZV URCs), the
+ * first reported update flags the event source as active; polling is then
+ * stopped and not started again while the interface stays enabled.
  */
 #define NETWORK_TIMEZONE_POLL_INTERVAL_SEC 5
 #define NETWORK_TIMEZONE_POLL_RETRIES 6
@@ -154,6 +160,8 @@ typedef struct {
     MMModemState state;
     guint network_timezone_poll_id;
     guint network_timezone_poll_retries;
+    /* Whether timezone updates are being reported by the modem */
+    gboolean network_timezone_events;
 } NetworkTimezoneContext;
 
 static void
@@ -169,6 +177,31 @@ network_timezone_context_free (NetworkTimezoneContext *ctx)
 
 static gboolean network_timezone_poll_cb (MMIfaceModemTime *self);
 
+/* Number of polling sequences not started, or cut short, thanks to the
+ * timezone updates reported by the modem. Each sequence runs up to
+ * NETWORK_TIMEZONE_POLL_RETRIES queries, but stops at the first success,
+ * so the number of queries actually avoided isn't known. Kept outside of
+ * the context, so that it is not reset when the interface is disabled. */
+static void
+network_timezone_poll_skipped (MMIfaceModemTime *self)
+{
+    guint skipped;
+
+    if (G_UNLIKELY (!network_timezone_skipped_quark))
+        network_timezone_skipped_quark = g_quark_from_static_string (NETWORK_TIMEZONE_SKIPPED_TAG);
+
+    skipped = GPOINTER_TO_UINT (g_object_get_qdata (G_OBJECT (self), network_timezone_skipped_quark));
+    g_object_set_qdata (G_OBJECT (self), network_timezone_skipped_quark, GUINT_TO_POINTER (++skipped));
+}
+
+guint
+mm_iface_modem_time_get_network_timezone_polls_skipped (MMIfaceModemTime *self)
+{
+    if (!network_timezone_skipped_quark)
+        return 0;
+    return GPOINTER_TO_UINT (g_object_get_qdata (G_OBJECT (self), network_timezone_skipped_quark));
+}
+
 static void
 update_network_timezone_dictionary (MMIfaceModemTime *self,
                                     MMNetworkTimezone *tz)
@@ -213,7 +246,12 @@ load_network_timezone_ready (MMIfaceModemTime *self,
         /* Retry? */
         ctx->network_timezone_poll_retries--;
 
-        /* If no more retries, we don't do anything else */
+        /* If no more retries, or if timezone updates are already being
+         * reported by the modem, we don't do anything else */
+        if (ctx->network_timezone_events) {
+            mm_obj_dbg (self, "network timezone reported by the modem, not retrying");
+            return;
+        }
         if (ctx->network_timezone_poll_retries == 0 ||
             !g_error_matches (error, MM_CORE_ERROR, MM_CORE_ERROR_RETRY)) {
             mm_obj_warn (self, "couldn't load network timezone from the current network");
@@ -285,8 +323,14 @@ network_timezone_state_changed (MMIfaceModemTime *self)
 
     g_object_get (self, MM_IFACE_MODEM_STATE, &ctx->state, NULL);
 
-    /* If going from unregistered to registered, start polling */
+    /* If going from unregistered to registered, start polling, unless the
+     * modem already reports timezone updates by itself */
     if (ctx->state >= MM_MODEM_STATE_REGISTERED && old_state < MM_MODEM_STATE_REGISTERED) {
+        if (ctx->network_timezone_events) {
+            network_timezone_poll_skipped (self);
+            mm_obj_dbg (self, "network timezone polling not needed: updates reported by the modem");
+            return;
+        }
         start_network_timezone_poll (self);
         return;
     }
@@ -305,6 +349,10 @@ stop_network_timezone (MMIfaceModemTime *self)
 
     ctx = (NetworkTimezoneContext *) g_object_get_qdata (G_OBJECT (self), network_timezone_context_quark);
     if (ctx) {
+        if (ctx->network_timezone_events)
+            mm_obj_dbg (self, "network timezone polling sequences skipped: %u",
+                        mm_iface_modem_time_get_network_timezone_polls_skipped (self));
+
         /* Remove signal connection and then trigger context free */
         if (ctx->state_changed_id) {
             g_signal_handler_disconnect (self, ctx->state_changed_id);
@@ -352,6 +400,27 @@ start_network_timezone (MMIfaceModemTime *self)
         start_network_timezone_poll (self);
 }
 
+static void
+network_timezone_events_reported (MMIfaceModemTime *self)
+{
+    NetworkTimezoneContext *ctx;
+
+    /* Note: may be NULL if the update is reported while the interface isn't
+     * enabled, or if loading network timezone isn't supported */
+    ctx = (NetworkTimezoneContext *) g_object_get_qdata (G_OBJECT (self), network_timezone_context_quark);
+    if (!ctx || ctx->network_timezone_events)
+        return;
+
+    mm_obj_dbg (self, "network timezone updates reported by the modem");
+    ctx->network_timezone_events = TRUE;
+
+    /* A pending poll is no longer needed */
+    if (ctx->network_timezone_poll_id) {
+        network_timezone_poll_skipped (self);
+        stop_network_timezone_poll (self);
+    }
+}
+
 /*****************************************************************************/
 
 void
@@ -391,6 +460,8 @@ mm_iface_modem_time_update_network_timezone (MMIfaceModemTime  *self,
         g_variant_unref (dictionary);
 
     g_object_unref (skeleton);
+
+    network_timezone_events_reported (self);
 }
 
 /*****************************************************************************/
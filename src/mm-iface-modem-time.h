@@ -131,6 +131,10 @@ void mm_iface_modem_time_bind_simple_status (MMIfaceModemTime *self,
 
 /* Implementations of the unsolicited events handling should call this method
  * to notify about the updated time */
+/* Number of network timezone polling sequences skipped, or cut short,
+ * because the modem reports timezone updates by itself */
+guint mm_iface_modem_time_get_network_timezone_polls_skipped (MMIfaceModemTime *self);
+
 void mm_iface_modem_time_update_network_time     (MMIfaceModemTime  *self,
                                                   const gchar       *network_time);
 void mm_iface_modem_time_update_network_timezone (MMIfaceModemTime  *self,
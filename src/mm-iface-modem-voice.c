@@ -29,6 +29,8 @@
 static GQuark call_list_polling_context_quark;
 static GQuark in_call_event_context_quark;
 
+static void call_list_polling_report_call_progress (MMIfaceModemVoice *self);
+
 /*****************************************************************************/
 
 void
@@ -330,6 +332,24 @@ mm_iface_modem_voice_report_call (MMIfaceModemVoice *self,
                 mm_call_state_get_string (call_info->state),
                 call_info->number ? call_info->number : "n/a");
 
+    /* Single call reports come from URCs. Generic ones (RING, +CLIP, +CCWA,
+     * NO CARRIER...) only tell about incoming or terminated calls, so any
+     * other state means the modem has proper call progress events. */
+    switch (call_info->state) {
+    case MM_CALL_STATE_DIALING:
+    case MM_CALL_STATE_RINGING_OUT:
+    case MM_CALL_STATE_ACTIVE:
+    case MM_CALL_STATE_HELD:
+        call_list_polling_report_call_progress (self);
+        break;
+    case MM_CALL_STATE_UNKNOWN:
+    case MM_CALL_STATE_RINGING_IN:
+    case MM_CALL_STATE_WAITING:
+    case MM_CALL_STATE_TERMINATED:
+    default:
+        break;
+    }
+
     g_object_get (MM_BASE_MODEM (self),
                   MM_IFACE_MODEM_VOICE_CALL_LIST, &list,
                   NULL);
@@ -2355,13 +2375,21 @@ setup_in_call_event_handling (MMCallList        *call_list,
  * Any time we add a new call to the list, we'll setup polling if it's not
  * already running, and the polling logic itself will decide when the polling
  * should stop.
+ *
+ * Once the modem reports call progress URCs (e.g. ^CCALLSTATE, ^CONF or
+ * +UCALLSTAT) for the calls being established, those drive the call state
+ * updates and the polling is only kept as a much less frequent sanity check,
+ * in case some URC gets lost. Regular polling is used again once the polling
+ * stops.
  */
 
-#define CALL_LIST_POLLING_TIMEOUT_SECS 2
+#define CALL_LIST_POLLING_TIMEOUT_SECS   2
+#define CALL_LIST_RECONCILE_TIMEOUT_SECS 30
 
 typedef struct {
     guint    polling_id;
     gboolean polling_ongoing;
+    gboolean call_progress_events;
 } CallListPollingContext;
 
 static void
@@ -2398,6 +2426,38 @@ get_call_list_polling_context (MMIfaceModemVoice *self)
 
 static gboolean call_list_poll (MMIfaceModemVoice *self);
 
+static void
+call_list_polling_schedule (MMIfaceModemVoice      *self,
+                            CallListPollingContext *ctx)
+{
+    g_assert (!ctx->polling_id);
+    ctx->polling_id = g_timeout_add_seconds (ctx->call_progress_events ?
+                                             CALL_LIST_RECONCILE_TIMEOUT_SECS :
+                                             CALL_LIST_POLLING_TIMEOUT_SECS,
+                                             (GSourceFunc) call_list_poll,
+                                             self);
+}
+
+static void
+call_list_polling_report_call_progress (MMIfaceModemVoice *self)
+{
+    CallListPollingContext *ctx;
+
+    ctx = get_call_list_polling_context (self);
+    if (ctx->call_progress_events)
+        return;
+
+    mm_obj_dbg (self, "call progress events detected: call list polling relaxed");
+    ctx->call_progress_events = TRUE;
+
+    /* Reschedule a pending poll with the new timeout */
+    if (ctx->polling_id) {
+        g_source_remove (ctx->polling_id);
+        ctx->polling_id = 0;
+        call_list_polling_schedule (self, ctx);
+    }
+}
+
 static void
 load_call_list_ready (MMIfaceModemVoice *self,
                       GAsyncResult      *res)
@@ -2423,9 +2483,7 @@ load_call_list_ready (MMIfaceModemVoice *self,
      * we reported calls (e.g. a new incoming call may have been detected that
      * also triggers the poll setup) */
     if (!ctx->polling_id)
-        ctx->polling_id = g_timeout_add_seconds (CALL_LIST_POLLING_TIMEOUT_SECS,
-                                                 (GSourceFunc) call_list_poll,
-                                                 self);
+        call_list_polling_schedule (self, ctx);
 }
 
 static void
@@ -2479,8 +2537,12 @@ call_list_poll (MMIfaceModemVoice *self)
         MM_IFACE_MODEM_VOICE_GET_INTERFACE (self)->load_call_list (self,
                                                                    (GAsyncReadyCallback)load_call_list_ready,
                                                                    NULL);
-    } else
+    } else {
         mm_obj_dbg (self, "no calls being established: call list polling stopped");
+        /* The next call starts with regular polling again, until its own call
+         * progress events are received */
+        ctx->call_progress_events = FALSE;
+    }
 
 out:
     g_clear_object (&list);
@@ -2497,9 +2559,7 @@ setup_call_list_polling (MMCallList        *call_list,
     ctx = get_call_list_polling_context (self);
 
     if (!ctx->polling_id && !ctx->polling_ongoing)
-        ctx->polling_id = g_timeout_add_seconds (CALL_LIST_POLLING_TIMEOUT_SECS,
-                                                 (GSourceFunc) call_list_poll,
-                                                 self);
+        call_list_polling_schedule (self, ctx);
 }
 
 /*****************************************************************************/
@@ -5593,7 +5593,7 @@ mm_iface_modem_initialize (MMIfaceModem *self,
                   MM_IFACE_MODEM_DBUS_SKELETON, &skeleton,
                   NULL);
     if (!skeleton) {
-        skeleton = mm_gdbus_modem_skeleton_new ();
+        skeleton = mm_base_modem_create_interface_skeleton (MM_BASE_MODEM (self), MM_GDBUS_TYPE_MODEM_SKELETON);
 
         /* Set all initial property defaults */
         mm_gdbus_modem_set_sim (skeleton, NULL);
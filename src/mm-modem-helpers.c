@@ -940,6 +940,22 @@ mm_3gpp_cds_regex_get (void)
                         NULL);
 }
 
+GRegex *
+mm_3gpp_ctz_regex_get (void)
+{
+    /* Examples:
+     * <CR><LF>+CTZV: +08<CR><LF>
+     * <CR><LF>+CTZV: 32,0<CR><LF>
+     * <CR><LF>+CTZE: "+08",1,"19/07/09,10:19:15"<CR><LF>
+     * <CR><LF>+CTZE: "-20",0,"2019/07/09,10:19:15"<CR><LF>
+     */
+    return g_regex_new ("\\r\\n\\+CTZ(V|E):\\s*\"?([-+]?\\d+)\"?(?:,\\s*(\\d+))?"
+                        "(?:,\\s*\"?(\\d+)/(\\d+)/(\\d+),(\\d+):(\\d+):(\\d+)\"?)?\\s*\\r\\n",
+                        G_REGEX_RAW | G_REGEX_OPTIMIZE,
+                        0,
+                        NULL);
+}
+
 /*************************************************************************/
 /* AT+WS46=? response parser
  *
@@ -1700,6 +1716,25 @@ mm_3gpp_pdp_context_list_free (GList *list)
     g_list_free_full (list, (GDestroyNotify) mm_3gpp_pdp_context_free);
 }
 
+static MM3gppPdpContext *
+mm_3gpp_pdp_context_copy (const MM3gppPdpContext *pdp,
+                          gpointer                unused)
+{
+    MM3gppPdpContext *copy;
+
+    copy = g_slice_new0 (MM3gppPdpContext);
+    copy->cid = pdp->cid;
+    copy->pdp_type = pdp->pdp_type;
+    copy->apn = g_strdup (pdp->apn);
+    return copy;
+}
+
+GList *
+mm_3gpp_pdp_context_list_copy (GList *list)
+{
+    return g_list_copy_deep (list, (GCopyFunc) mm_3gpp_pdp_context_copy, NULL);
+}
+
 static gint
 mm_3gpp_pdp_context_cmp (MM3gppPdpContext *a,
                          MM3gppPdpContext *b)
@@ -2087,6 +2122,38 @@ mm_3gpp_parse_cmgf_test_response (const gchar *reply,
 
 /*************************************************************************/
 
+/* With +CMMS=1 the modem keeps the link open for 1-5s after each message; if
+ * the previous message was sent less than this time ago, assume more are
+ * coming and keep the link open as well */
+#define SMS_SUBMIT_LINK_HOLD_USECS G_USEC_PER_SEC
+
+gboolean
+mm_3gpp_sms_submit_keep_link_open (guint    n_parts,
+                                   guint    n_pending,
+                                   gint64   last_completed,
+                                   gint64   started,
+                                   gboolean cmms_unsupported)
+{
+    if (cmms_unsupported)
+        return FALSE;
+
+    /* More parts of this message to send, or other messages being sent at
+     * the same time, or the previous message was just sent */
+    return (n_parts > 1 ||
+            n_pending > 1 ||
+            (last_completed && (started - last_completed) < SMS_SUBMIT_LINK_HOLD_USECS));
+}
+
+gboolean
+mm_3gpp_cmms_error_is_unsupported (const GError *error)
+{
+    /* Only an explicit error reply from the modem means the command isn't
+     * supported; timeouts or port errors may be transient */
+    return (error && error->domain == MM_MOBILE_EQUIPMENT_ERROR);
+}
+
+/*************************************************************************/
+
 MM3gppPduInfo *
 mm_3gpp_parse_cmgr_read_response (const gchar *reply,
                                   guint index,
@@ -4886,6 +4953,56 @@ mm_parse_gsn (const char *gsn,
     return success;
 }
 
+/*****************************************************************************/
+/* +CTZV/+CTZE URC parser */
+
+gboolean
+mm_3gpp_parse_ctz_urc (GMatchInfo         *match_info,
+                       gchar             **iso8601p,
+                       MMNetworkTimezone **tzp,
+                       GError            **error)
+{
+    guint year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0, dst = 0;
+    gint  tz = 0;
+
+    g_assert (iso8601p || tzp); /* at least one */
+
+    /* Timezone offset is given in 15 minute intervals */
+    if (!mm_get_int_from_match_info (match_info, 2, &tz)) {
+        g_set_error_literal (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                             "Failed to parse timezone in +CTZV/+CTZE URC");
+        return FALSE;
+    }
+
+    /* The date and time fields are optional; e.g. not given in the standard
+     * +CTZV URC, or if the network didn't provide them in +CTZE */
+    if (iso8601p) {
+        *iso8601p = NULL;
+        if (mm_get_uint_from_match_info (match_info, 4, &year)   &&
+            mm_get_uint_from_match_info (match_info, 5, &month)  &&
+            mm_get_uint_from_match_info (match_info, 6, &day)    &&
+            mm_get_uint_from_match_info (match_info, 7, &hour)   &&
+            mm_get_uint_from_match_info (match_info, 8, &minute) &&
+            mm_get_uint_from_match_info (match_info, 9, &second)) {
+            if (year < 100)
+                year += 2000;
+            *iso8601p = mm_new_iso8601_time (year, month, day, hour,
+                                             minute, second,
+                                             TRUE, tz * 15);
+        }
+    }
+
+    if (tzp) {
+        *tzp = mm_network_timezone_new ();
+        mm_network_timezone_set_offset (*tzp, tz * 15);
+        /* dst = daylight adjustment, 0 = none, 1 = 1 hour, 2 = 2 hours */
+        if (mm_get_uint_from_match_info (match_info, 3, &dst))
+            mm_network_timezone_set_dst_offset (*tzp, dst * 60);
+    }
+
+    return TRUE;
+}
+
 /*****************************************************************************/
 /* +CCLK response parser */
 
@@ -143,6 +143,7 @@ GRegex    *mm_3gpp_cgev_regex_get (void);
 GRegex    *mm_3gpp_cusd_regex_get (void);
 GRegex    *mm_3gpp_cmti_regex_get (void);
 GRegex    *mm_3gpp_cds_regex_get (void);
+GRegex    *mm_3gpp_ctz_regex_get (void);
 
 /* AT+WS46=? response parser: returns array of MMModemMode values */
 GArray *mm_3gpp_parse_ws46_test_response (const gchar  *response,
@@ -192,6 +193,7 @@ typedef struct {
     gchar *apn;
 } MM3gppPdpContext;
 void mm_3gpp_pdp_context_list_free (GList *pdp_list);
+GList *mm_3gpp_pdp_context_list_copy (GList *pdp_list);
 GList *mm_3gpp_parse_cgdcont_read_response (const gchar *reply,
                                             GError **error);
 
@@ -233,6 +235,20 @@ gboolean mm_3gpp_parse_cmgf_test_response (const gchar *reply,
                                            gboolean *sms_text_supported,
                                            GError **error);
 
+/* Whether the link to the SMSC should be kept open (AT+CMMS=1) before sending
+ * the parts of a SMS, given the amount of parts of the message, the amount of
+ * messages being sent (including this one), the time the previous message
+ * was sent and the time this one was requested (in monotonic time). */
+gboolean mm_3gpp_sms_submit_keep_link_open (guint     n_parts,
+                                            guint     n_pending,
+                                            gint64    last_completed,
+                                            gint64    started,
+                                            gboolean  cmms_unsupported);
+
+/* Whether the error returned by AT+CMMS=1 means that the modem doesn't support
+ * it at all, so that it is not tried again */
+gboolean mm_3gpp_cmms_error_is_unsupported (const GError *error);
+
 /* AT+CPMS=? (Preferred SMS storage) response parser */
 gboolean mm_3gpp_parse_cpms_test_response (const gchar  *reply,
                                            GArray      **mem1,
@@ -510,6 +526,12 @@ gboolean mm_parse_cclk_response (const gchar *response,
                                  MMNetworkTimezone **tzp,
                                  GError **error);
 
+/* +CTZV/+CTZE URC parser */
+gboolean mm_3gpp_parse_ctz_urc (GMatchInfo         *match_info,
+                                gchar             **iso8601p,
+                                MMNetworkTimezone **tzp,
+                                GError            **error);
+
 /* +CSIM response parser */
 gint mm_parse_csim_response (const gchar *response,
                                    GError **error);
@@ -16,11 +16,14 @@
  * Copyright (C) 2011 - 2019 Aleksander Morgado <aleksander@gnu.org>
  */
 
+#include <stdio.h>
 #include <string.h>
 #include <ctype.h>
+#include <errno.h>
 
 #include <gmodule.h>
 #include <gio/gio.h>
+#include <glib/gstdio.h>
 
 #include <ModemManager.h>
 #include <mm-errors-types.h>
@@ -34,6 +37,9 @@
 #define SHARED_PREFIX "libmm-shared"
 #define PLUGIN_PREFIX "libmm-plugin"
 
+typedef struct _PluginIndex PluginIndex;
+static void plugin_index_free (PluginIndex *plugin_index);
+
 static void initable_iface_init   (GInitableIface *iface);
 static void log_object_iface_init (MMLogObjectInterface *iface);
 
@@ -54,12 +60,22 @@ struct _MMPluginManagerPrivate {
     /* Device filter */
     MMFilter *filter;
 
-    /* This list contains all plugins except for the generic one, order is not
-     * important. It is loaded once when the program starts, and the list is NOT
-     * expected to change after that.*/
+    /* This list contains the info of all plugins except for the generic one,
+     * order is not important. It is loaded once when the program starts, and
+     * the list is NOT expected to change after that. The plugins themselves may
+     * be loaded on demand, though. */
     GList *plugins;
     /* Last, the generic plugin. */
     MMPlugin *generic;
+    gchar    *generic_path;
+    /* Plugin files found but not used, only to generate the manifest */
+    GList    *ignored_plugin_paths;
+    /* Index of plugins by pre-probing filters, built once all are loaded */
+    PluginIndex *index;
+    /* Statistics of the plugin lists built for each port */
+    guint        plugins_list_builds;
+    guint        plugins_list_candidates;
+    gint64       plugins_list_time;
 
     /* List of ongoing device support checks */
     GList *device_contexts;
@@ -68,6 +84,295 @@ struct _MMPluginManagerPrivate {
     gchar **subsystems;
 };
 
+/*****************************************************************************/
+/* Plugin info
+ *
+ * Static details of each plugin, either taken from the plugin object itself
+ * or from the plugin manifest, in which case the plugin is not loaded until
+ * it is really needed.
+ */
+
+typedef struct {
+    gchar          *path;
+    gchar          *name;
+    MMPlugin       *plugin;
+    gboolean        load_failed;
+    /* Pre-probing filters */
+    gchar         **subsystems;
+    gchar         **drivers;
+    gchar         **udev_tags;
+    guint16        *vendor_ids;
+    mm_uint16_pair *product_ids;
+    gboolean        requires_vendor_product_ids;
+} PluginInfo;
+
+static void
+plugin_info_free (PluginInfo *info)
+{
+    g_free (info->path);
+    g_free (info->name);
+    g_clear_object (&info->plugin);
+    g_strfreev (info->subsystems);
+    g_strfreev (info->drivers);
+    g_strfreev (info->udev_tags);
+    g_free (info->vendor_ids);
+    g_free (info->product_ids);
+    g_slice_free (PluginInfo, info);
+}
+
+static PluginInfo *
+plugin_info_new_from_plugin (const gchar *path,
+                             MMPlugin    *plugin)
+{
+    PluginInfo           *info;
+    const guint16        *vendor_ids;
+    const mm_uint16_pair *product_ids;
+    guint                 n;
+
+    info = g_slice_new0 (PluginInfo);
+    info->path = g_strdup (path);
+    info->name = g_strdup (mm_plugin_get_name (plugin));
+    info->plugin = g_object_ref (plugin);
+    info->subsystems = g_strdupv ((gchar **) mm_plugin_get_allowed_subsystems (plugin));
+    info->drivers = g_strdupv ((gchar **) mm_plugin_get_allowed_drivers (plugin));
+    info->udev_tags = g_strdupv ((gchar **) mm_plugin_get_allowed_udev_tags (plugin));
+    info->requires_vendor_product_ids = mm_plugin_requires_vendor_product_ids (plugin);
+
+    vendor_ids = mm_plugin_get_allowed_vendor_ids (plugin);
+    if (vendor_ids) {
+        for (n = 0; vendor_ids[n]; n++);
+        info->vendor_ids = g_memdup (vendor_ids, (n + 1) * sizeof (guint16));
+    }
+
+    product_ids = mm_plugin_get_allowed_product_ids (plugin);
+    if (product_ids) {
+        for (n = 0; product_ids[n].l; n++);
+        info->product_ids = g_memdup (product_ids, (n + 1) * sizeof (mm_uint16_pair));
+    }
+
+    return info;
+}
+
+static MMPlugin *load_plugin (MMPluginManager *self,
+                              const gchar     *path);
+
+static MMPlugin *
+plugin_manager_peek_info_plugin (MMPluginManager *self,
+                                 PluginInfo      *info)
+{
+    if (info->plugin || info->load_failed)
+        return info->plugin;
+
+    mm_obj_dbg (self, "loading plugin '%s' on demand...", info->name);
+    info->plugin = load_plugin (self, info->path);
+    if (!info->plugin) {
+        info->load_failed = TRUE;
+        return NULL;
+    }
+
+    if (!g_str_equal (info->name, mm_plugin_get_name (info->plugin)))
+        mm_obj_warn (self, "plugin '%s' loaded from '%s' doesn't match the manifest (expected '%s')",
+                     mm_plugin_get_name (info->plugin), info->path, info->name);
+    return info->plugin;
+}
+
+/*****************************************************************************/
+/* Plugin index
+ *
+ * The pre-probing filters of the plugins are static, so instead of running
+ * them all for every new port, we index the plugins by the filter values
+ * once they're all loaded. The index is conservative: it only discards the
+ * plugins that would have been discarded by the pre-probing filters anyway,
+ * and the full set of filters is still applied on the remaining candidates
+ * to compute the support hint.
+ */
+
+struct _PluginIndex {
+    /* subsystem -> GPtrArray of plugin infos, in load order */
+    GHashTable *subsystems;
+    /* driver/udev tag/vendor id -> set of plugin infos */
+    GHashTable *drivers;
+    GHashTable *udev_tags;
+    GHashTable *vendor_ids;
+    /* set of plugins that filter by driver/udev tag/vendor id */
+    GHashTable *filtered_by_driver;
+    GHashTable *filtered_by_udev_tag;
+    GHashTable *filtered_by_vendor_id;
+};
+
+static void
+plugin_index_free (PluginIndex *plugin_index)
+{
+    g_hash_table_unref (plugin_index->subsystems);
+    g_hash_table_unref (plugin_index->drivers);
+    g_hash_table_unref (plugin_index->udev_tags);
+    g_hash_table_unref (plugin_index->vendor_ids);
+    g_hash_table_unref (plugin_index->filtered_by_driver);
+    g_hash_table_unref (plugin_index->filtered_by_udev_tag);
+    g_hash_table_unref (plugin_index->filtered_by_vendor_id);
+    g_slice_free (PluginIndex, plugin_index);
+}
+
+static void
+plugin_index_add_to_set (GHashTable     *index_table,
+                         gconstpointer   key,
+                         GBoxedCopyFunc  key_copy,
+                         PluginInfo     *info)
+{
+    GHashTable *set;
+
+    set = g_hash_table_lookup (index_table, key);
+    if (!set) {
+        set = g_hash_table_new (g_direct_hash, g_direct_equal);
+        g_hash_table_insert (index_table, key_copy ? key_copy (key) : (gpointer) key, set);
+    }
+    g_hash_table_add (set, info);
+}
+
+static gboolean
+plugin_index_lookup_set (GHashTable    *index_table,
+                         gconstpointer  key,
+                         PluginInfo    *info)
+{
+    GHashTable *set;
+
+    set = g_hash_table_lookup (index_table, key);
+    return (set && g_hash_table_contains (set, info));
+}
+
+static void
+plugin_index_add (PluginIndex *plugin_index,
+                  PluginInfo  *info)
+{
+    guint i;
+
+    /* Plugins without subsystems are never registered */
+    g_assert (info->subsystems);
+    for (i = 0; info->subsystems[i]; i++) {
+        GPtrArray *infos;
+
+        infos = g_hash_table_lookup (plugin_index->subsystems, info->subsystems[i]);
+        if (!infos) {
+            infos = g_ptr_array_new ();
+            g_hash_table_insert (plugin_index->subsystems, g_strdup (info->subsystems[i]), infos);
+        }
+        g_ptr_array_add (infos, info);
+    }
+
+    /* Virtual ports are matched against a fake "virtual" driver name, don't
+     * index plugins allowing those, so that they're never discarded early */
+    if (info->drivers && !g_strv_contains ((const gchar * const *) info->drivers, "virtual")) {
+        g_hash_table_add (plugin_index->filtered_by_driver, info);
+        for (i = 0; info->drivers[i]; i++)
+            plugin_index_add_to_set (plugin_index->drivers, info->drivers[i], (GBoxedCopyFunc) g_strdup, info);
+    }
+
+    if (info->udev_tags) {
+        g_hash_table_add (plugin_index->filtered_by_udev_tag, info);
+        for (i = 0; info->udev_tags[i]; i++)
+            plugin_index_add_to_set (plugin_index->udev_tags, info->udev_tags[i], (GBoxedCopyFunc) g_strdup, info);
+    }
+
+    /* Only index vendor ids if a mismatch is enough to discard the port */
+    if (info->requires_vendor_product_ids) {
+        g_hash_table_add (plugin_index->filtered_by_vendor_id, info);
+        for (i = 0; info->vendor_ids && info->vendor_ids[i]; i++)
+            plugin_index_add_to_set (plugin_index->vendor_ids, GUINT_TO_POINTER (info->vendor_ids[i]), NULL, info);
+        for (i = 0; info->product_ids && info->product_ids[i].l; i++)
+            plugin_index_add_to_set (plugin_index->vendor_ids, GUINT_TO_POINTER (info->product_ids[i].l), NULL, info);
+    }
+}
+
+static PluginIndex *
+plugin_index_new (GList *plugins)
+{
+    PluginIndex *plugin_index;
+    GList       *l;
+
+    plugin_index = g_slice_new0 (PluginIndex);
+    plugin_index->subsystems = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_ptr_array_unref);
+    plugin_index->drivers = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_unref);
+    plugin_index->udev_tags = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) g_hash_table_unref);
+    plugin_index->vendor_ids = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_hash_table_unref);
+    plugin_index->filtered_by_driver = g_hash_table_new (g_direct_hash, g_direct_equal);
+    plugin_index->filtered_by_udev_tag = g_hash_table_new (g_direct_hash, g_direct_equal);
+    plugin_index->filtered_by_vendor_id = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+    for (l = plugins; l; l = g_list_next (l))
+        plugin_index_add (plugin_index, (PluginInfo *)(l->data));
+
+    return plugin_index;
+}
+
+static GPtrArray *
+plugin_index_lookup (PluginIndex    *plugin_index,
+                     MMDevice       *device,
+                     MMKernelDevice *port)
+{
+    GPtrArray          *candidates;
+    GPtrArray          *infos;
+    const gchar       **drivers;
+    guint16             vendor;
+    g_autoptr(GPtrArray) port_udev_tags = NULL;
+    GHashTableIter      iter;
+    gpointer            key;
+    guint               i;
+
+    candidates = g_ptr_array_new ();
+
+    infos = g_hash_table_lookup (plugin_index->subsystems, mm_kernel_device_get_subsystem (port));
+    if (!infos)
+        return candidates;
+
+    drivers = mm_device_get_drivers (device);
+    vendor = mm_device_get_vendor (device);
+
+    /* Only query the udev tags used by the plugins, once per port */
+    port_udev_tags = g_ptr_array_new ();
+    g_hash_table_iter_init (&iter, plugin_index->udev_tags);
+    while (g_hash_table_iter_next (&iter, &key, NULL)) {
+        if (mm_kernel_device_get_global_property_as_boolean (port, (const gchar *) key))
+            g_ptr_array_add (port_udev_tags, key);
+    }
+
+    for (i = 0; i < infos->len; i++) {
+        PluginInfo *info;
+
+        info = g_ptr_array_index (infos, i);
+
+        /* If drivers unknown, let the plugin filters decide */
+        if (drivers && g_hash_table_contains (plugin_index->filtered_by_driver, info)) {
+            guint j;
+
+            for (j = 0; drivers[j]; j++) {
+                if (plugin_index_lookup_set (plugin_index->drivers, drivers[j], info))
+                    break;
+            }
+            if (!drivers[j])
+                continue;
+        }
+
+        if (g_hash_table_contains (plugin_index->filtered_by_udev_tag, info)) {
+            guint j;
+
+            for (j = 0; j < port_udev_tags->len; j++) {
+                if (plugin_index_lookup_set (plugin_index->udev_tags, g_ptr_array_index (port_udev_tags, j), info))
+                    break;
+            }
+            if (j == port_udev_tags->len)
+                continue;
+        }
+
+        if (g_hash_table_contains (plugin_index->filtered_by_vendor_id, info) &&
+            !plugin_index_lookup_set (plugin_index->vendor_ids, GUINT_TO_POINTER (vendor), info))
+            continue;
+
+        g_ptr_array_add (candidates, info);
+    }
+
+    return candidates;
+}
+
 /*****************************************************************************/
 /* Build plugin list for a single port */
 
@@ -77,24 +382,39 @@ plugin_manager_build_plugins_list (MMPluginManager *self,
                                    MMKernelDevice  *port)
 {
     GList *list = NULL;
-    GList *l;
+    g_autoptr(GPtrArray) candidates = NULL;
+    guint i;
     gboolean supported_found = FALSE;
+    gint64 start;
+
+    start = g_get_monotonic_time ();
+
+    /* Only the candidates that pass the indexed filters are fully checked */
+    candidates = plugin_index_lookup (self->priv->index, device, port);
+    mm_obj_dbg (self, "port %s: %u candidate plugins found in index",
+                mm_kernel_device_get_name (port), candidates->len);
 
-    for (l = self->priv->plugins; l && !supported_found; l = g_list_next (l)) {
-        MMPluginSupportsHint hint;
+    for (i = 0; i < candidates->len && !supported_found; i++) {
+        MMPlugin             *plugin;
+        MMPluginSupportsHint  hint;
+
+        /* Plugins not loaded yet are loaded the first time a port matches them */
+        plugin = plugin_manager_peek_info_plugin (self, g_ptr_array_index (candidates, i));
+        if (!plugin)
+            continue;
 
-        hint = mm_plugin_discard_port_early (MM_PLUGIN (l->data), device, port);
+        hint = mm_plugin_discard_port_early (plugin, device, port);
         switch (hint) {
         case MM_PLUGIN_SUPPORTS_HINT_UNSUPPORTED:
             /* Fully discard */
             break;
         case MM_PLUGIN_SUPPORTS_HINT_MAYBE:
             /* Maybe supported, add to tail of list */
-            list = g_list_append (list, g_object_ref (l->data));
+            list = g_list_append (list, g_object_ref (plugin));
             break;
         case MM_PLUGIN_SUPPORTS_HINT_LIKELY:
             /* Likely supported, add to head of list */
-            list = g_list_prepend (list, g_object_ref (l->data));
+            list = g_list_prepend (list, g_object_ref (plugin));
             break;
         case MM_PLUGIN_SUPPORTS_HINT_SUPPORTED:
             /* Really supported, clean existing list and add it alone */
@@ -102,7 +422,7 @@ plugin_manager_build_plugins_list (MMPluginManager *self,
                 g_list_free_full (list, g_object_unref);
                 list = NULL;
             }
-            list = g_list_prepend (list, g_object_ref (l->data));
+            list = g_list_prepend (list, g_object_ref (plugin));
             /* This will end the loop as well */
             supported_found = TRUE;
             break;
@@ -115,6 +435,10 @@ plugin_manager_build_plugins_list (MMPluginManager *self,
     if (self->priv->generic)
         list = g_list_append (list, g_object_ref (self->priv->generic));
 
+    self->priv->plugins_list_builds++;
+    self->priv->plugins_list_candidates += candidates->len;
+    self->priv->plugins_list_time += g_get_monotonic_time () - start;
+
     return list;
 }
 
@@ -1594,10 +1918,10 @@ mm_plugin_manager_peek_plugin (MMPluginManager *self,
         return self->priv->generic;
 
     for (l = self->priv->plugins; l; l = g_list_next (l)) {
-        MMPlugin *plugin = MM_PLUGIN (l->data);
+        PluginInfo *info = l->data;
 
-        if (g_str_equal (plugin_name, mm_plugin_get_name (plugin)))
-            return plugin;
+        if (g_str_equal (plugin_name, info->name))
+            return plugin_manager_peek_info_plugin (self, info);
     }
 
     return NULL;
@@ -1611,51 +1935,56 @@ mm_plugin_manager_get_subsystems (MMPluginManager *self)
     return (const gchar **) self->priv->subsystems;
 }
 
+void
+mm_plugin_manager_get_plugins_list_stats (MMPluginManager *self,
+                                          guint           *builds,
+                                          guint           *candidates,
+                                          gint64          *time)
+{
+    *builds = self->priv->plugins_list_builds;
+    *candidates = self->priv->plugins_list_candidates;
+    *time = self->priv->plugins_list_time;
+}
+
 /*****************************************************************************/
 
 static void
 register_plugin_whitelist_tags (MMPluginManager *self,
-                                MMPlugin        *plugin)
+                                PluginInfo      *info)
 {
-    const gchar **tags;
-    guint         i;
+    guint i;
 
     if (!mm_filter_check_rule_enabled (self->priv->filter, MM_FILTER_RULE_PLUGIN_WHITELIST))
         return;
 
-    tags = mm_plugin_get_allowed_udev_tags (plugin);
-    for (i = 0; tags && tags[i]; i++)
-        mm_filter_register_plugin_whitelist_tag (self->priv->filter, tags[i]);
+    for (i = 0; info->udev_tags && info->udev_tags[i]; i++)
+        mm_filter_register_plugin_whitelist_tag (self->priv->filter, info->udev_tags[i]);
 }
 
 static void
 register_plugin_whitelist_vendor_ids (MMPluginManager *self,
-                                       MMPlugin        *plugin)
+                                       PluginInfo      *info)
 {
-    const guint16 *vendor_ids;
-    guint          i;
+    guint i;
 
     if (!mm_filter_check_rule_enabled (self->priv->filter, MM_FILTER_RULE_PLUGIN_WHITELIST))
         return;
 
-    vendor_ids = mm_plugin_get_allowed_vendor_ids (plugin);
-    for (i = 0; vendor_ids && vendor_ids[i]; i++)
-        mm_filter_register_plugin_whitelist_vendor_id (self->priv->filter, vendor_ids[i]);
+    for (i = 0; info->vendor_ids && info->vendor_ids[i]; i++)
+        mm_filter_register_plugin_whitelist_vendor_id (self->priv->filter, info->vendor_ids[i]);
 }
 
 static void
 register_plugin_whitelist_product_ids (MMPluginManager *self,
-                                       MMPlugin        *plugin)
+                                       PluginInfo      *info)
 {
-    const mm_uint16_pair *product_ids;
-    guint                 i;
+    guint i;
 
     if (!mm_filter_check_rule_enabled (self->priv->filter, MM_FILTER_RULE_PLUGIN_WHITELIST))
         return;
 
-    product_ids = mm_plugin_get_allowed_product_ids (plugin);
-    for (i = 0; product_ids && product_ids[i].l; i++)
-        mm_filter_register_plugin_whitelist_product_id (self->priv->filter, product_ids[i].l, product_ids[i].r);
+    for (i = 0; info->product_ids && info->product_ids[i].l; i++)
+        mm_filter_register_plugin_whitelist_product_id (self->priv->filter, info->product_ids[i].l, info->product_ids[i].r);
 }
 
 static MMPlugin *
@@ -1776,6 +2105,281 @@ out:
     g_free (path_display);
 }
 
+/*****************************************************************************/
+/* Plugin manifest
+ *
+ * The manifest is a key file stored in the plugin directory, with one group
+ * per plugin file listing the static pre-probing filters of the plugin. If a
+ * valid manifest is found, plugins are not loaded during startup; instead,
+ * each plugin is loaded the first time a port matches its filters. The
+ * manifest is generated with 'ModemManager --generate-plugin-manifest', and
+ * it is ignored altogether as soon as any plugin file is added, removed or
+ * modified.
+ */
+
+#define MANIFEST_FILE                             "plugins.manifest"
+#define MANIFEST_GROUP                            "manifest"
+#define MANIFEST_KEY_VERSION                      "version"
+#define MANIFEST_KEY_SIZE                         "size"
+#define MANIFEST_KEY_MTIME                        "mtime"
+#define MANIFEST_KEY_NAME                         "name"
+#define MANIFEST_KEY_GENERIC                      "generic"
+#define MANIFEST_KEY_IGNORED                      "ignored"
+#define MANIFEST_KEY_SUBSYSTEMS                   "subsystems"
+#define MANIFEST_KEY_DRIVERS                      "drivers"
+#define MANIFEST_KEY_UDEV_TAGS                    "udev-tags"
+#define MANIFEST_KEY_VENDOR_IDS                   "vendor-ids"
+#define MANIFEST_KEY_PRODUCT_IDS                  "product-ids"
+#define MANIFEST_KEY_REQUIRES_VENDOR_PRODUCT_IDS  "requires-vendor-product-ids"
+
+static gchar *
+manifest_build_version (void)
+{
+    return g_strdup_printf ("%d.%d", MM_PLUGIN_MAJOR_VERSION, MM_PLUGIN_MINOR_VERSION);
+}
+
+static gboolean
+manifest_set_file_info (GKeyFile     *manifest,
+                        const gchar  *path,
+                        GError      **error)
+{
+    g_autofree gchar *group = NULL;
+    GStatBuf          st;
+
+    if (g_stat (path, &st) < 0) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "couldn't get file info of '%s': %s", path, g_strerror (errno));
+        return FALSE;
+    }
+
+    group = g_path_get_basename (path);
+    g_key_file_set_int64 (manifest, group, MANIFEST_KEY_SIZE, (gint64) st.st_size);
+    g_key_file_set_int64 (manifest, group, MANIFEST_KEY_MTIME, (gint64) st.st_mtime);
+    return TRUE;
+}
+
+static gboolean
+manifest_check_file_info (GKeyFile    *manifest,
+                          const gchar *path)
+{
+    g_autofree gchar *group = NULL;
+    GStatBuf          st;
+
+    group = g_path_get_basename (path);
+    if (!g_key_file_has_group (manifest, group) || (g_stat (path, &st) < 0))
+        return FALSE;
+
+    return ((g_key_file_get_int64 (manifest, group, MANIFEST_KEY_SIZE, NULL) == (gint64) st.st_size) &&
+            (g_key_file_get_int64 (manifest, group, MANIFEST_KEY_MTIME, NULL) == (gint64) st.st_mtime));
+}
+
+static GKeyFile *
+plugin_manager_load_manifest (MMPluginManager *self,
+                              GList           *plugin_paths)
+{
+    g_autoptr(GKeyFile)  manifest = NULL;
+    g_autoptr(GError)    error = NULL;
+    g_autofree gchar    *path = NULL;
+    g_autofree gchar    *version = NULL;
+    g_autofree gchar    *expected_version = NULL;
+    GList               *l;
+
+    path = g_build_filename (self->priv->plugin_dir, MANIFEST_FILE, NULL);
+    if (!g_file_test (path, G_FILE_TEST_EXISTS)) {
+        mm_obj_dbg (self, "no plugin manifest found");
+        return NULL;
+    }
+
+    manifest = g_key_file_new ();
+    if (!g_key_file_load_from_file (manifest, path, G_KEY_FILE_NONE, &error)) {
+        mm_obj_warn (self, "couldn't load plugin manifest: %s", error->message);
+        return NULL;
+    }
+
+    version = g_key_file_get_string (manifest, MANIFEST_GROUP, MANIFEST_KEY_VERSION, NULL);
+    expected_version = manifest_build_version ();
+    if (g_strcmp0 (version, expected_version) != 0) {
+        mm_obj_warn (self, "plugin manifest version '%s' unsupported, %s is required",
+                     version ? version : "unknown", expected_version);
+        return NULL;
+    }
+
+    /* All plugin files must be listed in the manifest, unmodified */
+    for (l = plugin_paths; l; l = g_list_next (l)) {
+        if (!manifest_check_file_info (manifest, (const gchar *)(l->data))) {
+            mm_obj_warn (self, "plugin manifest is outdated: plugin '%s' changed", (const gchar *)(l->data));
+            return NULL;
+        }
+    }
+
+    mm_obj_dbg (self, "plugin manifest loaded: plugins will be loaded on demand");
+    return g_steal_pointer (&manifest);
+}
+
+static gboolean
+manifest_plugin_ignored (GKeyFile    *manifest,
+                         const gchar *path)
+{
+    g_autofree gchar *group = NULL;
+
+    group = g_path_get_basename (path);
+    return g_key_file_get_boolean (manifest, group, MANIFEST_KEY_IGNORED, NULL);
+}
+
+static PluginInfo *
+plugin_info_new_from_manifest (GKeyFile    *manifest,
+                               const gchar *path)
+{
+    PluginInfo        *info;
+    g_autofree gchar  *group = NULL;
+    g_autofree gint   *vendor_ids = NULL;
+    g_auto(GStrv)      product_ids = NULL;
+    gsize              n = 0;
+    guint              i;
+
+    group = g_path_get_basename (path);
+
+    /* The generic plugin is always loaded right away */
+    if (g_key_file_get_boolean (manifest, group, MANIFEST_KEY_GENERIC, NULL))
+        return NULL;
+
+    info = g_slice_new0 (PluginInfo);
+    info->path = g_strdup (path);
+    info->name = g_key_file_get_string (manifest, group, MANIFEST_KEY_NAME, NULL);
+    info->subsystems = g_key_file_get_string_list (manifest, group, MANIFEST_KEY_SUBSYSTEMS, NULL, NULL);
+    if (!info->name || !info->subsystems) {
+        plugin_info_free (info);
+        return NULL;
+    }
+
+    info->drivers = g_key_file_get_string_list (manifest, group, MANIFEST_KEY_DRIVERS, NULL, NULL);
+    info->udev_tags = g_key_file_get_string_list (manifest, group, MANIFEST_KEY_UDEV_TAGS, NULL, NULL);
+    info->requires_vendor_product_ids = g_key_file_get_boolean (manifest, group, MANIFEST_KEY_REQUIRES_VENDOR_PRODUCT_IDS, NULL);
+
+    vendor_ids = g_key_file_get_integer_list (manifest, group, MANIFEST_KEY_VENDOR_IDS, &n, NULL);
+    if (vendor_ids) {
+        info->vendor_ids = g_new0 (guint16, n + 1);
+        for (i = 0; i < n; i++)
+            info->vendor_ids[i] = (guint16) vendor_ids[i];
+    }
+
+    /* Product ids given as "vid:pid" pairs, in hex */
+    product_ids = g_key_file_get_string_list (manifest, group, MANIFEST_KEY_PRODUCT_IDS, &n, NULL);
+    if (product_ids) {
+        info->product_ids = g_new0 (mm_uint16_pair, n + 1);
+        for (i = 0; i < n; i++) {
+            guint vid = 0;
+            guint pid = 0;
+
+            if (sscanf (product_ids[i], "%x:%x", &vid, &pid) != 2 || !vid) {
+                plugin_info_free (info);
+                return NULL;
+            }
+            info->product_ids[i].l = (guint16) vid;
+            info->product_ids[i].r = (guint16) pid;
+        }
+    }
+
+    return info;
+}
+
+static void
+manifest_add_plugin_info (GKeyFile   *manifest,
+                          PluginInfo *info,
+                          gboolean    generic)
+{
+    g_autofree gchar *group = NULL;
+    guint             i;
+
+    group = g_path_get_basename (info->path);
+    g_key_file_set_string (manifest, group, MANIFEST_KEY_NAME, info->name);
+    if (generic)
+        g_key_file_set_boolean (manifest, group, MANIFEST_KEY_GENERIC, TRUE);
+    g_key_file_set_string_list (manifest, group, MANIFEST_KEY_SUBSYSTEMS,
+                                (const gchar * const *) info->subsystems, g_strv_length (info->subsystems));
+    if (info->drivers)
+        g_key_file_set_string_list (manifest, group, MANIFEST_KEY_DRIVERS,
+                                    (const gchar * const *) info->drivers, g_strv_length (info->drivers));
+    if (info->udev_tags)
+        g_key_file_set_string_list (manifest, group, MANIFEST_KEY_UDEV_TAGS,
+                                    (const gchar * const *) info->udev_tags, g_strv_length (info->udev_tags));
+    if (info->vendor_ids) {
+        g_autoptr(GArray) vendor_ids = NULL;
+
+        vendor_ids = g_array_new (FALSE, FALSE, sizeof (gint));
+        for (i = 0; info->vendor_ids[i]; i++) {
+            gint vendor_id = info->vendor_ids[i];
+
+            g_array_append_val (vendor_ids, vendor_id);
+        }
+        g_key_file_set_integer_list (manifest, group, MANIFEST_KEY_VENDOR_IDS,
+                                     (gint *) vendor_ids->data, vendor_ids->len);
+    }
+    if (info->product_ids) {
+        g_autoptr(GPtrArray) product_ids = NULL;
+
+        product_ids = g_ptr_array_new_with_free_func (g_free);
+        for (i = 0; info->product_ids[i].l; i++)
+            g_ptr_array_add (product_ids, g_strdup_printf ("%04x:%04x", info->product_ids[i].l, info->product_ids[i].r));
+        g_key_file_set_string_list (manifest, group, MANIFEST_KEY_PRODUCT_IDS,
+                                    (const gchar * const *) product_ids->pdata, product_ids->len);
+    }
+    g_key_file_set_boolean (manifest, group, MANIFEST_KEY_REQUIRES_VENDOR_PRODUCT_IDS, info->requires_vendor_product_ids);
+}
+
+gboolean
+mm_plugin_manager_write_manifest (MMPluginManager  *self,
+                                  GError          **error)
+{
+    g_autoptr(GKeyFile)  manifest = NULL;
+    g_autofree gchar    *path = NULL;
+    g_autofree gchar    *version = NULL;
+    GList               *l;
+
+    manifest = g_key_file_new ();
+    version = manifest_build_version ();
+    g_key_file_set_string (manifest, MANIFEST_GROUP, MANIFEST_KEY_VERSION, version);
+
+    for (l = self->priv->plugins; l; l = g_list_next (l)) {
+        PluginInfo *info = l->data;
+
+        manifest_add_plugin_info (manifest, info, FALSE);
+        if (!manifest_set_file_info (manifest, info->path, error))
+            return FALSE;
+    }
+
+    if (self->priv->generic) {
+        PluginInfo *info;
+        gboolean    success;
+
+        info = plugin_info_new_from_plugin (self->priv->generic_path, self->priv->generic);
+        manifest_add_plugin_info (manifest, info, TRUE);
+        success = manifest_set_file_info (manifest, info->path, error);
+        plugin_info_free (info);
+        if (!success)
+            return FALSE;
+    }
+
+    /* Plugin files that couldn't be used are also listed, so that the manifest
+     * is still valid in the next run */
+    for (l = self->priv->ignored_plugin_paths; l; l = g_list_next (l)) {
+        g_autofree gchar *group = NULL;
+
+        group = g_path_get_basename ((const gchar *)(l->data));
+        g_key_file_set_boolean (manifest, group, MANIFEST_KEY_IGNORED, TRUE);
+        if (!manifest_set_file_info (manifest, (const gchar *)(l->data), error))
+            return FALSE;
+    }
+
+    path = g_build_filename (self->priv->plugin_dir, MANIFEST_FILE, NULL);
+    if (!g_key_file_save_to_file (manifest, path, error))
+        return FALSE;
+
+    mm_obj_info (self, "plugin manifest written to '%s' (%u plugins)",
+                 path, g_list_length (self->priv->plugins) + !!self->priv->generic);
+    return TRUE;
+}
+
 static gboolean
 load_plugins (MMPluginManager  *self,
               GError          **error)
@@ -1788,6 +2392,8 @@ load_plugins (MMPluginManager  *self,
     GPtrArray        *subsystems = NULL;
     g_autofree gchar *subsystems_str = NULL;
     g_autofree gchar *plugindir_display = NULL;
+    g_autoptr(GKeyFile)  manifest = NULL;
+    guint             n_deferred = 0;
 
     if (!g_module_supported ()) {
         g_set_error (error,
@@ -1824,48 +2430,82 @@ load_plugins (MMPluginManager  *self,
     for (l = shared_paths; l; l = g_list_next (l))
         load_shared (self, (const gchar *)(l->data));
 
+    /* Plugins are loaded on demand if there is a valid manifest */
+    manifest = plugin_manager_load_manifest (self, plugin_paths);
+
     /* Load all plugins */
     subsystems = g_ptr_array_new ();
     for (l = plugin_paths; l; l = g_list_next (l)) {
-        MMPlugin     *plugin;
-        const gchar **plugin_subsystems;
-        guint         i;
+        const gchar *path;
+        MMPlugin    *plugin = NULL;
+        PluginInfo  *info = NULL;
+        gboolean     is_generic = FALSE;
+        guint        i;
+
+        path = (const gchar *)(l->data);
+        if (manifest) {
+            if (manifest_plugin_ignored (manifest, path)) {
+                self->priv->ignored_plugin_paths = g_list_append (self->priv->ignored_plugin_paths, g_strdup (path));
+                continue;
+            }
+            info = plugin_info_new_from_manifest (manifest, path);
+        }
 
-        plugin = load_plugin (self, (const gchar *)(l->data));
-        if (!plugin)
-            continue;
+        if (!info) {
+            plugin = load_plugin (self, path);
+            if (!plugin) {
+                self->priv->ignored_plugin_paths = g_list_append (self->priv->ignored_plugin_paths, g_strdup (path));
+                continue;
+            }
 
-        /* Ignore plugins that don't specify subsystems */
-        plugin_subsystems = mm_plugin_get_allowed_subsystems (plugin);
-        if (!plugin_subsystems) {
-            mm_obj_warn (self, "plugin '%s' doesn't specify allowed subsystems: ignored",
-                         mm_plugin_get_name (plugin));
-            continue;
-        }
+            /* Ignore plugins that don't specify subsystems */
+            if (!mm_plugin_get_allowed_subsystems (plugin)) {
+                mm_obj_warn (self, "plugin '%s' doesn't specify allowed subsystems: ignored",
+                             mm_plugin_get_name (plugin));
+                g_object_unref (plugin);
+                self->priv->ignored_plugin_paths = g_list_append (self->priv->ignored_plugin_paths, g_strdup (path));
+                continue;
+            }
 
-        /* Process generic plugin */
-        if (mm_plugin_is_generic (plugin)) {
-            if (self->priv->generic) {
+            /* Process generic plugin */
+            if (mm_plugin_is_generic (plugin) && self->priv->generic) {
                 mm_obj_warn (self, "plugin '%s' is generic and another one is already registered: ignored",
                              mm_plugin_get_name (plugin));
+                g_object_unref (plugin);
+                self->priv->ignored_plugin_paths = g_list_append (self->priv->ignored_plugin_paths, g_strdup (path));
                 continue;
             }
-            self->priv->generic = plugin;
+
+            info = plugin_info_new_from_plugin (path, plugin);
+            is_generic = mm_plugin_is_generic (plugin);
+            if (is_generic) {
+                self->priv->generic = plugin;
+                self->priv->generic_path = g_strdup (path);
+            } else
+                g_object_unref (plugin);
         } else
-            self->priv->plugins = g_list_append (self->priv->plugins, plugin);
+            n_deferred++;
 
         /* Track required subsystems, avoiding duplicates in the list */
-        for (i = 0; plugin_subsystems[i]; i++) {
-            if (!g_ptr_array_find_with_equal_func (subsystems, plugin_subsystems[i], g_str_equal, NULL))
-                g_ptr_array_add (subsystems, g_strdup (plugin_subsystems[i]));
+        for (i = 0; info->subsystems[i]; i++) {
+            if (!g_ptr_array_find_with_equal_func (subsystems, info->subsystems[i], g_str_equal, NULL))
+                g_ptr_array_add (subsystems, g_strdup (info->subsystems[i]));
         }
 
         /* Register plugin whitelist rules in filter, if any */
-        register_plugin_whitelist_tags        (self, plugin);
-        register_plugin_whitelist_vendor_ids  (self, plugin);
-        register_plugin_whitelist_product_ids (self, plugin);
+        register_plugin_whitelist_tags        (self, info);
+        register_plugin_whitelist_vendor_ids  (self, info);
+        register_plugin_whitelist_product_ids (self, info);
+
+        if (is_generic)
+            plugin_info_free (info);
+        else
+            self->priv->plugins = g_list_append (self->priv->plugins, info);
     }
 
+    /* Build the index to select candidate plugins for each port */
+    self->priv->index = plugin_index_new (self->priv->plugins);
+
     /* Check the generic plugin once all looped */
     if (!self->priv->generic)
         mm_obj_dbg (self, "generic plugin not loaded");
@@ -1893,8 +2533,8 @@ load_plugins (MMPluginManager  *self,
     self->priv->subsystems = (gchar **) g_ptr_array_free (subsystems, FALSE);
     subsystems_str = g_strjoinv (", ", self->priv->subsystems);
 
-    mm_obj_dbg (self, "successfully loaded %u plugins registering %u subsystems: %s",
-                g_list_length (self->priv->plugins) + !!self->priv->generic,
+    mm_obj_dbg (self, "successfully registered %u plugins (%u loaded on demand) registering %u subsystems: %s",
+                g_list_length (self->priv->plugins) + !!self->priv->generic, n_deferred,
                 g_strv_length (self->priv->subsystems), subsystems_str);
 
 out:
@@ -1996,8 +2636,11 @@ dispose (GObject *object)
 {
     MMPluginManager *self = MM_PLUGIN_MANAGER (object);
 
-    g_list_free_full (g_steal_pointer (&self->priv->plugins), g_object_unref);
+    g_clear_pointer (&self->priv->index, plugin_index_free);
+    g_list_free_full (g_steal_pointer (&self->priv->plugins), (GDestroyNotify) plugin_info_free);
+    g_list_free_full (g_steal_pointer (&self->priv->ignored_plugin_paths), g_free);
     g_clear_object (&self->priv->generic);
+    g_clear_pointer (&self->priv->generic_path, g_free);
     g_clear_pointer (&self->priv->plugin_dir, g_free);
     g_clear_object (&self->priv->filter);
     g_clear_pointer (&self->priv->subsystems, g_strfreev);
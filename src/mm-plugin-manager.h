@@ -66,5 +66,15 @@ MMPlugin *       mm_plugin_manager_device_support_check_finish (MMPluginManager
 MMPlugin        *mm_plugin_manager_peek_plugin                 (MMPluginManager      *self,
                                                                 const gchar          *plugin_name);
 const gchar    **mm_plugin_manager_get_subsystems              (MMPluginManager      *self);
+gboolean         mm_plugin_manager_write_manifest              (MMPluginManager      *self,
+                                                                GError              **error);
+
+/* Statistics of the plugin lists built for the probed ports: how many were
+ * built, how many candidate plugins were found in the index for all of them,
+ * and the total time spent building them, in microseconds */
+void             mm_plugin_manager_get_plugins_list_stats      (MMPluginManager      *self,
+                                                                guint                *builds,
+                                                                guint                *candidates,
+                                                                gint64               *time);
 
 #endif /* MM_PLUGIN_MANAGER_H */
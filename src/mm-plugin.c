@@ -170,12 +170,27 @@ mm_plugin_get_allowed_product_ids (MMPlugin *self)
     return self->priv->product_ids;
 }
 
+const gchar **
+mm_plugin_get_allowed_drivers (MMPlugin *self)
+{
+    return (const gchar **) self->priv->drivers;
+}
+
 gboolean
 mm_plugin_is_generic (MMPlugin *self)
 {
     return self->priv->is_generic;
 }
 
+gboolean
+mm_plugin_requires_vendor_product_ids (MMPlugin *self)
+{
+    return ((self->priv->vendor_ids || self->priv->product_ids) &&
+            !self->priv->vendor_strings &&
+            !self->priv->product_strings &&
+            !self->priv->forbidden_product_strings);
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -130,8 +130,13 @@ const gchar          **mm_plugin_get_allowed_subsystems  (MMPlugin *self);
 const gchar          **mm_plugin_get_allowed_udev_tags   (MMPlugin *self);
 const guint16         *mm_plugin_get_allowed_vendor_ids  (MMPlugin *self);
 const mm_uint16_pair  *mm_plugin_get_allowed_product_ids (MMPlugin *self);
+const gchar          **mm_plugin_get_allowed_drivers     (MMPlugin *self);
 gboolean               mm_plugin_is_generic              (MMPlugin *self);
 
+/* Whether the vendor/product ID filters are enough to discard a port, i.e.
+ * there are no vendor/product string filters to fallback to. */
+gboolean               mm_plugin_requires_vendor_product_ids (MMPlugin *self);
+
 /* This method will run all pre-probing filters, to see if we can discard this
  * plugin from the probing logic as soon as possible. */
 MMPluginSupportsHint mm_plugin_discard_port_early (MMPlugin       *self,
@@ -818,6 +818,188 @@ mm_port_mbim_peek_device (MMPortMbim *self)
     return self->priv->mbim_device;
 }
 
+/*****************************************************************************/
+/* Command batches */
+
+typedef struct {
+    MMPortMbimBatchParseFunc  parse;
+    GDestroyNotify            result_free;
+    gpointer                  result;
+    GError                   *error;
+    gboolean                  taken;
+} BatchEntry;
+
+struct _MMPortMbimBatch {
+    BatchEntry *entries;
+    guint       n_entries;
+    guint       n_failed;
+    guint       n_pending;
+};
+
+typedef struct {
+    GTask *task;
+    guint  i;
+} BatchCommandContext;
+
+void
+mm_port_mbim_batch_free (MMPortMbimBatch *batch)
+{
+    guint i;
+
+    for (i = 0; i < batch->n_entries; i++) {
+        if (batch->entries[i].result)
+            batch->entries[i].result_free (batch->entries[i].result);
+        if (batch->entries[i].error)
+            g_error_free (batch->entries[i].error);
+    }
+    g_free (batch->entries);
+    g_slice_free (MMPortMbimBatch, batch);
+}
+
+guint
+mm_port_mbim_batch_get_n_requests (MMPortMbimBatch *batch)
+{
+    return batch->n_entries;
+}
+
+guint
+mm_port_mbim_batch_get_n_failed (MMPortMbimBatch *batch)
+{
+    return batch->n_failed;
+}
+
+gpointer
+mm_port_mbim_batch_take_result (MMPortMbimBatch  *batch,
+                                guint             i,
+                                GError          **error)
+{
+    BatchEntry *entry;
+
+    g_assert (i < batch->n_entries);
+    entry = &batch->entries[i];
+
+    if (entry->error) {
+        g_propagate_error (error, g_error_copy (entry->error));
+        return NULL;
+    }
+    if (entry->taken) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE,
+                     "Batch result already taken");
+        return NULL;
+    }
+    entry->taken = TRUE;
+    return g_steal_pointer (&entry->result);
+}
+
+MMPortMbimBatch *
+mm_port_mbim_command_batch_finish (MMPortMbim    *self,
+                                   GAsyncResult  *res,
+                                   GError       **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+batch_command_ready (MbimDevice          *device,
+                     GAsyncResult        *res,
+                     BatchCommandContext *command_ctx)
+{
+    MMPortMbimBatch *batch;
+    BatchEntry      *entry;
+    GTask           *task;
+    MbimMessage     *response;
+
+    task  = command_ctx->task;
+    batch = g_task_get_task_data (task);
+    entry = &batch->entries[command_ctx->i];
+    g_slice_free (BatchCommandContext, command_ctx);
+
+    /* Transport errors, error status replies and parser errors are all
+     * reported as the error of the entry */
+    response = mbim_device_command_finish (device, res, &entry->error);
+    if (response &&
+        mbim_message_response_get_result (response, MBIM_MESSAGE_TYPE_COMMAND_DONE, &entry->error)) {
+        if (entry->parse)
+            entry->result = entry->parse (response, &entry->error);
+        else
+            entry->result = mbim_message_ref (response);
+    }
+    if (!entry->result) {
+        if (!entry->error)
+            entry->error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_FAILED, "No result parsed");
+        batch->n_failed++;
+    }
+    if (response)
+        mbim_message_unref (response);
+
+    g_assert (batch->n_pending > 0);
+    if (--batch->n_pending == 0) {
+        mm_obj_dbg (g_task_get_source_object (task), "command batch finished: %u/%u requests failed",
+                    batch->n_failed, batch->n_entries);
+        /* The batch is transferred to the caller */
+        g_task_return_pointer (task, batch, (GDestroyNotify) mm_port_mbim_batch_free);
+    }
+    g_object_unref (task);
+}
+
+void
+mm_port_mbim_command_batch (MMPortMbim                   *self,
+                            const MMPortMbimBatchRequest *requests,
+                            guint                         n_requests,
+                            guint                         timeout,
+                            GCancellable                 *cancellable,
+                            GAsyncReadyCallback           callback,
+                            gpointer                      user_data)
+{
+    MMPortMbimBatch *batch;
+    GTask           *task;
+    guint            i;
+
+    g_return_if_fail (MM_IS_PORT_MBIM (self));
+    g_return_if_fail (n_requests > 0);
+
+    task = g_task_new (self, cancellable, callback, user_data);
+
+    if (!self->priv->mbim_device) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE, "Port is not open");
+        g_object_unref (task);
+        return;
+    }
+
+    batch = g_slice_new0 (MMPortMbimBatch);
+    batch->entries = g_new0 (BatchEntry, n_requests);
+    batch->n_entries = n_requests;
+    batch->n_pending = n_requests;
+    for (i = 0; i < n_requests; i++) {
+        batch->entries[i].parse = requests[i].parse;
+        batch->entries[i].result_free = (requests[i].parse ?
+                                         requests[i].result_free :
+                                         (GDestroyNotify) mbim_message_unref);
+        g_assert (batch->entries[i].result_free);
+    }
+    /* The task data doesn't own the batch: it is always returned to the
+     * caller once all requests have been completed */
+    g_task_set_task_data (task, batch, NULL);
+
+    /* All requests are submitted right away, libmbim takes care of matching
+     * each response with its request by transaction id, so there is no need
+     * to wait for one reply before sending the next request. */
+    for (i = 0; i < n_requests; i++) {
+        BatchCommandContext *command_ctx;
+
+        command_ctx = g_slice_new (BatchCommandContext);
+        command_ctx->task = g_object_ref (task);
+        command_ctx->i = i;
+        mbim_device_command (self->priv->mbim_device,
+                             requests[i].message,
+                             timeout,
+                             cancellable,
+                             (GAsyncReadyCallback) batch_command_ready,
+                             command_ctx);
+    }
+    g_object_unref (task);
+}
+
 /*****************************************************************************/
 
 MMPortMbim *
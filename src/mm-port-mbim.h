@@ -92,6 +92,43 @@ gboolean   mm_port_mbim_allocate_qmi_client_finish (MMPortMbim           *self,
 
 MbimDevice *mm_port_mbim_peek_device (MMPortMbim *self);
 
+/* Batch of independent commands sent at once; each reply is reported
+ * separately, so that a failure in one of them doesn't affect the others.
+ * Each successful reply (i.e. with a MBIM_STATUS_ERROR_NONE status) is
+ * converted into a typed result by the parser given in the request; if no
+ * parser is given, the result is the response message itself. */
+typedef struct _MMPortMbimBatch MMPortMbimBatch;
+
+typedef gpointer (* MMPortMbimBatchParseFunc) (MbimMessage  *response,
+                                               GError      **error);
+
+typedef struct {
+    MbimMessage              *message;
+    MMPortMbimBatchParseFunc  parse;
+    GDestroyNotify            result_free;
+} MMPortMbimBatchRequest;
+
+void             mm_port_mbim_command_batch        (MMPortMbim                   *self,
+                                                    const MMPortMbimBatchRequest *requests,
+                                                    guint                         n_requests,
+                                                    guint                         timeout,
+                                                    GCancellable                 *cancellable,
+                                                    GAsyncReadyCallback           callback,
+                                                    gpointer                      user_data);
+MMPortMbimBatch *mm_port_mbim_command_batch_finish (MMPortMbim                   *self,
+                                                    GAsyncResult                 *res,
+                                                    GError                      **error);
+
+guint            mm_port_mbim_batch_get_n_requests (MMPortMbimBatch              *batch);
+guint            mm_port_mbim_batch_get_n_failed   (MMPortMbimBatch              *batch);
+/* Transfers the typed result of the given request (or its error) to the
+ * caller; each result can only be taken once. */
+gpointer         mm_port_mbim_batch_take_result    (MMPortMbimBatch              *batch,
+                                                    guint                         i,
+                                                    GError                      **error);
+void             mm_port_mbim_batch_free           (MMPortMbimBatch              *batch);
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMPortMbimBatch, mm_port_mbim_batch_free)
+
 void   mm_port_mbim_setup_link        (MMPortMbim            *self,
                                        MMPort                *data,
                                        const gchar           *link_prefix_hint,
@@ -27,6 +27,7 @@
 #include "mm-log-object.h"
 
 #define DEFAULT_LINK_PREALLOCATED_AMOUNT 4
+#define MAX_LINK_PREALLOCATED_AMOUNT     8
 
 G_DEFINE_TYPE (MMPortQmi, mm_port_qmi, MM_TYPE_PORT)
 
@@ -40,6 +41,7 @@ struct _MMPortQmiPrivate {
     gboolean   in_progress;
     QmiDevice *qmi_device;
     GList     *services;
+    GList     *allocate_client_ongoing;
     gchar     *net_driver;
     /* endpoint info */
     gulong              endpoint_info_signal_id;
@@ -56,6 +58,10 @@ struct _MMPortQmiPrivate {
     MMPort   *preallocated_links_master;
     GArray   *preallocated_links;
     GList    *preallocated_links_setup_pending;
+    /* data format setup in progress */
+    gboolean                        setup_data_format_in_progress;
+    MMPortQmiSetupDataFormatAction  setup_data_format_action;
+    GList                          *setup_data_format_pending;
 };
 
 /*****************************************************************************/
@@ -115,6 +121,201 @@ mm_port_qmi_peek_device (MMPortQmi *self)
     return self->priv->qmi_device;
 }
 
+/*****************************************************************************/
+/* Command batches */
+
+typedef struct {
+    MMPortQmiBatchFinishFunc     finish;
+    MMPortQmiBatchGetResultFunc  get_result;
+    GDestroyNotify               output_unref;
+    gpointer                     output;
+    GError                      *error;
+    gboolean                     taken;
+} BatchEntry;
+
+struct _MMPortQmiBatch {
+    BatchEntry *entries;
+    guint       n_entries;
+    guint       n_failed;
+    guint       n_pending;
+};
+
+typedef struct {
+    GTask *task;
+    guint  i;
+} BatchCommandContext;
+
+void
+mm_port_qmi_batch_free (MMPortQmiBatch *batch)
+{
+    guint i;
+
+    for (i = 0; i < batch->n_entries; i++) {
+        if (batch->entries[i].output)
+            batch->entries[i].output_unref (batch->entries[i].output);
+        if (batch->entries[i].error)
+            g_error_free (batch->entries[i].error);
+    }
+    g_free (batch->entries);
+    g_slice_free (MMPortQmiBatch, batch);
+}
+
+guint
+mm_port_qmi_batch_get_n_requests (MMPortQmiBatch *batch)
+{
+    return batch->n_entries;
+}
+
+guint
+mm_port_qmi_batch_get_n_failed (MMPortQmiBatch *batch)
+{
+    return batch->n_failed;
+}
+
+gpointer
+mm_port_qmi_batch_take_output (MMPortQmiBatch  *batch,
+                               guint            i,
+                               GError         **error)
+{
+    BatchEntry *entry;
+
+    g_assert (i < batch->n_entries);
+    entry = &batch->entries[i];
+
+    if (entry->error) {
+        g_propagate_error (error, g_error_copy (entry->error));
+        return NULL;
+    }
+    if (entry->taken) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE,
+                     "Batch output already taken");
+        return NULL;
+    }
+    entry->taken = TRUE;
+    return g_steal_pointer (&entry->output);
+}
+
+MMPortQmiBatch *
+mm_port_qmi_command_batch_finish (MMPortQmi     *self,
+                                  GAsyncResult  *res,
+                                  GError       **error)
+{
+    return g_task_propagate_pointer (G_TASK (res), error);
+}
+
+static void
+batch_entry_completed (GTask *task)
+{
+    MMPortQmiBatch *batch;
+
+    batch = g_task_get_task_data (task);
+
+    g_assert (batch->n_pending > 0);
+    if (--batch->n_pending == 0) {
+        mm_obj_dbg (g_task_get_source_object (task), "command batch finished: %u/%u requests failed",
+                    batch->n_failed, batch->n_entries);
+        /* The batch is transferred to the caller */
+        g_task_return_pointer (task, batch, (GDestroyNotify) mm_port_qmi_batch_free);
+    }
+    g_object_unref (task);
+}
+
+static void
+batch_command_ready (QmiClient           *client,
+                     GAsyncResult        *res,
+                     BatchCommandContext *command_ctx)
+{
+    MMPortQmiBatch *batch;
+    BatchEntry     *entry;
+    GTask          *task;
+
+    task  = command_ctx->task;
+    batch = g_task_get_task_data (task);
+    entry = &batch->entries[command_ctx->i];
+    g_slice_free (BatchCommandContext, command_ctx);
+
+    /* Transport errors and error results reported in the output are both
+     * reported as the error of the entry */
+    entry->output = entry->finish (client, res, &entry->error);
+    if (entry->output && !entry->get_result (entry->output, &entry->error))
+        g_clear_pointer (&entry->output, entry->output_unref);
+    if (!entry->output) {
+        g_assert (entry->error);
+        batch->n_failed++;
+    }
+
+    batch_entry_completed (task);
+}
+
+void
+mm_port_qmi_command_batch (MMPortQmi                   *self,
+                           const MMPortQmiBatchRequest *requests,
+                           guint                        n_requests,
+                           guint                        timeout,
+                           GCancellable                *cancellable,
+                           GAsyncReadyCallback          callback,
+                           gpointer                     user_data)
+{
+    MMPortQmiBatch *batch;
+    GTask          *task;
+    guint           i;
+
+    g_return_if_fail (MM_IS_PORT_QMI (self));
+    g_return_if_fail (n_requests > 0);
+
+    task = g_task_new (self, cancellable, callback, user_data);
+
+    if (!self->priv->qmi_device) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_WRONG_STATE, "Port is not open");
+        g_object_unref (task);
+        return;
+    }
+
+    batch = g_slice_new0 (MMPortQmiBatch);
+    batch->entries = g_new0 (BatchEntry, n_requests);
+    batch->n_entries = n_requests;
+    /* One extra pending operation held while submitting, so that requests
+     * failing right away don't complete the batch too early */
+    batch->n_pending = n_requests + 1;
+    for (i = 0; i < n_requests; i++) {
+        batch->entries[i].finish = requests[i].finish;
+        batch->entries[i].get_result = requests[i].get_result;
+        batch->entries[i].output_unref = requests[i].output_unref;
+    }
+    /* The task data doesn't own the batch: it is always returned to the
+     * caller once all requests have been completed */
+    g_task_set_task_data (task, batch, NULL);
+
+    /* All requests are submitted right away, libqmi takes care of matching
+     * each response with its request by transaction id, so there is no need
+     * to wait for one reply before sending the next request. */
+    for (i = 0; i < n_requests; i++) {
+        BatchCommandContext *command_ctx;
+        QmiClient           *client;
+
+        client = mm_port_qmi_peek_client (self, requests[i].service, MM_PORT_QMI_FLAG_DEFAULT);
+        if (!client) {
+            batch->entries[i].error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_UNSUPPORTED,
+                                                   "No client allocated for service '%s'",
+                                                   qmi_service_get_string (requests[i].service));
+            batch->n_failed++;
+            batch_entry_completed (g_object_ref (task));
+            continue;
+        }
+
+        command_ctx = g_slice_new (BatchCommandContext);
+        command_ctx->task = g_object_ref (task);
+        command_ctx->i = i;
+        requests[i].send (client,
+                          NULL,
+                          timeout,
+                          cancellable,
+                          (GAsyncReadyCallback) batch_command_ready,
+                          command_ctx);
+    }
+    batch_entry_completed (task);
+}
+
 /*****************************************************************************/
 
 static void
@@ -192,11 +393,13 @@ mm_port_qmi_release_client (MMPortQmi     *self,
 
 typedef struct {
     ServiceInfo *info;
+    GList       *waiting;
 } AllocateClientContext;
 
 static void
 allocate_client_context_free (AllocateClientContext *ctx)
 {
+    g_assert (!ctx->waiting);
     if (ctx->info) {
         g_assert (ctx->info->client == NULL);
         g_free (ctx->info);
@@ -204,6 +407,24 @@ allocate_client_context_free (AllocateClientContext *ctx)
     g_free (ctx);
 }
 
+static GTask *
+lookup_allocate_client_ongoing (MMPortQmi     *self,
+                                QmiService     service,
+                                MMPortQmiFlag  flag)
+{
+    GList *l;
+
+    for (l = self->priv->allocate_client_ongoing; l; l = g_list_next (l)) {
+        AllocateClientContext *ctx;
+
+        ctx = g_task_get_task_data (G_TASK (l->data));
+        if (ctx->info->service == service && ctx->info->flag == flag)
+            return G_TASK (l->data);
+    }
+
+    return NULL;
+}
+
 gboolean
 mm_port_qmi_allocate_client_finish (MMPortQmi *self,
                                     GAsyncResult *res,
@@ -223,19 +444,37 @@ allocate_client_ready (QmiDevice *qmi_device,
 
     self = g_task_get_source_object (task);
     ctx = g_task_get_task_data (task);
+    self->priv->allocate_client_ongoing = g_list_remove (self->priv->allocate_client_ongoing, task);
+
     ctx->info->client = qmi_device_allocate_client_finish (qmi_device, res, &error);
-    if (!ctx->info->client) {
+    if (!ctx->info->client)
         g_prefix_error (&error,
                         "Couldn't create client for service '%s': ",
                         qmi_service_get_string (ctx->info->service));
-        g_task_return_error (task, error);
-    } else {
+    else {
         /* Move the service info to our internal list */
         self->priv->services = g_list_prepend (self->priv->services, ctx->info);
         ctx->info = NULL;
-        g_task_return_boolean (task, TRUE);
     }
 
+    /* Requests for the same client received while the allocation was
+     * ongoing get the same result */
+    while (ctx->waiting) {
+        GTask *waiting;
+
+        waiting = ctx->waiting->data;
+        ctx->waiting = g_list_delete_link (ctx->waiting, ctx->waiting);
+        if (error)
+            g_task_return_error (waiting, g_error_copy (error));
+        else
+            g_task_return_boolean (waiting, TRUE);
+        g_object_unref (waiting);
+    }
+
+    if (error)
+        g_task_return_error (task, error);
+    else
+        g_task_return_boolean (task, TRUE);
     g_object_unref (task);
 }
 
@@ -249,6 +488,7 @@ mm_port_qmi_allocate_client (MMPortQmi *self,
 {
     AllocateClientContext *ctx;
     GTask *task;
+    GTask *ongoing;
 
     task = g_task_new (self, cancellable, callback, user_data);
 
@@ -267,11 +507,22 @@ mm_port_qmi_allocate_client (MMPortQmi *self,
         return;
     }
 
+    /* If the same client is already being allocated, e.g. by a different
+     * bearer connecting in parallel, wait for that operation instead of
+     * allocating a duplicate one */
+    ongoing = lookup_allocate_client_ongoing (self, service, flag);
+    if (ongoing) {
+        ctx = g_task_get_task_data (ongoing);
+        ctx->waiting = g_list_append (ctx->waiting, task);
+        return;
+    }
+
     ctx = g_new0 (AllocateClientContext, 1);
     ctx->info = g_new0 (ServiceInfo, 1);
     ctx->info->service = service;
     ctx->info->flag = flag;
     g_task_set_task_data (task, ctx, (GDestroyNotify)allocate_client_context_free);
+    self->priv->allocate_client_ongoing = g_list_prepend (self->priv->allocate_client_ongoing, task);
 
     qmi_device_allocate_client (self->priv->qmi_device,
                                 service,
@@ -283,11 +534,27 @@ mm_port_qmi_allocate_client (MMPortQmi *self,
 }
 
 /*****************************************************************************/
+/* Preallocated links (qmi_wwan)
+ *
+ * The qmi_wwan driver only allows creating links through its add_mux sysfs
+ * interface, so links are kept in a pool associated to a given master
+ * interface. The pool is initialized with DEFAULT_LINK_PREALLOCATED_AMOUNT
+ * links added in parallel, it grows one link at a time when exhausted (up to
+ * MAX_LINK_PREALLOCATED_AMOUNT links) and it shrinks back to the default size
+ * as the additional links are released.
+ */
+
+typedef enum {
+    PREALLOCATED_LINK_STATE_ADDING,
+    PREALLOCATED_LINK_STATE_AVAILABLE,
+    PREALLOCATED_LINK_STATE_SETUP,
+    PREALLOCATED_LINK_STATE_REMOVING,
+} PreallocatedLinkState;
 
 typedef struct {
-    gchar    *link_name;
-    guint     mux_id;
-    gboolean  setup;
+    gchar                 *link_name;
+    guint                  mux_id;
+    PreallocatedLinkState  state;
 } PreallocatedLinkInfo;
 
 static void
@@ -311,13 +578,18 @@ delete_preallocated_links (QmiDevice *qmi_device,
         PreallocatedLinkInfo *info;
 
         info = &g_array_index (preallocated_links, PreallocatedLinkInfo, i);
+        /* links being added or removed are deleted once the operation finishes */
+        if ((info->state == PREALLOCATED_LINK_STATE_ADDING) ||
+            (info->state == PREALLOCATED_LINK_STATE_REMOVING))
+            continue;
         qmi_device_delete_link (qmi_device, info->link_name, info->mux_id,
                                 NULL, NULL, NULL);
     }
 }
 
 static guint
-count_preallocated_links_setup (MMPortQmi *self)
+count_preallocated_links (MMPortQmi             *self,
+                          PreallocatedLinkState  state)
 {
     guint i;
     guint count = 0;
@@ -326,18 +598,18 @@ count_preallocated_links_setup (MMPortQmi *self)
         PreallocatedLinkInfo *info;
 
         info = &g_array_index (self->priv->preallocated_links, PreallocatedLinkInfo, i);
-        if (info->setup)
+        if (info->state == state)
             count++;
     }
 
     return count;
 }
 
-static gboolean
-release_preallocated_link (MMPortQmi    *self,
-                           const gchar  *link_name,
-                           guint         mux_id,
-                           GError     **error)
+static PreallocatedLinkInfo *
+lookup_preallocated_link (MMPortQmi             *self,
+                          guint                  mux_id,
+                          PreallocatedLinkState  state,
+                          guint                 *out_index)
 {
     guint i;
 
@@ -345,186 +617,356 @@ release_preallocated_link (MMPortQmi    *self,
         PreallocatedLinkInfo *info;
 
         info = &g_array_index (self->priv->preallocated_links, PreallocatedLinkInfo, i);
-        if (!info->setup || (g_strcmp0 (info->link_name, link_name) != 0) || (info->mux_id != mux_id))
-            continue;
-
-        info->setup = FALSE;
-        return TRUE;
+        if ((info->mux_id == mux_id) && (info->state == state)) {
+            if (out_index)
+                *out_index = i;
+            return info;
+        }
     }
-
-    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                 "No preallocated link found to release");
-    return FALSE;
+    return NULL;
 }
 
 static gboolean
 acquire_preallocated_link (MMPortQmi  *self,
-                           MMPort     *master,
                            gchar     **link_name,
-                           guint      *mux_id,
-                           GError    **error)
+                           guint      *mux_id)
 {
     guint i;
 
-    if (!self->priv->qmi_device) {
-        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_ABORTED,
-                     "port is closed");
-        return FALSE;
-    }
-
-    if (!self->priv->preallocated_links || !self->priv->preallocated_links_master) {
-        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                     "No preallocated links available");
-        return FALSE;
-    }
-
-    if ((master != self->priv->preallocated_links_master) &&
-        (g_strcmp0 (mm_port_get_device (master), mm_port_get_device (self->priv->preallocated_links_master)) != 0)) {
-        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                     "Preallocated links available in 'net/%s', not in 'net/%s'",
-                     mm_port_get_device (self->priv->preallocated_links_master),
-                     mm_port_get_device (master));
-        return FALSE;
-    }
-
-    for (i = 0; i < self->priv->preallocated_links->len; i++) {
+    for (i = 0; self->priv->preallocated_links && (i < self->priv->preallocated_links->len); i++) {
         PreallocatedLinkInfo *info;
 
         info = &g_array_index (self->priv->preallocated_links, PreallocatedLinkInfo, i);
-        if (info->setup)
+        if (info->state != PREALLOCATED_LINK_STATE_AVAILABLE)
             continue;
 
-        info->setup = TRUE;
+        info->state = PREALLOCATED_LINK_STATE_SETUP;
         *link_name = g_strdup (info->link_name);
         *mux_id = info->mux_id;
         return TRUE;
     }
 
-    g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
-                 "No more preallocated links available");
     return FALSE;
 }
 
 /*****************************************************************************/
 
 typedef struct {
-    QmiDevice *qmi_device;
-    MMPort    *data;
-    GArray    *preallocated_links;
-} InitializePreallocatedLinksContext;
+    MMPort *master;
+    gchar  *link_name;
+    guint   mux_id;
+} SetupLinkContext;
+
+static void
+setup_link_context_free (SetupLinkContext *ctx)
+{
+    g_free (ctx->link_name);
+    g_clear_object (&ctx->master);
+    g_slice_free (SetupLinkContext, ctx);
+}
 
 static void
-initialize_preallocated_links_context_free (InitializePreallocatedLinksContext *ctx)
+complete_preallocated_links_setup_pending (MMPortQmi *self)
 {
-    if (ctx->preallocated_links) {
-        delete_preallocated_links (ctx->qmi_device, ctx->preallocated_links);
-        g_array_unref (ctx->preallocated_links);
+    /* Serve as many pending requests as available links we have */
+    while (self->priv->preallocated_links_setup_pending) {
+        GTask            *task;
+        SetupLinkContext *ctx;
+
+        task = self->priv->preallocated_links_setup_pending->data;
+        ctx  = g_task_get_task_data (task);
+        if (!acquire_preallocated_link (self, &ctx->link_name, &ctx->mux_id))
+            break;
+
+        self->priv->preallocated_links_setup_pending = g_list_delete_link (self->priv->preallocated_links_setup_pending,
+                                                                           self->priv->preallocated_links_setup_pending);
+        g_task_return_boolean (task, TRUE);
+        g_object_unref (task);
     }
-    g_object_unref (ctx->qmi_device);
-    g_object_unref (ctx->data);
-    g_slice_free (InitializePreallocatedLinksContext, ctx);
 }
 
-static GArray *
-initialize_preallocated_links_finish (MMPortQmi     *self,
-                                      GAsyncResult  *res,
-                                      GError       **error)
+static void
+abort_preallocated_links_setup_pending (MMPortQmi    *self,
+                                        const GError *error,
+                                        guint         n_keep)
 {
-    return g_task_propagate_pointer (G_TASK (res), error);
+    while (g_list_length (self->priv->preallocated_links_setup_pending) > n_keep) {
+        GList *last;
+
+        /* Abort the most recent requests first */
+        last = g_list_last (self->priv->preallocated_links_setup_pending);
+        g_task_return_error (last->data, g_error_copy (error));
+        g_object_unref (last->data);
+        self->priv->preallocated_links_setup_pending = g_list_delete_link (self->priv->preallocated_links_setup_pending, last);
+    }
 }
 
-static void initialize_preallocated_links_next (GTask *task);
+static void
+reset_preallocated_links (MMPortQmi *self,
+                          QmiDevice *qmi_device)
+{
+    g_autoptr(GError) error = NULL;
+
+    error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_ABORTED, "port is closed");
+    abort_preallocated_links_setup_pending (self, error, 0);
+
+    if (self->priv->preallocated_links) {
+        if (qmi_device)
+            delete_preallocated_links (qmi_device, self->priv->preallocated_links);
+        g_clear_pointer (&self->priv->preallocated_links, g_array_unref);
+    }
+    g_clear_object (&self->priv->preallocated_links_master);
+}
+
+typedef struct {
+    MMPortQmi *self;
+    GArray    *preallocated_links;
+    guint      mux_id;
+} PreallocatedLinkOperationContext;
+
+static PreallocatedLinkOperationContext *
+preallocated_link_operation_context_new (MMPortQmi *self,
+                                         guint      mux_id)
+{
+    PreallocatedLinkOperationContext *ctx;
+
+    ctx = g_slice_new0 (PreallocatedLinkOperationContext);
+    ctx->self = g_object_ref (self);
+    ctx->preallocated_links = g_array_ref (self->priv->preallocated_links);
+    ctx->mux_id = mux_id;
+    return ctx;
+}
 
 static void
-device_add_link_preallocated_ready (QmiDevice     *device,
-                                    GAsyncResult  *res,
-                                    GTask         *task)
+preallocated_link_operation_context_free (PreallocatedLinkOperationContext *ctx)
 {
-    InitializePreallocatedLinksContext *ctx;
-    GError                             *error = NULL;
-    PreallocatedLinkInfo                info = { NULL, 0, FALSE };
+    g_array_unref (ctx->preallocated_links);
+    g_object_unref (ctx->self);
+    g_slice_free (PreallocatedLinkOperationContext, ctx);
+}
 
-    ctx = g_task_get_task_data (task);
+static void
+device_add_link_preallocated_ready (QmiDevice                        *device,
+                                    GAsyncResult                     *res,
+                                    PreallocatedLinkOperationContext *ctx)
+{
+    MMPortQmi            *self;
+    PreallocatedLinkInfo *info;
+    g_autoptr(GError)     error = NULL;
+    g_autofree gchar     *link_name = NULL;
+    guint                 mux_id = QMI_DEVICE_MUX_ID_UNBOUND;
+    guint                 i = 0;
 
-    info.link_name = qmi_device_add_link_finish (device, res, &info.mux_id, &error);
-    if (!info.link_name) {
-        g_prefix_error (&error, "failed to add preallocated link (%u/%u) for device: ",
-                        ctx->preallocated_links->len + 1, DEFAULT_LINK_PREALLOCATED_AMOUNT);
-        g_task_return_error (task, error);
-        return;
+    self = ctx->self;
+    link_name = qmi_device_add_link_finish (device, res, &mux_id, &error);
+
+    /* If the pool was reset while adding (e.g. port closed), just cleanup */
+    if (ctx->preallocated_links != self->priv->preallocated_links) {
+        if (link_name)
+            qmi_device_delete_link (device, link_name, mux_id, NULL, NULL, NULL);
+        goto out;
+    }
+
+    info = lookup_preallocated_link (self, ctx->mux_id, PREALLOCATED_LINK_STATE_ADDING, &i);
+    g_assert (info);
+
+    if (!link_name) {
+        mm_obj_dbg (self, "failed to add preallocated link with mux id %u: %s", ctx->mux_id, error->message);
+        g_prefix_error (&error, "failed to add preallocated link for device: ");
+        g_array_remove_index (self->priv->preallocated_links, i);
+
+        /* Abort as many pending requests as can't be served by the links still
+         * being added */
+        abort_preallocated_links_setup_pending (self, error, count_preallocated_links (self, PREALLOCATED_LINK_STATE_ADDING));
+
+        /* If no links are left, reset the master so that a new initialization
+         * is attempted in the next request */
+        if (!self->priv->preallocated_links->len)
+            g_clear_object (&self->priv->preallocated_links_master);
+        goto out;
     }
 
-    g_array_append_val (ctx->preallocated_links, info);
-    initialize_preallocated_links_next (task);
+    mm_obj_dbg (self, "preallocated link added: %s (mux id %u)", link_name, mux_id);
+    info->link_name = g_steal_pointer (&link_name);
+    info->mux_id = mux_id;
+    info->state = PREALLOCATED_LINK_STATE_AVAILABLE;
+    complete_preallocated_links_setup_pending (self);
+
+out:
+    preallocated_link_operation_context_free (ctx);
+}
+
+static guint
+select_preallocated_link_mux_id (MMPortQmi *self)
+{
+    guint mux_id;
+
+    for (mux_id = QMI_DEVICE_MUX_ID_MIN; mux_id < QMI_DEVICE_MUX_ID_MAX; mux_id++) {
+        guint i;
+
+        for (i = 0; i < self->priv->preallocated_links->len; i++) {
+            if (g_array_index (self->priv->preallocated_links, PreallocatedLinkInfo, i).mux_id == mux_id)
+                break;
+        }
+        if (i == self->priv->preallocated_links->len)
+            break;
+    }
+    return mux_id;
 }
 
 static void
-initialize_preallocated_links_next (GTask *task)
+add_preallocated_links (MMPortQmi *self,
+                        guint      n_links)
 {
-    MMPortQmi                          *self;
-    InitializePreallocatedLinksContext *ctx;
+    guint i;
 
-    self = g_task_get_source_object (task);
-    ctx  = g_task_get_task_data (task);
+    /* All links are requested in parallel, each with its own mux id reserved
+     * in the pool so that no two operations ever use the same one */
+    for (i = 0; i < n_links; i++) {
+        PreallocatedLinkInfo info = { NULL, 0, PREALLOCATED_LINK_STATE_ADDING };
 
-    /* if we were closed while allocating, bad thing, abort */
-    if (!self->priv->qmi_device) {
-        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_ABORTED, "port is closed");
+        info.mux_id = select_preallocated_link_mux_id (self);
+        g_array_append_val (self->priv->preallocated_links, info);
+
+        mm_obj_dbg (self, "adding preallocated link with mux id %u (%u/%u)...",
+                    info.mux_id, self->priv->preallocated_links->len, MAX_LINK_PREALLOCATED_AMOUNT);
+        qmi_device_add_link (self->priv->qmi_device,
+                             info.mux_id,
+                             mm_kernel_device_get_name (mm_port_peek_kernel_device (self->priv->preallocated_links_master)),
+                             "ignored", /* n/a in qmi_wwan add_mux */
+                             NULL,
+                             (GAsyncReadyCallback) device_add_link_preallocated_ready,
+                             preallocated_link_operation_context_new (self, info.mux_id));
+    }
+}
+
+static void
+setup_preallocated_link (MMPortQmi *self,
+                         GTask     *task)
+{
+    SetupLinkContext *ctx;
+    guint             n_adding;
+
+    ctx = g_task_get_task_data (task);
+
+    if (!self->priv->preallocated_links_master)
+        self->priv->preallocated_links_master = g_object_ref (ctx->master);
+    else if ((ctx->master != self->priv->preallocated_links_master) &&
+             (g_strcmp0 (mm_port_get_device (ctx->master), mm_port_get_device (self->priv->preallocated_links_master)) != 0)) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                 "Preallocated links available in 'net/%s', not in 'net/%s'",
+                                 mm_port_get_device (self->priv->preallocated_links_master),
+                                 mm_port_get_device (ctx->master));
         g_object_unref (task);
         return;
     }
 
-    if (ctx->preallocated_links->len == DEFAULT_LINK_PREALLOCATED_AMOUNT) {
-        g_task_return_pointer (task, g_steal_pointer (&ctx->preallocated_links), (GDestroyNotify)g_array_unref);
+    if (!self->priv->preallocated_links) {
+        self->priv->preallocated_links = g_array_sized_new (FALSE, FALSE, sizeof (PreallocatedLinkInfo), DEFAULT_LINK_PREALLOCATED_AMOUNT);
+        g_array_set_clear_func (self->priv->preallocated_links, (GDestroyNotify)preallocated_link_info_clear);
+    }
+
+    if (acquire_preallocated_link (self, &ctx->link_name, &ctx->mux_id)) {
+        g_task_return_boolean (task, TRUE);
         g_object_unref (task);
         return;
     }
 
-    qmi_device_add_link (self->priv->qmi_device,
-                         ctx->preallocated_links->len + 1,
-                         mm_kernel_device_get_name (mm_port_peek_kernel_device (ctx->data)),
-                         "ignored", /* n/a in qmi_wwan add_mux */
-                         NULL,
-                         (GAsyncReadyCallback) device_add_link_preallocated_ready,
-                         task);
+    /* No link available right away; if there are not enough links being
+     * added to serve all pending requests, grow the pool */
+    n_adding = count_preallocated_links (self, PREALLOCATED_LINK_STATE_ADDING);
+    if (n_adding <= g_list_length (self->priv->preallocated_links_setup_pending)) {
+        if (self->priv->preallocated_links->len >= MAX_LINK_PREALLOCATED_AMOUNT) {
+            g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                                     "No more preallocated links available");
+            g_object_unref (task);
+            return;
+        }
+        /* Note: growing the pool may fail if the master interface is already
+         * up, as not all qmi_wwan versions allow add_mux in that state */
+        add_preallocated_links (self,
+                                self->priv->preallocated_links->len ? 1 : DEFAULT_LINK_PREALLOCATED_AMOUNT);
+    }
+
+    /* Queue our task for completion once a link is available */
+    self->priv->preallocated_links_setup_pending = g_list_append (self->priv->preallocated_links_setup_pending, task);
 }
 
 static void
-initialize_preallocated_links (MMPortQmi           *self,
-                               GAsyncReadyCallback  callback,
-                               gpointer             user_data)
+device_delete_link_preallocated_ready (QmiDevice                        *device,
+                                       GAsyncResult                     *res,
+                                       PreallocatedLinkOperationContext *ctx)
 {
-    InitializePreallocatedLinksContext *ctx;
-    GTask                              *task;
+    MMPortQmi            *self;
+    PreallocatedLinkInfo *info;
+    g_autoptr(GError)     error = NULL;
+    guint                 i = 0;
 
-    task = g_task_new (self, NULL, callback, user_data);
+    self = ctx->self;
 
-    ctx = g_slice_new0 (InitializePreallocatedLinksContext);
-    ctx->qmi_device = g_object_ref (self->priv->qmi_device);
-    ctx->data = g_object_ref (self->priv->preallocated_links_master);
-    ctx->preallocated_links = g_array_sized_new (FALSE, FALSE, sizeof (PreallocatedLinkInfo), DEFAULT_LINK_PREALLOCATED_AMOUNT);
-    g_array_set_clear_func (ctx->preallocated_links, (GDestroyNotify)preallocated_link_info_clear);
-    g_task_set_task_data (task, ctx, (GDestroyNotify)initialize_preallocated_links_context_free);
+    if (!qmi_device_delete_link_finish (device, res, &error))
+        mm_obj_dbg (self, "couldn't remove additional preallocated link with mux id %u: %s",
+                    ctx->mux_id, error->message);
 
-    initialize_preallocated_links_next (task);
-}
+    /* If the pool was reset meanwhile there is nothing else to do */
+    if (ctx->preallocated_links != self->priv->preallocated_links)
+        goto out;
 
-/*****************************************************************************/
+    info = lookup_preallocated_link (self, ctx->mux_id, PREALLOCATED_LINK_STATE_REMOVING, &i);
+    g_assert (info);
 
-typedef struct {
-    MMPort *master;
-    gchar  *link_name;
-    guint   mux_id;
-} SetupLinkContext;
+    /* If the link couldn't be removed (e.g. master interface up), keep it
+     * in the pool so that it can be reused */
+    if (error) {
+        info->state = PREALLOCATED_LINK_STATE_AVAILABLE;
+        complete_preallocated_links_setup_pending (self);
+    } else
+        g_array_remove_index (self->priv->preallocated_links, i);
 
-static void
-setup_link_context_free (SetupLinkContext *ctx)
+out:
+    preallocated_link_operation_context_free (ctx);
+}
+
+static gboolean
+release_preallocated_link (MMPortQmi    *self,
+                           const gchar  *link_name,
+                           guint         mux_id,
+                           GError     **error)
 {
-    g_free (ctx->link_name);
-    g_clear_object (&ctx->master);
-    g_slice_free (SetupLinkContext, ctx);
+    PreallocatedLinkInfo *info;
+    guint                 i = 0;
+
+    info = lookup_preallocated_link (self, mux_id, PREALLOCATED_LINK_STATE_SETUP, &i);
+    if (!info || (g_strcmp0 (info->link_name, link_name) != 0)) {
+        g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_FAILED,
+                     "No preallocated link found to release");
+        return FALSE;
+    }
+
+    /* If there are requests waiting for a link, hand this one over directly */
+    info->state = PREALLOCATED_LINK_STATE_AVAILABLE;
+    if (self->priv->preallocated_links_setup_pending) {
+        complete_preallocated_links_setup_pending (self);
+        return TRUE;
+    }
+
+    /* Shrink the pool back to its default size; the link (and its mux id)
+     * is kept in the pool until the deletion succeeds */
+    if ((self->priv->preallocated_links->len > DEFAULT_LINK_PREALLOCATED_AMOUNT) && self->priv->qmi_device) {
+        mm_obj_dbg (self, "removing additional preallocated link: %s (mux id %u)...", link_name, mux_id);
+        info->state = PREALLOCATED_LINK_STATE_REMOVING;
+        qmi_device_delete_link (self->priv->qmi_device,
+                                info->link_name,
+                                info->mux_id,
+                                NULL,
+                                (GAsyncReadyCallback) device_delete_link_preallocated_ready,
+                                preallocated_link_operation_context_new (self, mux_id));
+    }
+    return TRUE;
 }
 
+/*****************************************************************************/
+
 gchar *
 mm_port_qmi_setup_link_finish (MMPortQmi     *self,
                                GAsyncResult  *res,
@@ -561,56 +1003,6 @@ device_add_link_ready (QmiDevice    *device,
     g_object_unref (task);
 }
 
-static void
-setup_preallocated_link (GTask *task)
-{
-    MMPortQmi        *self;
-    SetupLinkContext *ctx;
-    GError           *error = NULL;
-
-    self = g_task_get_source_object (task);
-    ctx  = g_task_get_task_data (task);
-
-    if (!acquire_preallocated_link (self, ctx->master, &ctx->link_name, &ctx->mux_id, &error))
-        g_task_return_error (task, error);
-    else
-        g_task_return_boolean (task, TRUE);
-    g_object_unref (task);
-}
-
-static void
-initialize_preallocated_links_ready (MMPortQmi    *self,
-                                     GAsyncResult *res,
-                                     GTask        *task)
-{
-    g_autoptr(GError) error = NULL;
-
-    g_assert (!self->priv->preallocated_links);
-    self->priv->preallocated_links = initialize_preallocated_links_finish (self, res, &error);
-    if (!self->priv->preallocated_links) {
-        /* We need to fail this task and all the additional tasks also pending */
-        g_task_return_error (task, g_error_copy (error));
-        g_object_unref (task);
-        while (self->priv->preallocated_links_setup_pending) {
-            g_task_return_error (self->priv->preallocated_links_setup_pending->data, g_error_copy (error));
-            g_object_unref (self->priv->preallocated_links_setup_pending->data);
-            self->priv->preallocated_links_setup_pending = g_list_delete_link (self->priv->preallocated_links_setup_pending,
-                                                                               self->priv->preallocated_links_setup_pending);
-        }
-        /* and reset back the master, because we're not really initialized */
-        g_clear_object (&self->priv->preallocated_links_master);
-        return;
-    }
-
-    /* Now we know preallocated links are available, complete our task and all the pending ones */
-    setup_preallocated_link (task);
-    while (self->priv->preallocated_links_setup_pending) {
-        setup_preallocated_link (self->priv->preallocated_links_setup_pending->data);
-        self->priv->preallocated_links_setup_pending = g_list_delete_link (self->priv->preallocated_links_setup_pending,
-                                                                           self->priv->preallocated_links_setup_pending);
-    }
-}
-
 void
 mm_port_qmi_setup_link (MMPortQmi           *self,
                         MMPort              *data,
@@ -656,25 +1048,7 @@ mm_port_qmi_setup_link (MMPortQmi           *self,
     }
 
     /* For qmi_wwan, use preallocated links */
-    if (self->priv->preallocated_links) {
-        setup_preallocated_link (task);
-        return;
-    }
-
-    /* We must make sure we don't run this procedure in parallel (e.g. if multiple
-     * connection attempts reach at the same time), so if we're told the preallocated
-     * links are already being initialized (master is set) but the array didn't exist,
-     * queue our task for completion once we're fully initialized */
-    if (self->priv->preallocated_links_master) {
-        self->priv->preallocated_links_setup_pending = g_list_append (self->priv->preallocated_links_setup_pending, task);
-        return;
-    }
-
-    /* Store master to flag that we're initializing preallocated links */
-    self->priv->preallocated_links_master = g_object_ref (data);
-    initialize_preallocated_links (self,
-                                   (GAsyncReadyCallback) initialize_preallocated_links_ready,
-                                   task);
+    setup_preallocated_link (self, task);
 }
 
 /*****************************************************************************/
@@ -1173,10 +1547,13 @@ internal_setup_data_format_finish (MMPortQmi                      *self,
                 mm_obj_dbg (self, "rmnet link management supported: %u multiplexed bearers allowed",
                             *out_max_multiplexed_links);
             }
-            /* if multiplex backend may be qmi_wwan, the max preallocated amount :/  */
+            /* if multiplex backend may be qmi_wwan, the max preallocated amount; links
+             * beyond the initial pool are added on demand, and if the kernel refuses
+             * add_mux (e.g. master interface already up) the link setup fails and
+             * so does the connection of the bearer requesting it */
             else if ((mm_port_get_subsys (MM_PORT (self)) == MM_PORT_SUBSYS_USBMISC) &&
                      ctx->kernel_data_format_qmap_raw_ip_supported) {
-                *out_max_multiplexed_links = DEFAULT_LINK_PREALLOCATED_AMOUNT;
+                *out_max_multiplexed_links = MAX_LINK_PREALLOCATED_AMOUNT;
                 mm_obj_dbg (self, "qmi_wwan link management supported: %u multiplexed bearers allowed",
                             *out_max_multiplexed_links);
             } else {
@@ -1758,6 +2135,30 @@ mm_port_qmi_setup_data_format_finish (MMPortQmi                *self,
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
+static void
+setup_data_format_complete (MMPortQmi *self,
+                            GTask     *task,
+                            GError    *error)
+{
+    GList *pending;
+
+    /* Complete our task and all the ones requesting the same action that
+     * were queued while we were running */
+    pending = g_steal_pointer (&self->priv->setup_data_format_pending);
+    pending = g_list_prepend (pending, task);
+    self->priv->setup_data_format_in_progress = FALSE;
+
+    while (pending) {
+        if (error)
+            g_task_return_error (pending->data, g_error_copy (error));
+        else
+            g_task_return_boolean (pending->data, TRUE);
+        g_object_unref (pending->data);
+        pending = g_list_delete_link (pending, pending);
+    }
+    g_clear_error (&error);
+}
+
 static void
 internal_setup_data_format_ready (MMPortQmi    *self,
                                   GAsyncResult *res,
@@ -1765,17 +2166,14 @@ internal_setup_data_format_ready (MMPortQmi    *self,
 {
     GError *error = NULL;
 
-    if (!internal_setup_data_format_finish (self,
-                                            res,
-                                            &self->priv->kernel_data_format,
-                                            &self->priv->llp,
-                                            &self->priv->dap,
-                                            NULL, /* not expected to update */
-                                            &error))
-        g_task_return_error (task, error);
-    else
-        g_task_return_boolean (task, TRUE);
-    g_object_unref (task);
+    internal_setup_data_format_finish (self,
+                                       res,
+                                       &self->priv->kernel_data_format,
+                                       &self->priv->llp,
+                                       &self->priv->dap,
+                                       NULL, /* not expected to update */
+                                       &error);
+    setup_data_format_complete (self, task, error);
 }
 
 static void
@@ -1790,8 +2188,7 @@ setup_data_format_internal_reset_ready (MMPortQmi    *self,
 
     if (!internal_reset_finish (self, res, &error)) {
         g_prefix_error (&error, "Couldn't reset interface before setting up data format: ");
-        g_task_return_error (task, error);
-        g_object_unref (task);
+        setup_data_format_complete (self, task, error);
         return;
     }
 
@@ -1826,7 +2223,7 @@ count_links_setup (MMPortQmi *self,
         return links->len;
     }
 
-    return count_preallocated_links_setup (self);
+    return count_preallocated_links (self, PREALLOCATED_LINK_STATE_SETUP);
 }
 
 void
@@ -1857,6 +2254,21 @@ mm_port_qmi_setup_data_format (MMPortQmi                      *self,
         return;
     }
 
+    /* Multiple bearers may be connected in parallel, all of them requesting
+     * the same data format; if that is already being setup just wait for the
+     * ongoing operation instead of resetting the interface again */
+    if (self->priv->setup_data_format_in_progress) {
+        if (self->priv->setup_data_format_action != action) {
+            g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_IN_PROGRESS,
+                                     "A different data format setup is already in progress");
+            g_object_unref (task);
+            return;
+        }
+        mm_obj_dbg (self, "data format setup already in progress, waiting for it to finish...");
+        self->priv->setup_data_format_pending = g_list_append (self->priv->setup_data_format_pending, task);
+        return;
+    }
+
     if ((action == MM_PORT_QMI_SETUP_DATA_FORMAT_ACTION_SET_MULTIPLEX) &&
         (self->priv->kernel_data_format == QMI_DEVICE_EXPECTED_DATA_FORMAT_RAW_IP ||
          self->priv->kernel_data_format == QMI_DEVICE_EXPECTED_DATA_FORMAT_QMAP_PASS_THROUGH) &&
@@ -1900,6 +2312,8 @@ mm_port_qmi_setup_data_format (MMPortQmi                      *self,
     ctx->action = action;
     g_task_set_task_data (task, ctx, (GDestroyNotify)setup_data_format_context_free);
 
+    self->priv->setup_data_format_in_progress = TRUE;
+    self->priv->setup_data_format_action = action;
     internal_reset (self,
                     data,
                     ctx->device,
@@ -2399,11 +2813,7 @@ mm_port_qmi_close (MMPortQmi           *self,
     self->priv->services = NULL;
 
     /* Cleanup preallocated links, if any */
-    if (self->priv->preallocated_links) {
-        delete_preallocated_links (ctx->qmi_device, self->priv->preallocated_links);
-        g_clear_pointer (&self->priv->preallocated_links, g_array_unref);
-    }
-    g_clear_object (&self->priv->preallocated_links_master);
+    reset_preallocated_links (self, ctx->qmi_device);
 
     qmi_device_close_async (ctx->qmi_device,
                             5,
@@ -2463,10 +2873,7 @@ dispose (GObject *object)
     self->priv->services = NULL;
 
     /* Cleanup preallocated links, if any */
-    if (self->priv->preallocated_links && self->priv->qmi_device)
-        delete_preallocated_links (self->priv->qmi_device, self->priv->preallocated_links);
-    g_clear_pointer (&self->priv->preallocated_links, g_array_unref);
-    g_clear_object (&self->priv->preallocated_links_master);
+    reset_preallocated_links (self, self->priv->qmi_device);
 
     /* Clear device object */
     g_clear_object (&self->priv->qmi_device);
@@ -97,6 +97,64 @@ QmiClient *mm_port_qmi_get_client  (MMPortQmi *self,
 
 QmiDevice *mm_port_qmi_peek_device (MMPortQmi *self);
 
+/* Batch of independent requests sent at once, each one through the client
+ * of its service already allocated in the port; each reply is reported
+ * separately, so that a failure in one of them doesn't affect the others.
+ * The result of each request is its typed output message, only available
+ * if the request succeeded (i.e. the output reports a successful result). */
+typedef struct _MMPortQmiBatch MMPortQmiBatch;
+
+typedef void     (* MMPortQmiBatchSendFunc)      (QmiClient            *client,
+                                                  gpointer              input,
+                                                  guint                 timeout,
+                                                  GCancellable         *cancellable,
+                                                  GAsyncReadyCallback   callback,
+                                                  gpointer              user_data);
+typedef gpointer (* MMPortQmiBatchFinishFunc)    (QmiClient            *client,
+                                                  GAsyncResult         *res,
+                                                  GError              **error);
+typedef gboolean (* MMPortQmiBatchGetResultFunc) (gpointer              output,
+                                                  GError              **error);
+
+typedef struct {
+    QmiService                  service;
+    MMPortQmiBatchSendFunc      send;
+    MMPortQmiBatchFinishFunc    finish;
+    MMPortQmiBatchGetResultFunc get_result;
+    GDestroyNotify              output_unref;
+} MMPortQmiBatchRequest;
+
+/* Request without input built from the libqmi generated methods, e.g.
+ * MM_PORT_QMI_BATCH_REQUEST (DMS, dms, get_model) */
+#define MM_PORT_QMI_BATCH_REQUEST(SERVICE, service, method) {                                   \
+        QMI_SERVICE_##SERVICE,                                                                   \
+        (MMPortQmiBatchSendFunc)      qmi_client_##service##_##method,                           \
+        (MMPortQmiBatchFinishFunc)    qmi_client_##service##_##method##_finish,                  \
+        (MMPortQmiBatchGetResultFunc) qmi_message_##service##_##method##_output_get_result,      \
+        (GDestroyNotify)              qmi_message_##service##_##method##_output_unref            \
+    }
+
+void            mm_port_qmi_command_batch        (MMPortQmi                   *self,
+                                                  const MMPortQmiBatchRequest *requests,
+                                                  guint                        n_requests,
+                                                  guint                        timeout,
+                                                  GCancellable                *cancellable,
+                                                  GAsyncReadyCallback          callback,
+                                                  gpointer                     user_data);
+MMPortQmiBatch *mm_port_qmi_command_batch_finish (MMPortQmi                   *self,
+                                                  GAsyncResult                *res,
+                                                  GError                     **error);
+
+guint           mm_port_qmi_batch_get_n_requests (MMPortQmiBatch              *batch);
+guint           mm_port_qmi_batch_get_n_failed   (MMPortQmiBatch              *batch);
+/* Transfers the output of the given request (or its error) to the caller;
+ * each output can only be taken once. */
+gpointer        mm_port_qmi_batch_take_output    (MMPortQmiBatch              *batch,
+                                                  guint                        i,
+                                                  GError                     **error);
+void            mm_port_qmi_batch_free           (MMPortQmiBatch              *batch);
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (MMPortQmiBatch, mm_port_qmi_batch_free)
+
 QmiDataEndpointType mm_port_qmi_get_endpoint_type             (MMPortQmi *self);
 guint               mm_port_qmi_get_endpoint_interface_number (MMPortQmi *self);
 
@@ -434,6 +434,71 @@ mm_port_serial_at_command (MMPortSerialAt *self,
     g_byte_array_unref (buf);
 }
 
+/* Commands are classified by their name and type, e.g. "+CSQ", "+COPS?" or
+ * "+COPS=?". Set commands also include their arguments, e.g. "+COPS=0" and
+ * "+COPS=3,2" are different classes, as their reply times have nothing in
+ * common; and they never get an adaptive timeout, because how long they take
+ * depends on the operation requested, not only on the port. Same for the
+ * dial and answer commands. Raw commands are not classified. */
+#define COMMAND_CLASS_MAX_LEN 32
+
+gchar *
+mm_port_serial_at_command_class (const GByteArray *command,
+                                 gboolean         *adaptive_timeout)
+{
+    GString  *key;
+    gboolean  set = FALSE;
+    guint     i;
+
+    if (command->len < 2 || g_ascii_strncasecmp ((const gchar *) command->data, "AT", 2) != 0)
+        return NULL;
+
+    if (command->len > 2 && (g_ascii_toupper (command->data[2]) == 'D' || g_ascii_toupper (command->data[2]) == 'A'))
+        *adaptive_timeout = FALSE;
+
+    key = g_string_sized_new (COMMAND_CLASS_MAX_LEN);
+    for (i = 2; i < command->len && key->len < COMMAND_CLASS_MAX_LEN; i++) {
+        gchar c = (gchar) command->data[i];
+
+        if (c == '\r' || c == '\n' || c == ';')
+            break;
+        if (set) {
+            /* Arguments are kept as given, e.g. APN names are case sensitive */
+            g_string_append_c (key, c);
+            continue;
+        }
+        if (c == '=') {
+            g_string_append_c (key, c);
+            if (i + 1 < command->len && command->data[i + 1] == '?') {
+                g_string_append_c (key, '?');
+                break;
+            }
+            set = TRUE;
+            *adaptive_timeout = FALSE;
+            continue;
+        }
+        if (c == '?') {
+            g_string_append_c (key, c);
+            break;
+        }
+        g_string_append_c (key, g_ascii_toupper (c));
+    }
+
+    /* Plain "AT" */
+    if (!key->len)
+        g_string_append (key, "AT");
+
+    return g_string_free (key, FALSE);
+}
+
+static gchar *
+command_class (MMPortSerial     *self,
+               const GByteArray *command,
+               gboolean         *adaptive_timeout)
+{
+    return mm_port_serial_at_command_class (command, adaptive_timeout);
+}
+
 static void
 debug_log (MMPortSerial *self,
            const gchar  *prefix,
@@ -649,6 +714,7 @@ mm_port_serial_at_class_init (MMPortSerialAtClass *klass)
     serial_class->parse_unsolicited = parse_unsolicited;
     serial_class->parse_response = parse_response;
     serial_class->debug_log = debug_log;
+    serial_class->command_class = command_class;
     serial_class->config = config;
 
     g_object_class_install_property
@@ -119,7 +119,9 @@ const gchar *mm_port_serial_at_command_finish (MMPortSerialAt *self,
 gchar   *mm_port_serial_at_quote_string (const char *string);
 
 /* Just for unit tests */
-void     mm_port_serial_at_remove_echo (GByteArray *response);
+void     mm_port_serial_at_remove_echo   (GByteArray       *response);
+gchar   *mm_port_serial_at_command_class (const GByteArray *command,
+                                          gboolean         *adaptive_timeout);
 
 void     mm_port_serial_at_set_flags (MMPortSerialAt *self,
                                       MMPortSerialAtFlag flags);
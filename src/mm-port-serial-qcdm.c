@@ -32,7 +32,10 @@
 G_DEFINE_TYPE (MMPortSerialQcdm, mm_port_serial_qcdm, MM_TYPE_PORT_SERIAL)
 
 struct _MMPortSerialQcdmPrivate {
-    GSList *unsolicited_msg_handlers;
+    /* log code -> MMQcdmUnsolicitedMsgHandler */
+    GHashTable *unsolicited_msg_handlers;
+    /* handlers with log items pending to be reported in batch */
+    GPtrArray *unsolicited_msg_batches;
 };
 
 /*****************************************************************************/
@@ -79,7 +82,7 @@ parse_qcdm (GByteArray *response,
     gsize start = 0;
     gsize used = 0;
     gsize unescaped_len = 0;
-    guint8 *unescaped_buffer;
+    guint8 unescaped_buffer[1024];
     qcdmbool more = FALSE;
 
     /* Get the offset into the buffer of where the QCDM frame starts */
@@ -95,12 +98,12 @@ parse_qcdm (GByteArray *response,
     if (response->len == 0)
         return MM_PORT_SERIAL_RESPONSE_NONE;
 
-    /* Try to decapsulate the response into a buffer */
-    unescaped_buffer = g_malloc (1024);
+    /* Try to decapsulate the response into a buffer; only allocate once we
+     * know we got a full frame to report */
     if (!dm_decapsulate_buffer ((const char *)(response->data),
                                 response->len,
                                 (char *)unescaped_buffer,
-                                1024,
+                                sizeof (unescaped_buffer),
                                 &unescaped_len,
                                 &used,
                                 &more)) {
@@ -111,14 +114,12 @@ parse_qcdm (GByteArray *response,
                      MM_SERIAL_ERROR,
                      MM_SERIAL_ERROR_PARSE_FAILED,
                      "Failed to unescape QCDM packet");
-        g_free (unescaped_buffer);
         return MM_PORT_SERIAL_RESPONSE_ERROR;
     }
 
     if (more) {
         /* Need more data, we leave the original byte array untouched so that
          * we can retry later when more data arrives. */
-        g_free (unescaped_buffer);
         return MM_PORT_SERIAL_RESPONSE_NONE;
     }
 
@@ -126,15 +127,14 @@ parse_qcdm (GByteArray *response,
         /* If we only want log items and this isn't one, don't remove this
          * DM packet from the buffer.
          */
-        g_free (unescaped_buffer);
         return MM_PORT_SERIAL_RESPONSE_NONE;
     }
 
     /* Successfully decapsulated the DM command. We'll build a new byte array
      * with the response, and leave the input buffer cleaned up. */
-    g_assert (unescaped_len <= 1024);
-    unescaped_buffer = g_realloc (unescaped_buffer, unescaped_len);
-    *parsed_response = g_byte_array_new_take (unescaped_buffer, unescaped_len);
+    g_assert (unescaped_len <= sizeof (unescaped_buffer));
+    *parsed_response = g_byte_array_sized_new (unescaped_len);
+    g_byte_array_append (*parsed_response, unescaped_buffer, unescaped_len);
 
     /* Remove the data we used from the input buffer, leaving out any
      * additional data that may already been received (e.g. from the following
@@ -205,6 +205,23 @@ mm_port_serial_qcdm_command (MMPortSerialQcdm *self,
                             task);
 }
 
+/* Commands are classified by their DIAG command code */
+static gchar *
+command_class (MMPortSerial     *self,
+               const GByteArray *command,
+               gboolean         *adaptive_timeout)
+{
+    guint i = 0;
+
+    /* Skip the optional leading frame marker */
+    while (i < command->len && command->data[i] == 0x7E)
+        i++;
+    if (i == command->len)
+        return NULL;
+
+    return g_strdup_printf ("diag-0x%02x", command->data[i]);
+}
+
 static void
 debug_log (MMPortSerial *self,
            const gchar  *prefix,
@@ -231,49 +248,86 @@ debug_log (MMPortSerial *self,
 typedef struct {
     guint log_code;
     MMPortSerialQcdmUnsolicitedMsgFn callback;
+    MMPortSerialQcdmUnsolicitedMsgBatchFn batch_callback;
     gboolean enable;
     gpointer user_data;
     GDestroyNotify notify;
+    /* Log items received but not yet reported to the batch callback */
+    GPtrArray *pending;
 } MMQcdmUnsolicitedMsgHandler;
 
-static gint
-unsolicited_msg_handler_cmp (MMQcdmUnsolicitedMsgHandler *handler,
-                             gpointer log_code)
+static void
+unsolicited_msg_handler_free (MMQcdmUnsolicitedMsgHandler *handler)
 {
-    return handler->log_code - GPOINTER_TO_UINT (log_code);
+    if (handler->notify)
+        handler->notify (handler->user_data);
+    if (handler->pending)
+        g_ptr_array_unref (handler->pending);
+    g_slice_free (MMQcdmUnsolicitedMsgHandler, handler);
 }
 
-void
-mm_port_serial_qcdm_add_unsolicited_msg_handler (MMPortSerialQcdm *self,
-                                                 guint log_code,
-                                                 MMPortSerialQcdmUnsolicitedMsgFn callback,
-                                                 gpointer user_data,
-                                                 GDestroyNotify notify)
+static MMQcdmUnsolicitedMsgHandler *
+unsolicited_msg_handler_setup (MMPortSerialQcdm *self,
+                               guint log_code,
+                               gpointer user_data,
+                               GDestroyNotify notify)
 {
-    GSList *existing;
     MMQcdmUnsolicitedMsgHandler *handler;
 
-    g_return_if_fail (MM_IS_PORT_SERIAL_QCDM (self));
-    g_return_if_fail (log_code > 0 && log_code <= G_MAXUINT16);
-
-    existing = g_slist_find_custom (self->priv->unsolicited_msg_handlers,
-                                    GUINT_TO_POINTER (log_code),
-                                    (GCompareFunc)unsolicited_msg_handler_cmp);
-    if (existing) {
-        handler = existing->data;
+    handler = g_hash_table_lookup (self->priv->unsolicited_msg_handlers, GUINT_TO_POINTER (log_code));
+    if (handler) {
         /* We OVERWRITE any existing one, so if any context data existing, free it */
         if (handler->notify)
             handler->notify (handler->user_data);
+        /* Items pending for the previous callback are discarded */
+        if (handler->pending)
+            g_ptr_array_set_size (handler->pending, 0);
     } else {
-        handler = g_slice_new (MMQcdmUnsolicitedMsgHandler);
-        self->priv->unsolicited_msg_handlers = g_slist_append (self->priv->unsolicited_msg_handlers, handler);
+        handler = g_slice_new0 (MMQcdmUnsolicitedMsgHandler);
         handler->log_code = log_code;
+        g_hash_table_insert (self->priv->unsolicited_msg_handlers, GUINT_TO_POINTER (log_code), handler);
     }
 
-    handler->callback = callback;
+    handler->callback = NULL;
+    handler->batch_callback = NULL;
     handler->enable = TRUE;
     handler->user_data = user_data;
     handler->notify = notify;
+    return handler;
+}
+
+void
+mm_port_serial_qcdm_add_unsolicited_msg_handler (MMPortSerialQcdm *self,
+                                                 guint log_code,
+                                                 MMPortSerialQcdmUnsolicitedMsgFn callback,
+                                                 gpointer user_data,
+                                                 GDestroyNotify notify)
+{
+    MMQcdmUnsolicitedMsgHandler *handler;
+
+    g_return_if_fail (MM_IS_PORT_SERIAL_QCDM (self));
+    g_return_if_fail (log_code > 0 && log_code <= G_MAXUINT16);
+
+    handler = unsolicited_msg_handler_setup (self, log_code, user_data, notify);
+    handler->callback = callback;
+}
+
+void
+mm_port_serial_qcdm_add_unsolicited_msg_batch_handler (MMPortSerialQcdm *self,
+                                                       guint log_code,
+                                                       MMPortSerialQcdmUnsolicitedMsgBatchFn callback,
+                                                       gpointer user_data,
+                                                       GDestroyNotify notify)
+{
+    MMQcdmUnsolicitedMsgHandler *handler;
+
+    g_return_if_fail (MM_IS_PORT_SERIAL_QCDM (self));
+    g_return_if_fail (log_code > 0 && log_code <= G_MAXUINT16);
+
+    handler = unsolicited_msg_handler_setup (self, log_code, user_data, notify);
+    handler->batch_callback = callback;
+    if (callback && !handler->pending)
+        handler->pending = g_ptr_array_new_with_free_func ((GDestroyNotify) g_byte_array_unref);
 }
 
 void
@@ -281,19 +335,32 @@ mm_port_serial_qcdm_enable_unsolicited_msg_handler (MMPortSerialQcdm *self,
                                                     guint log_code,
                                                     gboolean enable)
 {
-    GSList *existing;
     MMQcdmUnsolicitedMsgHandler *handler;
 
     g_return_if_fail (MM_IS_PORT_SERIAL_QCDM (self));
     g_return_if_fail (log_code > 0 && log_code <= G_MAXUINT16);
 
-    existing = g_slist_find_custom (self->priv->unsolicited_msg_handlers,
-                                    GUINT_TO_POINTER (log_code),
-                                    (GCompareFunc)unsolicited_msg_handler_cmp);
-    if (existing) {
-        handler = existing->data;
+    handler = g_hash_table_lookup (self->priv->unsolicited_msg_handlers, GUINT_TO_POINTER (log_code));
+    if (handler)
         handler->enable = enable;
+}
+
+static void
+flush_unsolicited_msg_batches (MMPortSerialQcdm *self)
+{
+    guint i;
+
+    for (i = 0; i < self->priv->unsolicited_msg_batches->len; i++) {
+        MMQcdmUnsolicitedMsgHandler *handler;
+
+        handler = g_ptr_array_index (self->priv->unsolicited_msg_batches, i);
+        /* The handler may have been updated while processing other batches */
+        if (handler->batch_callback && handler->pending->len > 0)
+            handler->batch_callback (self, handler->pending, handler->user_data);
+        if (handler->pending)
+            g_ptr_array_set_size (handler->pending, 0);
     }
+    g_ptr_array_set_size (self->priv->unsolicited_msg_batches, 0);
 }
 
 static void
@@ -301,34 +368,39 @@ parse_unsolicited (MMPortSerial *port, GByteArray *response)
 {
     MMPortSerialQcdm *self = MM_PORT_SERIAL_QCDM (port);
     GByteArray *log_buffer = NULL;
-    GSList *iter;
-
-    if (parse_qcdm (response,
-                    TRUE,
-                    &log_buffer,
-                    NULL) != MM_PORT_SERIAL_RESPONSE_BUFFER) {
-        return;
-    }
-
-    /* These should be guaranteed by parse_qcdm() */
-    g_return_if_fail (log_buffer);
-    g_return_if_fail (log_buffer->len > 0);
-    g_return_if_fail (log_buffer->data[0] == DIAG_CMD_LOG);
 
-    if (log_buffer->len < sizeof (DMCmdLog))
-        return;
+    /* Process all log items already available in the buffer, not just the
+     * first one, so that a burst of items is handled in a single pass and
+     * batch handlers get them all at once */
+    while (parse_qcdm (response, TRUE, &log_buffer, NULL) == MM_PORT_SERIAL_RESPONSE_BUFFER) {
+        MMQcdmUnsolicitedMsgHandler *handler;
+        DMCmdLog *log_cmd;
 
-    for (iter = self->priv->unsolicited_msg_handlers; iter; iter = iter->next) {
-        MMQcdmUnsolicitedMsgHandler *handler = (MMQcdmUnsolicitedMsgHandler *) iter->data;
-        DMCmdLog *log_cmd = (DMCmdLog *) log_buffer->data;
+        /* These should be guaranteed by parse_qcdm() */
+        g_assert (log_buffer && log_buffer->len > 0);
+        g_assert (log_buffer->data[0] == DIAG_CMD_LOG);
 
-        if (!handler->enable)
+        if (log_buffer->len < sizeof (DMCmdLog)) {
+            g_clear_pointer (&log_buffer, g_byte_array_unref);
             continue;
-        if (handler->log_code != le16toh (log_cmd->log_code))
-            continue;
-        if (handler->callback)
-            handler->callback (self, log_buffer, handler->user_data);
+        }
+
+        log_cmd = (DMCmdLog *) log_buffer->data;
+        handler = g_hash_table_lookup (self->priv->unsolicited_msg_handlers,
+                                       GUINT_TO_POINTER ((guint) le16toh (log_cmd->log_code)));
+        if (handler && handler->enable) {
+            if (handler->callback)
+                handler->callback (self, log_buffer, handler->user_data);
+            else if (handler->batch_callback) {
+                if (handler->pending->len == 0)
+                    g_ptr_array_add (self->priv->unsolicited_msg_batches, handler);
+                g_ptr_array_add (handler->pending, g_steal_pointer (&log_buffer));
+            }
+        }
+        g_clear_pointer (&log_buffer, g_byte_array_unref);
     }
+
+    flush_unsolicited_msg_batches (self);
 }
 
 /*****************************************************************************/
@@ -383,6 +455,11 @@ static void
 mm_port_serial_qcdm_init (MMPortSerialQcdm *self)
 {
     self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self, MM_TYPE_PORT_SERIAL_QCDM, MMPortSerialQcdmPrivate);
+    self->priv->unsolicited_msg_handlers = g_hash_table_new_full (g_direct_hash,
+                                                                  g_direct_equal,
+                                                                  NULL,
+                                                                  (GDestroyNotify) unsolicited_msg_handler_free);
+    self->priv->unsolicited_msg_batches = g_ptr_array_new ();
 }
 
 static void
@@ -390,16 +467,8 @@ finalize (GObject *object)
 {
     MMPortSerialQcdm *self = MM_PORT_SERIAL_QCDM (object);
 
-    while (self->priv->unsolicited_msg_handlers) {
-        MMQcdmUnsolicitedMsgHandler *handler = (MMQcdmUnsolicitedMsgHandler *) self->priv->unsolicited_msg_handlers->data;
-
-        if (handler->notify)
-            handler->notify (handler->user_data);
-
-        g_slice_free (MMQcdmUnsolicitedMsgHandler, handler);
-        self->priv->unsolicited_msg_handlers = g_slist_delete_link (self->priv->unsolicited_msg_handlers,
-                                                                    self->priv->unsolicited_msg_handlers);
-    }
+    g_ptr_array_unref (self->priv->unsolicited_msg_batches);
+    g_hash_table_unref (self->priv->unsolicited_msg_handlers);
 
     G_OBJECT_CLASS (mm_port_serial_qcdm_parent_class)->finalize (object);
 }
@@ -418,4 +487,5 @@ mm_port_serial_qcdm_class_init (MMPortSerialQcdmClass *klass)
     port_class->parse_response = parse_response;
     port_class->config_fd = config_fd;
     port_class->debug_log = debug_log;
+    port_class->command_class = command_class;
 }
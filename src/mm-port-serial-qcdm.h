@@ -69,6 +69,19 @@ void     mm_port_serial_qcdm_add_unsolicited_msg_handler (MMPortSerialQcdm *self
                                                           gpointer user_data,
                                                           GDestroyNotify notify);
 
+/* Batch handlers get all the log items with the given code that were
+ * received in the same read from the port. The array is owned by the port
+ * and only valid during the callback. */
+typedef void (*MMPortSerialQcdmUnsolicitedMsgBatchFn) (MMPortSerialQcdm *port,
+                                                       GPtrArray *log_buffers,
+                                                       gpointer user_data);
+
+void     mm_port_serial_qcdm_add_unsolicited_msg_batch_handler (MMPortSerialQcdm *self,
+                                                                guint log_code,
+                                                                MMPortSerialQcdmUnsolicitedMsgBatchFn callback,
+                                                                gpointer user_data,
+                                                                GDestroyNotify notify);
+
 void     mm_port_serial_qcdm_enable_unsolicited_msg_handler (MMPortSerialQcdm *self,
                                                              guint log_code,
                                                              gboolean enable);
@@ -75,6 +75,17 @@ static guint signals[LAST_SIGNAL] = { 0 };
 
 #define SERIAL_BUF_SIZE 2048
 
+/* Once a port has timed out, commands of a class with at least this number of
+ * latency samples get an adaptive timeout instead of the static one given by
+ * the caller, so that a wedged port is detected early. Classes flagged as not
+ * suitable for adaptive timeouts (e.g. AT set commands) always get the static
+ * one, as a reply arriving after the command is failed would be matched to
+ * the next command in the queue. */
+#define ADAPTIVE_TIMEOUT_MIN_SAMPLES 5
+#define ADAPTIVE_TIMEOUT_MIN_MS      2000
+/* Limit the amount of different command classes tracked */
+#define LATENCY_STATS_MAX_CLASSES    64
+
 struct _MMPortSerialPrivate {
     guint32 open_count;
     gboolean forced_close;
@@ -109,6 +120,10 @@ struct _MMPortSerialPrivate {
 
     guint n_consecutive_timeouts;
 
+    /* Observed response latencies, per command class and port-wide */
+    GHashTable *latency_stats;
+    MMPortSerialLatencyStats latency_stats_all;
+
     guint connected_id;
 
     GTask *flash_task;
@@ -130,6 +145,11 @@ typedef struct {
     guint32 idx;
     gboolean started;
     gboolean done;
+
+    /* Latency tracking, set once fully sent */
+    gchar *class_key;
+    gboolean adaptive_timeout;
+    gint64 sent_time;
 } CommandContext;
 
 static void
@@ -143,6 +163,7 @@ command_context_complete_and_free (CommandContext *ctx, gboolean idle)
     g_byte_array_unref (ctx->command);
     if (ctx->cancellable)
         g_object_unref (ctx->cancellable);
+    g_free (ctx->class_key);
     g_object_unref (ctx->self);
     g_slice_free (CommandContext, ctx);
 }
@@ -688,6 +709,191 @@ port_serial_get_cached_reply (MMPortSerial *self,
     return (const GByteArray *)g_hash_table_lookup (self->priv->reply_cache, command);
 }
 
+/*****************************************************************************/
+/* Response latency statistics */
+
+static MMPortSerialLatencyStats *
+port_serial_lookup_latency_stats (MMPortSerial *self,
+                                  const gchar  *class_key,
+                                  gboolean      create)
+{
+    MMPortSerialLatencyStats *stats;
+
+    if (!class_key)
+        return NULL;
+
+    stats = g_hash_table_lookup (self->priv->latency_stats, class_key);
+    if (!stats && create && g_hash_table_size (self->priv->latency_stats) < LATENCY_STATS_MAX_CLASSES) {
+        stats = g_slice_new0 (MMPortSerialLatencyStats);
+        g_hash_table_insert (self->priv->latency_stats, g_strdup (class_key), stats);
+    }
+    return stats;
+}
+
+void
+mm_port_serial_latency_stats_add_sample (MMPortSerialLatencyStats *stats,
+                                         guint                     latency_ms)
+{
+    if (!stats->n_samples) {
+        stats->srtt_ms   = latency_ms;
+        stats->rttvar_ms = latency_ms / 2.0;
+    } else {
+        stats->rttvar_ms = (0.75 * stats->rttvar_ms) + (0.25 * ABS (stats->srtt_ms - latency_ms));
+        stats->srtt_ms   = (0.875 * stats->srtt_ms) + (0.125 * latency_ms);
+    }
+    stats->max_ms = MAX (stats->max_ms, latency_ms);
+    stats->n_samples++;
+}
+
+static void
+port_serial_record_latency (MMPortSerial   *self,
+                            CommandContext *ctx)
+{
+    MMPortSerialLatencyStats *stats;
+    guint                     latency_ms;
+
+    /* Only commands fully sent have a latency */
+    if (!ctx || !ctx->sent_time)
+        return;
+
+    latency_ms = (guint) ((g_get_monotonic_time () - ctx->sent_time) / 1000);
+    mm_port_serial_latency_stats_add_sample (&self->priv->latency_stats_all, latency_ms);
+    stats = port_serial_lookup_latency_stats (self, ctx->class_key, TRUE);
+    if (stats)
+        mm_port_serial_latency_stats_add_sample (stats, latency_ms);
+}
+
+static void
+port_serial_record_timeout (MMPortSerial   *self,
+                            CommandContext *ctx)
+{
+    MMPortSerialLatencyStats *stats;
+
+    if (!ctx)
+        return;
+
+    self->priv->latency_stats_all.n_timeouts++;
+    stats = port_serial_lookup_latency_stats (self, ctx->class_key, TRUE);
+    if (stats)
+        stats->n_timeouts++;
+}
+
+guint
+mm_port_serial_latency_stats_get_adaptive_timeout (const MMPortSerialLatencyStats *stats,
+                                                   guint                           static_timeout_ms)
+{
+    guint adaptive_timeout_ms;
+
+    if (stats->n_samples < ADAPTIVE_TIMEOUT_MIN_SAMPLES)
+        return static_timeout_ms;
+
+    adaptive_timeout_ms = (guint) (stats->srtt_ms + (4 * stats->rttvar_ms));
+    /* Never above the static timeout requested by the caller, even if it is
+     * below the minimum */
+    if (adaptive_timeout_ms < ADAPTIVE_TIMEOUT_MIN_MS)
+        adaptive_timeout_ms = ADAPTIVE_TIMEOUT_MIN_MS;
+    return MIN (adaptive_timeout_ms, static_timeout_ms);
+}
+
+/* Timeout to use while waiting for the response of the given command, in ms */
+static guint
+port_serial_get_response_timeout (MMPortSerial   *self,
+                                  CommandContext *ctx)
+{
+    MMPortSerialLatencyStats *stats;
+    guint                     static_timeout_ms;
+    guint                     adaptive_timeout_ms;
+
+    static_timeout_ms = ctx->timeout * 1000;
+
+    /* While the port is behaving, always honour the static timeout requested
+     * by the caller; some commands (e.g. network scans) are expected to take
+     * much longer than usual now and then. */
+    if (!self->priv->n_consecutive_timeouts || !ctx->adaptive_timeout)
+        return static_timeout_ms;
+
+    /* The port may be wedged: don't wait much longer than the time this class
+     * of command usually takes to reply before reporting another timeout. */
+    stats = port_serial_lookup_latency_stats (self, ctx->class_key, FALSE);
+    if (!stats)
+        return static_timeout_ms;
+
+    adaptive_timeout_ms = mm_port_serial_latency_stats_get_adaptive_timeout (stats, static_timeout_ms);
+    if (adaptive_timeout_ms < static_timeout_ms)
+        mm_obj_dbg (self, "port timed out %u consecutive times: waiting %ums instead of %ums for '%s' reply",
+                    self->priv->n_consecutive_timeouts, adaptive_timeout_ms, static_timeout_ms, ctx->class_key);
+    return adaptive_timeout_ms;
+}
+
+static void
+latency_stats_log (MMPortSerial                   *self,
+                   const gchar                    *class_key,
+                   const MMPortSerialLatencyStats *stats)
+{
+    if (!stats->n_samples) {
+        mm_obj_dbg (self, "  %-16s: no replies, %u timeouts", class_key, stats->n_timeouts);
+        return;
+    }
+
+    mm_obj_dbg (self, "  %-16s: %u replies, %u timeouts, latency avg %.0fms dev %.0fms max %ums",
+                class_key,
+                stats->n_samples,
+                stats->n_timeouts,
+                stats->srtt_ms,
+                stats->rttvar_ms,
+                stats->max_ms);
+}
+
+void
+mm_port_serial_log_latency_stats (MMPortSerial *self)
+{
+    GHashTableIter            iter;
+    const gchar              *class_key;
+    MMPortSerialLatencyStats *stats;
+
+    g_return_if_fail (MM_IS_PORT_SERIAL (self));
+
+    if (!self->priv->latency_stats_all.n_samples && !self->priv->latency_stats_all.n_timeouts)
+        return;
+
+    mm_obj_dbg (self, "response latency statistics:");
+    latency_stats_log (self, "all", &self->priv->latency_stats_all);
+    g_hash_table_iter_init (&iter, self->priv->latency_stats);
+    while (g_hash_table_iter_next (&iter, (gpointer *)&class_key, (gpointer *)&stats))
+        latency_stats_log (self, class_key, stats);
+}
+
+static GVariant *
+latency_stats_variant (const MMPortSerialLatencyStats *stats)
+{
+    return g_variant_new ("(uuddu)",
+                          stats->n_samples,
+                          stats->n_timeouts,
+                          stats->srtt_ms,
+                          stats->rttvar_ms,
+                          stats->max_ms);
+}
+
+GVariant *
+mm_port_serial_get_latency_stats (MMPortSerial *self)
+{
+    GVariantBuilder                 builder;
+    GHashTableIter                  iter;
+    const gchar                    *class_key;
+    const MMPortSerialLatencyStats *stats;
+
+    g_return_val_if_fail (MM_IS_PORT_SERIAL (self), NULL);
+
+    g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{s(uuddu)}"));
+    g_variant_builder_add (&builder, "{s@(uuddu)}", "all", latency_stats_variant (&self->priv->latency_stats_all));
+    g_hash_table_iter_init (&iter, self->priv->latency_stats);
+    while (g_hash_table_iter_next (&iter, (gpointer *)&class_key, (gpointer *)&stats))
+        g_variant_builder_add (&builder, "{s@(uuddu)}", class_key, latency_stats_variant (stats));
+    return g_variant_builder_end (&builder);
+}
+
+/*****************************************************************************/
+
 static void
 port_serial_schedule_queue_process (MMPortSerial *self, guint timeout_ms)
 {
@@ -771,6 +977,7 @@ port_serial_timed_out (gpointer data)
 
     /* Update number of consecutive timeouts found */
     self->priv->n_consecutive_timeouts++;
+    port_serial_record_timeout (self, (CommandContext *) g_queue_peek_head (self->priv->queue));
 
     /* FIXME: This is not completely correct - if the response finally arrives and there's
      * some other command waiting for response right now, the other command will
@@ -885,10 +1092,27 @@ port_serial_queue_process (gpointer data)
         self->priv->cancellable_id = cancellable_id;
     }
 
-    /* If the command is finished being sent, schedule the timeout */
-    self->priv->timeout_id = g_timeout_add_seconds (ctx->timeout,
+    /* The command is finished being sent, start measuring the reply latency */
+    ctx->sent_time = g_get_monotonic_time ();
+    if (!ctx->class_key && MM_PORT_SERIAL_GET_CLASS (self)->command_class) {
+        ctx->adaptive_timeout = TRUE;
+        ctx->class_key = MM_PORT_SERIAL_GET_CLASS (self)->command_class (self, ctx->command, &ctx->adaptive_timeout);
+    }
+
+    /* Schedule the timeout; the static one unless the port seems wedged */
+    {
+        guint timeout_ms;
+
+        timeout_ms = port_serial_get_response_timeout (self, ctx);
+        if (timeout_ms == ctx->timeout * 1000)
+            self->priv->timeout_id = g_timeout_add_seconds (ctx->timeout,
+                                                            port_serial_timed_out,
+                                                            self);
+        else
+            self->priv->timeout_id = g_timeout_add (timeout_ms,
                                                     port_serial_timed_out,
                                                     self);
+    }
     return G_SOURCE_REMOVE;
 }
 
@@ -922,6 +1146,7 @@ parse_response_buffer (MMPortSerial *self)
         /* We have a valid response to process */
         g_assert (parsed_response);
         self->priv->n_consecutive_timeouts = 0;
+        port_serial_record_latency (self, (CommandContext *) g_queue_peek_head (self->priv->queue));
         /* Note: may complete last operation and unref the MMPortSerial */
         port_serial_got_response (self, parsed_response, NULL);
         g_byte_array_unref (parsed_response);
@@ -930,6 +1155,7 @@ parse_response_buffer (MMPortSerial *self)
         /* We have an error to process */
         g_assert (error);
         self->priv->n_consecutive_timeouts = 0;
+        port_serial_record_latency (self, (CommandContext *) g_queue_peek_head (self->priv->queue));
         /* Note: may complete last operation and unref the MMPortSerial */
         port_serial_got_response (self, NULL, error);
         g_error_free (error);
@@ -1377,6 +1603,7 @@ _close_internal (MMPortSerial *self, gboolean force)
         GTimeVal tv_start, tv_end;
         struct serial_struct sinfo = { 0 };
 
+        mm_port_serial_log_latency_stats (self);
         mm_obj_dbg (self, "closing serial port...");
 
         mm_port_set_connected (MM_PORT (self), FALSE);
@@ -1947,12 +2174,19 @@ ba_free (gpointer v)
     g_byte_array_unref ((GByteArray *) v);
 }
 
+static void
+latency_stats_free (MMPortSerialLatencyStats *stats)
+{
+    g_slice_free (MMPortSerialLatencyStats, stats);
+}
+
 static void
 mm_port_serial_init (MMPortSerial *self)
 {
     self->priv = G_TYPE_INSTANCE_GET_PRIVATE (self, MM_TYPE_PORT_SERIAL, MMPortSerialPrivate);
 
     self->priv->reply_cache = g_hash_table_new_full (ba_hash, ba_equal, ba_free, ba_free);
+    self->priv->latency_stats = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) latency_stats_free);
 
     self->priv->fd = -1;
     self->priv->baud = 57600;
@@ -2071,6 +2305,7 @@ finalize (GObject *object)
         g_source_remove (self->priv->queue_id);
 
     g_hash_table_destroy (self->priv->reply_cache);
+    g_hash_table_destroy (self->priv->latency_stats);
     g_byte_array_unref (self->priv->response);
     g_queue_free (self->priv->queue);
 
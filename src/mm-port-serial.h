@@ -100,6 +100,18 @@ struct _MMPortSerialClass {
                                    const gchar  *buf,
                                    gsize         len);
 
+    /* Called to get the class of a command being sent, used to group the
+     * observed response latencies. Commands of the same class are expected
+     * to take a similar time to reply. If not implemented, or if NULL is
+     * returned, the command is accounted only in the port-wide statistics.
+     * Commands whose reply time doesn't depend only on the port (e.g. set
+     * commands triggering network operations) should set 'adaptive_timeout'
+     * to FALSE, so that they always get the static timeout.
+     */
+    gchar * (*command_class)      (MMPortSerial     *self,
+                                   const GByteArray *command,
+                                   gboolean         *adaptive_timeout);
+
     /* Signals */
     void (*buffer_full)           (MMPortSerial *port, const GByteArray *buffer);
     void (*timed_out)             (MMPortSerial *port, guint n_consecutive_replies);
@@ -158,4 +170,29 @@ gboolean mm_port_serial_set_flow_control (MMPortSerial   *self,
                                           GError        **error);
 
 MMFlowControl mm_port_serial_get_flow_control (MMPortSerial *self);
+
+/* Dump the observed response latency statistics to the debug log */
+void mm_port_serial_log_latency_stats (MMPortSerial *self);
+
+/* Observed response latency statistics, as a 'a{s(uuddu)}' dictionary
+ * keyed by command class, plus the port-wide ones in the "all" entry. Each
+ * value gives the number of replies, the number of timeouts, the smoothed
+ * latency, its mean deviation and the maximum latency (in ms). */
+GVariant *mm_port_serial_get_latency_stats (MMPortSerial *self);
+
+/* Response latency estimator, same as the TCP retransmission timer
+ * (RFC 6298): smoothed latency plus 4 times its mean deviation. */
+typedef struct {
+    guint   n_samples;
+    guint   n_timeouts;
+    gdouble srtt_ms;
+    gdouble rttvar_ms;
+    guint   max_ms;
+} MMPortSerialLatencyStats;
+
+/* Just for unit tests */
+void  mm_port_serial_latency_stats_add_sample           (MMPortSerialLatencyStats       *stats,
+                                                         guint                           latency_ms);
+guint mm_port_serial_latency_stats_get_adaptive_timeout (const MMPortSerialLatencyStats *stats,
+                                                         guint                           static_timeout_ms);
 #endif /* MM_PORT_SERIAL_H */
@@ -20,12 +20,15 @@
 #include <glib-object.h>
 #include <gio/gio.h>
 
+#include <ModemManager-tags.h>
+
 #define _LIBMM_INSIDE_MM
 #include <libmm-glib.h>
 
 #include <libqmi-glib.h>
 
 #include "mm-log-object.h"
+#include "mm-base-modem.h"
 #include "mm-iface-modem.h"
 #include "mm-iface-modem-3gpp.h"
 #include "mm-iface-modem-location.h"
@@ -6575,29 +6578,41 @@ mm_shared_qmi_location_load_supported_assistance_data (MMIfaceModemLocation  *se
 
 #define MAX_BYTES_PER_REQUEST 1024
 
+/* Number of parts that may be pending to be acknowledged by the device while
+ * injecting assistance data. By default we wait for the indication of each
+ * part before sending the next one, devices known to support it may allow
+ * more via udev tag. */
+#define DEFAULT_INJECTION_WINDOW 1
+#define MAX_INJECTION_WINDOW     16
+
+#define INJECTION_INDICATION_TIMEOUT_SECS 10
+
 typedef struct {
     QmiClientLoc *client;
-    guint8       *data;
+    /* Not owned, valid until the operation is completed */
+    const guint8 *data;
     goffset       data_size;
     gulong        total_parts;
     guint32       part_size;
-    glong         indication_id;
+    guint         window;
+    gboolean      use_xtra;
+    gboolean      completed;
+    GArray       *part;
+    gulong        indication_id;
     guint         timeout_id;
-    goffset       i;
-    gulong        n_part;
+    gulong        n_sent;
+    gulong        n_acked;
+    gint64        start;
 } InjectAssistanceDataContext;
 
 static void
 inject_assistance_data_context_free (InjectAssistanceDataContext *ctx)
 {
-    if (ctx->client) {
-        if (ctx->timeout_id)
-            g_source_remove (ctx->timeout_id);
-        if (ctx->indication_id)
-            g_signal_handler_disconnect (ctx->client, ctx->indication_id);
-        g_object_unref (ctx->client);
-    }
-    g_free (ctx->data);
+    g_assert (!ctx->timeout_id);
+    g_assert (!ctx->indication_id);
+    if (ctx->part)
+        g_array_unref (ctx->part);
+    g_clear_object (&ctx->client);
     g_slice_free (InjectAssistanceDataContext, ctx);
 }
 
@@ -6609,196 +6624,183 @@ mm_shared_qmi_location_inject_assistance_data_finish (MMIfaceModemLocation  *sel
     return g_task_propagate_boolean (G_TASK (res), error);
 }
 
-static gboolean
-loc_location_inject_data_indication_timed_out (GTask *task)
+static void
+inject_assistance_data_stop (InjectAssistanceDataContext *ctx)
 {
-    InjectAssistanceDataContext *ctx;
-
-    ctx = g_task_get_task_data (task);
-    ctx->timeout_id = 0;
-
-    g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_ABORTED,
-                             "Failed to receive indication with the server update result");
-    g_object_unref (task);
-    return G_SOURCE_REMOVE;
+    if (ctx->timeout_id) {
+        g_source_remove (ctx->timeout_id);
+        ctx->timeout_id = 0;
+    }
+    if (ctx->indication_id) {
+        g_signal_handler_disconnect (ctx->client, ctx->indication_id);
+        ctx->indication_id = 0;
+    }
 }
 
-static void inject_xtra_data_next (GTask *task);
-
+/* The task reference created along with the task is released here; each
+ * request in flight holds its own additional reference. */
 static void
-loc_location_inject_xtra_data_indication_cb (QmiClientLoc                         *client,
-                                             QmiIndicationLocInjectXtraDataOutput *output,
-                                             GTask                                *task)
+inject_assistance_data_complete (GTask  *task,
+                                 GError *error)
 {
+    MMSharedQmi                 *self;
     InjectAssistanceDataContext *ctx;
-    QmiLocIndicationStatus       status;
-    GError                      *error = NULL;
 
-    if (!qmi_indication_loc_inject_xtra_data_output_get_indication_status (output, &status, &error)) {
-        g_prefix_error (&error, "QMI operation failed: ");
-        goto out;
-    }
+    self = g_task_get_source_object (task);
+    ctx  = g_task_get_task_data (task);
 
-    mm_error_from_qmi_loc_indication_status (status, &error);
+    g_assert (!ctx->completed);
+    ctx->completed = TRUE;
+    inject_assistance_data_stop (ctx);
 
-out:
     if (error) {
         g_task_return_error (task, error);
-        g_object_unref (task);
-        return;
+    } else {
+        gdouble elapsed;
+
+        elapsed = (gdouble) (g_get_monotonic_time () - ctx->start) / G_USEC_PER_SEC;
+        mm_obj_info (self, "injected %" G_GOFFSET_FORMAT " bytes of %s data in %.2f s (%.1f KiB/s, window %u)",
+                     ctx->data_size,
+                     ctx->use_xtra ? "xtra" : "predicted orbits",
+                     elapsed,
+                     elapsed > 0 ? ((gdouble) ctx->data_size / 1024.0) / elapsed : 0.0,
+                     ctx->window);
+        g_task_return_boolean (task, TRUE);
     }
+    g_object_unref (task);
+}
 
-    ctx = g_task_get_task_data (task);
+static gboolean
+loc_location_inject_data_indication_timed_out (GTask *task)
+{
+    InjectAssistanceDataContext *ctx;
 
-    g_source_remove (ctx->timeout_id);
+    ctx = g_task_get_task_data (task);
     ctx->timeout_id = 0;
 
-    g_signal_handler_disconnect (ctx->client, ctx->indication_id);
-    ctx->indication_id = 0;
-
-    inject_xtra_data_next (task);
+    inject_assistance_data_complete (task,
+                                     g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_ABORTED,
+                                                  "Failed to receive indication with the server update result"));
+    return G_SOURCE_REMOVE;
 }
 
 static void
-inject_xtra_data_ready (QmiClientLoc *client,
-                        GAsyncResult *res,
-                        GTask        *task)
+inject_assistance_data_restart_timeout (GTask *task)
 {
-    QmiMessageLocInjectXtraDataOutput *output;
-    InjectAssistanceDataContext       *ctx;
-    GError                            *error = NULL;
+    InjectAssistanceDataContext *ctx;
 
     ctx = g_task_get_task_data (task);
-
-    output = qmi_client_loc_inject_xtra_data_finish (client, res, &error);
-    if (!output || !qmi_message_loc_inject_xtra_data_output_get_result (output, &error)) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
-        goto out;
-    }
-
-    /* The task ownership is shared between signal and timeout; the one which is
-     * scheduled first will cancel the other. */
-    ctx->indication_id = g_signal_connect (ctx->client,
-                                           "inject-xtra-data",
-                                           G_CALLBACK (loc_location_inject_xtra_data_indication_cb),
-                                           task);
-    ctx->timeout_id = g_timeout_add_seconds (10,
+    if (ctx->timeout_id)
+        g_source_remove (ctx->timeout_id);
+    ctx->timeout_id = g_timeout_add_seconds (INJECTION_INDICATION_TIMEOUT_SECS,
                                              (GSourceFunc)loc_location_inject_data_indication_timed_out,
                                              task);
-out:
-    if (output)
-        qmi_message_loc_inject_xtra_data_output_unref (output);
 }
 
+static void inject_assistance_data_start       (GTask *task);
+static void inject_assistance_data_fill_window (GTask *task);
+
 static void
-inject_xtra_data_next (GTask *task)
+inject_assistance_data_indication (GTask  *task,
+                                   GError *error)
 {
-    MMSharedQmi                      *self;
-    QmiMessageLocInjectXtraDataInput *input;
-    InjectAssistanceDataContext      *ctx;
-    goffset                           total_bytes_left;
-    gsize                             count;
-    GArray                           *data;
+    InjectAssistanceDataContext *ctx;
 
-    self = g_task_get_source_object (task);
-    ctx  = g_task_get_task_data (task);
+    ctx = g_task_get_task_data (task);
 
-    g_assert (ctx->data_size >= ctx->i);
-    total_bytes_left = ctx->data_size - ctx->i;
-    if (total_bytes_left == 0) {
-        g_task_return_boolean (task, TRUE);
-        g_object_unref (task);
+    if (error) {
+        inject_assistance_data_complete (task, error);
         return;
     }
 
-    ctx->n_part++;
-    count = (total_bytes_left >= ctx->part_size) ? ctx->part_size : total_bytes_left;
-
-    input = qmi_message_loc_inject_xtra_data_input_new ();
-    qmi_message_loc_inject_xtra_data_input_set_total_size (
-        input,
-        (guint32)ctx->data_size,
-        NULL);
-    qmi_message_loc_inject_xtra_data_input_set_total_parts (
-        input,
-        (guint16)ctx->total_parts,
-        NULL);
-    qmi_message_loc_inject_xtra_data_input_set_part_number (
-        input,
-        (guint16)ctx->n_part,
-        NULL);
-    data = g_array_append_vals (g_array_sized_new (FALSE, FALSE, sizeof (guint8), count), &(ctx->data[ctx->i]), count);
-    qmi_message_loc_inject_xtra_data_input_set_part_data (
-        input,
-        data,
-        NULL);
-    g_array_unref (data);
-
-    ctx->i += count;
-
-    mm_obj_info (self, "injecting xtra data: %" G_GSIZE_FORMAT " bytes (%u/%u)",
-                 count, (guint) ctx->n_part, (guint) ctx->total_parts);
-    qmi_client_loc_inject_xtra_data (ctx->client,
-                                     input,
-                                     10,
-                                     NULL,
-                                     (GAsyncReadyCallback) inject_xtra_data_ready,
-                                     task);
+    /* Indications are received in the same order as the parts were sent */
+    ctx->n_acked++;
+    g_assert (ctx->n_acked <= ctx->n_sent);
+    if (ctx->n_acked == ctx->total_parts) {
+        inject_assistance_data_complete (task, NULL);
+        return;
+    }
 
-    qmi_message_loc_inject_xtra_data_input_unref (input);
+    inject_assistance_data_restart_timeout (task);
+    inject_assistance_data_fill_window (task);
 }
 
 static void
-inject_xtra_data (GTask *task)
+inject_assistance_data_response (GTask  *task,
+                                 GError *error)
 {
     InjectAssistanceDataContext *ctx;
 
     ctx = g_task_get_task_data (task);
 
-    g_assert (ctx->timeout_id == 0);
-    g_assert (ctx->indication_id == 0);
+    if (!error || ctx->completed)
+        goto out;
 
-    ctx->n_part = 0;
-    ctx->i = 0;
+    /* Try with InjectXtra if InjectPredictedOrbits is unsupported; this can
+     * only happen with the very first part, which is always sent alone */
+    if (!ctx->use_xtra &&
+        !ctx->n_acked &&
+        g_error_matches (error, QMI_PROTOCOL_ERROR, QMI_PROTOCOL_ERROR_NOT_SUPPORTED)) {
+        g_assert (ctx->n_sent == 1);
+        inject_assistance_data_stop (ctx);
+        ctx->use_xtra = TRUE;
+        inject_assistance_data_start (task);
+        goto out;
+    }
 
-    inject_xtra_data_next (task);
-}
+    g_prefix_error (&error, "QMI operation failed: ");
+    inject_assistance_data_complete (task, g_steal_pointer (&error));
 
-static void inject_assistance_data_next (GTask *task);
+out:
+    g_clear_error (&error);
+    g_object_unref (task);
+}
 
 static void
-loc_location_inject_predicted_orbits_data_indication_cb (QmiClientLoc                                    *client,
-                                                         QmiIndicationLocInjectPredictedOrbitsDataOutput *output,
-                                                         GTask                                           *task)
+loc_location_inject_xtra_data_indication_cb (QmiClientLoc                         *client,
+                                             QmiIndicationLocInjectXtraDataOutput *output,
+                                             GTask                                *task)
 {
-    InjectAssistanceDataContext *ctx;
-    QmiLocIndicationStatus       status;
-    GError                      *error = NULL;
+    QmiLocIndicationStatus  status;
+    GError                 *error = NULL;
 
-    if (!qmi_indication_loc_inject_predicted_orbits_data_output_get_indication_status (output, &status, &error)) {
+    if (!qmi_indication_loc_inject_xtra_data_output_get_indication_status (output, &status, &error))
         g_prefix_error (&error, "QMI operation failed: ");
-        goto out;
-    }
+    else
+        mm_error_from_qmi_loc_indication_status (status, &error);
 
-    mm_error_from_qmi_loc_indication_status (status, &error);
+    inject_assistance_data_indication (task, error);
+}
 
-out:
-    if (error) {
-        g_task_return_error (task, error);
-        g_object_unref (task);
-        return;
-    }
+static void
+inject_xtra_data_ready (QmiClientLoc *client,
+                        GAsyncResult *res,
+                        GTask        *task)
+{
+    g_autoptr(QmiMessageLocInjectXtraDataOutput) output = NULL;
+    GError                                      *error = NULL;
 
-    ctx = g_task_get_task_data (task);
+    output = qmi_client_loc_inject_xtra_data_finish (client, res, &error);
+    if (output)
+        qmi_message_loc_inject_xtra_data_output_get_result (output, &error);
 
-    g_source_remove (ctx->timeout_id);
-    ctx->timeout_id = 0;
+    inject_assistance_data_response (task, error);
+}
 
-    g_signal_handler_disconnect (ctx->client, ctx->indication_id);
-    ctx->indication_id = 0;
+static void
+loc_location_inject_predicted_orbits_data_indication_cb (QmiClientLoc                                    *client,
+                                                         QmiIndicationLocInjectPredictedOrbitsDataOutput *output,
+                                                         GTask                                           *task)
+{
+    QmiLocIndicationStatus  status;
+    GError                 *error = NULL;
 
-    inject_assistance_data_next (task);
+    if (!qmi_indication_loc_inject_predicted_orbits_data_output_get_indication_status (output, &status, &error))
+        g_prefix_error (&error, "QMI operation failed: ");
+    else
+        mm_error_from_qmi_loc_indication_status (status, &error);
+
+    inject_assistance_data_indication (task, error);
 }
 
 static void
@@ -6806,100 +6808,139 @@ inject_predicted_orbits_data_ready (QmiClientLoc *client,
                                     GAsyncResult *res,
                                     GTask        *task)
 {
-    QmiMessageLocInjectPredictedOrbitsDataOutput *output;
-    InjectAssistanceDataContext                  *ctx;
-    GError                                       *error = NULL;
+    g_autoptr(QmiMessageLocInjectPredictedOrbitsDataOutput) output = NULL;
+    GError                                                 *error = NULL;
+
+    output = qmi_client_loc_inject_predicted_orbits_data_finish (client, res, &error);
+    if (output)
+        qmi_message_loc_inject_predicted_orbits_data_output_get_result (output, &error);
+
+    inject_assistance_data_response (task, error);
+}
+
+static void
+inject_assistance_data_send_part (GTask *task)
+{
+    InjectAssistanceDataContext *ctx;
+    goffset                      offset;
+    guint32                      count;
 
     ctx = g_task_get_task_data (task);
 
-    output = qmi_client_loc_inject_predicted_orbits_data_finish (client, res, &error);
-    if (!output || !qmi_message_loc_inject_predicted_orbits_data_output_get_result (output, &error)) {
-        /* Try with InjectXtra if InjectPredictedOrbits is unsupported */
-        if (g_error_matches (error, QMI_PROTOCOL_ERROR, QMI_PROTOCOL_ERROR_NOT_SUPPORTED)) {
-            g_error_free (error);
-            inject_xtra_data (task);
-            goto out;
-        }
-        g_prefix_error (&error, "QMI operation failed: ");
-        g_task_return_error (task, error);
-        g_object_unref (task);
-        goto out;
+    offset = (goffset) ctx->n_sent * ctx->part_size;
+    g_assert (offset < ctx->data_size);
+    count = (guint32) MIN ((goffset) ctx->part_size, ctx->data_size - offset);
+    ctx->n_sent++;
+
+    /* The same buffer is reused for all parts, as the request message is
+     * fully built before the client call returns */
+    g_array_set_size (ctx->part, 0);
+    g_array_append_vals (ctx->part, &ctx->data[offset], count);
+
+    mm_obj_dbg (g_task_get_source_object (task), "injecting %s data: %u bytes (%lu/%lu)",
+                ctx->use_xtra ? "xtra" : "predicted orbits",
+                count, ctx->n_sent, ctx->total_parts);
+
+    if (ctx->use_xtra) {
+        g_autoptr(QmiMessageLocInjectXtraDataInput) input = NULL;
+
+        input = qmi_message_loc_inject_xtra_data_input_new ();
+        qmi_message_loc_inject_xtra_data_input_set_total_size (input, (guint32)ctx->data_size, NULL);
+        qmi_message_loc_inject_xtra_data_input_set_total_parts (input, (guint16)ctx->total_parts, NULL);
+        qmi_message_loc_inject_xtra_data_input_set_part_number (input, (guint16)ctx->n_sent, NULL);
+        qmi_message_loc_inject_xtra_data_input_set_part_data (input, ctx->part, NULL);
+        qmi_client_loc_inject_xtra_data (ctx->client,
+                                         input,
+                                         10,
+                                         NULL,
+                                         (GAsyncReadyCallback) inject_xtra_data_ready,
+                                         g_object_ref (task));
+    } else {
+        g_autoptr(QmiMessageLocInjectPredictedOrbitsDataInput) input = NULL;
+
+        input = qmi_message_loc_inject_predicted_orbits_data_input_new ();
+        qmi_message_loc_inject_predicted_orbits_data_input_set_format_type (input, QMI_LOC_PREDICTED_ORBITS_DATA_FORMAT_XTRA, NULL);
+        qmi_message_loc_inject_predicted_orbits_data_input_set_total_size (input, (guint32)ctx->data_size, NULL);
+        qmi_message_loc_inject_predicted_orbits_data_input_set_total_parts (input, (guint16)ctx->total_parts, NULL);
+        qmi_message_loc_inject_predicted_orbits_data_input_set_part_number (input, (guint16)ctx->n_sent, NULL);
+        qmi_message_loc_inject_predicted_orbits_data_input_set_part_data (input, ctx->part, NULL);
+        qmi_client_loc_inject_predicted_orbits_data (ctx->client,
+                                                     input,
+                                                     10,
+                                                     NULL,
+                                                     (GAsyncReadyCallback) inject_predicted_orbits_data_ready,
+                                                     g_object_ref (task));
     }
+}
 
-    /* The task ownership is shared between signal and timeout; the one which is
-     * scheduled first will cancel the other. */
-    ctx->indication_id = g_signal_connect (ctx->client,
-                                           "inject-predicted-orbits-data",
-                                           G_CALLBACK (loc_location_inject_predicted_orbits_data_indication_cb),
-                                           task);
-    ctx->timeout_id = g_timeout_add_seconds (10,
-                                             (GSourceFunc)loc_location_inject_data_indication_timed_out,
-                                             task);
-out:
-    if (output)
-        qmi_message_loc_inject_predicted_orbits_data_output_unref (output);
+static void
+inject_assistance_data_fill_window (GTask *task)
+{
+    InjectAssistanceDataContext *ctx;
+    guint                        window;
+
+    ctx = g_task_get_task_data (task);
+
+    /* Until the first part is acknowledged, we don't know whether the message
+     * is supported at all, so don't pipeline anything */
+    window = ctx->n_acked ? ctx->window : 1;
+
+    while (!ctx->completed &&
+           ctx->n_sent < ctx->total_parts &&
+           (ctx->n_sent - ctx->n_acked) < window)
+        inject_assistance_data_send_part (task);
 }
 
 static void
-inject_assistance_data_next (GTask *task)
+inject_assistance_data_start (GTask *task)
 {
-    MMSharedQmi                                 *self;
-    QmiMessageLocInjectPredictedOrbitsDataInput *input;
-    InjectAssistanceDataContext                 *ctx;
-    goffset                                      total_bytes_left;
-    gsize                                        count;
-    GArray                                      *data;
+    InjectAssistanceDataContext *ctx;
 
-    self = g_task_get_source_object (task);
-    ctx  = g_task_get_task_data (task);
+    ctx = g_task_get_task_data (task);
 
-    g_assert (ctx->data_size >= ctx->i);
-    total_bytes_left = ctx->data_size - ctx->i;
-    if (total_bytes_left == 0) {
-        g_task_return_boolean (task, TRUE);
-        g_object_unref (task);
-        return;
-    }
+    g_assert (ctx->timeout_id == 0);
+    g_assert (ctx->indication_id == 0);
 
-    ctx->n_part++;
-    count = (total_bytes_left >= ctx->part_size) ? ctx->part_size : total_bytes_left;
+    ctx->n_sent = 0;
+    ctx->n_acked = 0;
 
-    input = qmi_message_loc_inject_predicted_orbits_data_input_new ();
-    qmi_message_loc_inject_predicted_orbits_data_input_set_format_type (
-        input,
-        QMI_LOC_PREDICTED_ORBITS_DATA_FORMAT_XTRA,
-        NULL);
-    qmi_message_loc_inject_predicted_orbits_data_input_set_total_size (
-        input,
-        (guint32)ctx->data_size,
-        NULL);
-    qmi_message_loc_inject_predicted_orbits_data_input_set_total_parts (
-        input,
-        (guint16)ctx->total_parts,
-        NULL);
-    qmi_message_loc_inject_predicted_orbits_data_input_set_part_number (
-        input,
-        (guint16)ctx->n_part,
-        NULL);
-    data = g_array_append_vals (g_array_sized_new (FALSE, FALSE, sizeof (guint8), count), &(ctx->data[ctx->i]), count);
-    qmi_message_loc_inject_predicted_orbits_data_input_set_part_data (
-        input,
-        data,
-        NULL);
-    g_array_unref (data);
+    /* The indication handler is kept connected during the whole injection;
+     * it doesn't own a task reference, it's disconnected on completion */
+    ctx->indication_id = ctx->use_xtra ?
+        g_signal_connect (ctx->client,
+                          "inject-xtra-data",
+                          G_CALLBACK (loc_location_inject_xtra_data_indication_cb),
+                          task) :
+        g_signal_connect (ctx->client,
+                          "inject-predicted-orbits-data",
+                          G_CALLBACK (loc_location_inject_predicted_orbits_data_indication_cb),
+                          task);
+
+    inject_assistance_data_restart_timeout (task);
+    inject_assistance_data_fill_window (task);
+}
 
-    ctx->i += count;
+static guint
+load_injection_window (MMSharedQmi *self)
+{
+    GList *ports;
+    GList *l;
+    guint  window = DEFAULT_INJECTION_WINDOW;
 
-    mm_obj_info (self, "injecting predicted orbits data: %" G_GSIZE_FORMAT " bytes (%u/%u)",
-                 count, (guint) ctx->n_part, (guint) ctx->total_parts);
-    qmi_client_loc_inject_predicted_orbits_data (ctx->client,
-                                                 input,
-                                                 10,
-                                                 NULL,
-                                                 (GAsyncReadyCallback) inject_predicted_orbits_data_ready,
-                                                 task);
+    ports = mm_base_modem_find_ports (MM_BASE_MODEM (self), MM_PORT_SUBSYS_UNKNOWN, MM_PORT_TYPE_UNKNOWN);
+    for (l = ports; l; l = g_list_next (l)) {
+        MMKernelDevice *kernel_device;
+
+        kernel_device = mm_port_peek_kernel_device (MM_PORT (l->data));
+        if (kernel_device && mm_kernel_device_has_property (kernel_device, ID_MM_QMI_LOC_INJECTION_WINDOW)) {
+            window = CLAMP (mm_kernel_device_get_property_as_int (kernel_device, ID_MM_QMI_LOC_INJECTION_WINDOW),
+                            1, MAX_INJECTION_WINDOW);
+            break;
+        }
+    }
+    g_list_free_full (ports, g_object_unref);
 
-    qmi_message_loc_inject_predicted_orbits_data_input_unref (input);
+    return window;
 }
 
 void
@@ -6923,10 +6964,11 @@ mm_shared_qmi_location_inject_assistance_data (MMIfaceModemLocation *self,
 
     task = g_task_new (self, NULL, callback, user_data);
     ctx = g_slice_new0 (InjectAssistanceDataContext);
-    ctx->client = g_object_ref (client);
-    ctx->data = g_memdup (data, data_size);
+    ctx->client = QMI_CLIENT_LOC (g_object_ref (client));
+    ctx->data = data;
     ctx->data_size = data_size;
     ctx->part_size = ((priv->loc_assistance_data_max_part_size > 0) ? priv->loc_assistance_data_max_part_size : MAX_BYTES_PER_REQUEST);
+    ctx->window = load_injection_window (MM_SHARED_QMI (self));
     g_task_set_task_data (task, ctx, (GDestroyNotify) inject_assistance_data_context_free);
 
     if ((ctx->data_size > (G_MAXUINT16 * ctx->part_size)) ||
@@ -6937,14 +6979,25 @@ mm_shared_qmi_location_inject_assistance_data (MMIfaceModemLocation *self,
         return;
     }
 
+    if (!ctx->data_size) {
+        g_task_return_new_error (task, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                                 "Assistance data file is empty");
+        g_object_unref (task);
+        return;
+    }
+
     ctx->total_parts = (ctx->data_size / ctx->part_size);
     if (ctx->data_size % ctx->part_size)
         ctx->total_parts++;
     g_assert (ctx->total_parts <= G_MAXUINT16);
 
-    mm_obj_dbg (self, "injecting gpsOneXTRA data (%" G_GOFFSET_FORMAT " bytes)...", ctx->data_size);
+    ctx->part = g_array_sized_new (FALSE, FALSE, sizeof (guint8), ctx->part_size);
+    ctx->start = g_get_monotonic_time ();
+
+    mm_obj_dbg (self, "injecting gpsOneXTRA data (%" G_GOFFSET_FORMAT " bytes, %lu parts, window %u)...",
+                ctx->data_size, ctx->total_parts, ctx->window);
 
-    inject_assistance_data_next (task);
+    inject_assistance_data_start (task);
 }
 
 /*****************************************************************************/
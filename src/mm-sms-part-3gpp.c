@@ -133,13 +133,9 @@ sms_decode_address (const guint8  *address,
     address++;
 
     if (addrtype == SMS_NUMBER_TYPE_ALPHA) {
-        g_autoptr(GByteArray)  unpacked_array = NULL;
-        guint8                *unpacked = NULL;
-        guint32                unpacked_len;
-
-        unpacked = mm_charset_gsm_unpack (address, (len * 4) / 7, 0, &unpacked_len);
-        unpacked_array = g_byte_array_new_take (unpacked, unpacked_len);
-        utf8 = mm_modem_charset_bytearray_to_utf8 (unpacked_array, MM_MODEM_CHARSET_GSM, FALSE, error);
+        utf8 = mm_charset_gsm_packed_to_utf8 (address, (len * 4) / 7, 0, FALSE, error);
+        if (!utf8)
+            g_prefix_error (error, "Invalid conversion from GSM to UTF-8: ");
     } else if (addrtype == SMS_NUMBER_TYPE_INTL &&
                addrplan == SMS_NUMBER_PLAN_TELEPHONE) {
         /* International telphone number, format as "+1234567890" */
@@ -251,26 +247,23 @@ sms_decode_text (const guint8   *text,
                  GError        **error)
 {
     if (encoding == MM_SMS_ENCODING_GSM7) {
-        g_autoptr(GByteArray)  unpacked_array = NULL;
-        guint8                *unpacked = NULL;
-        guint32                unpacked_len;
-        gchar                 *utf8;
-
-        unpacked = mm_charset_gsm_unpack ((const guint8 *) text, len, bit_offset, &unpacked_len);
-        unpacked_array = g_byte_array_new_take (unpacked, unpacked_len);
-        utf8 = mm_modem_charset_bytearray_to_utf8 (unpacked_array, MM_MODEM_CHARSET_GSM, FALSE, error);
-        if (utf8)
-            mm_obj_dbg (log_object, "converted SMS part text from GSM-7 to UTF-8: %s", utf8);
+        gchar *utf8;
+
+        /* Septets are converted straight from the packed user data */
+        utf8 = mm_charset_gsm_packed_to_utf8 (text, len, bit_offset, FALSE, error);
+        if (!utf8) {
+            g_prefix_error (error, "Invalid conversion from GSM to UTF-8: ");
+            return NULL;
+        }
+        mm_obj_dbg (log_object, "converted SMS part text from GSM-7 to UTF-8: %s", utf8);
         return utf8;
     }
 
     /* Always assume UTF-16 instead of UCS-2! */
     if (encoding == MM_SMS_ENCODING_UCS2) {
-        g_autoptr(GByteArray)  bytearray = NULL;
-        gchar                 *utf8;
+        gchar *utf8;
 
-        bytearray = g_byte_array_append (g_byte_array_sized_new (len), (const guint8 *)text, len);
-        utf8 = mm_modem_charset_bytearray_to_utf8 (bytearray, MM_MODEM_CHARSET_UTF16, FALSE, error);
+        utf8 = mm_modem_charset_bytes_to_utf8 (text, len, MM_MODEM_CHARSET_UTF16, FALSE, error);
         if (utf8)
             mm_obj_dbg (log_object, "converted SMS part text from UTF-16BE to UTF-8: %s", utf8);
         return utf8;
@@ -345,14 +338,40 @@ mm_sms_part_3gpp_new_from_pdu (guint         index,
                                gpointer      log_object,
                                GError      **error)
 {
-    g_autofree guint8 *pdu = NULL;
+    guint8             pdu[PDU_SIZE];
+    g_autofree guint8 *heap_pdu = NULL;
+    gsize              hexpdu_len;
     gsize              pdu_len;
+    gsize              i;
+
+    hexpdu_len = strlen (hexpdu);
+
+    /* PDUs are at most 176 bytes long (12 bytes of SMSC address plus 164
+     * bytes of TPDU), so decode the hex string into a stack buffer; anything
+     * else goes through the generic converter, which also reports errors on
+     * empty and odd-length strings */
+    if (hexpdu_len == 0 || (hexpdu_len % 2) != 0 || (hexpdu_len / 2) > sizeof (pdu)) {
+        heap_pdu = mm_utils_hexstr2bin (hexpdu, hexpdu_len, &pdu_len, error);
+        if (!heap_pdu) {
+            g_prefix_error (error, "Couldn't convert 3GPP PDU from hex to binary: ");
+            return NULL;
+        }
+        return mm_sms_part_3gpp_new_from_binary_pdu (index, heap_pdu, pdu_len, log_object, error);
+    }
 
-    /* Convert PDU from hex to binary */
-    pdu = mm_utils_hexstr2bin (hexpdu, -1, &pdu_len, error);
-    if (!pdu) {
-        g_prefix_error (error, "Couldn't convert 3GPP PDU from hex to binary: ");
-        return NULL;
+    pdu_len = hexpdu_len / 2;
+    for (i = 0; i < pdu_len; i++) {
+        gint a;
+
+        a = mm_utils_hex2byte (&hexpdu[2 * i]);
+        if (a < 0) {
+            g_set_error (error, MM_CORE_ERROR, MM_CORE_ERROR_INVALID_ARGS,
+                         "Couldn't convert 3GPP PDU from hex to binary: "
+                         "Hex byte conversion from '%c%c' failed",
+                         hexpdu[2 * i], hexpdu[2 * i + 1]);
+            return NULL;
+        }
+        pdu[i] = (guint8) a;
     }
 
     return mm_sms_part_3gpp_new_from_binary_pdu (index, pdu, pdu_len, log_object, error);
@@ -149,6 +149,113 @@ at_serial_parse_error (void)
     _run_parse_test (parse_error_tests, G_N_ELEMENTS(parse_error_tests));
 }
 
+typedef struct {
+    const gchar *command;
+    const gchar *class_key;
+    gboolean     adaptive_timeout;
+} CommandClassTest;
+
+static const CommandClassTest command_class_tests[] = {
+    /* Plain commands and queries */
+    { "AT",                              "AT",                               TRUE  },
+    { "AT+CSQ",                          "+CSQ",                             TRUE  },
+    { "at+csq\r",                        "+CSQ",                             TRUE  },
+    { "AT+COPS?",                        "+COPS?",                           TRUE  },
+    { "at+cops?\r\n",                    "+COPS?",                           TRUE  },
+    { "AT+CGMI;+CGMM",                   "+CGMI",                            TRUE  },
+    { "ATI",                             "I",                                TRUE  },
+    /* Tests */
+    { "AT+COPS=?",                       "+COPS=?",                          TRUE  },
+    { "AT+CGDCONT=?\r",                  "+CGDCONT=?",                       TRUE  },
+    /* Set commands keep their arguments as given, never adaptive */
+    { "AT+COPS=0",                       "+COPS=0",                          FALSE },
+    { "AT+COPS=3,2",                     "+COPS=3,2",                        FALSE },
+    { "at+cgdcont=1,\"IP\",\"Internet\"", "+CGDCONT=1,\"IP\",\"Internet\"",   FALSE },
+    /* Class keys are truncated to 32 chars */
+    { "AT+CGDCONT=1,\"IPV4V6\",\"a.very.long.apn.name\"",
+      "+CGDCONT=1,\"IPV4V6\",\"a.very.long",
+      FALSE },
+    /* Dial and answer, never adaptive */
+    { "ATD*99#",                         "D*99#",                            FALSE },
+    { "atd*99***1#\r",                   "D*99***1#",                        FALSE },
+    { "ATA",                             "A",                                FALSE },
+    /* Not AT commands */
+    { "",                                NULL,                               TRUE  },
+    { "A",                               NULL,                               TRUE  },
+    { "+CSQ",                            NULL,                               TRUE  },
+};
+
+static void
+at_serial_command_class (void)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (command_class_tests); i++) {
+        g_autoptr(GByteArray)  command = NULL;
+        g_autofree gchar      *class_key = NULL;
+        gboolean               adaptive_timeout = TRUE;
+
+        command = g_byte_array_new ();
+        g_byte_array_append (command,
+                             (const guint8 *) command_class_tests[i].command,
+                             strlen (command_class_tests[i].command));
+
+        class_key = mm_port_serial_at_command_class (command, &adaptive_timeout);
+        g_assert_cmpstr (class_key, ==, command_class_tests[i].class_key);
+        g_assert_cmpint (adaptive_timeout, ==, command_class_tests[i].adaptive_timeout);
+    }
+}
+
+static void
+add_latency_samples (MMPortSerialLatencyStats *stats,
+                     guint                     latency_ms,
+                     guint                     n_samples)
+{
+    guint i;
+
+    for (i = 0; i < n_samples; i++)
+        mm_port_serial_latency_stats_add_sample (stats, latency_ms);
+}
+
+static void
+at_serial_adaptive_timeout_min_samples (void)
+{
+    MMPortSerialLatencyStats stats = { 0 };
+
+    /* Not enough samples: static timeout always */
+    add_latency_samples (&stats, 100, 4);
+    g_assert_cmpuint (stats.n_samples, ==, 4);
+    g_assert_cmpuint (mm_port_serial_latency_stats_get_adaptive_timeout (&stats, 10000), ==, 10000);
+
+    add_latency_samples (&stats, 100, 1);
+    g_assert_cmpuint (mm_port_serial_latency_stats_get_adaptive_timeout (&stats, 10000), <, 10000);
+}
+
+static void
+at_serial_adaptive_timeout_clamp (void)
+{
+    MMPortSerialLatencyStats stats = { 0 };
+
+    /* Fast replies: never below the minimum adaptive timeout (2s)... */
+    add_latency_samples (&stats, 100, 5);
+    g_assert_cmpuint (mm_port_serial_latency_stats_get_adaptive_timeout (&stats, 10000), ==, 2000);
+    /* ...unless the static timeout is even shorter */
+    g_assert_cmpuint (mm_port_serial_latency_stats_get_adaptive_timeout (&stats, 1000), ==, 1000);
+
+    /* Slow replies: smoothed latency plus 4 times its deviation, i.e.
+     * 3000 + 4 * (1500 * 0.75^4) = 4898, never above the static timeout */
+    memset (&stats, 0, sizeof (stats));
+    add_latency_samples (&stats, 3000, 5);
+    g_assert_cmpuint (stats.max_ms, ==, 3000);
+    g_assert_cmpuint (mm_port_serial_latency_stats_get_adaptive_timeout (&stats, 10000), ==, 4898);
+    g_assert_cmpuint (mm_port_serial_latency_stats_get_adaptive_timeout (&stats, 4000), ==, 4000);
+
+    /* A single outlier increases the deviation, and so the timeout */
+    add_latency_samples (&stats, 9000, 1);
+    g_assert_cmpuint (stats.max_ms, ==, 9000);
+    g_assert_cmpuint (mm_port_serial_latency_stats_get_adaptive_timeout (&stats, 30000), >, 4898);
+}
+
 int main (int argc, char **argv)
 {
     g_test_init (&argc, &argv, NULL);
@@ -156,6 +263,9 @@ int main (int argc, char **argv)
     g_test_add_func ("/ModemManager/AT-serial/echo-removal", at_serial_echo_removal);
     g_test_add_func ("/ModemManager/AT-serial/parse-ok", at_serial_parse_ok);
     g_test_add_func ("/ModemManager/AT-serial/parse-error", at_serial_parse_error);
+    g_test_add_func ("/ModemManager/AT-serial/command-class", at_serial_command_class);
+    g_test_add_func ("/ModemManager/AT-serial/adaptive-timeout-min-samples", at_serial_adaptive_timeout_min_samples);
+    g_test_add_func ("/ModemManager/AT-serial/adaptive-timeout-clamp", at_serial_adaptive_timeout_clamp);
 
     return g_test_run ();
 }
@@ -3131,6 +3131,71 @@ test_cpms_query_response (void *f, gpointer d) {
     }
 }
 
+/*****************************************************************************/
+/* Test +CMMS decisions when sending SMS */
+
+typedef struct {
+    const gchar *desc;
+    guint        n_parts;
+    guint        n_pending;
+    gint64       last_completed;
+    gint64       started;
+    gboolean     cmms_unsupported;
+    gboolean     expected;
+} SmsSubmitKeepLinkOpenTest;
+
+static const SmsSubmitKeepLinkOpenTest sms_submit_keep_link_open_tests[] = {
+    { "single part, nothing else",           1, 1, 0,                       10 * G_USEC_PER_SEC, FALSE, FALSE },
+    { "multipart",                           3, 1, 0,                       10 * G_USEC_PER_SEC, FALSE, TRUE  },
+    { "other messages pending",              1, 2, 0,                       10 * G_USEC_PER_SEC, FALSE, TRUE  },
+    { "previous message just sent",          1, 1, 9500 * 1000,             10 * G_USEC_PER_SEC, FALSE, TRUE  },
+    { "previous message sent long ago",      1, 1, 5 * G_USEC_PER_SEC,      10 * G_USEC_PER_SEC, FALSE, FALSE },
+    { "previous message sent 1s ago",         1, 1, 9 * G_USEC_PER_SEC,      10 * G_USEC_PER_SEC, FALSE, FALSE },
+    { "multipart, cmms unsupported",         3, 1, 0,                       10 * G_USEC_PER_SEC, TRUE,  FALSE },
+    { "pending, cmms unsupported",           1, 4, 9500 * 1000,             10 * G_USEC_PER_SEC, TRUE,  FALSE },
+};
+
+static void
+test_sms_submit_keep_link_open (void *f, gpointer d)
+{
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS (sms_submit_keep_link_open_tests); i++) {
+        const SmsSubmitKeepLinkOpenTest *t = &sms_submit_keep_link_open_tests[i];
+
+        g_debug ("Testing +CMMS decision: %s", t->desc);
+        g_assert_cmpint (mm_3gpp_sms_submit_keep_link_open (t->n_parts,
+                                                            t->n_pending,
+                                                            t->last_completed,
+                                                            t->started,
+                                                            t->cmms_unsupported), ==, t->expected);
+    }
+}
+
+static void
+test_cmms_error_is_unsupported (void *f, gpointer d)
+{
+    GError *error;
+
+    g_assert (!mm_3gpp_cmms_error_is_unsupported (NULL));
+
+    error = g_error_new (MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_NOT_SUPPORTED, "not supported");
+    g_assert (mm_3gpp_cmms_error_is_unsupported (error));
+    g_clear_error (&error);
+
+    error = g_error_new (MM_MOBILE_EQUIPMENT_ERROR, MM_MOBILE_EQUIPMENT_ERROR_UNKNOWN, "unknown");
+    g_assert (mm_3gpp_cmms_error_is_unsupported (error));
+    g_clear_error (&error);
+
+    error = g_error_new (MM_SERIAL_ERROR, MM_SERIAL_ERROR_RESPONSE_TIMEOUT, "timeout");
+    g_assert (!mm_3gpp_cmms_error_is_unsupported (error));
+    g_clear_error (&error);
+
+    error = g_error_new (MM_CORE_ERROR, MM_CORE_ERROR_ABORTED, "aborted");
+    g_assert (!mm_3gpp_cmms_error_is_unsupported (error));
+    g_clear_error (&error);
+}
+
 /*****************************************************************************/
 /* Test CNUM responses */
 
@@ -3625,6 +3690,64 @@ test_cclk_response (void)
 }
 
 
+/*****************************************************************************/
+/* Test +CTZV/+CTZE URCs */
+
+typedef struct {
+    const gchar *str;
+    const gchar *iso8601;
+    gint32       offset;
+    gint32       dst_offset;
+} CtzTest;
+
+static const CtzTest ctz_tests[] = {
+    { "\r\n+CTZV: +08\r\n", NULL, 120, MM_NETWORK_TIMEZONE_OFFSET_UNKNOWN },
+    { "\r\n+CTZV: -20\r\n", NULL, -300, MM_NETWORK_TIMEZONE_OFFSET_UNKNOWN },
+    { "\r\n+CTZV: 32,0\r\n", NULL, 480, 0 },
+    { "\r\n+CTZV: +08,19/07/09,10:19:15\r\n",
+      "2019-07-09T10:19:15+02:00", 120, MM_NETWORK_TIMEZONE_OFFSET_UNKNOWN },
+    { "\r\n+CTZE: \"+08\",1,\"19/07/09,10:19:15\"\r\n",
+      "2019-07-09T10:19:15+02:00", 120, 60 },
+    { "\r\n+CTZE: \"-20\",0,\"2019/07/09,10:19:15\"\r\n",
+      "2019-07-09T10:19:15-05:00", -300, 0 },
+    { "\r\n+CTZE: \"+04\",0\r\n", NULL, 60, 0 },
+};
+
+static void
+test_ctz_urc (void)
+{
+    GRegex *r;
+    guint   i;
+
+    r = mm_3gpp_ctz_regex_get ();
+    g_assert (r);
+
+    for (i = 0; i < G_N_ELEMENTS (ctz_tests); i++) {
+        GMatchInfo        *match_info = NULL;
+        GError            *error = NULL;
+        gchar             *iso8601 = NULL;
+        MMNetworkTimezone *tz = NULL;
+        gboolean           ret;
+
+        ret = g_regex_match (r, ctz_tests[i].str, 0, &match_info);
+        g_assert (ret);
+
+        ret = mm_3gpp_parse_ctz_urc (match_info, &iso8601, &tz, &error);
+        g_assert_no_error (error);
+        g_assert (ret);
+
+        g_assert_cmpstr (iso8601, ==, ctz_tests[i].iso8601);
+        g_assert_cmpint (mm_network_timezone_get_offset (tz), ==, ctz_tests[i].offset);
+        g_assert_cmpint (mm_network_timezone_get_dst_offset (tz), ==, ctz_tests[i].dst_offset);
+
+        g_free (iso8601);
+        g_object_unref (tz);
+        g_match_info_free (match_info);
+    }
+
+    g_regex_unref (r);
+}
+
 /*****************************************************************************/
 /* Test +CRSM responses */
 
@@ -4634,6 +4757,9 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_cpms_response_empty_fields, NULL));
     g_test_suite_add (suite, TESTCASE (test_cpms_query_response,        NULL));
 
+    g_test_suite_add (suite, TESTCASE (test_sms_submit_keep_link_open, NULL));
+    g_test_suite_add (suite, TESTCASE (test_cmms_error_is_unsupported, NULL));
+
     g_test_suite_add (suite, TESTCASE (test_cmp_apn_name, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_cgdcont_test_response_single, NULL));
@@ -4676,6 +4802,7 @@ int main (int argc, char **argv)
     g_test_suite_add (suite, TESTCASE (test_supported_mode_filter, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_cclk_response, NULL));
+    g_test_suite_add (suite, TESTCASE (test_ctz_urc, NULL));
 
     g_test_suite_add (suite, TESTCASE (test_crsm_response, NULL));
 
@@ -16,6 +16,7 @@
 #include <config.h>
 #include <glib.h>
 #include <string.h>
+#include <endian.h>
 #include <pty.h>
 #include <unistd.h>
 #include <stdlib.h>
@@ -31,6 +32,8 @@
 
 #include "mm-port-serial-qcdm.h"
 #include "libqcdm/src/commands.h"
+#include "libqcdm/src/dm-commands.h"
+#include "libqcdm/src/log-items.h"
 #include "libqcdm/src/utils.h"
 #include "libqcdm/src/com.h"
 #include "libqcdm/src/errors.h"
@@ -397,6 +400,189 @@ test_leading_frame_markers (TestData *d)
     g_assert (wait_for_child (d, 3));
 }
 
+typedef struct {
+    GMainLoop *loop;
+    guint      n_batches;
+    guint      n_batch_items;
+    guint      n_items;
+} LogItemsContext;
+
+static void
+qcdm_log_items_check_done (LogItemsContext *ctx)
+{
+    if (ctx->n_batch_items == 3 && ctx->n_items == 1)
+        g_main_loop_quit (ctx->loop);
+}
+
+static void
+qcdm_log_items_batch_cb (MMPortSerialQcdm *port,
+                         GPtrArray *log_buffers,
+                         LogItemsContext *ctx)
+{
+    guint i;
+
+    for (i = 0; i < log_buffers->len; i++) {
+        GByteArray *log_buffer = g_ptr_array_index (log_buffers, i);
+        DMCmdLog *log_cmd = (DMCmdLog *) log_buffer->data;
+
+        g_assert_cmpuint (log_buffer->len, >=, sizeof (DMCmdLog));
+        g_assert_cmpuint (le16toh (log_cmd->log_code), ==, DM_LOG_ITEM_CDMA_REVERSE_POWER_CONTROL);
+        /* Items are given in the same order they were received */
+        g_assert_cmpuint (log_cmd->data[0], ==, ctx->n_batch_items + i);
+    }
+
+    ctx->n_batches++;
+    ctx->n_batch_items += log_buffers->len;
+    qcdm_log_items_check_done (ctx);
+}
+
+static void
+qcdm_log_items_cb (MMPortSerialQcdm *port,
+                   GByteArray *log_buffer,
+                   LogItemsContext *ctx)
+{
+    DMCmdLog *log_cmd = (DMCmdLog *) log_buffer->data;
+
+    g_assert_cmpuint (le16toh (log_cmd->log_code), ==, DM_LOG_ITEM_EVDO_PILOT_SETS_V2);
+    ctx->n_items++;
+    qcdm_log_items_check_done (ctx);
+}
+
+static void
+qcdm_log_items_unexpected_cb (MMPortSerialQcdm *port,
+                              GPtrArray *log_buffers,
+                              LogItemsContext *ctx)
+{
+    g_assert_not_reached ();
+}
+
+static gboolean
+qcdm_log_items_timeout_cb (LogItemsContext *ctx)
+{
+    g_assert_not_reached ();
+    return G_SOURCE_REMOVE;
+}
+
+static void
+qcdm_log_items_child (int fd)
+{
+    MMPortSerialQcdm *port;
+    LogItemsContext ctx = { 0 };
+    gboolean success;
+    GError *error = NULL;
+    const char ready = 0x7e;
+    int status;
+
+    ctx.loop = g_main_loop_new (NULL, FALSE);
+
+    port = mm_port_serial_qcdm_new_fd (fd);
+    g_assert (port);
+
+    success = mm_port_serial_open (MM_PORT_SERIAL (port), &error);
+    g_assert_no_error (error);
+    g_assert (success);
+
+    mm_port_serial_qcdm_add_unsolicited_msg_batch_handler (port,
+                                                           DM_LOG_ITEM_CDMA_REVERSE_POWER_CONTROL,
+                                                           (MMPortSerialQcdmUnsolicitedMsgBatchFn) qcdm_log_items_batch_cb,
+                                                           &ctx,
+                                                           NULL);
+    mm_port_serial_qcdm_add_unsolicited_msg_handler (port,
+                                                     DM_LOG_ITEM_EVDO_PILOT_SETS_V2,
+                                                     (MMPortSerialQcdmUnsolicitedMsgFn) qcdm_log_items_cb,
+                                                     &ctx,
+                                                     NULL);
+    mm_port_serial_qcdm_add_unsolicited_msg_batch_handler (port,
+                                                           DM_LOG_ITEM_CDMA_MARKOV_STATS,
+                                                           (MMPortSerialQcdmUnsolicitedMsgBatchFn) qcdm_log_items_unexpected_cb,
+                                                           &ctx,
+                                                           NULL);
+    mm_port_serial_qcdm_enable_unsolicited_msg_handler (port, DM_LOG_ITEM_CDMA_MARKOV_STATS, FALSE);
+
+    /* Tell the parent that the handlers are ready */
+    status = write (fd, &ready, 1);
+    g_assert_cmpint (status, ==, 1);
+
+    g_timeout_add_seconds (3, (GSourceFunc) qcdm_log_items_timeout_cb, &ctx);
+    g_main_loop_run (ctx.loop);
+    g_main_loop_unref (ctx.loop);
+
+    /* All items of the same code were received in a single read */
+    g_assert_cmpuint (ctx.n_batches, ==, 1);
+
+    mm_port_serial_close (MM_PORT_SERIAL (port));
+    g_object_unref (port);
+}
+
+static gsize
+log_item_frame_append (char *buf, gsize len, guint16 log_code, guint8 seq)
+{
+    char item[sizeof (DMCmdLog) + 1 + 2];
+    DMCmdLog *log_cmd = (DMCmdLog *) item;
+
+    memset (item, 0, sizeof (item));
+    log_cmd->code = DIAG_CMD_LOG;
+    log_cmd->len = htole16 (sizeof (DMCmdLog) - 4 + 1);
+    log_cmd->_unknown2 = log_cmd->len;
+    log_cmd->log_code = htole16 (log_code);
+    log_cmd->data[0] = seq;
+
+    return dm_encapsulate_buffer (item, sizeof (DMCmdLog) + 1, sizeof (item), buf, len);
+}
+
+/* Test that several log items received in one chunk are all processed in
+ * the same pass, delivered in batch or one by one depending on the handler,
+ * and not delivered at all when the handler is disabled or missing.
+ */
+static void
+test_log_items_batch (TestData *d)
+{
+    char frames[512];
+    gsize frames_len = 0;
+    char ready = 0;
+    fd_set in;
+    struct timeval timeout = { 2, 0 };
+    int status;
+    pid_t cpid;
+
+    signal (SIGCHLD, SIG_DFL);
+    cpid = fork ();
+    g_assert (cpid >= 0);
+
+    if (cpid == 0) {
+        /* In the child */
+        qcdm_log_items_child (d->slave);
+        exit (0);
+    }
+    /* Parent */
+    d->child = cpid;
+
+    FD_ZERO (&in);
+    FD_SET (d->master, &in);
+    status = select (d->master + 1, &in, NULL, NULL, &timeout);
+    g_assert_cmpint (status, ==, 1);
+    status = read (d->master, &ready, 1);
+    g_assert_cmpint (status, ==, 1);
+    g_assert_cmpint (ready, ==, 0x7e);
+
+    frames_len += log_item_frame_append (&frames[frames_len], sizeof (frames) - frames_len, DM_LOG_ITEM_CDMA_REVERSE_POWER_CONTROL, 0);
+    frames_len += log_item_frame_append (&frames[frames_len], sizeof (frames) - frames_len, DM_LOG_ITEM_EVDO_PILOT_SETS_V2, 0);
+    frames_len += log_item_frame_append (&frames[frames_len], sizeof (frames) - frames_len, DM_LOG_ITEM_CDMA_MARKOV_STATS, 0);
+    frames_len += log_item_frame_append (&frames[frames_len], sizeof (frames) - frames_len, DM_LOG_ITEM_CDMA_REVERSE_POWER_CONTROL, 1);
+    frames_len += log_item_frame_append (&frames[frames_len], sizeof (frames) - frames_len, DM_LOG_ITEM_GSM_BURST_METRICS, 0);
+    frames_len += log_item_frame_append (&frames[frames_len], sizeof (frames) - frames_len, DM_LOG_ITEM_CDMA_REVERSE_POWER_CONTROL, 2);
+
+    if (g_test_verbose ())
+        print_buf (">>>", frames, frames_len);
+
+    /* All frames written at once, so that they're read in a single chunk */
+    status = write (d->master, frames, frames_len);
+    g_assert_cmpint (status, ==, (int) frames_len);
+
+    /* We expect the child to exit normally */
+    g_assert (wait_for_child (d, 5));
+}
+
 static void
 test_pty_create (TestData *d)
 {
@@ -448,6 +634,7 @@ int main (int argc, char **argv)
     TESTCASE_PTY ("/MM/QCDM/Sierra-Cns-Rejected", test_sierra_cns_rejected);
     TESTCASE_PTY ("/MM/QCDM/Random-Data-Rejected", test_random_data_rejected);
     TESTCASE_PTY ("/MM/QCDM/Leading-Frame-Markers", test_leading_frame_markers);
+    TESTCASE_PTY ("/MM/QCDM/Log-Items-Batch", test_log_items_batch);
 
     return g_test_run ();
 }
@@ -24,6 +24,7 @@
 #include <libmm-glib.h>
 
 #include "mm-sms-part-3gpp.h"
+#include "mm-charsets.h"
 #include "mm-log-test.h"
 
 /********************* PDU PARSER TESTS *********************/
@@ -890,6 +891,160 @@ test_text_split_two_pdu_utf16 (void)
     common_test_text_split (text, expected, MM_SMS_ENCODING_UCS2);
 }
 
+/********************* PDU DECODE BENCHMARK *********************/
+
+#define DECODE_BENCHMARK_NUMBER          "+34600000000"
+#define DECODE_BENCHMARK_PDUS            1000
+#define DECODE_BENCHMARK_PDUS_PERF       100000
+
+static const gchar *decode_benchmark_gsm7_texts[] = {
+    "Hello there, how are you?",
+    "Price: 10€ [incl. VAT] {ref ~42} a|b \\ ^",
+    "Accents: ÄÖÑÜ§¿äöñüà èéùìò Ç Øø Åå ΔΦΓΛΩΠΨΣΘΞ ÆæßÉ ¡£¥¤",
+    "user@example.com @ the office",
+};
+
+static const gchar *decode_benchmark_ucs2_texts[] = {
+    "你好，世界",
+    "Здравствуйте, как дела?",
+    "emoji 😀 and 𑰀𑰁 surrogates",
+};
+
+/* Decodes the user data of the SUBMIT PDUs built by the benchmark as the
+ * previous implementation did: unpack the septets into their own buffer,
+ * and then convert the unpacked buffer to UTF-8. */
+static gchar *
+reference_decode_text (const guint8  *pdu,
+                       guint          msgstart,
+                       MMSmsEncoding  encoding,
+                       gboolean       has_udh)
+{
+    g_autoptr(GByteArray)  array = NULL;
+    g_autoptr(GError)      error = NULL;
+    guint                  offset;
+    guint                  udl;
+    gchar                 *utf8;
+
+    /* First octet, TP-MR, number of digits, type of address, digits (skipping
+     * the leading '+'), TP-PID and TP-DCS */
+    offset = msgstart + 4 + (strlen (DECODE_BENCHMARK_NUMBER + 1) + 1) / 2 + 2;
+    udl = pdu[offset++];
+
+    if (encoding == MM_SMS_ENCODING_GSM7) {
+        guint8  *unpacked;
+        guint32  unpacked_len;
+
+        if (has_udh) {
+            /* 6 bytes of UDH plus 1 bit of padding, 7 septets */
+            unpacked = mm_charset_gsm_unpack (&pdu[offset + 6], udl - 7, 1, &unpacked_len);
+        } else
+            unpacked = mm_charset_gsm_unpack (&pdu[offset], udl, 0, &unpacked_len);
+        array = g_byte_array_new_take (unpacked, unpacked_len);
+        utf8 = mm_modem_charset_bytearray_to_utf8 (array, MM_MODEM_CHARSET_GSM, FALSE, &error);
+    } else {
+        g_assert_cmpuint (encoding, ==, MM_SMS_ENCODING_UCS2);
+        g_assert (!has_udh);
+        array = g_byte_array_append (g_byte_array_sized_new (udl), &pdu[offset], udl);
+        utf8 = mm_modem_charset_bytearray_to_utf8 (array, MM_MODEM_CHARSET_UTF16, FALSE, &error);
+    }
+    g_assert_no_error (error);
+    return utf8;
+}
+
+static void
+test_pdu_decode_benchmark (void)
+{
+    GPtrArray  *hexpdus;
+    GPtrArray  *expected;
+    GTimer     *timer;
+    guint       n_pdus;
+    guint       i;
+    gdouble     elapsed;
+
+    n_pdus = g_test_perf () ? DECODE_BENCHMARK_PDUS_PERF : DECODE_BENCHMARK_PDUS;
+    hexpdus = g_ptr_array_new_with_free_func (g_free);
+    expected = g_ptr_array_new_with_free_func (g_free);
+
+    /* Build a mix of GSM-7 (with and without UDH), UCS-2 and 8-bit PDUs,
+     * and decode the text of each of them with the previous implementation */
+    for (i = 0; i < n_pdus; i++) {
+        g_autofree guint8 *pdu = NULL;
+        MMSmsPart         *part;
+        MMSmsEncoding      encoding;
+        guint              len = 0;
+        guint              msgstart = 0;
+        gboolean           has_udh = FALSE;
+        GError            *error = NULL;
+
+        part = mm_sms_part_new (0, MM_SMS_PDU_TYPE_SUBMIT);
+        mm_sms_part_set_number (part, DECODE_BENCHMARK_NUMBER);
+
+        switch (i % 3) {
+        case 0:
+            encoding = MM_SMS_ENCODING_GSM7;
+            mm_sms_part_set_text (part, decode_benchmark_gsm7_texts[(i / 3) % G_N_ELEMENTS (decode_benchmark_gsm7_texts)]);
+            if ((i / 3) % 2) {
+                has_udh = TRUE;
+                mm_sms_part_set_concat_reference (part, i & 0xff);
+                mm_sms_part_set_concat_max (part, 2);
+                mm_sms_part_set_concat_sequence (part, 1);
+            }
+            break;
+        case 1:
+            encoding = MM_SMS_ENCODING_UCS2;
+            mm_sms_part_set_text (part, decode_benchmark_ucs2_texts[(i / 3) % G_N_ELEMENTS (decode_benchmark_ucs2_texts)]);
+            break;
+        default: {
+            GByteArray *data;
+            guint       j;
+
+            encoding = MM_SMS_ENCODING_8BIT;
+            data = g_byte_array_sized_new (100);
+            for (j = 0; j < 100; j++)
+                data->data[j] = (guint8) (i + j);
+            data->len = 100;
+            mm_sms_part_take_data (part, data);
+            break;
+        }
+        }
+        mm_sms_part_set_encoding (part, encoding);
+
+        pdu = mm_sms_part_3gpp_get_submit_pdu (part, &len, &msgstart, NULL, &error);
+        g_assert_no_error (error);
+        g_assert (pdu);
+
+        g_ptr_array_add (hexpdus, mm_utils_bin2hexstr (pdu, len));
+        g_ptr_array_add (expected, (encoding == MM_SMS_ENCODING_8BIT) ?
+                         NULL :
+                         reference_decode_text (pdu, msgstart, encoding, has_udh));
+        mm_sms_part_free (part);
+    }
+
+    timer = g_timer_new ();
+    for (i = 0; i < n_pdus; i++) {
+        MMSmsPart *part;
+        GError    *error = NULL;
+
+        part = mm_sms_part_3gpp_new_from_pdu (0, g_ptr_array_index (hexpdus, i), NULL, &error);
+        g_assert_no_error (error);
+        g_assert (part);
+
+        if (g_ptr_array_index (expected, i))
+            g_assert_cmpstr (mm_sms_part_get_text (part), ==, g_ptr_array_index (expected, i));
+        else
+            g_assert_cmpuint (mm_sms_part_get_data (part)->len, ==, 100);
+
+        mm_sms_part_free (part);
+    }
+    elapsed = g_timer_elapsed (timer, NULL);
+    g_timer_destroy (timer);
+
+    g_test_minimized_result (elapsed, "decoded %u PDUs in %.3f seconds", n_pdus, elapsed);
+
+    g_ptr_array_unref (expected);
+    g_ptr_array_unref (hexpdus);
+}
+
 /************************************************************/
 
 int main (int argc, char **argv)
@@ -935,5 +1090,7 @@ int main (int argc, char **argv)
     g_test_add_func ("/MM/SMS/3GPP/Text-Split/ucs2/two-pdu",         test_text_split_two_pdu_ucs2);
     g_test_add_func ("/MM/SMS/3GPP/Text-Split/utf16/two-pdu",        test_text_split_two_pdu_utf16);
 
+    g_test_add_func ("/MM/SMS/3GPP/PDU-Parser/decode-benchmark", test_pdu_decode_benchmark);
+
     return g_test_run ();
 }
@@ -0,0 +1,500 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details:
+ *
+ * Synthetic hotplug storm generator, reporting bursts of kernel events to a
+ * ModemManager daemon running without udev monitoring, e.g.:
+ *   ModemManager --debug --no-auto-scan --test-enable
+ *
+ * The daemon only accepts events for ports that exist in sysfs, so existing
+ * ports are used, grouped into fake physical devices through the reported
+ * uid. The ports should not be in use, as the daemon will probe them.
+ *
+ * ReportKernelEvent replies are sent before the events are processed, so the
+ * time spent processing them is read from the daemon statistics, given by the
+ * GetStats method of the Test interface when the daemon runs with it enabled.
+ * When ports are added, the time the plugin manager spends building the list
+ * of plugins to probe for each of them is also reported, once all of them
+ * have started probing.
+ */
+
+#include "config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locale.h>
+
+#include <glib.h>
+#include <gio/gio.h>
+#include <libmm-glib.h>
+
+#define PROGRAM_NAME    "mmhotplugstorm"
+#define PROGRAM_VERSION PACKAGE_VERSION
+
+#define MM_DBUS_INTERFACE_TEST "org.freedesktop.ModemManager1.Test"
+
+#define STATS_POLL_MS 10
+
+/* Once the batches are processed, the daemon starts probing the ports after a
+ * minimum wait time; the plugin lists are considered all built once none has
+ * been built for this time */
+#define PROBING_IDLE_TIMEOUT_MS 3000
+
+/* Globals */
+static GMainLoop *loop;
+static guint      n_pending;
+static guint      n_failed;
+static gchar    **ports;
+static GTimer    *timer;
+static gdouble    reported_elapsed;
+
+/* Daemon statistics */
+typedef struct {
+    guint    batches;
+    gdouble  batches_ms;
+    guint    ports_added;
+    guint    ports_removed;
+    gboolean batch_pending;
+    guint    plugins_list_builds;
+    guint    plugins_list_candidates;
+    gdouble  plugins_list_ms;
+} Stats;
+
+static GDBusConnection *connection;
+static gboolean         stats_available;
+static Stats            start_stats;
+static Stats            last_stats;
+static gdouble          last_batch_elapsed;
+static gdouble          last_build_elapsed;
+static gboolean         batches_done;
+
+/* Context */
+static gint     n_devices = 8;
+static gint     n_ports = 4;
+static gint     n_flaps = 10;
+static gchar   *subsystem_str;
+static gchar   *names_str;
+static gboolean keep_flag;
+static gboolean version_flag;
+
+static GOptionEntry main_entries[] = {
+    { "devices", 'd', 0, G_OPTION_ARG_INT, &n_devices,
+      "Number of fake physical devices (default 8)",
+      "[NUMBER]"
+    },
+    { "ports", 'p', 0, G_OPTION_ARG_INT, &n_ports,
+      "Number of ports per fake device (default 4)",
+      "[NUMBER]"
+    },
+    { "flaps", 'f', 0, G_OPTION_ARG_INT, &n_flaps,
+      "Number of add/remove cycles reported per port before the final add (default 10)",
+      "[NUMBER]"
+    },
+    { "subsystem", 's', 0, G_OPTION_ARG_STRING, &subsystem_str,
+      "Subsystem of the ports (default tty)",
+      "[SUBSYSTEM]"
+    },
+    { "names", 'n', 0, G_OPTION_ARG_STRING, &names_str,
+      "Comma separated list of ports to use (default the first ones found in /sys/class/[SUBSYSTEM])",
+      "[NAME,NAME...]"
+    },
+    { "keep", 'k', 0, G_OPTION_ARG_NONE, &keep_flag,
+      "Don't report the ports as removed at the end",
+      NULL
+    },
+    { "version", 'V', 0, G_OPTION_ARG_NONE, &version_flag,
+      "Print version",
+      NULL
+    },
+    { NULL }
+};
+
+static void
+print_version_and_exit (void)
+{
+    g_print ("\n"
+             PROGRAM_NAME " " PROGRAM_VERSION "\n"
+             "License GPLv2+: GNU GPL version 2 or later <http://gnu.org/licenses/gpl-2.0.html>\n"
+             "This is free software: you are free to change and redistribute it.\n"
+             "There is NO WARRANTY, to the extent permitted by law.\n"
+             "\n");
+    exit (EXIT_SUCCESS);
+}
+
+static void
+report_kernel_event_ready (MMManager    *manager,
+                           GAsyncResult *res)
+{
+    GError *error = NULL;
+
+    if (!mm_manager_report_kernel_event_finish (manager, res, &error)) {
+        if (!n_failed)
+            g_printerr ("error: couldn't report kernel event: %s\n", error->message);
+        g_error_free (error);
+        n_failed++;
+    }
+
+    g_assert (n_pending > 0);
+    if (!--n_pending) {
+        reported_elapsed = g_timer_elapsed (timer, NULL);
+        /* When the daemon statistics are available, wait for the batches to
+         * be processed */
+        if (!stats_available)
+            g_main_loop_quit (loop);
+    }
+}
+
+static void
+report_kernel_event (MMManager   *manager,
+                     const gchar *action,
+                     guint        device_i,
+                     guint        port_i)
+{
+    MMKernelEventProperties *properties;
+    gchar                   *uid;
+
+    uid = g_strdup_printf ("mmstorm-device-%u", device_i);
+
+    properties = mm_kernel_event_properties_new ();
+    mm_kernel_event_properties_set_action    (properties, action);
+    mm_kernel_event_properties_set_subsystem (properties, subsystem_str ? subsystem_str : "tty");
+    mm_kernel_event_properties_set_name      (properties, ports[(device_i * n_ports) + port_i]);
+    mm_kernel_event_properties_set_uid       (properties, uid);
+
+    /* All requests are issued right away, so that the daemon receives them
+     * as a burst */
+    n_pending++;
+    mm_manager_report_kernel_event (manager,
+                                    properties,
+                                    NULL,
+                                    (GAsyncReadyCallback)report_kernel_event_ready,
+                                    NULL);
+
+    g_object_unref (properties);
+    g_free (uid);
+}
+
+/* Loads the kernel event batch and plugin list statistics of the daemon */
+static gboolean
+stats_load (Stats   *out,
+            GError **error)
+{
+    GVariant *result;
+    GVariant *stats;
+    GVariant *manager_stats;
+
+    result = g_dbus_connection_call_sync (connection,
+                                          MM_DBUS_SERVICE,
+                                          MM_DBUS_PATH,
+                                          MM_DBUS_INTERFACE_TEST,
+                                          "GetStats",
+                                          NULL,
+                                          G_VARIANT_TYPE ("(a{sa{sv}})"),
+                                          G_DBUS_CALL_FLAGS_NO_AUTO_START,
+                                          -1,
+                                          NULL,
+                                          error);
+    if (!result)
+        return FALSE;
+
+    memset (out, 0, sizeof (Stats));
+
+    stats = g_variant_get_child_value (result, 0);
+    manager_stats = g_variant_lookup_value (stats, MM_DBUS_PATH, G_VARIANT_TYPE ("a{sv}"));
+    if (manager_stats) {
+        g_variant_lookup (manager_stats, "kernel-event-batches", "u", &out->batches);
+        g_variant_lookup (manager_stats, "kernel-event-batches-time-ms", "d", &out->batches_ms);
+        g_variant_lookup (manager_stats, "kernel-event-batch-ports-added", "u", &out->ports_added);
+        g_variant_lookup (manager_stats, "kernel-event-batch-ports-removed", "u", &out->ports_removed);
+        g_variant_lookup (manager_stats, "kernel-event-batch-pending", "b", &out->batch_pending);
+        g_variant_lookup (manager_stats, "plugins-list-builds", "u", &out->plugins_list_builds);
+        g_variant_lookup (manager_stats, "plugins-list-candidates", "u", &out->plugins_list_candidates);
+        g_variant_lookup (manager_stats, "plugins-list-time-ms", "d", &out->plugins_list_ms);
+        g_variant_unref (manager_stats);
+    }
+    g_variant_unref (stats);
+    g_variant_unref (result);
+
+    return TRUE;
+}
+
+static gboolean
+stats_poll (gpointer wait_probing)
+{
+    Stats   stats;
+    gdouble now;
+
+    /* Wait for the batches as long as events are being reported */
+    if (n_pending)
+        return G_SOURCE_CONTINUE;
+
+    if (!stats_load (&stats, NULL)) {
+        g_main_loop_quit (loop);
+        return G_SOURCE_REMOVE;
+    }
+
+    now = g_timer_elapsed (timer, NULL);
+    if (stats.batches != last_stats.batches)
+        last_batch_elapsed = now;
+    if (stats.plugins_list_builds != last_stats.plugins_list_builds)
+        last_build_elapsed = now;
+    last_stats = stats;
+
+    if (!batches_done) {
+        if (stats.batch_pending)
+            return G_SOURCE_CONTINUE;
+        batches_done = TRUE;
+        last_build_elapsed = now;
+    }
+
+    /* Port probing is only waited for if requested */
+    if (GPOINTER_TO_UINT (wait_probing) && (now - last_build_elapsed) * 1000 < PROBING_IDLE_TIMEOUT_MS)
+        return G_SOURCE_CONTINUE;
+
+    g_main_loop_quit (loop);
+    return G_SOURCE_REMOVE;
+}
+
+static gdouble
+run_storm (MMManager *manager,
+           gboolean   remove_all)
+{
+    gint d, p, f;
+
+    /* Only batches processed from now on are accounted */
+    n_failed = 0;
+    last_batch_elapsed = 0.0;
+    last_build_elapsed = 0.0;
+    batches_done = FALSE;
+    if (stats_available && !stats_load (&start_stats, NULL))
+        stats_available = FALSE;
+    last_stats = start_stats;
+
+    g_timer_start (timer);
+    reported_elapsed = 0.0;
+
+    /* The replies are received before the events are processed, so the
+     * daemon statistics are polled until no batch is pending and, when ports
+     * are added, until they have all been given a list of plugins to probe */
+    if (stats_available)
+        g_timeout_add (STATS_POLL_MS, (GSourceFunc) stats_poll, GUINT_TO_POINTER (!remove_all));
+
+    if (remove_all) {
+        for (d = 0; d < n_devices; d++)
+            for (p = 0; p < n_ports; p++)
+                report_kernel_event (manager, "remove", d, p);
+    } else {
+        /* Interleave the ports of all devices, as seen after a hub reset */
+        for (f = 0; f < n_flaps; f++) {
+            for (d = 0; d < n_devices; d++)
+                for (p = 0; p < n_ports; p++)
+                    report_kernel_event (manager, "add", d, p);
+            for (d = 0; d < n_devices; d++)
+                for (p = 0; p < n_ports; p++)
+                    report_kernel_event (manager, "remove", d, p);
+        }
+        for (d = 0; d < n_devices; d++)
+            for (p = 0; p < n_ports; p++)
+                report_kernel_event (manager, "add", d, p);
+    }
+
+    g_main_loop_run (loop);
+    return reported_elapsed;
+}
+
+static gint
+port_name_cmp (const gchar **a,
+               const gchar **b)
+{
+    return g_strcmp0 (*a, *b);
+}
+
+static gboolean
+load_ports (GError **error)
+{
+    const gchar *subsystem;
+    GPtrArray   *found;
+    guint        n_needed;
+
+    subsystem = subsystem_str ? subsystem_str : "tty";
+    n_needed = n_devices * n_ports;
+
+    if (names_str) {
+        gchar **names;
+        guint   i;
+
+        names = g_strsplit (names_str, ",", -1);
+        found = g_ptr_array_new_with_free_func (g_free);
+        for (i = 0; names[i]; i++) {
+            g_strstrip (names[i]);
+            if (names[i][0])
+                g_ptr_array_add (found, g_strdup (names[i]));
+        }
+        g_strfreev (names);
+    } else {
+        gchar       *path;
+        GDir        *dir;
+        const gchar *name;
+
+        path = g_strdup_printf ("/sys/class/%s", subsystem);
+        dir = g_dir_open (path, 0, error);
+        g_free (path);
+        if (!dir)
+            return FALSE;
+
+        found = g_ptr_array_new_with_free_func (g_free);
+        while ((name = g_dir_read_name (dir)) != NULL)
+            g_ptr_array_add (found, g_strdup (name));
+        g_dir_close (dir);
+        g_ptr_array_sort (found, (GCompareFunc) port_name_cmp);
+    }
+
+    if (found->len < n_needed) {
+        g_set_error (error, G_IO_ERROR, G_IO_ERROR_NOT_FOUND,
+                     "%u %s ports needed (%d devices, %d ports each), only %u available",
+                     n_needed, subsystem, n_devices, n_ports, found->len);
+        g_ptr_array_unref (found);
+        return FALSE;
+    }
+
+    /* Keep only the ones needed, as a NULL-terminated array */
+    g_ptr_array_set_size (found, n_needed);
+    g_ptr_array_add (found, NULL);
+    ports = (gchar **) g_ptr_array_free (found, FALSE);
+    return TRUE;
+}
+
+static void
+print_batches (void)
+{
+    guint builds;
+
+    if (!stats_available)
+        return;
+
+    if (last_stats.batches == start_stats.batches) {
+        g_print ("  no kernel event batches processed by the daemon\n");
+        return;
+    }
+    g_print ("  daemon processed %u kernel event batches in %.3fms (%u ports removed, %u ports added), "
+             "last one done %.3fs after the first event\n",
+             last_stats.batches - start_stats.batches,
+             last_stats.batches_ms - start_stats.batches_ms,
+             last_stats.ports_removed - start_stats.ports_removed,
+             last_stats.ports_added - start_stats.ports_added,
+             last_batch_elapsed);
+
+    builds = last_stats.plugins_list_builds - start_stats.plugins_list_builds;
+    if (!builds)
+        return;
+    g_print ("  daemon built %u port plugin lists in %.3fms (%.1fus and %.1f candidate plugins per port), "
+             "last one done %.3fs after the first event\n",
+             builds,
+             last_stats.plugins_list_ms - start_stats.plugins_list_ms,
+             ((last_stats.plugins_list_ms - start_stats.plugins_list_ms) * 1000.0) / builds,
+             (gdouble) (last_stats.plugins_list_candidates - start_stats.plugins_list_candidates) / builds,
+             last_build_elapsed);
+}
+
+int main (int argc, char **argv)
+{
+    GOptionContext  *context;
+    MMManager       *manager;
+    gchar           *name_owner;
+    guint            n_events;
+    guint            n_failed_storm;
+    gdouble          elapsed;
+    GError          *error = NULL;
+
+    setlocale (LC_ALL, "");
+
+    /* Setup option context, process it and destroy it */
+    context = g_option_context_new ("- ModemManager hotplug storm generator");
+    g_option_context_add_main_entries (context, main_entries, NULL);
+    g_option_context_parse (context, &argc, &argv, NULL);
+    g_option_context_free (context);
+
+    if (version_flag)
+        print_version_and_exit ();
+
+    if (n_devices <= 0 || n_ports <= 0 || n_flaps < 0) {
+        g_printerr ("error: invalid storm size requested\n");
+        exit (EXIT_FAILURE);
+    }
+
+    if (!load_ports (&error)) {
+        g_printerr ("error: couldn't load ports: %s\n", error->message);
+        exit (EXIT_FAILURE);
+    }
+
+    /* Setup dbus connection to use */
+    connection = g_bus_get_sync (G_BUS_TYPE_SYSTEM, NULL, &error);
+    if (!connection) {
+        g_printerr ("error: couldn't get bus: %s\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    manager = mm_manager_new_sync (connection,
+                                   G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_DO_NOT_AUTO_START,
+                                   NULL,
+                                   &error);
+    if (!manager) {
+        g_printerr ("error: couldn't create manager: %s\n",
+                    error ? error->message : "unknown error");
+        exit (EXIT_FAILURE);
+    }
+
+    name_owner = g_dbus_object_manager_client_get_name_owner (G_DBUS_OBJECT_MANAGER_CLIENT (manager));
+    if (!name_owner) {
+        g_printerr ("error: couldn't find the ModemManager process in the bus\n");
+        exit (EXIT_FAILURE);
+    }
+    g_free (name_owner);
+
+    /* The batch processing can only be measured if the daemon exposes its
+     * statistics */
+    if (!stats_load (&start_stats, &error)) {
+        g_print ("warning: couldn't load daemon statistics, kernel event batches won't be measured: %s\n",
+                 error->message);
+        g_clear_error (&error);
+    } else
+        stats_available = TRUE;
+
+    loop = g_main_loop_new (NULL, FALSE);
+    timer = g_timer_new ();
+
+    n_events = n_devices * n_ports * (2 * n_flaps + 1);
+    g_print ("reporting %u kernel events (%d devices, %d ports each, %d flaps per port)...\n",
+             n_events, n_devices, n_ports, n_flaps);
+    elapsed = run_storm (manager, FALSE);
+    g_print ("storm reported in %.3fs (%.0f events/s), %u events failed\n",
+             elapsed, n_events / elapsed, n_failed);
+    print_batches ();
+    n_failed_storm = n_failed;
+
+    if (!keep_flag) {
+        elapsed = run_storm (manager, TRUE);
+        g_print ("cleanup reported in %.3fs, %u events failed\n", elapsed, n_failed);
+        print_batches ();
+    }
+
+    g_timer_destroy (timer);
+    g_main_loop_unref (loop);
+    g_object_unref (manager);
+    g_object_unref (connection);
+    g_strfreev (ports);
+    g_free (subsystem_str);
+    g_free (names_str);
+
+    return ((n_failed_storm || n_failed) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
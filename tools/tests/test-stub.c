@@ -442,6 +442,81 @@ test_sim_interface (TestData **ptdata,
     g_clear_object (&mm_modem);
 }
 
+static gboolean
+snapshot_updated (TestData *tdata,
+                  guint     generation)
+{
+    MMManagerSnapshot *snapshot;
+
+    snapshot = mm_manager_peek_snapshot (tdata->mm_manager);
+    return (snapshot && mm_manager_snapshot_get_generation (snapshot) != generation);
+}
+
+static void
+wait_snapshot_update (TestData *tdata,
+                      guint     generation)
+{
+    tdata->timeout_id = g_timeout_add (1000, loop_timeout_cb, tdata);
+    while (!snapshot_updated (tdata, generation))
+        g_main_context_iteration (NULL, TRUE);
+    g_source_remove (tdata->timeout_id);
+    tdata->timeout_id = 0;
+}
+
+static void
+test_manager_snapshot (TestData **ptdata,
+                       gconstpointer data)
+{
+    TestData *tdata = NULL;
+    MMManagerSnapshot *snapshot;
+    MMManagerSnapshot *previous;
+    GError *error = NULL;
+    guint32 unlock_required = 0;
+    guint generation;
+    const gchar *sim_path;
+    g_autofree gchar *modem_path = NULL;
+    g_autofree gchar *second_modem_path = NULL;
+
+    tdata = *ptdata;
+    modem_path = add_modem (tdata, TRUE, "89330122503000800750");
+
+    /* Initial load includes the modem and its SIM */
+    snapshot = mm_manager_load_snapshot_sync (tdata->mm_manager, NULL, &error);
+    g_assert_no_error (error);
+    g_assert_nonnull (snapshot);
+    g_assert (snapshot == mm_manager_peek_snapshot (tdata->mm_manager));
+    g_assert (mm_manager_snapshot_has_object (snapshot, modem_path));
+    sim_path = mm_manager_snapshot_peek_string (snapshot, modem_path, MM_DBUS_INTERFACE_MODEM, MM_MODEM_PROPERTY_SIM);
+    g_assert_nonnull (sim_path);
+    g_assert_cmpstr (mm_manager_snapshot_peek_string (snapshot, sim_path, MM_DBUS_INTERFACE_SIM, MM_SIM_PROPERTY_SIMIDENTIFIER),
+                     ==, "89330122503000800750");
+    g_assert (mm_manager_snapshot_get_uint32 (snapshot, modem_path, MM_DBUS_INTERFACE_MODEM, MM_MODEM_PROPERTY_UNLOCKREQUIRED, &unlock_required));
+    g_assert_cmpuint (unlock_required, ==, MM_MODEM_LOCK_NONE);
+
+    /* PropertiesChanged builds a new snapshot, the previous one is untouched */
+    previous = snapshot;
+    generation = mm_manager_snapshot_get_generation (previous);
+    set_modem_unlock (tdata, MM_MODEM_LOCK_SIM_PIN);
+    wait_snapshot_update (tdata, generation);
+    snapshot = mm_manager_peek_snapshot (tdata->mm_manager);
+    g_assert (snapshot != previous);
+    g_assert (mm_manager_snapshot_get_uint32 (snapshot, modem_path, MM_DBUS_INTERFACE_MODEM, MM_MODEM_PROPERTY_UNLOCKREQUIRED, &unlock_required));
+    g_assert_cmpuint (unlock_required, ==, MM_MODEM_LOCK_SIM_PIN);
+    g_assert (mm_manager_snapshot_get_uint32 (previous, modem_path, MM_DBUS_INTERFACE_MODEM, MM_MODEM_PROPERTY_UNLOCKREQUIRED, &unlock_required));
+    g_assert_cmpuint (unlock_required, ==, MM_MODEM_LOCK_NONE);
+    g_object_unref (previous);
+
+    /* InterfacesAdded adds new modems to the snapshot */
+    generation = mm_manager_snapshot_get_generation (snapshot);
+    tdata->modem_object_path = NULL;
+    g_clear_object (&tdata->mm_modem_prop_proxy);
+    second_modem_path = add_modem (tdata, FALSE, "");
+    wait_snapshot_update (tdata, generation);
+    snapshot = mm_manager_peek_snapshot (tdata->mm_manager);
+    g_assert (mm_manager_snapshot_has_object (snapshot, second_modem_path));
+    g_assert (mm_manager_snapshot_has_object (snapshot, modem_path));
+}
+
 int main (int argc,
           char **argv)
 {
@@ -455,5 +530,9 @@ int main (int argc,
                 TestData *, NULL, setup,
                 test_sim_interface,
                 teardown);
+    g_test_add ("/MM/stub/manager/snapshot",
+                TestData *, NULL, setup,
+                test_manager_snapshot,
+                teardown);
     return g_test_run ();
 }